@@ -0,0 +1,30 @@
+#pragma once
+#include "../core/IComponent.h"
+#include "../core/EntityHandle.h"
+
+/**
+ * @file HierarchyC.h
+ * @brief Component linking an entity's transform to a parent entity.
+ */
+
+/**
+ * @struct HierarchyC
+ * @brief Makes the entity's TransformC relative to another entity.
+ *
+ * Only children carry this component; an entity without it is a root whose
+ * TransformC is already in world space. The TransformSystem resolves the
+ * links, orders entities by depth and caches their world matrices. Parents
+ * are normally set with TransformSystem::setParent(), which rejects cycles.
+ */
+struct HierarchyC : public IComponent
+{
+    /** @brief Entity whose world transform this entity's TransformC is relative to */
+    EntityHandle parent;
+
+    /**
+     * @brief Construct a new HierarchyC component.
+     *
+     * @param parentHandle Parent entity (default: none)
+     */
+    explicit HierarchyC(EntityHandle parentHandle = EntityHandle()) : parent(parentHandle) {}
+};
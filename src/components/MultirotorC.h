@@ -0,0 +1,40 @@
+#pragma once
+#include "../core/IComponent.h"
+#include "../physics/MultirotorModel.h"
+#include <memory>
+
+/**
+ * @file MultirotorC.h
+ * @brief Component for entities flown as electric multirotors.
+ *
+ * The MultirotorC component links an entity to its compiled vehicle type
+ * and holds the commands and the rotor, motor and battery state that the
+ * MultirotorSystem advances every fixed step.
+ */
+
+/**
+ * @struct MultirotorC
+ * @brief Component that drives an entity's PhysicsC with rotor thrust and torque.
+ *
+ * The parameter block is immutable and shared by every drone of the same
+ * type; only the commands and the state are per entity.
+ */
+struct MultirotorC : public IComponent
+{
+    /** @brief Compiled vehicle type, shared between drones built from the same file */
+    std::shared_ptr<const MultirotorParams> params;
+
+    /** @brief Commands applied through the control-map, held until changed */
+    MultirotorInput input;
+
+    /** @brief Rotor speeds and battery state */
+    MultirotorState state;
+
+    /**
+     * @brief Construct a new MultirotorC component.
+     *
+     * @param p Compiled vehicle type (default: none, which leaves the entity unpowered)
+     */
+    MultirotorC(std::shared_ptr<const MultirotorParams> p = nullptr)
+        : params(std::move(p)) {}
+};
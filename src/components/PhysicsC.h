@@ -1,6 +1,8 @@
 #pragma once
 #include "../core/IComponent.h"
-#include <string>
+#include "../core/EntityHandle.h"
+#include "../core/Vector3D.h"
+#include "../physics/ColliderType.h"
 
 /**
  * @file PhysicsC.h
@@ -30,10 +32,10 @@ struct PhysicsC : public IComponent
     /** @brief Restitution (bounciness) coefficient (0.0 = no bounce, 1.0 = perfect bounce) */
     float restitution;
 
-    /** @brief Type of collider (e.g., "box", "sphere", "capsule", etc.) */
-    std::string colliderType;
+    /** @brief Shape of the collider */
+    ColliderType colliderType;
 
-    /** @brief Size of the collider in each dimension (x, y, z) */
+    /** @brief Size of the collider's bounding box in each dimension (x, y, z); a sphere's diameter is colliderSize[0] */
     float colliderSize[3];
 
     /** @brief Whether the entity is kinematic (moved by script, not by physics) */
@@ -42,24 +44,51 @@ struct PhysicsC : public IComponent
     /** @brief Whether the entity is affected by gravity */
     bool useGravity;
 
+    /** @brief Linear velocity in world space (m/s) */
+    Vector3D velocity;
+
+    /** @brief Angular velocity in world space (rad/s) */
+    Vector3D angularVelocity;
+
+    /** @brief Principal moments of inertia (kg m^2); zero derives them from mass and collider */
+    Vector3D inertia;
+
+    /** @brief Aerodynamic drag coefficient, applied to the collider's mean cross-section */
+    float dragCoefficient;
+
+    /** @brief Force to apply during the next physics step, in world space (N); cleared by the step */
+    Vector3D force;
+
+    /** @brief Torque to apply during the next physics step, in world space (N m); cleared by the step */
+    Vector3D torque;
+
+    /** @brief Whether the body is asleep: at rest and skipped by the simulation until touched or pushed */
+    bool isSleeping;
+
+    /** @brief Time the body has been nearly at rest (s) */
+    float sleepTime;
+
+    /** @brief A member of the sleeping island the body belongs to, shared by the whole island; invalid while awake */
+    EntityHandle sleepIsland;
+
     /**
      * @brief Construct a new PhysicsC component.
      *
      * @param m Mass of the entity (default: 1.0)
      * @param f Friction coefficient (default: 0.5)
      * @param r Restitution coefficient (default: 0.3)
-     * @param cType Type of collider (default: "sphere")
+     * @param cType Shape of the collider (default: sphere)
      * @param k Whether the entity is kinematic (default: false)
      * @param g Whether the entity is affected by gravity (default: true)
      */
     PhysicsC(float m = 1.0f,
              float f = 0.5f,
              float r = 0.3f,
-             std::string cType = "sphere",
+             ColliderType cType = ColliderType::Sphere,
              bool k = false,
              bool g = true)
         : mass(m), friction(f), restitution(r), colliderType(cType),
-          isKinematic(k), useGravity(g)
+          isKinematic(k), useGravity(g), dragCoefficient(1.0f), isSleeping(false), sleepTime(0.0f)
     {
         colliderSize[0] = colliderSize[1] = colliderSize[2] = 1.0f;
     }
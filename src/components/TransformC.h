@@ -31,6 +31,9 @@ struct TransformC : public IComponent
     /** @brief Scale of the entity in each axis */
     Vector3D scale;
 
+    /** @brief Position at the start of the last fixed physics step, for render interpolation */
+    Vector3D previousPosition;
+
     /**
      * @brief Construct a new TransformC component.
      *
@@ -39,6 +42,17 @@ struct TransformC : public IComponent
      * @param scl Initial scale (default: unit scale)
      */
     TransformC(Vector3D pos = Vector3D(), Quaternion rot = Quaternion(), Vector3D scl = Vector3D(1.0f, 1.0f, 1.0f))
-        : position(pos), rotation(rot), scale(scl) {}
+        : position(pos), rotation(rot), scale(scl), previousPosition(pos) {}
+
+    /**
+     * @brief Blend the previous and current physics positions.
+     *
+     * @param alpha Interpolation factor from SimClock::getAlpha() (0 = previous, 1 = current)
+     * @return Position to render
+     */
+    Vector3D interpolatedPosition(float alpha) const
+    {
+        return previousPosition + (position - previousPosition) * alpha;
+    }
 };
 
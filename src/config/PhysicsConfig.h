@@ -15,14 +15,18 @@ namespace Physics
         bool enableCollisions = true;     /**< Whether collision detection is enabled */
         int iterationsPerStep = 1;        /**< Physics iterations per time step */
         int maxSubsteps = 10;             /**< Maximum physics substeps per frame */
+        float rotorSubstepRate = 4000.0f; /**< Multirotor rotor, motor and battery substeps per second (2000-8000) */
+        float timeScale = 1.0f;           /**< Simulated seconds per real second */
         float seaLevelDensity = 1.225f;   /**< Air density at sea level in kg/m³ */
-        float scaleHeight = 8000.0f;      /**< Atmospheric scale height in meters */
+        float scaleHeight = 8000.0f;      /**< Atmospheric scale height in meters, for ExponentialAirDensityModel */
         float baseWindSpeed = 0.0f;       /**< Base wind speed in m/s */
-        float turbulenceScale = 100.0f;   /**< Turbulence scale factor */
-        float turbulenceIntensity = 0.1f; /**< Turbulence intensity (0-1) */
+        float turbulenceScale = 100.0f;   /**< Size of the wind gusts in meters */
+        float turbulenceIntensity = 0.1f; /**< RMS gust speed as a fraction of the base wind speed (0-1) */
         int randomSeed = 12345;           /**< Random seed for procedural generators */
         float restitution = 0.5f;         /**< Collision elasticity (0-1) */
         float friction = 0.3f;            /**< Surface friction coefficient */
+        int workerThreads = -1;           /**< Job system worker threads, -1 for hardware concurrency minus one */
+        bool deterministic = false;       /**< Fixed job chunking and reduction order for bit-exact runs */
 
         PhysicsConfig() = default;
     };
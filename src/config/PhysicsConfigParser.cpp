@@ -70,6 +70,8 @@ Physics::PhysicsConfig PhysicsConfigParser::parseConfig(const std::string &xmlCo
         // Parse Simulation Clock parameters
         config.fixedTimestep = extractFloatValue(xmlContent, "FixedTimestep", config.fixedTimestep);
         config.maxSubsteps = extractIntValue(xmlContent, "MaxSubsteps", config.maxSubsteps);
+        config.timeScale = extractFloatValue(xmlContent, "TimeScale", config.timeScale);
+        config.rotorSubstepRate = extractFloatValue(xmlContent, "RotorSubstepRate", config.rotorSubstepRate);
 
         // Parse Air Density Model parameters
         config.seaLevelDensity = extractFloatValue(xmlContent, "SeaLevelDensity", config.seaLevelDensity);
@@ -85,6 +87,10 @@ Physics::PhysicsConfig PhysicsConfigParser::parseConfig(const std::string &xmlCo
         config.restitution = extractFloatValue(xmlContent, "Restitution", config.restitution);
         config.friction = extractFloatValue(xmlContent, "Friction", config.friction);
 
+        // Parse threading parameters
+        config.workerThreads = extractIntValue(xmlContent, "WorkerThreads", config.workerThreads);
+        config.deterministic = extractIntValue(xmlContent, "Deterministic", config.deterministic ? 1 : 0) != 0;
+
         if (Debug())
         {
             DEBUG_LOG("Physics configuration loaded successfully:");
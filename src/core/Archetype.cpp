@@ -0,0 +1,241 @@
+#include "Archetype.h"
+
+/**
+ * @brief Construct an empty column for the given component type.
+ *
+ * @param typeId Dense ID of the component type stored in this column
+ */
+ComponentColumn::ComponentColumn(ComponentTypeId typeId)
+    : typeId_(typeId), info_(&ComponentRegistry::getInfo(typeId)), data_(nullptr), size_(0), capacity_(0)
+{
+}
+
+/**
+ * @brief Destroy all stored components and release the storage.
+ */
+ComponentColumn::~ComponentColumn()
+{
+    if (data_ == nullptr)
+        return;
+
+    for (std::size_t i = 0; i < size_; ++i)
+    {
+        info_->destroy(at(i));
+    }
+    ::operator delete(data_, std::align_val_t(info_->alignment));
+}
+
+/**
+ * @brief Take over the storage of another column.
+ *
+ * @param other Column to move from; left empty
+ */
+ComponentColumn::ComponentColumn(ComponentColumn &&other) noexcept
+    : typeId_(other.typeId_), info_(other.info_), data_(other.data_), size_(other.size_), capacity_(other.capacity_)
+{
+    other.data_ = nullptr;
+    other.size_ = 0;
+    other.capacity_ = 0;
+}
+
+/**
+ * @brief Ensure capacity for at least the given number of components.
+ *
+ * Existing components are move-constructed into the new buffer, so
+ * pointers into the column are invalidated when it grows.
+ *
+ * @param capacity Required capacity in elements
+ */
+void ComponentColumn::reserve(std::size_t capacity)
+{
+    if (capacity <= capacity_)
+        return;
+
+    auto *newData = static_cast<unsigned char *>(
+        ::operator new(capacity * info_->size, std::align_val_t(info_->alignment)));
+
+    for (std::size_t i = 0; i < size_; ++i)
+    {
+        void *source = at(i);
+        info_->moveConstruct(newData + i * info_->size, source);
+        info_->destroy(source);
+    }
+
+    if (data_ != nullptr)
+    {
+        ::operator delete(data_, std::align_val_t(info_->alignment));
+    }
+
+    data_ = newData;
+    capacity_ = capacity;
+}
+
+/**
+ * @brief Append a component by move-constructing it from source.
+ *
+ * @param source Pointer to a component of this column's type
+ * @return Pointer to the newly constructed component
+ */
+void *ComponentColumn::pushMove(void *source)
+{
+    if (size_ == capacity_)
+    {
+        reserve(capacity_ == 0 ? 16 : capacity_ * 2);
+    }
+
+    void *target = data_ + size_ * info_->size;
+    info_->moveConstruct(target, source);
+    ++size_;
+    return target;
+}
+
+/**
+ * @brief Append a component by copy-constructing it from source.
+ *
+ * @param source Pointer to a component of this column's type (must be copyable)
+ * @return Pointer to the newly constructed component
+ */
+void *ComponentColumn::pushCopy(const void *source)
+{
+    if (size_ == capacity_)
+    {
+        reserve(capacity_ == 0 ? 16 : capacity_ * 2);
+    }
+
+    void *target = data_ + size_ * info_->size;
+    info_->copyConstruct(target, source);
+    ++size_;
+    return target;
+}
+
+/**
+ * @brief Replace the component at a row by move-constructing from source.
+ *
+ * @param row Row to overwrite
+ * @param source Pointer to a component of this column's type
+ */
+void ComponentColumn::replaceMove(std::size_t row, void *source)
+{
+    void *target = at(row);
+    info_->destroy(target);
+    info_->moveConstruct(target, source);
+}
+
+/**
+ * @brief Remove a row by moving the last element into its place.
+ *
+ * @param row Row to remove
+ */
+void ComponentColumn::swapRemove(std::size_t row)
+{
+    const std::size_t last = size_ - 1;
+    if (row != last)
+    {
+        replaceMove(row, at(last));
+    }
+    info_->destroy(at(last));
+    --size_;
+}
+
+/**
+ * @brief Destroy the last component.
+ */
+void ComponentColumn::popBack()
+{
+    info_->destroy(at(size_ - 1));
+    --size_;
+}
+
+/**
+ * @brief Construct an empty archetype for a component signature.
+ *
+ * Creates one column per set bit in the mask, in ascending type ID order.
+ *
+ * @param mask Set of component types stored by this archetype
+ */
+Archetype::Archetype(const ComponentMask &mask) : mask_(mask)
+{
+    columnIndex_.fill(-1);
+    addTransitions_.fill(nullptr);
+    removeTransitions_.fill(nullptr);
+
+    columns_.reserve(mask.count());
+    for (std::size_t typeId = 0; typeId < MaxComponentTypes; ++typeId)
+    {
+        if (mask.test(typeId))
+        {
+            columnIndex_[typeId] = static_cast<std::int16_t>(columns_.size());
+            columns_.emplace_back(static_cast<ComponentTypeId>(typeId));
+        }
+    }
+}
+
+/**
+ * @brief Reserve capacity in every column.
+ *
+ * @param capacity Required capacity in rows
+ */
+void Archetype::reserve(std::size_t capacity)
+{
+    entities_.reserve(capacity);
+    for (auto &column : columns_)
+    {
+        column.reserve(capacity);
+    }
+}
+
+/**
+ * @brief Append an entity row.
+ *
+ * @param entity Entity that owns the new row
+ * @return Index of the new row
+ */
+std::size_t Archetype::appendEntity(Entity *entity)
+{
+    entities_.push_back(entity);
+    return entities_.size() - 1;
+}
+
+/**
+ * @brief Remove a row, moving the last row into its place.
+ *
+ * @param row Row to remove
+ * @return The entity that now occupies the row, or nullptr if the last row was removed
+ */
+Entity *Archetype::removeRow(std::size_t row)
+{
+    for (auto &column : columns_)
+    {
+        column.swapRemove(row);
+    }
+
+    const std::size_t last = entities_.size() - 1;
+    Entity *moved = nullptr;
+    if (row != last)
+    {
+        entities_[row] = entities_[last];
+        moved = entities_[row];
+    }
+    entities_.pop_back();
+    return moved;
+}
+
+/**
+ * @brief Drop rows from the end, including components pushed for a row not yet appended.
+ *
+ * Used to undo a batch that failed part way: columns may then hold one
+ * component more than there are entity rows.
+ *
+ * @param rows Number of rows to keep (at most size())
+ */
+void Archetype::truncate(std::size_t rows)
+{
+    for (auto &column : columns_)
+    {
+        while (column.size() > rows)
+        {
+            column.popBack();
+        }
+    }
+    entities_.resize(rows);
+}
@@ -0,0 +1,263 @@
+#ifndef ARCHETYPE_H
+#define ARCHETYPE_H
+
+#include "ComponentTypeId.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class Entity;
+
+/**
+ * @brief Contiguous, type-erased array of components of a single type.
+ *
+ * A column owns raw aligned storage and constructs/destroys elements through
+ * the ComponentInfo of its type, so components of the same type sit next to
+ * each other in memory instead of in separate heap allocations.
+ */
+class ComponentColumn
+{
+public:
+    /**
+     * @brief Construct an empty column for the given component type.
+     *
+     * @param typeId Dense ID of the component type stored in this column
+     */
+    explicit ComponentColumn(ComponentTypeId typeId);
+
+    ~ComponentColumn();
+
+    ComponentColumn(ComponentColumn &&other) noexcept;
+    ComponentColumn &operator=(ComponentColumn &&other) = delete;
+    ComponentColumn(const ComponentColumn &) = delete;
+    ComponentColumn &operator=(const ComponentColumn &) = delete;
+
+    /**
+     * @brief Get the component type stored in this column.
+     *
+     * @return Dense component type ID
+     */
+    ComponentTypeId getTypeId() const { return typeId_; }
+
+    /**
+     * @brief Get the number of components stored.
+     *
+     * @return Element count
+     */
+    std::size_t size() const { return size_; }
+
+    /**
+     * @brief Get the number of components the column can hold without growing.
+     *
+     * @return Capacity in elements
+     */
+    std::size_t capacity() const { return capacity_; }
+
+    /**
+     * @brief Get a pointer to the component at the given row.
+     *
+     * @param row Row index (must be < size())
+     * @return Untyped pointer to the component
+     */
+    void *at(std::size_t row) { return data_ + row * info_->size; }
+
+    /**
+     * @brief Get the column as a typed array.
+     *
+     * @tparam T Component type stored in this column
+     * @return Pointer to the first element
+     */
+    template <typename T>
+    T *data() { return reinterpret_cast<T *>(data_); }
+
+    /**
+     * @brief Ensure capacity for at least the given number of components.
+     *
+     * @param capacity Required capacity in elements
+     */
+    void reserve(std::size_t capacity);
+
+    /**
+     * @brief Append a component by move-constructing it from source.
+     *
+     * @param source Pointer to a component of this column's type
+     * @return Pointer to the newly constructed component
+     */
+    void *pushMove(void *source);
+
+    /**
+     * @brief Append a component by copy-constructing it from source.
+     *
+     * @param source Pointer to a component of this column's type (must be copyable)
+     * @return Pointer to the newly constructed component
+     */
+    void *pushCopy(const void *source);
+
+    /**
+     * @brief Replace the component at a row by move-constructing from source.
+     *
+     * @param row Row to overwrite
+     * @param source Pointer to a component of this column's type
+     */
+    void replaceMove(std::size_t row, void *source);
+
+    /**
+     * @brief Remove a row by moving the last element into its place.
+     *
+     * @param row Row to remove
+     */
+    void swapRemove(std::size_t row);
+
+    /**
+     * @brief Destroy the last component.
+     */
+    void popBack();
+
+private:
+    ComponentTypeId typeId_;     /**< Component type stored in this column */
+    const ComponentInfo *info_;  /**< Size/alignment/lifetime operations for the type */
+    unsigned char *data_;        /**< Raw aligned storage */
+    std::size_t size_;           /**< Number of constructed elements */
+    std::size_t capacity_;       /**< Number of elements the storage can hold */
+};
+
+/**
+ * @brief Storage for all entities sharing the same set of component types.
+ *
+ * Each archetype keeps one ComponentColumn per component type in its mask.
+ * Row i of every column belongs to the entity at getEntity(i). Adding or
+ * removing a component moves an entity to a different archetype; the
+ * transitions are cached per component type so repeated moves are O(1).
+ */
+class Archetype
+{
+public:
+    /**
+     * @brief Construct an empty archetype for a component signature.
+     *
+     * @param mask Set of component types stored by this archetype
+     */
+    explicit Archetype(const ComponentMask &mask);
+
+    /**
+     * @brief Get the component signature of this archetype.
+     *
+     * @return Component mask
+     */
+    const ComponentMask &getMask() const { return mask_; }
+
+    /**
+     * @brief Get the number of entities stored.
+     *
+     * @return Row count
+     */
+    std::size_t size() const { return entities_.size(); }
+
+    /**
+     * @brief Get the entity stored at a row.
+     *
+     * @param row Row index
+     * @return Pointer to the entity
+     */
+    Entity *getEntity(std::size_t row) const { return entities_[row]; }
+
+    /**
+     * @brief Get all entities stored in this archetype, in row order.
+     *
+     * @return Const reference to the entity list
+     */
+    const std::vector<Entity *> &getEntities() const { return entities_; }
+
+    /**
+     * @brief Check whether this archetype stores a component type.
+     *
+     * @param typeId Dense component type ID
+     * @return true if the type is part of the signature
+     */
+    bool hasComponent(ComponentTypeId typeId) const { return columnIndex_[typeId] >= 0; }
+
+    /**
+     * @brief Get the column for a component type.
+     *
+     * @param typeId Dense component type ID
+     * @return Pointer to the column, or nullptr if the type is not stored here
+     */
+    ComponentColumn *getColumn(ComponentTypeId typeId)
+    {
+        const int index = columnIndex_[typeId];
+        return index >= 0 ? &columns_[index] : nullptr;
+    }
+
+    /**
+     * @brief Get a component of an entity stored in this archetype.
+     *
+     * @param typeId Dense component type ID
+     * @param row Row of the entity
+     * @return Untyped pointer to the component, or nullptr if not stored here
+     */
+    void *getComponent(ComponentTypeId typeId, std::size_t row)
+    {
+        const int index = columnIndex_[typeId];
+        return index >= 0 ? columns_[index].at(row) : nullptr;
+    }
+
+    /**
+     * @brief Get all columns in ascending component type order.
+     *
+     * @return Reference to the column list
+     */
+    std::vector<ComponentColumn> &getColumns() { return columns_; }
+
+    /**
+     * @brief Reserve capacity in every column.
+     *
+     * @param capacity Required capacity in rows
+     */
+    void reserve(std::size_t capacity);
+
+    /**
+     * @brief Append an entity row. The caller must push one component into every column.
+     *
+     * @param entity Entity that owns the new row
+     * @return Index of the new row
+     */
+    std::size_t appendEntity(Entity *entity);
+
+    /**
+     * @brief Remove a row, moving the last row into its place.
+     *
+     * @param row Row to remove
+     * @return The entity that now occupies the row, or nullptr if the last row was removed
+     */
+    Entity *removeRow(std::size_t row);
+
+    /**
+     * @brief Drop rows from the end, including components pushed for a row not yet appended.
+     *
+     * @param rows Number of rows to keep (at most size())
+     */
+    void truncate(std::size_t rows);
+
+    /** @brief Cached archetype reached by adding a component type (nullptr if not yet resolved) */
+    Archetype *getAddTransition(ComponentTypeId typeId) const { return addTransitions_[typeId]; }
+
+    /** @brief Cached archetype reached by removing a component type (nullptr if not yet resolved) */
+    Archetype *getRemoveTransition(ComponentTypeId typeId) const { return removeTransitions_[typeId]; }
+
+    /** @brief Cache the archetype reached by adding a component type */
+    void setAddTransition(ComponentTypeId typeId, Archetype *target) { addTransitions_[typeId] = target; }
+
+    /** @brief Cache the archetype reached by removing a component type */
+    void setRemoveTransition(ComponentTypeId typeId, Archetype *target) { removeTransitions_[typeId] = target; }
+
+private:
+    ComponentMask mask_;                                         /**< Component signature */
+    std::vector<ComponentColumn> columns_;                       /**< One column per component type, sorted by type ID */
+    std::array<std::int16_t, MaxComponentTypes> columnIndex_;    /**< Type ID -> column index, -1 if absent */
+    std::vector<Entity *> entities_;                             /**< Row -> owning entity */
+    std::array<Archetype *, MaxComponentTypes> addTransitions_;    /**< Cached add-component edges */
+    std::array<Archetype *, MaxComponentTypes> removeTransitions_; /**< Cached remove-component edges */
+};
+
+#endif
@@ -1,5 +1,6 @@
 #include "AssetPackLoader.h"
 #include "../platform/PugiXmlParser.h"
+#include "Metrics.h"
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -32,6 +33,10 @@ AssetPackLoader::~AssetPackLoader() {}
  */
 bool AssetPackLoader::loadPackage(const std::string &packagePath)
 {
+    static Histogram &loadTime = MetricsRegistry::instance().histogram("assets.load_time");
+    static Counter &loadFailures = MetricsRegistry::instance().counter("assets.load_failures");
+    MetricTimer loadTimer(loadTime);
+
     DEBUG_LOG("Attempting to load package from: " << packagePath);
 
     // Read XML file
@@ -39,6 +44,7 @@ bool AssetPackLoader::loadPackage(const std::string &packagePath)
     if (!file.is_open())
     {
         std::cerr << "Failed to open package file: " << packagePath << std::endl;
+        loadFailures.add();
         return false;
     }
 
@@ -59,6 +65,7 @@ bool AssetPackLoader::loadPackage(const std::string &packagePath)
     if (!parseAssets(xmlContent, packageName))
     {
         std::cerr << "Failed to parse assets from package: " << packageName << std::endl;
+        loadFailures.add();
         return false;
     }
 
@@ -66,10 +73,12 @@ bool AssetPackLoader::loadPackage(const std::string &packagePath)
     if (!parseConfigurations(xmlContent, packageName))
     {
         std::cerr << "Failed to parse configurations from package: " << packageName << std::endl;
+        loadFailures.add();
         return false;
     }
 
     registry_.markPackageLoaded(packageName);
+    MetricsRegistry::instance().counter("assets.packages_loaded").add();
     DEBUG_LOG("Successfully loaded package: " << packageName);
     return true;
 }
@@ -0,0 +1,53 @@
+#include "CommandBuffer.h"
+
+/**
+ * @brief Record the creation of an empty entity.
+ *
+ * @param name Optional entity name
+ * @return Reference to the entity (valid until the buffer is flushed)
+ */
+Entity &CommandBuffer::spawn(const std::string &name)
+{
+    auto entity = std::make_unique<Entity>();
+    entity->setName(name);
+    return spawn(std::move(entity));
+}
+
+/**
+ * @brief Record the addition of an already built entity.
+ *
+ * @param entity Entity to add to the World at the next flush
+ * @return Reference to the entity (valid until the buffer is flushed)
+ */
+Entity &CommandBuffer::spawn(std::unique_ptr<Entity> entity)
+{
+    Command command;
+    command.type = CommandType::Spawn;
+    command.entity = std::move(entity);
+    Entity &spawned = *command.entity;
+    commands_.push_back(std::move(command));
+    ++spawnCount_;
+    return spawned;
+}
+
+/**
+ * @brief Record the destruction of an entity.
+ *
+ * @param handle Handle of the entity to destroy
+ */
+void CommandBuffer::destroy(EntityHandle handle)
+{
+    Command command;
+    command.type = CommandType::Destroy;
+    command.handle = handle;
+    commands_.push_back(std::move(command));
+}
+
+/**
+ * @brief Discard every recorded command, keeping the allocated capacity.
+ */
+void CommandBuffer::clear()
+{
+    commands_.clear();
+    spawnCount_ = 0;
+}
@@ -0,0 +1,158 @@
+#ifndef COMMANDBUFFER_H
+#define COMMANDBUFFER_H
+
+#include "Entity.h"
+#include "EntityHandle.h"
+#include "ComponentTypeId.h"
+#include "IComponent.h"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Records structural changes to a World for later application.
+ *
+ * Systems must not create or destroy entities, or add or remove components
+ * of attached entities, while the World is being updated: other systems may
+ * be iterating the same archetypes on other threads. Instead they record
+ * the change in the calling thread's buffer (World::getCommandBuffer()) and
+ * the World applies every buffer in one batch at the next sync point
+ * (World::flushCommands()).
+ *
+ * Commands are applied in the order they were recorded within a buffer.
+ * Commands that target an entity destroyed in the meantime are ignored.
+ * The buffer keeps its capacity across flushes, so steady spawn/destroy
+ * traffic does not reallocate.
+ *
+ * A buffer is only ever written by the thread that owns it.
+ */
+class CommandBuffer
+{
+public:
+    /**
+     * @brief Construct an empty command buffer.
+     */
+    CommandBuffer() = default;
+
+    CommandBuffer(const CommandBuffer &) = delete;
+    CommandBuffer &operator=(const CommandBuffer &) = delete;
+
+    /**
+     * @brief Record the creation of an empty entity.
+     *
+     * The returned entity is not yet part of the World; components added to
+     * it are held as pending components and moved into archetype storage
+     * when the buffer is flushed.
+     *
+     * @param name Optional entity name
+     * @return Reference to the entity (valid until the buffer is flushed)
+     */
+    Entity &spawn(const std::string &name = "");
+
+    /**
+     * @brief Record the addition of an already built entity.
+     *
+     * @param entity Entity to add to the World at the next flush
+     * @return Reference to the entity (valid until the buffer is flushed)
+     */
+    Entity &spawn(std::unique_ptr<Entity> entity);
+
+    /**
+     * @brief Record the destruction of an entity.
+     *
+     * @param handle Handle of the entity to destroy
+     */
+    void destroy(EntityHandle handle);
+
+    /**
+     * @brief Record the addition (or replacement) of a component.
+     *
+     * @tparam T The type of component to add
+     * @param handle Handle of the target entity
+     * @param component Component instance to move into the entity
+     */
+    template <typename T>
+    void addComponent(EntityHandle handle, std::unique_ptr<T> component)
+    {
+        Command command;
+        command.type = CommandType::AddComponent;
+        command.handle = handle;
+        command.typeId = componentTypeId<T>();
+        command.component = std::move(component);
+        commands_.push_back(std::move(command));
+    }
+
+    /**
+     * @brief Record the removal of a component.
+     *
+     * @tparam T The type of component to remove
+     * @param handle Handle of the target entity
+     */
+    template <typename T>
+    void removeComponent(EntityHandle handle)
+    {
+        Command command;
+        command.type = CommandType::RemoveComponent;
+        command.handle = handle;
+        command.typeId = componentTypeId<T>();
+        commands_.push_back(std::move(command));
+    }
+
+    /**
+     * @brief Check whether the buffer holds no commands.
+     *
+     * @return true if nothing has been recorded since the last flush
+     */
+    bool empty() const { return commands_.empty(); }
+
+    /**
+     * @brief Get the number of recorded commands.
+     *
+     * @return Command count
+     */
+    std::size_t size() const { return commands_.size(); }
+
+    /**
+     * @brief Get the number of recorded spawn commands.
+     *
+     * @return Entities that will be added at the next flush
+     */
+    std::size_t getSpawnCount() const { return spawnCount_; }
+
+    /**
+     * @brief Discard every recorded command, keeping the allocated capacity.
+     */
+    void clear();
+
+private:
+    friend class World;
+
+    /**
+     * @brief Kind of structural change.
+     */
+    enum class CommandType : std::uint8_t
+    {
+        Spawn,
+        Destroy,
+        AddComponent,
+        RemoveComponent
+    };
+
+    /**
+     * @brief One recorded structural change.
+     */
+    struct Command
+    {
+        CommandType type = CommandType::Spawn;   /**< Kind of change */
+        EntityHandle handle;                     /**< Target entity (all but Spawn) */
+        ComponentTypeId typeId = 0;              /**< Component type (Add/RemoveComponent) */
+        std::unique_ptr<IComponent> component;   /**< Component to add (AddComponent) */
+        std::unique_ptr<Entity> entity;          /**< Entity to add (Spawn) */
+    };
+
+    std::vector<Command> commands_; /**< Commands in recording order */
+    std::size_t spawnCount_ = 0;    /**< Spawn commands in commands_ */
+};
+
+#endif
@@ -0,0 +1,333 @@
+#include "ComponentStorage.h"
+#include "Entity.h"
+#include "Prefab.h"
+#include <algorithm>
+#include <mutex>
+
+/**
+ * @brief Construct storage containing only the empty archetype.
+ *
+ * The empty archetype holds entities that have no components, so every
+ * attached entity always has a valid archetype and row.
+ */
+ComponentStorage::ComponentStorage()
+{
+    getOrCreateArchetype(ComponentMask());
+}
+
+/**
+ * @brief Find or create the archetype for a component signature.
+ *
+ * @param mask Component signature
+ * @return Reference to the archetype
+ */
+Archetype &ComponentStorage::getOrCreateArchetype(const ComponentMask &mask)
+{
+    auto it = archetypesByMask_.find(mask);
+    if (it != archetypesByMask_.end())
+    {
+        return *it->second;
+    }
+
+    archetypes_.push_back(std::make_unique<Archetype>(mask));
+    Archetype *archetype = archetypes_.back().get();
+    archetypesByMask_[mask] = archetype;
+
+    // Keep cached queries current instead of rebuilding them on the next lookup
+    std::unique_lock<std::shared_mutex> lock(queryCacheMutex_);
+    for (auto &[queryMask, matches] : queryCache_)
+    {
+        if ((mask & queryMask) == queryMask)
+        {
+            matches.push_back(archetype);
+        }
+    }
+    return *archetype;
+}
+
+/**
+ * @brief Get the cached list of archetypes containing every type in a mask.
+ *
+ * Concurrently scheduled systems may create views at the same time, so a
+ * hit only takes the shared lock and a miss re-checks under the exclusive
+ * one before building the list. Cache entries are never erased and map
+ * nodes do not move, so the returned reference outlives the lock.
+ *
+ * @param mask Required component types
+ * @return Archetypes whose signature is a superset of mask, in creation order
+ */
+const std::vector<Archetype *> &ComponentStorage::getMatchingArchetypes(const ComponentMask &mask)
+{
+    {
+        std::shared_lock<std::shared_mutex> lock(queryCacheMutex_);
+        auto it = queryCache_.find(mask);
+        if (it != queryCache_.end())
+        {
+            return it->second;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(queryCacheMutex_);
+    auto [it, inserted] = queryCache_.try_emplace(mask);
+    if (inserted)
+    {
+        for (const auto &archetype : archetypes_)
+        {
+            if ((archetype->getMask() & mask) == mask)
+            {
+                it->second.push_back(archetype.get());
+            }
+        }
+    }
+    return it->second;
+}
+
+/**
+ * @brief Attach an entity, moving its pending components into archetype columns.
+ *
+ * Components added to an entity before it joins a World are held as
+ * individual heap objects; this moves them into the packed columns of the
+ * archetype matching the entity's component set and frees the originals.
+ *
+ * @param entity Entity to attach (must not already be attached)
+ */
+void ComponentStorage::attach(Entity &entity)
+{
+    ComponentMask mask;
+    for (const auto &pending : entity.pendingComponents_)
+    {
+        mask.set(pending.typeId);
+    }
+
+    Archetype &archetype = getOrCreateArchetype(mask);
+    const std::size_t row = archetype.appendEntity(&entity);
+
+    for (auto &column : archetype.getColumns())
+    {
+        const ComponentTypeId typeId = column.getTypeId();
+        for (auto &pending : entity.pendingComponents_)
+        {
+            if (pending.typeId == typeId)
+            {
+                column.pushMove(ComponentRegistry::getInfo(typeId).fromBase(pending.component.get()));
+                break;
+            }
+        }
+    }
+
+    entity.pendingComponents_.clear();
+    bumpVersions(mask);
+    entity.storage_ = this;
+    entity.archetype_ = &archetype;
+    entity.row_ = row;
+}
+
+/**
+ * @brief Attach a batch of component-less entities as copies of a prefab.
+ *
+ * Columns only grow when the batch does not fit, and then to at least twice
+ * their size, so spawning many small batches stays amortized O(1) per
+ * entity. Membership versions are bumped once for the whole batch.
+ *
+ * Each row is copied into every column before it is committed. If a copy
+ * throws, the rows of this batch are dropped again, the entities are left
+ * unattached and the exception is rethrown.
+ *
+ * @param entities Entities to attach (not attached, no pending components)
+ * @param count Number of entities
+ * @param prefab Compiled template to copy
+ */
+void ComponentStorage::attachPrefab(Entity *const *entities, std::size_t count, const Prefab &prefab)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    Archetype &archetype = getOrCreateArchetype(prefab.getMask());
+    std::vector<ComponentColumn> &columns = archetype.getColumns();
+    const std::size_t base = archetype.size();
+    const std::size_t required = base + count;
+    if (!columns.empty() && required > columns.front().capacity())
+    {
+        archetype.reserve(std::max(required, base * 2));
+    }
+
+    const std::vector<const void *> &prototypes = prefab.getPrototypes();
+    std::size_t attached = 0;
+    try
+    {
+        for (; attached < count; ++attached)
+        {
+            for (std::size_t c = 0; c < columns.size(); ++c)
+            {
+                columns[c].pushCopy(prototypes[c]);
+            }
+            Entity &entity = *entities[attached];
+            entity.row_ = archetype.appendEntity(&entity);
+            entity.storage_ = this;
+            entity.archetype_ = &archetype;
+        }
+    }
+    catch (...)
+    {
+        archetype.truncate(base);
+        for (std::size_t i = 0; i < attached; ++i)
+        {
+            entities[i]->storage_ = nullptr;
+            entities[i]->archetype_ = nullptr;
+            entities[i]->row_ = 0;
+        }
+        throw;
+    }
+    bumpVersions(prefab.getMask());
+}
+
+/**
+ * @brief Detach an entity, destroying all of its stored components.
+ *
+ * @param entity Entity to detach (must be attached to this storage)
+ */
+void ComponentStorage::detach(Entity &entity)
+{
+    bumpVersions(entity.archetype_->getMask());
+    removeFromArchetype(entity);
+    entity.storage_ = nullptr;
+    entity.archetype_ = nullptr;
+    entity.row_ = 0;
+}
+
+/**
+ * @brief Add or replace a component on an attached entity.
+ *
+ * If the entity already has a component of this type it is replaced in
+ * place. Otherwise the entity moves along the cached add-transition to the
+ * archetype that also contains the new type.
+ *
+ * @param entity Attached entity
+ * @param typeId Dense component type ID
+ * @param source Component to move-construct from (concrete component type)
+ * @return Pointer to the stored component
+ */
+void *ComponentStorage::addComponent(Entity &entity, ComponentTypeId typeId, void *source)
+{
+    Archetype *current = entity.archetype_;
+    if (current->hasComponent(typeId))
+    {
+        ComponentColumn *column = current->getColumn(typeId);
+        column->replaceMove(entity.row_, source);
+        return column->at(entity.row_);
+    }
+
+    Archetype *target = current->getAddTransition(typeId);
+    if (target == nullptr)
+    {
+        ComponentMask mask = current->getMask();
+        mask.set(typeId);
+        target = &getOrCreateArchetype(mask);
+        current->setAddTransition(typeId, target);
+        target->setRemoveTransition(typeId, current);
+    }
+
+    ++typeVersions_[typeId];
+    return moveEntity(entity, *target, typeId, source);
+}
+
+/**
+ * @brief Remove a component from an attached entity.
+ *
+ * @param entity Attached entity
+ * @param typeId Dense component type ID
+ * @return true if the component existed and was removed
+ */
+bool ComponentStorage::removeComponent(Entity &entity, ComponentTypeId typeId)
+{
+    Archetype *current = entity.archetype_;
+    if (!current->hasComponent(typeId))
+    {
+        return false;
+    }
+
+    Archetype *target = current->getRemoveTransition(typeId);
+    if (target == nullptr)
+    {
+        ComponentMask mask = current->getMask();
+        mask.reset(typeId);
+        target = &getOrCreateArchetype(mask);
+        current->setRemoveTransition(typeId, target);
+        target->setAddTransition(typeId, current);
+    }
+
+    ++typeVersions_[typeId];
+    moveEntity(entity, *target, static_cast<ComponentTypeId>(MaxComponentTypes), nullptr);
+    return true;
+}
+
+/**
+ * @brief Move an attached entity into another archetype.
+ *
+ * Every column of the target archetype is filled either from the entity's
+ * current row or, for addedType, from addedSource. The old row is then
+ * removed; components not present in the target are destroyed with it.
+ *
+ * @param entity Attached entity
+ * @param target Destination archetype
+ * @param addedType Type being added, or MaxComponentTypes when removing
+ * @param addedSource Source for the added component, or nullptr
+ * @return Pointer to the added component, or nullptr when removing
+ */
+void *ComponentStorage::moveEntity(Entity &entity, Archetype &target, ComponentTypeId addedType, void *addedSource)
+{
+    Archetype *current = entity.archetype_;
+    const std::size_t oldRow = entity.row_;
+    const std::size_t newRow = target.appendEntity(&entity);
+
+    void *added = nullptr;
+    for (auto &column : target.getColumns())
+    {
+        const ComponentTypeId typeId = column.getTypeId();
+        if (typeId == addedType)
+        {
+            added = column.pushMove(addedSource);
+        }
+        else
+        {
+            column.pushMove(current->getComponent(typeId, oldRow));
+        }
+    }
+
+    removeFromArchetype(entity);
+    entity.archetype_ = &target;
+    entity.row_ = newRow;
+    return added;
+}
+
+/**
+ * @brief Remove the entity's current row and patch the entity swapped into it.
+ *
+ * @param entity Attached entity
+ */
+void ComponentStorage::removeFromArchetype(Entity &entity)
+{
+    Entity *moved = entity.archetype_->removeRow(entity.row_);
+    if (moved != nullptr)
+    {
+        moved->row_ = entity.row_;
+    }
+}
+
+/**
+ * @brief Advance the membership version of every type in a signature.
+ *
+ * @param mask Component types an entity gained or lost
+ */
+void ComponentStorage::bumpVersions(const ComponentMask &mask)
+{
+    for (std::size_t typeId = 0; typeId < MaxComponentTypes; ++typeId)
+    {
+        if (mask.test(typeId))
+        {
+            ++typeVersions_[typeId];
+        }
+    }
+}
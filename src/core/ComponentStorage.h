@@ -0,0 +1,150 @@
+#ifndef COMPONENTSTORAGE_H
+#define COMPONENTSTORAGE_H
+
+#include "Archetype.h"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+class Entity;
+class Prefab;
+
+/**
+ * @brief Archetype-based structure-of-arrays storage for all components in a World.
+ *
+ * Entities attached to the storage have their components packed into
+ * contiguous per-type columns, grouped by component signature (archetype).
+ * Component lookup is a direct array index by dense component type ID, and
+ * iterating every component of one type touches contiguous memory.
+ *
+ * Pointers returned for components stay valid until the next structural
+ * change (add/remove component, attach/detach entity) in the same archetype.
+ */
+class ComponentStorage
+{
+public:
+    /**
+     * @brief Construct storage containing only the empty archetype.
+     */
+    ComponentStorage();
+
+    ComponentStorage(const ComponentStorage &) = delete;
+    ComponentStorage &operator=(const ComponentStorage &) = delete;
+
+    /**
+     * @brief Attach an entity, moving its pending components into archetype columns.
+     *
+     * @param entity Entity to attach (must not already be attached)
+     */
+    void attach(Entity &entity);
+
+    /**
+     * @brief Attach a batch of component-less entities as copies of a prefab.
+     *
+     * The prefab's archetype is grown once for the whole batch and each
+     * instance's components are copy-constructed from the prefab's prototypes.
+     * If a copy throws, no entity of the batch is attached and the exception
+     * propagates.
+     *
+     * @param entities Entities to attach (not attached, no pending components)
+     * @param count Number of entities
+     * @param prefab Compiled template to copy
+     */
+    void attachPrefab(Entity *const *entities, std::size_t count, const Prefab &prefab);
+
+    /**
+     * @brief Detach an entity, destroying all of its stored components.
+     *
+     * @param entity Entity to detach (must be attached to this storage)
+     */
+    void detach(Entity &entity);
+
+    /**
+     * @brief Add or replace a component on an attached entity.
+     *
+     * The entity is moved to the archetype that includes the new type.
+     *
+     * @param entity Attached entity
+     * @param typeId Dense component type ID
+     * @param source Component to move-construct from (concrete component type)
+     * @return Pointer to the stored component
+     */
+    void *addComponent(Entity &entity, ComponentTypeId typeId, void *source);
+
+    /**
+     * @brief Remove a component from an attached entity.
+     *
+     * @param entity Attached entity
+     * @param typeId Dense component type ID
+     * @return true if the component existed and was removed
+     */
+    bool removeComponent(Entity &entity, ComponentTypeId typeId);
+
+    /**
+     * @brief Find or create the archetype for a component signature.
+     *
+     * @param mask Component signature
+     * @return Reference to the archetype
+     */
+    Archetype &getOrCreateArchetype(const ComponentMask &mask);
+
+    /**
+     * @brief Get all archetypes created so far, in creation order.
+     *
+     * @return Const reference to the archetype list
+     */
+    const std::vector<std::unique_ptr<Archetype>> &getArchetypes() const { return archetypes_; }
+
+    /**
+     * @brief Get the cached list of archetypes containing every type in a mask.
+     *
+     * The list is built on first request and then kept up to date as new
+     * archetypes are created, so queries never rescan the archetype table.
+     * The returned reference stays valid for the lifetime of the storage.
+     * Safe to call from systems the scheduler runs concurrently; only the
+     * first request for a mask takes an exclusive lock.
+     *
+     * @param mask Required component types
+     * @return Archetypes whose signature is a superset of mask, in creation order
+     */
+    const std::vector<Archetype *> &getMatchingArchetypes(const ComponentMask &mask);
+
+    /**
+     * @brief Get the membership version of a component type.
+     *
+     * The version changes whenever an entity gains or loses a component of
+     * the type, including entities attached or detached with it. Systems that
+     * cache per-entity data for a type compare versions to know when the set
+     * of entities has changed. Replacing a component in place does not count.
+     *
+     * @param typeId Dense component type ID
+     * @return Current version
+     */
+    std::uint64_t getTypeVersion(ComponentTypeId typeId) const { return typeVersions_[typeId]; }
+
+private:
+    /**
+     * @brief Move an attached entity into another archetype.
+     *
+     * Components present in both archetypes are moved across; a component of
+     * type addedType (if any) is move-constructed from addedSource.
+     */
+    void *moveEntity(Entity &entity, Archetype &target, ComponentTypeId addedType, void *addedSource);
+
+    /** @brief Remove the entity's current row and patch the entity swapped into it */
+    void removeFromArchetype(Entity &entity);
+
+    /** @brief Advance the membership version of every type in mask */
+    void bumpVersions(const ComponentMask &mask);
+
+    std::vector<std::unique_ptr<Archetype>> archetypes_;                 /**< Owned archetypes (stable addresses) */
+    std::unordered_map<ComponentMask, Archetype *> archetypesByMask_;    /**< Signature -> archetype lookup */
+    std::unordered_map<ComponentMask, std::vector<Archetype *>> queryCache_; /**< Query mask -> matching archetypes */
+    std::shared_mutex queryCacheMutex_;                                  /**< Guards queryCache_ against concurrent first lookups */
+    std::array<std::uint64_t, MaxComponentTypes> typeVersions_{};        /**< Membership version per component type */
+};
+
+#endif
@@ -0,0 +1,66 @@
+#include "ComponentTypeId.h"
+#include <array>
+#include <mutex>
+#include <stdexcept>
+
+namespace
+{
+    /** Registry state kept in a function-local static so registration is safe during static initialization */
+    struct RegistryState
+    {
+        std::array<ComponentInfo, MaxComponentTypes> infos{};
+        std::size_t typeCount = 0;
+        std::mutex mutex;
+    };
+
+    RegistryState &registryState()
+    {
+        static RegistryState state;
+        return state;
+    }
+}
+
+/**
+ * @brief Register a new component type.
+ *
+ * Called once per component type from the function-local static inside
+ * componentTypeId<T>(), so the lock is only taken on first use of a type.
+ *
+ * @param info Description of the component type
+ * @return The newly assigned dense ID
+ */
+ComponentTypeId ComponentRegistry::registerType(const ComponentInfo &info)
+{
+    RegistryState &state = registryState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (state.typeCount >= MaxComponentTypes)
+    {
+        throw std::length_error("ComponentRegistry: too many component types (raise MaxComponentTypes)");
+    }
+
+    state.infos[state.typeCount] = info;
+    return static_cast<ComponentTypeId>(state.typeCount++);
+}
+
+/**
+ * @brief Get the description of a registered component type.
+ *
+ * @param typeId ID returned by componentTypeId<T>()
+ * @return Reference to the component description
+ */
+const ComponentInfo &ComponentRegistry::getInfo(ComponentTypeId typeId)
+{
+    return registryState().infos[typeId];
+}
+
+/**
+ * @brief Get the number of component types registered so far.
+ *
+ * @return Number of registered types
+ */
+std::size_t ComponentRegistry::getTypeCount()
+{
+    RegistryState &state = registryState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    return state.typeCount;
+}
@@ -0,0 +1,125 @@
+#ifndef COMPONENTTYPEID_H
+#define COMPONENTTYPEID_H
+
+#include "IComponent.h"
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @file ComponentTypeId.h
+ * @brief Dense integer identifiers for component types.
+ *
+ * Every component type used with the ECS is assigned a small integer ID the
+ * first time it is referenced. The IDs index directly into per-archetype
+ * column tables and component masks, replacing std::type_index hashing.
+ */
+
+/** @brief Dense integer identifier of a component type */
+using ComponentTypeId = std::uint32_t;
+
+/** @brief Maximum number of distinct component types supported by the ECS */
+constexpr std::size_t MaxComponentTypes = 64;
+
+/** @brief Bit set describing which component types an archetype contains */
+using ComponentMask = std::bitset<MaxComponentTypes>;
+
+/**
+ * @brief Type-erased description of a component type.
+ *
+ * Holds the size, alignment and lifetime operations needed to store
+ * components of this type in raw contiguous column buffers.
+ */
+struct ComponentInfo
+{
+    std::size_t size;                            /**< sizeof(T) */
+    std::size_t alignment;                       /**< alignof(T) */
+    void (*moveConstruct)(void *dst, void *src); /**< Placement-move a T from src into dst */
+    void (*copyConstruct)(void *dst, const void *src); /**< Placement-copy a T from src into dst, nullptr if T is move-only */
+    void (*destroy)(void *ptr);                  /**< Run T's destructor in place */
+    void *(*fromBase)(IComponent *component);    /**< Downcast an IComponent pointer to T */
+
+    /**
+     * @brief Build the description for component type T.
+     *
+     * @tparam T Concrete component type
+     * @return ComponentInfo describing T
+     */
+    template <typename T>
+    static ComponentInfo of()
+    {
+        ComponentInfo info;
+        info.size = sizeof(T);
+        info.alignment = alignof(T);
+        info.moveConstruct = [](void *dst, void *src)
+        { new (dst) T(std::move(*static_cast<T *>(src))); };
+        if constexpr (std::is_copy_constructible<T>::value)
+        {
+            info.copyConstruct = [](void *dst, const void *src)
+            { new (dst) T(*static_cast<const T *>(src)); };
+        }
+        else
+        {
+            info.copyConstruct = nullptr;
+        }
+        info.destroy = [](void *ptr)
+        { static_cast<T *>(ptr)->~T(); };
+        info.fromBase = [](IComponent *component) -> void *
+        { return static_cast<T *>(component); };
+        return info;
+    }
+};
+
+/**
+ * @brief Process-wide table of registered component types.
+ *
+ * Types are registered lazily through componentTypeId<T>() and receive
+ * consecutive IDs starting at zero.
+ */
+class ComponentRegistry
+{
+public:
+    /**
+     * @brief Register a new component type.
+     *
+     * @param info Description of the component type
+     * @return The newly assigned dense ID
+     * @throws std::length_error if more than MaxComponentTypes types are registered
+     */
+    static ComponentTypeId registerType(const ComponentInfo &info);
+
+    /**
+     * @brief Get the description of a registered component type.
+     *
+     * @param typeId ID returned by componentTypeId<T>()
+     * @return Reference to the component description
+     */
+    static const ComponentInfo &getInfo(ComponentTypeId typeId);
+
+    /**
+     * @brief Get the number of component types registered so far.
+     *
+     * @return Number of registered types
+     */
+    static std::size_t getTypeCount();
+};
+
+/**
+ * @brief Get the dense ID of component type T, registering it on first use.
+ *
+ * @tparam T Component type (must derive from IComponent and be move-constructible)
+ * @return The dense component type ID
+ */
+template <typename T>
+ComponentTypeId componentTypeId()
+{
+    static_assert(std::is_base_of<IComponent, T>::value, "Components must derive from IComponent");
+    static_assert(std::is_move_constructible<T>::value, "Components must be move-constructible");
+    static const ComponentTypeId id = ComponentRegistry::registerType(ComponentInfo::of<T>());
+    return id;
+}
+
+#endif
@@ -1,22 +1,34 @@
 #include "Engine.h"
+#include "Profiler.h"
+#include "Metrics.h"
+#include "WorldSnapshot.h"
 #include "../config/PhysicsConfigParser.h"
 #include "../config/RenderConfigParser.h"
 #include "../config/InputConfigParser.h"
 #include "../events/WorldGenEvents.h"
-#include "../physics/ExponentialAirDensityModel.h"
+#include "../events/SimulationEvents.h"
+#include "../events/InputEvents.h"
+#include "../components/TransformC.h"
+#include "../components/PhysicsC.h"
+#include "../physics/StandardAtmosphereModel.h"
 #include "../physics/PerlinWindModel.h"
-#include "../physics/ImpulseCollisionResolver.h"
 #include "../systems/PhysicsSystem.h"
-#include "../systems/InputSystem.h"
 #include "../systems/VehicleControlSystem.h"
+#include "../systems/MultirotorSystem.h"
+#include "../systems/TransformSystem.h"
+#include "../systems/SpatialIndexSystem.h"
 #include "../systems/BootstrapSystem.h"
 #include "../systems/WorldGenSystem.h"
-#include "../systems/VisualizationSystem.h"
 #include "../systems/ConsoleSystem.h"
 #include "../systems/AssetHotReloadSystem.h"
 #include "../systems/MaterialManager.h"
-#include "../platform/WinInputDevice.h"
+#include "../platform/IInputDevice.h"
 #include "../platform/PugiXmlParser.h"
+#ifndef FPV_HEADLESS
+#include "../systems/InputSystem.h"
+#include "../systems/VisualizationSystem.h"
+#include "../platform/WinInputDevice.h"
+#endif
 #include "../debug.h"
 
 #include <filesystem>
@@ -24,35 +36,55 @@
 #include <sstream>
 #include <iomanip>
 #include <chrono>
+#include <cmath>
 #include <thread>
 
 Engine::Engine()
-    : eventBus(),
+    : jobSystem(),
+      eventBus(),
       world(eventBus),
       simClock(0.016667f), // Default 60Hz
       assetRegistry(),
       assetLoader(assetRegistry),
-      windowHandle(nullptr),
       running(false),
       frameCount(0),
       fpsUpdateInterval(1.0f)
 {
+#ifdef FPV_HEADLESS
+    headlessConfig.enabled = true;
+#endif
+
     // Subscribe to scene loaded events to update window title
-    eventBus.subscribe(EventType::SceneLoaded, [this](const IEvent &event)
-                       {
-        const auto &sceneEvent = static_cast<const SceneLoadedEvent &>(event);
-        updateWindowTitle(sceneEvent.sceneName); });
+    eventBus.subscribe<SceneLoadedEvent>([this](const SceneLoadedEvent &event)
+                                         { updateWindowTitle(event.sceneName); });
+    eventBus.subscribe<RewindRequestEvent, Engine, &Engine::onRewindRequest>(this);
+    eventBus.subscribe<InputActionEvent, Engine, &Engine::onInputAction>(this);
 }
 
 Engine::~Engine()
 {
     shutdownSystems();
 
+    // Let in-flight jobs finish before the world and its systems are destroyed
+    world.getScheduler().setJobSystem(nullptr);
+    jobSystem.stop();
+
+#ifndef FPV_HEADLESS
     // Clean up window
     if (windowHandle != nullptr)
     {
         DestroyWindow(windowHandle);
     }
+#endif
+}
+
+void Engine::setHeadlessConfig(const HeadlessConfig &config)
+{
+    headlessConfig = config;
+#ifdef FPV_HEADLESS
+    // There is no window, renderer or input device to fall back to
+    headlessConfig.enabled = true;
+#endif
 }
 
 bool Engine::initialize(const std::string &physicsConfigPath,
@@ -67,22 +99,67 @@ bool Engine::initialize(const std::string &physicsConfigPath,
     DEBUG_LOG("Loading render config from " + renderConfigPath);
     renderConfig = Render::RenderConfigParser::loadFromFile(renderConfigPath);
 
+    if (!replayConfig.playPath.empty())
+    {
+        // Re-simulate with the recorded settings; there is no device to read input from
+        if (!replayPlayer.open(replayConfig.playPath))
+        {
+            return false;
+        }
+        const ReplayHeader &header = replayPlayer.getHeader();
+        physicsConfig.fixedTimestep = static_cast<float>(header.fixedTimestep);
+        physicsConfig.randomSeed = static_cast<int>(header.randomSeed);
+        physicsConfig.deterministic = header.deterministic;
+        headlessConfig.enabled = true;
+        headlessConfig.duration = replayPlayer.getStepCount() * header.fixedTimestep;
+        replaying = true;
+    }
+
     // Initialize simulation clock with physics timestep
-    simClock = SimClock(physicsConfig.fixedTimestep);
+    simClock = SimClock(physicsConfig.fixedTimestep, physicsConfig.maxSubsteps);
+    simClock.setTimeScale(physicsConfig.timeScale);
+    rewindBuffer.configure(rewindDuration, simClock.getFixedTimestep());
 
-    // Create window
-    DEBUG_LOG("Creating window");
-    windowHandle = createWindow();
-    if (windowHandle == nullptr)
+    if (!replayConfig.recordPath.empty())
     {
-        std::cerr << "Failed to create window!" << std::endl;
-        return false;
+        ReplayHeader header;
+        header.fixedTimestep = simClock.getFixedTimestep();
+        header.randomSeed = static_cast<std::uint32_t>(physicsConfig.randomSeed);
+        header.deterministic = physicsConfig.deterministic;
+        if (!replayRecorder.open(replayConfig.recordPath, header))
+        {
+            return false;
+        }
+    }
+
+    // Start the job system shared by the system scheduler and parallel loops
+    jobSystem.setDeterministic(physicsConfig.deterministic);
+    Profiler::instance().setThreadName("Main");
+    jobSystem.start(physicsConfig.workerThreads);
+    JobSystem::setCurrent(&jobSystem);
+    world.getScheduler().setJobSystem(&jobSystem);
+    DEBUG_LOG("Job system started with " + std::to_string(jobSystem.getWorkerCount()) + " worker threads" +
+              (jobSystem.isDeterministic() ? " (deterministic)" : ""));
+
+#ifndef FPV_HEADLESS
+    if (!headlessConfig.enabled)
+    {
+        // Create window
+        DEBUG_LOG("Creating window");
+        windowHandle = createWindow();
+        if (windowHandle == nullptr)
+        {
+            std::cerr << "Failed to create window!" << std::endl;
+            return false;
+        }
     }
+#endif
 
     // Initialize systems
     DEBUG_LOG("Initializing systems");
     initializeSystems();
 
+#ifndef FPV_HEADLESS
     // Load input configuration
     DEBUG_LOG("Loading input configuration from " + inputConfigPath);
     InputSystem *inputSystem = world.getSystem<InputSystem>();
@@ -93,6 +170,7 @@ bool Engine::initialize(const std::string &physicsConfigPath,
             DEBUG_LOG("Warning: Could not load input configuration, using defaults");
         }
     }
+#endif
 
     return true;
 }
@@ -153,8 +231,13 @@ bool Engine::displayCompiledScene()
     return true;
 }
 
-bool Engine::loadAndDisplayScene(const std::string &sceneId)
+bool Engine::loadAndDisplayScene(const std::string &requestedSceneId)
 {
+    // A replay always starts from the scene it was recorded in
+    const std::string &sceneId =
+        replaying && !replayPlayer.getHeader().sceneId.empty() ? replayPlayer.getHeader().sceneId : requestedSceneId;
+    replayRecorder.recordScene(sceneId);
+
     DEBUG_LOG("Loading and displaying scene: " + sceneId);
     // Find the WorldGenSystem which is responsible for scene loading
     WorldGenSystem *worldGenSys = world.getSystem<WorldGenSystem>();
@@ -176,6 +259,10 @@ bool Engine::loadAndDisplayScene(const std::string &sceneId)
         worldGenSys->GenerateDefaultSphereWorld();
     }
 
+    // Recording and playback start from the freshly loaded scene with no solver state carried over
+    if (PhysicsSystem *physics = world.getSystem<PhysicsSystem>())
+        physics->resetContacts();
+
     return true; // Even if scene loading failed, we return true because we've fallen back to a default scene
 }
 
@@ -183,6 +270,12 @@ int Engine::run()
 {
     DEBUG_LOG("Running engine main loop...");
 
+    if (headlessConfig.enabled)
+    {
+        return runHeadless();
+    }
+
+#ifndef FPV_HEADLESS
     if (windowHandle == nullptr)
     {
         std::cerr << "ERROR: Cannot run main loop - window handle is nullptr!" << std::endl;
@@ -204,10 +297,16 @@ int Engine::run()
     {
         while (running)
         {
+            PROFILE_SCOPE("Frame");
+            MetricTimer frameTimer(frameTimeMetric());
+
             // Process Windows messages
             if (!processWindowMessages())
                 break;
 
+            // Publish events posted by background threads (asset loading, file watching)
+            eventBus.dispatchPosted();
+
             // Calculate delta time
             auto currentTime = std::chrono::high_resolution_clock::now();
             float deltaTime = std::chrono::duration<float>(currentTime - lastFrameTime).count();
@@ -223,11 +322,15 @@ int Engine::run()
             // Fixed timestep updates (physics)
             updateFixedTimestep(deltaTime);
 
+            // Deliver events queued during the physics steps (contacts, telemetry) in per-type batches
+            eventBus.dispatchQueued();
+
             // Variable timestep updates (input, rendering)
             updateVariableTimestep(deltaTime);
 
             // Update frame rate display
             updateFrameRate();
+            updateFrameMetrics();
 
             // Small delay for first few frames
             if (frameCount < 10)
@@ -248,9 +351,67 @@ int Engine::run()
     }
 
     DEBUG_LOG("=== MAIN LOOP EXITED ===");
-    return 0;
+#endif
+    return finishReplay();
+}
+
+int Engine::runHeadless()
+{
+    const double fixedTimestep = simClock.getFixedTimestep();
+    const double speedMultiplier = headlessConfig.speedMultiplier;
+    const unsigned long long targetSteps =
+        headlessConfig.duration > 0.0 ? static_cast<unsigned long long>(std::llround(headlessConfig.duration / fixedTimestep)) : 0;
+
+    DEBUG_LOG("=== ENTERING HEADLESS LOOP === (" +
+              (targetSteps > 0 ? std::to_string(headlessConfig.duration) + "s simulated" : std::string("until stopped")) + ", " +
+              (speedMultiplier > 0.0 ? std::to_string(speedMultiplier) + "x real time" : std::string("unpaced")) + ")");
+
+    running = true;
+    const auto wallStart = std::chrono::steady_clock::now();
+    unsigned long long steps = 0;
+
+    try
+    {
+        while (running && (targetSteps == 0 || steps < targetSteps))
+        {
+            PROFILE_SCOPE("Frame");
+            MetricTimer frameTimer(frameTimeMetric());
+            eventBus.dispatchPosted();
+
+            // Exactly one fixed step per iteration: no wall-clock accumulation, so no substep cap or dropped time
+            simClock.requestStep();
+            simClock.tick(0.0f);
+            updateFixedTimestep(static_cast<float>(fixedTimestep));
+            eventBus.dispatchQueued();
+            updateFrameMetrics();
+            ++steps;
+
+            if (speedMultiplier > 0.0)
+            {
+                // Pace against the start time so sleep overshoot does not accumulate
+                const auto due = wallStart + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                                 std::chrono::duration<double>(steps * fixedTimestep / speedMultiplier));
+                std::this_thread::sleep_until(due);
+            }
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "FATAL ERROR in headless loop: " << e.what() << std::endl;
+        return 1;
+    }
+
+    const double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+    const double simulatedSeconds = steps * fixedTimestep;
+    std::cout << "Headless run finished: " << steps << " steps, " << simulatedSeconds << " s simulated in "
+              << wallSeconds << " s wall time (" << (wallSeconds > 0.0 ? simulatedSeconds / wallSeconds : 0.0)
+              << "x real time)" << std::endl;
+
+    DEBUG_LOG("=== HEADLESS LOOP EXITED ===");
+    return finishReplay();
 }
 
+#ifndef FPV_HEADLESS
 HWND Engine::createWindow()
 {
     const char CLASS_NAME[] = "FPV_FlightSimWindow";
@@ -293,17 +454,24 @@ HWND Engine::createWindow()
 
     return hwnd;
 }
+#endif
 
 void Engine::updateWindowTitle(const std::string &sceneName)
 {
+#ifdef FPV_HEADLESS
+    DEBUG_LOG("Scene loaded: " + sceneName);
+#else
     if (windowHandle != nullptr)
     {
         std::string newTitle = "FPV Flight Sim - " + sceneName;
         SetWindowTextA(windowHandle, newTitle.c_str());
         DEBUG_LOG("Updated window title to: " + newTitle);
     }
+#endif
 }
 
+#ifndef FPV_HEADLESS
+
 LRESULT CALLBACK Engine::windowProcStatic(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
 {
     // Get the Engine instance
@@ -355,56 +523,102 @@ LRESULT Engine::handleWindowMessage(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM
     }
     return DefWindowProc(hwnd, uMsg, wParam, lParam);
 }
+#endif
 
 void Engine::initializeSystems()
 {
     DEBUG_LOG("Initializing simulation systems...");
 
-    // Initialize physics models
-    auto airDensityModel = std::make_unique<ExponentialAirDensityModel>(
-        physicsConfig.seaLevelDensity, physicsConfig.scaleHeight);
-    auto windModel = std::make_unique<PerlinWindModel>(
-        physicsConfig.baseWindSpeed, physicsConfig.turbulenceScale,
-        physicsConfig.turbulenceIntensity, physicsConfig.randomSeed);
-    auto collisionResolver = std::make_unique<ImpulseCollisionResolver>(
-        physicsConfig.restitution, physicsConfig.friction);
+    // Physics models live in the world's service registry, so they outlive the systems that use them
+    ServiceRegistry &services = world.getServices();
+    IAirDensityModel &airDensityModel = services.add<IAirDensityModel>(std::make_unique<StandardAtmosphereModel>(
+        physicsConfig.seaLevelDensity));
+    // Gusts are turbulenceScale meters across with an RMS speed of turbulenceIntensity times the mean wind
+    IWindModel &windModel = services.add<IWindModel>(std::make_unique<PerlinWindModel>(
+        physicsConfig.baseWindSpeed,
+        physicsConfig.turbulenceScale > 0.0f ? 1.0f / physicsConfig.turbulenceScale : 0.0f,
+        physicsConfig.turbulenceIntensity * physicsConfig.baseWindSpeed, physicsConfig.randomSeed));
 
     // Initialize material manager
-    auto materialManager = std::make_unique<Material::MaterialManager>();
-    materialManager->LoadDefaultMaterials();
-    Material::MaterialManager *materialManagerPtr = materialManager.get();
+    Material::MaterialManager &materialManager = services.add<Material::MaterialManager>(
+        std::make_unique<Material::MaterialManager>());
+    materialManager.LoadDefaultMaterials();
     DEBUG_LOG("Material manager initialized with default materials");
 
     // Add core systems
+    // Adds rotor thrust and torque to the PhysicsC, so the scheduler runs it before physics
+    world.addSystem(std::make_unique<MultirotorSystem>(eventBus, physicsConfig.rotorSubstepRate));
     world.addSystem(std::make_unique<PhysicsSystem>(
-        eventBus, *airDensityModel, *windModel, *collisionResolver));
+        eventBus, airDensityModel, windModel, physicsConfig.gravity));
 
-    inputDevice_ = std::make_unique<WinInputDevice>();
-    world.addSystem(std::make_unique<InputSystem>(eventBus, *inputDevice_));
+#ifndef FPV_HEADLESS
+    if (!headlessConfig.enabled)
+    {
+        inputDevice_ = std::make_unique<WinInputDevice>();
+        world.addSystem(std::make_unique<InputSystem>(eventBus, *inputDevice_));
+    }
+#endif
 
     world.addSystem(std::make_unique<VehicleControlSystem>(eventBus));
+    // Reads the transforms PhysicsSystem writes, so the scheduler runs it after physics
+    world.addSystem(std::make_unique<TransformSystem>(world));
+    // Refits from the world matrices, so it follows the TransformSystem
+    SpatialIndexSystem *spatialIndex = world.addSystem(std::make_unique<SpatialIndexSystem>(world));
+    world.getServices().provide<SpatialIndex>(&spatialIndex->getIndex());
     DEBUG_LOG("Core simulation systems initialized");
 
     // Add asset pipeline systems
     world.addSystem(std::make_unique<BootstrapSystem>(
         eventBus, world, assetRegistry, assetLoader));
-    world.addSystem(std::make_unique<AssetHotReloadSystem>(
-        assetRegistry, assetLoader));
+    if (!headlessConfig.enabled)
+    {
+        // Batch runs never see asset edits, so skip the per-frame file polling
+        world.addSystem(std::make_unique<AssetHotReloadSystem>(
+            assetRegistry, assetLoader));
+    }
     DEBUG_LOG("Asset pipeline systems initialized");
 
     // Add world generation system
     world.addSystem(std::make_unique<WorldGenSystem>(
-        eventBus, world, assetRegistry, *materialManagerPtr));
+        eventBus, world, assetRegistry, materialManager));
     DEBUG_LOG("World generation system initialized");
 
     // Add UI and visualization systems
     world.addSystem(std::make_unique<ConsoleSystem>(eventBus));
-    world.addSystem(std::make_unique<VisualizationSystem>(
-        eventBus, world, windowHandle, *materialManagerPtr, renderConfig));
+#ifndef FPV_HEADLESS
+    if (!headlessConfig.enabled)
+    {
+        world.addSystem(std::make_unique<VisualizationSystem>(
+            eventBus, world, windowHandle, materialManager, renderConfig, simClock));
+    }
+#endif
     DEBUG_LOG("Visualization systems initialized");
 
-    // Store MaterialManager to keep it alive
-    world.storeSharedResource("MaterialManager", std::move(materialManager));
+    // Build the per-phase schedules; systems with disjoint component access may run concurrently
+    std::vector<ISystem *> fixedSystems;
+    for (ISystem *system : {static_cast<ISystem *>(world.getSystem<MultirotorSystem>()),
+                            static_cast<ISystem *>(world.getSystem<PhysicsSystem>()),
+                            static_cast<ISystem *>(world.getSystem<VehicleControlSystem>()),
+                            static_cast<ISystem *>(world.getSystem<TransformSystem>()),
+                            static_cast<ISystem *>(world.getSystem<SpatialIndexSystem>())})
+    {
+        if (system)
+            fixedSystems.push_back(system);
+    }
+    fixedSchedule.setSystems(std::move(fixedSystems));
+
+    std::vector<ISystem *> variableSystems;
+    for (ISystem *system : {
+#ifndef FPV_HEADLESS
+             static_cast<ISystem *>(world.getSystem<InputSystem>()),
+             static_cast<ISystem *>(world.getSystem<VisualizationSystem>()),
+#endif
+             static_cast<ISystem *>(world.getSystem<AssetHotReloadSystem>())})
+    {
+        if (system)
+            variableSystems.push_back(system);
+    }
+    variableSchedule.setSystems(std::move(variableSystems));
 
     DEBUG_LOG("All systems initialized successfully");
 }
@@ -414,6 +628,7 @@ void Engine::shutdownSystems()
     // World destructor will handle system shutdown
 }
 
+#ifndef FPV_HEADLESS
 void Engine::keepWindowAlive(const std::string &errorMessage)
 {
     // Show error dialog
@@ -447,28 +662,53 @@ bool Engine::processWindowMessages()
     }
     return true;
 }
+#endif
 
 void Engine::updateFixedTimestep(float deltaTime)
 {
-    // Get system references
-    PhysicsSystem *physicsSystem = world.getSystem<PhysicsSystem>();
-    VehicleControlSystem *vehicleControlSystem = world.getSystem<VehicleControlSystem>();
-
     const float fixedTimestep = simClock.getFixedTimestep();
     int physicsSteps = 0;
 
     // Run physics updates at fixed timestep
     while (simClock.shouldStepPhysics())
     {
+        if (replaying && !replayPlayer.nextStep(replayActions))
+        {
+            running = false;
+            break;
+        }
         physicsSteps++;
 
         try
         {
-            if (physicsSystem)
-                physicsSystem->update(world, fixedTimestep);
-
-            if (vehicleControlSystem)
-                vehicleControlSystem->update(world, fixedTimestep);
+            PROFILE_SCOPE("Engine::fixedStep");
+            static Histogram &stepTime = MetricsRegistry::instance().histogram("physics.step_time");
+            static Counter &stepCount = MetricsRegistry::instance().counter("physics.steps");
+            MetricTimer stepTimer(stepTime);
+            stepCount.add();
+
+            // Played-back actions arrive where live ones did: after the previous step, before this one
+            for (const std::string &action : replayActions)
+                eventBus.publish(InputActionEvent{action});
+
+            // Keep the pre-step positions of physics bodies for render interpolation
+            world.view<TransformC, PhysicsC>().each([](Entity &, TransformC &transform, PhysicsC &)
+                                                     { transform.previousPosition = transform.position; });
+
+            // Wind depends on simulation time alone, so rewinds and replays see the same gusts
+            if (IWindModel *windModel = world.getServices().get<IWindModel>())
+                windModel->setTime(simClock.getSimulationTime());
+
+            world.getScheduler().run(world, fixedSchedule, fixedTimestep);
+            world.flushCommands();
+            recordReplayStep();
+
+            if (rewindBuffer.isEnabled())
+            {
+                static Histogram &recordTime = MetricsRegistry::instance().histogram("rewind.record_time");
+                MetricTimer recordTimer(recordTime);
+                rewindBuffer.record(world, RewindBuffer::FrameInfo{simClock.getStepCount(), simClock.getSimulationTime()});
+            }
         }
         catch (const std::exception &e)
         {
@@ -479,37 +719,124 @@ void Engine::updateFixedTimestep(float deltaTime)
 
 void Engine::updateVariableTimestep(float deltaTime)
 {
-    // Get system references
-    InputSystem *inputSystem = world.getSystem<InputSystem>();
-    VisualizationSystem *visualSystem = world.getSystem<VisualizationSystem>();
-    AssetHotReloadSystem *hotReloadSystem = world.getSystem<AssetHotReloadSystem>();
-
     try
     {
-        // Update input system
-        if (inputSystem)
-            inputSystem->update(world, deltaTime);
+        // Input, visualization and asset hot reload, in that order where their access conflicts
+        PROFILE_SCOPE("Engine::variableUpdate");
+        world.getScheduler().run(world, variableSchedule, deltaTime);
+        world.flushCommands();
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "ERROR in variable timestep update: " << e.what() << std::endl;
+    }
+}
 
-        // Update visualization system
-        if (visualSystem)
-        {
-            auto startTime = std::chrono::high_resolution_clock::now();
-            visualSystem->update(world, deltaTime);
-            auto endTime = std::chrono::high_resolution_clock::now();
+Histogram &Engine::frameTimeMetric()
+{
+    static Histogram &frameTime = MetricsRegistry::instance().histogram("frame.time");
+    return frameTime;
+}
 
-            float duration = std::chrono::duration<float>(endTime - startTime).count();
-            if (frameCount % 60 == 0) // Log occasionally
-                DEBUG_LOG("Visualization update: " + std::to_string(duration * 1000.0f) + "ms");
-        }
+void Engine::updateFrameMetrics()
+{
+    static MetricsRegistry &metrics = MetricsRegistry::instance();
+    static Counter &frames = metrics.counter("frame.count");
+    static Gauge &substeps = metrics.gauge("physics.substeps");
+    static Gauge &droppedTime = metrics.gauge("physics.dropped_time_s");
+    static Gauge &entities = metrics.gauge("world.entities");
+    static Gauge &postedDropped = metrics.gauge("events.posted_dropped");
+    static Gauge &postedHighWater = metrics.gauge("events.posted_high_water");
+
+    frames.add();
+    substeps.set(simClock.getStepsThisTick());
+    droppedTime.set(simClock.getDroppedTime());
+    entities.set(static_cast<double>(world.getEntities().size()));
+    const EventBus::PostedStats posted = eventBus.getPostedStats();
+    postedDropped.set(static_cast<double>(posted.dropped));
+    postedHighWater.set(static_cast<double>(posted.highWater));
+
+    if (rewindBuffer.isEnabled())
+    {
+        static Gauge &rewindFrames = metrics.gauge("rewind.frames");
+        static Gauge &rewindBytes = metrics.gauge("rewind.bytes");
+        static Gauge &rewindSeconds = metrics.gauge("rewind.seconds");
+        const RewindBuffer::Stats stats = rewindBuffer.getStats();
+        rewindFrames.set(static_cast<double>(stats.frames));
+        rewindBytes.set(static_cast<double>(stats.storedBytes));
+        rewindSeconds.set(stats.seconds);
+    }
+
+    metrics.dumpIfDue();
+}
 
-        // Update asset hot reload system
-        if (hotReloadSystem)
-            hotReloadSystem->update(world, deltaTime);
+bool Engine::rewind(double seconds)
+{
+    if (replaying || replayRecorder.isOpen())
+    {
+        std::cerr << "Rewind is unavailable while a replay is recorded or played back" << std::endl;
+        return false;
     }
-    catch (const std::exception &e)
+
+    const auto start = std::chrono::steady_clock::now();
+    RewindBuffer::FrameInfo frame;
+    if (!rewindBuffer.rewind(world, seconds, frame))
     {
-        std::cerr << "ERROR in variable timestep update: " << e.what() << std::endl;
+        std::cerr << "Rewind failed: " << (rewindBuffer.isEnabled() ? "no frames recorded" : "rewind buffer disabled") << std::endl;
+        return false;
     }
+    simClock.restoreTime(frame.simulationTime, frame.step);
+    if (PhysicsSystem *physics = world.getSystem<PhysicsSystem>())
+        physics->resetContacts();
+
+    std::ostringstream message;
+    message << "Rewound to t=" << std::fixed << std::setprecision(3) << frame.simulationTime << " s (step " << frame.step
+            << ") in " << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() << " ms";
+    LOG_INFO(message.str());
+    if (ConsoleSystem *console = world.getSystem<ConsoleSystem>())
+        console->AddOutput(message.str());
+    return true;
+}
+
+void Engine::onRewindRequest(const RewindRequestEvent &event)
+{
+    rewind(event.seconds);
+}
+
+void Engine::onInputAction(const InputActionEvent &event)
+{
+    replayRecorder.addAction(event.action);
+}
+
+void Engine::recordReplayStep()
+{
+    if (!replaying && !replayRecorder.isOpen())
+        return;
+
+    static Histogram &hashTime = MetricsRegistry::instance().histogram("replay.hash_time");
+    MetricTimer hashTimer(hashTime);
+    WorldSnapshot::capture(world, stateSnapshot);
+    const std::uint64_t stateHash = WorldSnapshot::hash(stateSnapshot.data(), stateSnapshot.size());
+
+    replayRecorder.recordStep(stateHash);
+    if (replaying)
+        replayPlayer.verifyStep(stateHash);
+}
+
+int Engine::finishReplay()
+{
+    replayRecorder.close();
+    if (!replaying)
+        return 0;
+
+    const std::uint64_t mismatches = replayPlayer.getMismatchCount();
+    std::cout << "Replay " << (replayPlayer.isFinished() ? "finished" : "stopped early") << ": "
+              << replayPlayer.getStepCount() << " recorded steps, ";
+    if (mismatches == 0)
+        std::cout << "all state hashes match" << std::endl;
+    else
+        std::cout << mismatches << " state hash mismatches, first at step " << replayPlayer.getFirstMismatchStep() << std::endl;
+    return mismatches == 0 ? 0 : 2;
 }
 
 void Engine::updateFrameRate()
@@ -523,7 +850,9 @@ void Engine::updateFrameRate()
         float fps = frameCount / timeSinceLastFpsUpdate;
         std::ostringstream oss;
         oss << renderConfig.getWindowTitle() << " - FPS: " << std::fixed << std::setprecision(0) << fps;
+#ifndef FPV_HEADLESS
         SetWindowTextA(windowHandle, oss.str().c_str());
+#endif
 
         frameCount = 0;
         lastFpsUpdateTime = currentTime;
@@ -1,17 +1,24 @@
 #pragma once
 
 #include "EventBus.h"
+#include "JobSystem.h"
 #include "World.h"
 #include "SimClock.h"
+#include "RewindBuffer.h"
+#include "Replay.h"
 #include "AssetRegistry.h"
 #include "AssetPackLoader.h"
 #include "../config/PhysicsConfig.h"
 #include "../config/RenderConfig.h"
 
+#ifndef FPV_HEADLESS
 #include <windows.h>
+#endif
 #include <memory>
 #include <string>
 #include <chrono>
+#include <cstdint>
+#include <vector>
 
 // Forward declarations
 class IInputDevice;
@@ -20,11 +27,44 @@ class WorldGenSystem;
 class VisualizationSystem;
 class ConsoleSystem;
 class AssetHotReloadSystem;
+class Histogram;
+struct RewindRequestEvent;
+struct InputActionEvent;
 namespace Material
 {
     class MaterialManager;
 }
 
+/**
+ * @brief Settings for running the simulation without a window, renderer or input device.
+ *
+ * Headless runs step the world one fixed timestep at a time for a set amount
+ * of simulated time, either as fast as the machine allows or paced at a
+ * multiple of real time. Builds configured with FPV_HEADLESS are always headless.
+ */
+struct HeadlessConfig
+{
+    bool enabled = false;                   /**< Run without window, renderer and input */
+    double duration = 10.0;                 /**< Simulated seconds to run, <= 0 to run until stopped */
+    double speedMultiplier = 0.0;           /**< Simulated seconds per wall-clock second, <= 0 for as fast as possible */
+    std::string sceneId = "DeveloperScene"; /**< Scene loaded before the run */
+};
+
+/**
+ * @brief Session recording and replay settings.
+ *
+ * A recording stores the fixed timestep, random seed, scene, the input
+ * actions of every fixed step and a World state hash after each step.
+ * Playing it back runs headless with the recorded settings, feeds the
+ * actions in at the same steps and reports the first step whose state hash
+ * differs.
+ */
+struct ReplayConfig
+{
+    std::string recordPath; /**< Replay file to write, empty to not record */
+    std::string playPath;   /**< Replay file to play back, empty for a live run */
+};
+
 /**
  * @class Engine
  * @brief Core engine class that encapsulates the runtime environment.
@@ -47,6 +87,59 @@ public:
      */
     ~Engine();
 
+    /**
+     * @brief Select headless or windowed operation.
+     *
+     * Must be called before initialize(). Ignored (always headless) in
+     * builds configured with FPV_HEADLESS.
+     *
+     * @param config Headless run settings
+     */
+    void setHeadlessConfig(const HeadlessConfig &config);
+
+    /**
+     * @brief Check whether the engine runs without window, renderer and input.
+     *
+     * @return true for headless operation
+     */
+    bool isHeadless() const { return headlessConfig.enabled; }
+
+    /**
+     * @brief Ask the main loop to exit after the current frame.
+     */
+    void stop() { running = false; }
+
+    /**
+     * @brief Keep a rewind buffer of the last seconds of simulation.
+     *
+     * Must be called before initialize(), which sizes the buffer for the
+     * configured fixed timestep.
+     *
+     * @param seconds Simulated seconds to keep, 0 to disable (default)
+     */
+    void setRewindDuration(double seconds) { rewindDuration = seconds; }
+
+    /**
+     * @brief Record the session to, or play it back from, a replay file.
+     *
+     * Must be called before initialize(). Playback forces headless
+     * operation and overrides the timestep, seed, scene and duration.
+     *
+     * @param config Replay settings
+     */
+    void setReplayConfig(const ReplayConfig &config) { replayConfig = config; }
+
+    /**
+     * @brief Restore the world and clock from the rewind buffer.
+     *
+     * Must be called between frames. Stepping continues from the restored
+     * state and the frames after it are discarded.
+     *
+     * @param seconds Simulated seconds to go back (clamped to the oldest frame)
+     * @return true if a frame was restored
+     */
+    bool rewind(double seconds);
+
     /**
      * @brief Initialize the engine with configuration files
      *
@@ -87,6 +180,8 @@ public:
     /**
      * @brief Load and display a specific scene by ID
      *
+     * When a replay is played back, the scene it was recorded in is loaded instead.
+     *
      * @param sceneId The ID of the scene to load (e.g., "DeveloperScene")
      * @return true if scene loading and display succeeded
      * @return false if scene loading or display failed
@@ -109,18 +204,39 @@ public:
 
 private:
     // Core systems
+    JobSystem jobSystem; // Declared first so it outlives every system that submits jobs
     EventBus eventBus;
     World world;
     SimClock simClock;
     AssetRegistry assetRegistry;
     AssetPackLoader assetLoader;
 
+    // System schedules for the two update phases (built in initializeSystems)
+    SystemSchedule fixedSchedule;
+    SystemSchedule variableSchedule;
+
     // Configuration
     Physics::PhysicsConfig physicsConfig;
     Render::RenderConfiguration renderConfig;
 
+    HeadlessConfig headlessConfig;
+
+    // Recent world states for rewinding (empty unless setRewindDuration() was given a duration)
+    RewindBuffer rewindBuffer;
+    double rewindDuration = 0.0;
+
+    // Session recording and playback
+    ReplayConfig replayConfig;
+    ReplayRecorder replayRecorder;
+    ReplayPlayer replayPlayer;
+    bool replaying = false;
+    std::vector<std::string> replayActions;     // Actions of the step being played back
+    std::vector<std::uint8_t> stateSnapshot;    // Reused buffer for per-step state hashes
+
     // Platform components
-    HWND windowHandle;
+#ifndef FPV_HEADLESS
+    HWND windowHandle = nullptr;
+#endif
     bool running;
     std::unique_ptr<IInputDevice> inputDevice_;
 
@@ -131,20 +247,33 @@ private:
     float fpsUpdateInterval;
 
     // Private helper methods
+#ifndef FPV_HEADLESS
     HWND createWindow();
     static LRESULT CALLBACK windowProcStatic(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
     LRESULT handleWindowMessage(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
+#endif
 
     // Systems management
     void initializeSystems();
     void shutdownSystems();
 
     // Main loop helpers
+    int runHeadless();
+#ifndef FPV_HEADLESS
     bool processWindowMessages();
+#endif
     void updateFixedTimestep(float deltaTime);
     void updateVariableTimestep(float deltaTime);
     void updateFrameRate();
+    void updateFrameMetrics();
+    void onRewindRequest(const RewindRequestEvent &event);
+    void onInputAction(const InputActionEvent &event);
+    void recordReplayStep();
+    int finishReplay();
+    static Histogram &frameTimeMetric();
 
     // Error handling helpers
+#ifndef FPV_HEADLESS
     void keepWindowAlive(const std::string &errorMessage);
+#endif
 };
@@ -8,13 +8,15 @@
 #include "../components/LightC.h"
 #include "Vector3D.h"
 #include "Quaternion.h"
+#include <iostream>
 
 /**
  * @brief Construct an entity with a unique identifier.
  *
- * Initializes the entity with the provided ID and prepares the component storage.
+ * Initializes the entity with the provided ID. Components added before the
+ * entity is attached to a World are held as pending components.
  *
- * @param id The unique identifier for this entity
+ * @param id The unique identifier for this entity, or 0 to let the World assign one
  */
 Entity::Entity(unsigned int id) : id_(id)
 {
@@ -141,7 +143,7 @@ void Entity::setPhysicsComponent(bool hasPhysics, float mass, float friction, fl
     {
         DEBUG_LOG("Removing PhysicsC component");
         // If physics is disabled, remove the component if it exists
-        components_.erase(std::type_index(typeid(PhysicsC)));
+        removeComponent<PhysicsC>();
         return;
     }
 
@@ -165,7 +167,10 @@ void Entity::setPhysicsComponent(bool hasPhysics, float mass, float friction, fl
 /**
  * @brief Set collider type for physics.
  *
- * @param colliderType Type of collider ("sphere", "box", etc.)
+ * Unknown names are reported and leave the collider a sphere (or unchanged
+ * if the entity already has a PhysicsC).
+ *
+ * @param colliderType Type of collider ("sphere", "box" or "capsule")
  */
 void Entity::setColliderType(const std::string &colliderType)
 {
@@ -176,13 +181,16 @@ void Entity::setColliderType(const std::string &colliderType)
     {
         DEBUG_LOG("Creating new PhysicsC component");
         auto newPhysics = std::make_unique<PhysicsC>();
-        newPhysics->colliderType = colliderType;
         addComponent<PhysicsC>(std::move(newPhysics));
+        physics = getComponent<PhysicsC>();
     }
     else
     {
         DEBUG_LOG("Updating existing PhysicsC component");
-        physics->colliderType = colliderType;
+    }
+    if (!parseColliderType(colliderType, physics->colliderType))
+    {
+        std::cerr << "Entity " << id_ << ": unknown collider type '" << colliderType << "'" << std::endl;
     }
 }
 
@@ -353,3 +361,63 @@ void Entity::setCustomProperty(const std::string &name, const std::string &value
     customProperties_[name] = value;
 }
 
+
+/**
+ * @brief Store a component while the entity is not attached to a World.
+ *
+ * Pending components are kept in a small vector keyed by dense type ID;
+ * entities carry only a handful of components, so a linear scan is cheaper
+ * than hashing.
+ *
+ * @param typeId Dense component type ID
+ * @param component Component instance to store
+ */
+void Entity::setPendingComponent(ComponentTypeId typeId, std::unique_ptr<IComponent> component)
+{
+    for (auto &pending : pendingComponents_)
+    {
+        if (pending.typeId == typeId)
+        {
+            pending.component = std::move(component);
+            return;
+        }
+    }
+    pendingComponents_.push_back(PendingComponent{typeId, std::move(component)});
+}
+
+/**
+ * @brief Find a pending component by type.
+ *
+ * @param typeId Dense component type ID
+ * @return Pointer to the component, or nullptr if not present
+ */
+IComponent *Entity::findPendingComponent(ComponentTypeId typeId) const
+{
+    for (const auto &pending : pendingComponents_)
+    {
+        if (pending.typeId == typeId)
+        {
+            return pending.component.get();
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Remove a pending component by type.
+ *
+ * @param typeId Dense component type ID
+ * @return true if the component existed and was removed
+ */
+bool Entity::removePendingComponent(ComponentTypeId typeId)
+{
+    for (auto it = pendingComponents_.begin(); it != pendingComponents_.end(); ++it)
+    {
+        if (it->typeId == typeId)
+        {
+            pendingComponents_.erase(it);
+            return true;
+        }
+    }
+    return false;
+}
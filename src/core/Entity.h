@@ -2,10 +2,13 @@
 #define ENTITY_H
 
 #include "IComponent.h"
+#include "ComponentTypeId.h"
+#include "ComponentStorage.h"
+#include "EntityHandle.h"
 #include <memory>
 #include <string>
 #include <unordered_map>
-#include <typeindex>
+#include <vector>
 
 /**
  * @brief Represents an entity in the Entity Component System (ECS).
@@ -14,6 +17,10 @@
  * Entities are identified by a unique ID and can have multiple components attached
  * to them. The entity itself contains no logic - all behavior is implemented
  * through systems that operate on entities with specific component combinations.
+ *
+ * Until an entity is added to a World its components are held individually.
+ * Once attached, they live in the World's ComponentStorage, packed by type in
+ * the columns of the archetype matching the entity's component set.
  */
 class Entity
 {
@@ -21,9 +28,15 @@ public:
     /**
      * @brief Construct an entity with a unique identifier.
      *
-     * @param id The unique identifier for this entity
+     * An ID of 0 means "unassigned"; World::addEntity then gives the entity
+     * the next free ID from the world's allocator.
+     *
+     * @param id The unique identifier for this entity, or 0 to let the World assign one
      */
-    Entity(unsigned int id);
+    explicit Entity(unsigned int id = 0);
+
+    Entity(const Entity &) = delete;
+    Entity &operator=(const Entity &) = delete;
 
     /**
      * @brief Get the unique identifier of this entity.
@@ -32,6 +45,13 @@ public:
      */
     unsigned int getId() const { return id_; }
 
+    /**
+     * @brief Get the generational handle of this entity.
+     *
+     * @return The handle issued by the owning World, or an invalid handle if not yet added
+     */
+    EntityHandle getHandle() const { return handle_; }
+
     /**
      * @brief Set the name of this entity.
      *
@@ -109,7 +129,9 @@ public:
     /**
      * @brief Set collider type for physics.
      *
-     * @param colliderType Type of collider ("sphere", "box", etc.)
+     * Unknown names are reported and leave the collider a sphere.
+     *
+     * @param colliderType Type of collider ("sphere", "box" or "capsule")
      */
     void setColliderType(const std::string &colliderType);
 
@@ -185,7 +207,8 @@ public:
      * @brief Add a component to this entity.
      *
      * Components define the properties and capabilities of an entity.
-     * Each component type can only be added once per entity.
+     * Each component type can only be added once per entity; adding a
+     * second component of the same type replaces the first.
      *
      * @tparam T The type of component to add
      * @param component Unique pointer to the component instance
@@ -193,33 +216,93 @@ public:
     template <typename T>
     void addComponent(std::unique_ptr<T> component)
     {
-        components_[std::type_index(typeid(T))] = std::move(component);
+        const ComponentTypeId typeId = componentTypeId<T>();
+        if (storage_ != nullptr)
+        {
+            storage_->addComponent(*this, typeId, component.get());
+            return;
+        }
+        setPendingComponent(typeId, std::move(component));
     }
 
     /**
      * @brief Get a component from this entity.
      *
+     * The returned pointer is invalidated by the next structural change
+     * (component added or removed) to any entity sharing this entity's archetype.
+     *
      * @tparam T The type of component to retrieve
      * @return Pointer to the component if it exists, nullptr otherwise
      */
     template <typename T>
     T *getComponent()
     {
-        auto it = components_.find(std::type_index(typeid(T)));
-        if (it != components_.end())
+        const ComponentTypeId typeId = componentTypeId<T>();
+        if (archetype_ != nullptr)
         {
-            return static_cast<T *>(it->second.get());
+            return static_cast<T *>(archetype_->getComponent(typeId, row_));
         }
-        return nullptr;
+        return static_cast<T *>(findPendingComponent(typeId));
+    }
+
+    /**
+     * @brief Check whether this entity has a component.
+     *
+     * @tparam T The type of component to check for
+     * @return true if the component exists, false otherwise
+     */
+    template <typename T>
+    bool hasComponent()
+    {
+        return getComponent<T>() != nullptr;
+    }
+
+    /**
+     * @brief Remove a component from this entity.
+     *
+     * @tparam T The type of component to remove
+     * @return true if the component existed and was removed
+     */
+    template <typename T>
+    bool removeComponent()
+    {
+        const ComponentTypeId typeId = componentTypeId<T>();
+        if (storage_ != nullptr)
+        {
+            return storage_->removeComponent(*this, typeId);
+        }
+        return removePendingComponent(typeId);
     }
 
 private:
-    unsigned int id_;                                                             /**< Unique identifier for this entity */
-    std::string name_;                                                            /**< Entity name */
-    bool active_ = true;                                                          /**< Whether the entity is active */
-    float lifetime_ = -1.0f;                                                      /**< Entity lifetime in seconds, -1 for infinite */
-    std::unordered_map<std::type_index, std::unique_ptr<IComponent>> components_; /**< Map of component types to component instances */
-    std::unordered_map<std::string, std::string> customProperties_;               /**< Custom entity properties */
+    friend class ComponentStorage;
+    friend class World;
+    friend class WorldSnapshot;
+    friend class Prefab;
+
+    /**
+     * @brief A component added before the entity was attached to a World.
+     */
+    struct PendingComponent
+    {
+        ComponentTypeId typeId;                /**< Dense component type ID */
+        std::unique_ptr<IComponent> component; /**< Heap-allocated component instance */
+    };
+
+    void setPendingComponent(ComponentTypeId typeId, std::unique_ptr<IComponent> component);
+    IComponent *findPendingComponent(ComponentTypeId typeId) const;
+    bool removePendingComponent(ComponentTypeId typeId);
+
+    unsigned int id_;                                               /**< Unique identifier for this entity */
+    EntityHandle handle_;                                           /**< Slot handle issued by the owning World */
+    std::string name_;                                              /**< Entity name */
+    bool active_ = true;                                            /**< Whether the entity is active */
+    float lifetime_ = -1.0f;                                        /**< Entity lifetime in seconds, -1 for infinite */
+    std::vector<PendingComponent> pendingComponents_;               /**< Components held until the entity is attached */
+    ComponentStorage *storage_ = nullptr;                           /**< Storage owning the components once attached */
+    Archetype *archetype_ = nullptr;                                /**< Archetype holding the components once attached */
+    std::size_t row_ = 0;                                           /**< Row within the archetype's columns */
+    std::unordered_map<std::string, std::string> customProperties_; /**< Custom entity properties */
 };
 
 #endif
@@ -0,0 +1,60 @@
+#ifndef ENTITYHANDLE_H
+#define ENTITYHANDLE_H
+
+#include <cstdint>
+
+/**
+ * @brief Generational reference to an entity owned by a World.
+ *
+ * A handle names a slot in the World's entity table plus the generation the
+ * slot had when the entity was created. Destroying an entity bumps the slot's
+ * generation, so stale handles to a recycled slot resolve to nullptr instead
+ * of silently aliasing the new occupant.
+ *
+ * Handles are 64 bits wide and can be stored or sent in events as a plain
+ * integer via value() / fromValue().
+ */
+struct EntityHandle
+{
+    /** @brief Slot index used by handles that do not refer to any entity */
+    static constexpr std::uint32_t InvalidIndex = 0xFFFFFFFFu;
+
+    std::uint32_t index = InvalidIndex; /**< Slot in the World's entity table */
+    std::uint32_t generation = 0;       /**< Slot generation when the entity was created */
+
+    /**
+     * @brief Check whether the handle refers to a slot at all.
+     *
+     * A valid handle may still be stale; use World::isAlive to check that
+     * the entity has not been destroyed.
+     *
+     * @return true if the handle has a slot index
+     */
+    bool isValid() const { return index != InvalidIndex; }
+
+    /**
+     * @brief Pack the handle into a single 64-bit integer.
+     *
+     * @return Generation in the high 32 bits, slot index in the low 32 bits
+     */
+    std::uint64_t value() const { return (static_cast<std::uint64_t>(generation) << 32) | index; }
+
+    /**
+     * @brief Rebuild a handle from a packed 64-bit integer.
+     *
+     * @param packed Value previously returned by value()
+     * @return The unpacked handle
+     */
+    static EntityHandle fromValue(std::uint64_t packed)
+    {
+        EntityHandle handle;
+        handle.index = static_cast<std::uint32_t>(packed & 0xFFFFFFFFu);
+        handle.generation = static_cast<std::uint32_t>(packed >> 32);
+        return handle;
+    }
+
+    bool operator==(const EntityHandle &other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const EntityHandle &other) const { return !(*this == other); }
+};
+
+#endif
@@ -1,63 +1,141 @@
 #include "EventBus.h"
 #include "debug.h"
-#define DEBUG
-
-#ifdef DEBUG
-#pragma message("DEBUG is defined")
-#else
-#pragma message("DEBUG is not defined")
-#endif
+#include <atomic>
 
 /**
  * @brief Construct an empty event bus.
  *
- * Initializes the event bus with no registered handlers.
+ * Initializes the event bus with no registered handlers and an empty
+ * cross-thread ring.
+ *
+ * @param postedCapacity Cells in the cross-thread ring (rounded up to a power of two)
  */
-EventBus::EventBus()
+EventBus::EventBus(std::size_t postedCapacity)
+    : posted_(postedCapacity),
+      overflowPolicy_(OverflowPolicy::DropNewest),
+      postedCount_(0),
+      droppedCount_(0),
+      blockedCount_(0),
+      postedHighWater_(0)
 {
     DEBUG_LOG("Creating EventBus");
 }
 
 /**
- * @brief Subscribe a handler function to a specific event type.
+ * @brief Destroy the bus, discarding events still in the cross-thread ring.
+ */
+EventBus::~EventBus()
+{
+    while (posted_.tryPop([](PostedEvent &cell)
+                          { cell.dispatch(nullptr, cell.storage); }))
+    {
+    }
+}
+
+/**
+ * @brief Remove a subscription.
  *
- * Adds the handler to the list of functions that will be called when
- * events of the specified type are published. If this is the first
- * handler for this event type, a new entry is created in the handlers map.
+ * The handler is disabled immediately and erased from its channel once no
+ * delivery of that channel is in progress.
  *
- * @param type The event type to subscribe to
- * @param handler Function to call when events of this type are published
+ * @param id ID returned by subscribe()
+ * @return true if the subscription existed
  */
-void EventBus::subscribe(EventType type, std::function<void(const IEvent &)> handler)
+bool EventBus::unsubscribe(SubscriptionId id)
 {
-    DEBUG_LOG("Subscribing handler for event type " + std::to_string(static_cast<int>(type)));
-    handlers_[type].push_back(handler);
+    for (auto &channel : channels_)
+    {
+        if (channel && channel->remove(id))
+        {
+            return true;
+        }
+    }
+    return false;
 }
 
 /**
- * @brief Publish an event to all subscribed handlers.
+ * @brief Deliver every queued event, one event type at a time.
  *
- * Looks up all handlers registered for the event's type and calls each
- * one with a reference to the event. If no handlers are registered for
- * this event type, the function returns without doing anything.
+ * Channels are drained in order of their type index. Each channel swaps its
+ * queue with a scratch buffer before delivering, so handlers may enqueue
+ * further events (of any type) while the drain is running.
  *
- * @param event The event to publish
+ * @return Number of events delivered
  */
-void EventBus::publish(const IEvent &event)
+std::size_t EventBus::dispatchQueued()
 {
-    DEBUG_LOG("Publishing event of type " + std::to_string(static_cast<int>(event.getType())));
-    auto it = handlers_.find(event.getType());
-    if (it != handlers_.end())
+    std::size_t delivered = 0;
+    // Index loop: handlers may subscribe to new event types, growing channels_
+    for (std::size_t i = 0; i < channels_.size(); ++i)
     {
-        DEBUG_LOG("Found " + std::to_string(it->second.size()) + " handlers for event type " + std::to_string(static_cast<int>(event.getType())));
-        for (auto &handler : it->second)
+        if (channels_[i])
         {
-            handler(event);
+            delivered += channels_[i]->dispatchQueued();
         }
     }
-    else
+    return delivered;
+}
+
+/**
+ * @brief Assign the next dense event type index.
+ *
+ * Called once per event type from the function-local static inside
+ * eventTypeIndex<T>().
+ *
+ * @return The newly assigned index
+ */
+std::size_t EventBus::registerEventType()
+{
+    static std::atomic<std::size_t> nextIndex{0};
+    return nextIndex.fetch_add(1);
+}
+
+/**
+ * @brief Publish every event posted from other threads. Main thread only.
+ *
+ * Drains the ring in posting order. Events posted while the drain is running
+ * may be published in the same call.
+ *
+ * @return Number of events published
+ */
+std::size_t EventBus::dispatchPosted()
+{
+    std::size_t published = 0;
+    while (posted_.tryPop([this](PostedEvent &cell)
+                          { cell.dispatch(this, cell.storage); }))
     {
-        DEBUG_LOG("No handlers found for event type " + std::to_string(static_cast<int>(event.getType())));
+        ++published;
     }
+    return published;
+}
+
+/**
+ * @brief Get back-pressure statistics of the cross-thread ring.
+ *
+ * @return Snapshot of the counters
+ */
+EventBus::PostedStats EventBus::getPostedStats() const
+{
+    PostedStats stats;
+    stats.posted = postedCount_.load(std::memory_order_relaxed);
+    stats.dropped = droppedCount_.load(std::memory_order_relaxed);
+    stats.blocked = blockedCount_.load(std::memory_order_relaxed);
+    stats.highWater = postedHighWater_.load(std::memory_order_relaxed);
+    stats.capacity = posted_.capacity();
+    return stats;
 }
 
+/**
+ * @brief Count an accepted post and update the high-water mark.
+ */
+void EventBus::recordPosted()
+{
+    postedCount_.fetch_add(1, std::memory_order_relaxed);
+
+    const std::size_t occupancy = posted_.sizeApprox();
+    std::size_t highWater = postedHighWater_.load(std::memory_order_relaxed);
+    while (occupancy > highWater &&
+           !postedHighWater_.compare_exchange_weak(highWater, occupancy, std::memory_order_relaxed))
+    {
+    }
+}
@@ -2,8 +2,15 @@
 #define EVENTBUS_H
 
 #include "IEvent.h"
-#include <functional>
-#include <unordered_map>
+#include "MpscRing.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 /**
@@ -13,39 +20,455 @@
  * subscribe to specific event types and receive notifications when those
  * events are published. This enables decoupled communication between
  * different parts of the simulation.
+ *
+ * Each event type T gets its own channel, found by a dense per-type index
+ * rather than a hash lookup. Handlers are stored as a context pointer plus a
+ * plain function pointer, so dispatch is one indirect call per handler and
+ * publishing never allocates.
+ *
+ * Events can be delivered two ways:
+ * - publish<T>() calls every handler immediately.
+ * - enqueue<T>() appends the event to the channel's contiguous queue; all
+ *   queued events are delivered, type by type, by dispatchQueued() (called
+ *   once per frame by the Engine). Use this for high-rate events such as
+ *   collision contacts or rotor telemetry.
+ *
+ * Subscribe, publish, enqueue and dispatch must all happen on the main
+ * thread. Other threads (asset loading, file watching, I/O) use post<T>(),
+ * which pushes the event into a bounded lock-free ring; the main thread
+ * publishes everything posted when it calls dispatchPosted() at the start
+ * of each frame.
+ *
+ * Usage:
+ * @code
+ * eventBus.subscribe<SceneLoadedEvent>([this](const SceneLoadedEvent &event)
+ *                                      { updateWindowTitle(event.sceneName); });
+ * eventBus.subscribe<DebugModeToggled, ThisClass, &ThisClass::onDebugModeToggled>(this);
+ * eventBus.publish(SceneLoadedEvent{"Default World"});
+ * @endcode
  */
 class EventBus
 {
 public:
+    /** @brief Identifies a subscription for unsubscribe() */
+    using SubscriptionId = std::uint64_t;
+
+    /** @brief Default number of cells in the cross-thread ring */
+    static constexpr std::size_t DefaultPostedCapacity = 1024;
+
+    /** @brief Largest event type (in bytes) that can be posted across threads */
+    static constexpr std::size_t MaxPostedEventSize = 64;
+
+    /**
+     * @brief What post() does when the cross-thread ring is full.
+     */
+    enum class OverflowPolicy
+    {
+        DropNewest, /**< Reject the event and count it as dropped (never blocks) */
+        Block       /**< Yield until the main thread frees a cell */
+    };
+
+    /**
+     * @brief Back-pressure statistics of the cross-thread ring.
+     */
+    struct PostedStats
+    {
+        std::uint64_t posted;  /**< Events accepted since construction */
+        std::uint64_t dropped; /**< Events rejected by DropNewest */
+        std::uint64_t blocked; /**< post() calls that found the ring full and waited */
+        std::size_t highWater; /**< Highest ring occupancy seen by a producer */
+        std::size_t capacity;  /**< Ring capacity */
+    };
+
     /**
      * @brief Construct an empty event bus.
+     *
+     * @param postedCapacity Cells in the cross-thread ring (rounded up to a power of two)
+     */
+    explicit EventBus(std::size_t postedCapacity = DefaultPostedCapacity);
+
+    /**
+     * @brief Destroy the bus, discarding events still in the cross-thread ring.
      */
-    EventBus();
+    ~EventBus();
+
+    EventBus(const EventBus &) = delete;
+    EventBus &operator=(const EventBus &) = delete;
 
     /**
-     * @brief Subscribe a handler function to a specific event type.
+     * @brief Subscribe a callable to events of type T.
+     *
+     * The callable is moved into storage owned by the bus; this is the only
+     * allocation, and it happens here rather than on publish.
      *
-     * Multiple handlers can subscribe to the same event type. When an
-     * event of that type is published, all subscribed handlers will be called.
+     * @tparam T Event type
+     * @param handler Callable taking (const T &)
+     * @return Subscription ID
+     */
+    template <typename T, typename Handler>
+    SubscriptionId subscribe(Handler &&handler)
+    {
+        using Stored = typename std::decay<Handler>::type;
+        std::shared_ptr<Stored> stored = std::make_shared<Stored>(std::forward<Handler>(handler));
+        void *context = stored.get();
+        return channel<T>().add(context, [](void *ctx, const T &event)
+                                { (*static_cast<Stored *>(ctx))(event); },
+                                std::move(stored), nextSubscriptionId_++);
+    }
+
+    /**
+     * @brief Subscribe a member function to events of type T without any allocation.
      *
-     * @param type The event type to subscribe to
-     * @param handler Function to call when events of this type are published
+     * @tparam T Event type
+     * @tparam C Class of the receiver
+     * @tparam Method Member function taking (const T &)
+     * @param receiver Object the member function is called on (must outlive the subscription)
+     * @return Subscription ID
      */
-    void subscribe(EventType type, std::function<void(const IEvent &)> handler);
+    template <typename T, typename C, void (C::*Method)(const T &)>
+    SubscriptionId subscribe(C *receiver)
+    {
+        return channel<T>().add(receiver, [](void *ctx, const T &event)
+                                { (static_cast<C *>(ctx)->*Method)(event); },
+                                nullptr, nextSubscriptionId_++);
+    }
 
     /**
-     * @brief Publish an event to all subscribed handlers.
+     * @brief Remove a subscription.
      *
-     * All handlers subscribed to the event's type will be called with
-     * a reference to the event object.
+     * Safe to call from inside a handler; the handler is skipped from then on.
      *
+     * @param id ID returned by subscribe()
+     * @return true if the subscription existed
+     */
+    bool unsubscribe(SubscriptionId id);
+
+    /**
+     * @brief Deliver an event to every handler of its type immediately.
+     *
+     * @tparam T Event type
      * @param event The event to publish
      */
-    void publish(const IEvent &event);
+    template <typename T>
+    void publish(const T &event)
+    {
+        const std::size_t index = eventTypeIndex<T>();
+        if (index < channels_.size() && channels_[index])
+        {
+            static_cast<Channel<T> *>(channels_[index].get())->deliver(event);
+        }
+    }
+
+    /**
+     * @brief Queue an event for the next dispatchQueued().
+     *
+     * Events are stored by value in a per-type contiguous buffer whose
+     * capacity is kept between frames. Events of types nobody subscribed to
+     * are dropped without being stored.
+     *
+     * @tparam T Event type
+     * @param event The event to queue
+     */
+    template <typename T>
+    void enqueue(T event)
+    {
+        const std::size_t index = eventTypeIndex<T>();
+        if (index < channels_.size() && channels_[index])
+        {
+            static_cast<Channel<T> *>(channels_[index].get())->queue.push_back(std::move(event));
+        }
+    }
+
+    /**
+     * @brief Deliver every queued event, one event type at a time.
+     *
+     * Channels are drained in type-index order. Events that handlers queue
+     * during the drain are delivered in the same call if their channel has
+     * not been drained yet (or is the one being drained), otherwise at the
+     * next call.
+     *
+     * @return Number of events delivered
+     */
+    std::size_t dispatchQueued();
+
+    /**
+     * @brief Hand an event to the main thread. Safe to call from any thread.
+     *
+     * The event is move-constructed into a cell of a bounded lock-free ring
+     * and published on the main thread by the next dispatchPosted(). When
+     * the ring is full the overflow policy decides whether the event is
+     * dropped or the caller waits; never use Block from the main thread.
+     *
+     * @tparam T Event type (at most MaxPostedEventSize bytes, nothrow move-constructible)
+     * @param event The event to post
+     * @return false if the event was dropped
+     */
+    template <typename T>
+    bool post(T event)
+    {
+        static_assert(sizeof(T) <= MaxPostedEventSize, "Event too large to post across threads (raise MaxPostedEventSize)");
+        static_assert(alignof(T) <= alignof(std::max_align_t), "Over-aligned events cannot be posted across threads");
+        // The ring cell is claimed before the event is moved in; a throwing move would leave it unpublished forever
+        static_assert(std::is_nothrow_move_constructible<T>::value, "Posted events must be nothrow move-constructible");
+
+        auto fill = [&event](PostedEvent &cell)
+        {
+            new (cell.storage) T(std::move(event));
+            cell.dispatch = &dispatchPostedEvent<T>;
+        };
+
+        if (!posted_.tryPush(fill))
+        {
+            if (overflowPolicy_.load(std::memory_order_relaxed) == OverflowPolicy::DropNewest)
+            {
+                droppedCount_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+
+            blockedCount_.fetch_add(1, std::memory_order_relaxed);
+            while (!posted_.tryPush(fill))
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        recordPosted();
+        return true;
+    }
+
+    /**
+     * @brief Publish every event posted from other threads. Main thread only.
+     *
+     * @return Number of events published
+     */
+    std::size_t dispatchPosted();
+
+    /**
+     * @brief Set what post() does when the cross-thread ring is full.
+     *
+     * @param policy Overflow policy (DropNewest by default)
+     */
+    void setOverflowPolicy(OverflowPolicy policy) { overflowPolicy_.store(policy, std::memory_order_relaxed); }
+
+    /**
+     * @brief Get the overflow policy of the cross-thread ring.
+     *
+     * @return Current overflow policy
+     */
+    OverflowPolicy getOverflowPolicy() const { return overflowPolicy_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Get back-pressure statistics of the cross-thread ring.
+     *
+     * @return Snapshot of the counters
+     */
+    PostedStats getPostedStats() const;
+
+    /**
+     * @brief Get the number of handlers subscribed to events of type T.
+     *
+     * @tparam T Event type
+     * @return Active subscription count
+     */
+    template <typename T>
+    std::size_t getSubscriberCount() const
+    {
+        const std::size_t index = eventTypeIndex<T>();
+        if (index < channels_.size() && channels_[index])
+        {
+            return channels_[index]->activeCount;
+        }
+        return 0;
+    }
 
 private:
-    /** Map of event types to lists of handler functions */
-    std::unordered_map<EventType, std::vector<std::function<void(const IEvent &)>>> handlers_;
+    /**
+     * @brief Ring cell holding one event posted from another thread.
+     */
+    struct PostedEvent
+    {
+        void (*dispatch)(EventBus *, void *) = nullptr;                     /**< Publishes (bus non-null) and destroys the event */
+        alignas(std::max_align_t) unsigned char storage[MaxPostedEventSize]; /**< Event constructed in place */
+    };
+
+    /**
+     * @brief Publish a posted event of type T on bus (if non-null), then destroy it.
+     */
+    template <typename T>
+    static void dispatchPostedEvent(EventBus *bus, void *storage)
+    {
+        T &event = *static_cast<T *>(storage);
+        struct Destroy
+        {
+            T &event;
+            ~Destroy() { event.~T(); }
+        } destroy{event};
+
+        if (bus != nullptr)
+        {
+            bus->publish(event);
+        }
+    }
+
+    /** @brief Count an accepted post and update the high-water mark */
+    void recordPosted();
+
+    /**
+     * @brief Type-independent part of a channel.
+     */
+    struct ChannelBase
+    {
+        virtual ~ChannelBase() = default;
+
+        /** @brief Deliver the queued events; returns how many were delivered */
+        virtual std::size_t dispatchQueued() = 0;
+
+        /** @brief Disable a handler; returns true if it was found */
+        virtual bool remove(SubscriptionId id) = 0;
+
+        std::size_t activeCount = 0; /**< Handlers not yet unsubscribed */
+    };
+
+    /**
+     * @brief Handlers and queued events for one event type.
+     */
+    template <typename T>
+    struct Channel : ChannelBase
+    {
+        /**
+         * @brief One subscribed handler.
+         */
+        struct Handler
+        {
+            void *context;                        /**< Receiver or stored callable */
+            void (*invoke)(void *, const T &);    /**< Trampoline, nullptr once unsubscribed */
+            std::shared_ptr<void> owner;          /**< Keeps a stored callable alive */
+            SubscriptionId id;                    /**< Subscription ID */
+        };
+
+        SubscriptionId add(void *context, void (*invoke)(void *, const T &), std::shared_ptr<void> owner, SubscriptionId id)
+        {
+            handlers.push_back(Handler{context, invoke, std::move(owner), id});
+            ++activeCount;
+            return id;
+        }
+
+        bool remove(SubscriptionId id) override
+        {
+            for (Handler &handler : handlers)
+            {
+                if (handler.id == id && handler.invoke != nullptr)
+                {
+                    handler.invoke = nullptr;
+                    --activeCount;
+                    removed = true;
+                    compact();
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void deliver(const T &event)
+        {
+            ++depth;
+            // Index loop: handlers may subscribe (reallocating the vector) while we iterate
+            const std::size_t count = handlers.size();
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const Handler &handler = handlers[i];
+                if (handler.invoke != nullptr)
+                {
+                    void *context = handler.context;
+                    handler.invoke(context, event);
+                }
+            }
+            --depth;
+            compact();
+        }
+
+        std::size_t dispatchQueued() override
+        {
+            std::size_t delivered = 0;
+            while (!queue.empty())
+            {
+                draining.swap(queue);
+                for (const T &event : draining)
+                {
+                    deliver(event);
+                }
+                delivered += draining.size();
+                draining.clear();
+            }
+            return delivered;
+        }
+
+        void compact()
+        {
+            if (!removed || depth > 0)
+                return;
+
+            std::size_t kept = 0;
+            for (std::size_t i = 0; i < handlers.size(); ++i)
+            {
+                if (handlers[i].invoke != nullptr)
+                {
+                    if (kept != i)
+                        handlers[kept] = std::move(handlers[i]);
+                    ++kept;
+                }
+            }
+            handlers.erase(handlers.begin() + static_cast<std::ptrdiff_t>(kept), handlers.end());
+            removed = false;
+        }
+
+        std::vector<Handler> handlers; /**< Handlers in subscription order */
+        std::vector<T> queue;          /**< Events waiting for dispatchQueued() */
+        std::vector<T> draining;       /**< Batch currently being delivered */
+        int depth = 0;                 /**< Nesting level of deliver() */
+        bool removed = false;          /**< Whether disabled handlers await compaction */
+    };
+
+    /**
+     * @brief Get the dense index of event type T, assigning one on first use.
+     */
+    template <typename T>
+    static std::size_t eventTypeIndex()
+    {
+        static const std::size_t index = registerEventType();
+        return index;
+    }
+
+    /** @brief Assign the next dense event type index */
+    static std::size_t registerEventType();
+
+    /**
+     * @brief Get the channel for event type T, creating it if needed.
+     */
+    template <typename T>
+    Channel<T> &channel()
+    {
+        const std::size_t index = eventTypeIndex<T>();
+        if (index >= channels_.size())
+        {
+            channels_.resize(index + 1);
+        }
+        if (!channels_[index])
+        {
+            channels_[index] = std::make_unique<Channel<T>>();
+        }
+        return *static_cast<Channel<T> *>(channels_[index].get());
+    }
+
+    std::vector<std::unique_ptr<ChannelBase>> channels_; /**< Channel per event type index (null if unused) */
+    SubscriptionId nextSubscriptionId_ = 1;              /**< Next subscription ID to hand out */
+
+    MpscRing<PostedEvent> posted_;                       /**< Events posted from other threads */
+    std::atomic<OverflowPolicy> overflowPolicy_;         /**< Behaviour of post() when posted_ is full */
+    std::atomic<std::uint64_t> postedCount_;             /**< Events accepted by post() */
+    std::atomic<std::uint64_t> droppedCount_;            /**< Events rejected by post() */
+    std::atomic<std::uint64_t> blockedCount_;            /**< post() calls that waited for space */
+    std::atomic<std::size_t> postedHighWater_;           /**< Highest occupancy of posted_ */
 };
 
 #endif
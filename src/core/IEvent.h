@@ -14,9 +14,11 @@ enum class EventType
     ConsoleToggle,            /**< Console visibility toggle event */
     ConsoleVisibilityChanged, /**< Console visibility state change event */
     DebugModeToggled,         /**< Debug mode activation/deactivation event */
+    InputAction,              /**< Input action reaching the simulation */
     NoPackagesFound,          /**< No asset packages found during bootstrap */
     DefaultWorldGenerated,    /**< Default world generation completed */
     SceneLoaded,              /**< Scene successfully loaded with name */
+    RewindRequested,          /**< Rewind of the simulation requested */
     // Add more as needed
 };
 
@@ -1,6 +1,8 @@
 #ifndef ISYSTEM_H
 #define ISYSTEM_H
 
+#include "SystemAccess.h"
+
 class World;
 
 /**
@@ -34,6 +36,17 @@ public:
      * @return String name of the system
      */
     virtual const char *getName() const { return "UnnamedSystem"; }
+
+    /**
+     * @brief Declare the component types this system reads and writes.
+     *
+     * The scheduler runs systems with non-overlapping access sets concurrently.
+     * The default declares nothing, which makes the system exclusive: it runs
+     * alone, on the thread driving the update, in registration order.
+     *
+     * @return Component access set of this system
+     */
+    virtual SystemAccess getAccess() const { return SystemAccess(); }
 };
 
 #endif
@@ -0,0 +1,461 @@
+#include "JobSystem.h"
+#include "Profiler.h"
+#include <string>
+
+/**
+ * @brief Internal job record.
+ *
+ * pendingCount starts at one for the "not yet submitted" guard and gains one
+ * per unfinished prerequisite; the job is queued when it drops to zero.
+ */
+struct JobSystem::Job
+{
+    JobFunction function;                  /**< Work to execute (released after running) */
+    std::atomic<int> pendingCount{1};      /**< Submit guard plus unfinished prerequisites */
+    std::atomic<bool> finished{false};     /**< Set once the function has run */
+    std::mutex mutex;                      /**< Guards continuations against finishing */
+    std::vector<JobHandle> continuations;  /**< Jobs waiting on this one */
+    std::exception_ptr error;              /**< Exception thrown by the function, if any */
+};
+
+namespace
+{
+    std::atomic<JobSystem *> currentJobSystem{nullptr};
+
+    /** Job system whose worker is running on this thread (nullptr for other threads) */
+    thread_local const JobSystem *workerOwner = nullptr;
+
+    /** Queue index of this thread within workerOwner */
+    thread_local unsigned int workerQueueIndex = 0;
+}
+
+/**
+ * @brief Construct a job system with no worker threads.
+ */
+JobSystem::JobSystem() : queuedJobs_(0), stopping_(false)
+{
+    queues_.push_back(std::make_unique<WorkQueue>());
+}
+
+/**
+ * @brief Stop and join all worker threads.
+ */
+JobSystem::~JobSystem()
+{
+    stop();
+    if (current() == this)
+    {
+        setCurrent(nullptr);
+    }
+}
+
+/**
+ * @brief Start the worker threads.
+ *
+ * Does nothing if workers are already running.
+ *
+ * @param workerCount Number of workers, or -1 for hardware concurrency minus one
+ */
+void JobSystem::start(int workerCount)
+{
+    if (isRunning())
+        return;
+
+    if (workerCount < 0)
+    {
+        const unsigned int hardware = std::thread::hardware_concurrency();
+        workerCount = hardware > 1 ? static_cast<int>(hardware - 1) : 0;
+    }
+
+    stopping_ = false;
+    for (int i = 0; i < workerCount; ++i)
+    {
+        queues_.push_back(std::make_unique<WorkQueue>());
+    }
+    for (int i = 0; i < workerCount; ++i)
+    {
+        workers_.emplace_back(&JobSystem::workerLoop, this, static_cast<unsigned int>(i + 1));
+    }
+}
+
+/**
+ * @brief Finish queued jobs and join the worker threads.
+ */
+void JobSystem::stop()
+{
+    if (!isRunning())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+
+    for (auto &worker : workers_)
+    {
+        worker.join();
+    }
+    workers_.clear();
+    queues_.resize(1);
+}
+
+/**
+ * @brief Create a job without scheduling it.
+ *
+ * @param function Work to execute
+ * @return Handle to the new job
+ */
+JobSystem::JobHandle JobSystem::create(JobFunction function)
+{
+    auto job = std::make_shared<Job>();
+    job->function = std::move(function);
+    return job;
+}
+
+/**
+ * @brief Make a job wait for another job to finish.
+ *
+ * If the prerequisite has already finished this is a no-op.
+ *
+ * @param job Job that must wait
+ * @param prerequisite Job that must finish first
+ */
+void JobSystem::addDependency(const JobHandle &job, const JobHandle &prerequisite)
+{
+    std::lock_guard<std::mutex> lock(prerequisite->mutex);
+    if (prerequisite->finished.load(std::memory_order_acquire))
+        return;
+
+    job->pendingCount.fetch_add(1, std::memory_order_relaxed);
+    prerequisite->continuations.push_back(job);
+}
+
+/**
+ * @brief Submit a created job; it runs once all its dependencies have finished.
+ *
+ * @param job Job returned by create()
+ */
+void JobSystem::submit(const JobHandle &job)
+{
+    if (job->pendingCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        push(job);
+    }
+}
+
+/**
+ * @brief Create and submit a job with no dependencies.
+ *
+ * @param function Work to execute
+ * @return Handle to the scheduled job
+ */
+JobSystem::JobHandle JobSystem::schedule(JobFunction function)
+{
+    JobHandle job = create(std::move(function));
+    submit(job);
+    return job;
+}
+
+/**
+ * @brief Schedule a continuation that runs after another job finishes.
+ *
+ * @param prerequisite Job to follow
+ * @param function Work to execute afterwards
+ * @return Handle to the continuation job
+ */
+JobSystem::JobHandle JobSystem::then(const JobHandle &prerequisite, JobFunction function)
+{
+    JobHandle job = create(std::move(function));
+    addDependency(job, prerequisite);
+    submit(job);
+    return job;
+}
+
+/**
+ * @brief Wait for a job, executing other jobs meanwhile.
+ *
+ * @param job Job to wait for
+ */
+void JobSystem::wait(const JobHandle &job)
+{
+    while (!job->finished.load(std::memory_order_acquire))
+    {
+        if (!runPendingJob())
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    if (job->error)
+    {
+        std::rethrow_exception(job->error);
+    }
+}
+
+/**
+ * @brief Check whether a job has finished.
+ *
+ * @param job Job to check
+ * @return true if the job's function has run
+ */
+bool JobSystem::isFinished(const JobHandle &job)
+{
+    return job->finished.load(std::memory_order_acquire);
+}
+
+/**
+ * @brief Execute one ready job on the calling thread, if any.
+ *
+ * @return true if a job was executed
+ */
+bool JobSystem::runPendingJob()
+{
+    JobHandle job = pop();
+    if (!job)
+        return false;
+
+    execute(job);
+    return true;
+}
+
+/**
+ * @brief Compute the chunk size used to split a range.
+ *
+ * Deterministic mode ignores the thread count so the same range always
+ * produces the same chunks. Otherwise ranges are split into roughly four
+ * chunks per thread, but never below the grain size.
+ *
+ * @param count Number of elements in the range
+ * @param grainSize Requested minimum chunk size (0 for automatic)
+ * @return Elements per chunk
+ */
+std::size_t JobSystem::chunkSize(std::size_t count, std::size_t grainSize) const
+{
+    if (deterministic_)
+    {
+        return grainSize > 0 ? grainSize : DefaultDeterministicGrain;
+    }
+
+    if (!isRunning())
+    {
+        return std::max<std::size_t>(count, 1);
+    }
+
+    const std::size_t threads = workers_.size() + 1;
+    const std::size_t target = (count + threads * 4 - 1) / (threads * 4);
+    return std::max<std::size_t>(std::max<std::size_t>(grainSize, 1), target);
+}
+
+/**
+ * @brief Get the job system installed for code without an explicit reference.
+ *
+ * @return The current job system, or nullptr if none is installed
+ */
+JobSystem *JobSystem::current()
+{
+    return currentJobSystem.load(std::memory_order_acquire);
+}
+
+/**
+ * @brief Install the job system returned by current().
+ *
+ * @param jobSystem Job system to install, or nullptr to clear
+ */
+void JobSystem::setCurrent(JobSystem *jobSystem)
+{
+    currentJobSystem.store(jobSystem, std::memory_order_release);
+}
+
+/**
+ * @brief Run body(0) .. body(chunkCount - 1), spreading chunks over all threads.
+ *
+ * Chunk 0 runs on the calling thread, which then helps with the rest until
+ * every chunk has finished. Without workers the chunks run inline in order.
+ *
+ * @param chunkCount Number of chunks
+ * @param body Callable invoked once per chunk index
+ */
+void JobSystem::forEachChunk(std::size_t chunkCount, const std::function<void(std::size_t)> &body)
+{
+    if (chunkCount == 1 || !isRunning())
+    {
+        for (std::size_t index = 0; index < chunkCount; ++index)
+        {
+            body(index);
+        }
+        return;
+    }
+
+    std::atomic<std::size_t> remaining(chunkCount - 1);
+    std::mutex errorMutex;
+    std::exception_ptr error;
+
+    auto runChunk = [&](std::size_t index)
+    {
+        try
+        {
+            body(index);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!error)
+                error = std::current_exception();
+        }
+    };
+
+    for (std::size_t index = 1; index < chunkCount; ++index)
+    {
+        JobHandle job = create([&runChunk, &remaining, index]
+                               {
+            runChunk(index);
+            remaining.fetch_sub(1, std::memory_order_acq_rel); });
+        job->pendingCount.store(0, std::memory_order_relaxed);
+        push(std::move(job));
+    }
+
+    runChunk(0);
+
+    while (remaining.load(std::memory_order_acquire) > 0)
+    {
+        if (!runPendingJob())
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+}
+
+/**
+ * @brief Queue a ready job on the calling thread's deque and wake a worker.
+ *
+ * Without workers the job is executed immediately instead.
+ *
+ * @param job Ready job
+ */
+void JobSystem::push(JobHandle job)
+{
+    if (!isRunning())
+    {
+        execute(job);
+        return;
+    }
+
+    WorkQueue &queue = *queues_[workerOwner == this ? workerQueueIndex : 0];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back(std::move(job));
+    }
+    queuedJobs_.fetch_add(1, std::memory_order_release);
+
+    {
+        // Taking the lock orders this push before a worker's predicate check
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+    }
+    wake_.notify_one();
+}
+
+/**
+ * @brief Take a ready job: newest from the own deque, otherwise steal the oldest from another.
+ *
+ * @return The job, or nullptr if every queue is empty
+ */
+JobSystem::JobHandle JobSystem::pop()
+{
+    if (queuedJobs_.load(std::memory_order_acquire) == 0)
+        return nullptr;
+
+    const std::size_t queueCount = queues_.size();
+    const std::size_t own = workerOwner == this ? workerQueueIndex : 0;
+
+    {
+        WorkQueue &queue = *queues_[own];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.jobs.empty())
+        {
+            JobHandle job = std::move(queue.jobs.back());
+            queue.jobs.pop_back();
+            queuedJobs_.fetch_sub(1, std::memory_order_acq_rel);
+            return job;
+        }
+    }
+
+    for (std::size_t offset = 1; offset < queueCount; ++offset)
+    {
+        WorkQueue &victim = *queues_[(own + offset) % queueCount];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.empty())
+        {
+            JobHandle job = std::move(victim.jobs.front());
+            victim.jobs.pop_front();
+            queuedJobs_.fetch_sub(1, std::memory_order_acq_rel);
+            return job;
+        }
+    }
+
+    return nullptr;
+}
+
+/**
+ * @brief Run a job and release its continuations.
+ *
+ * @param job Ready job
+ */
+void JobSystem::execute(const JobHandle &job)
+{
+    try
+    {
+        job->function();
+    }
+    catch (...)
+    {
+        job->error = std::current_exception();
+    }
+    job->function = nullptr;
+
+    std::vector<JobHandle> continuations;
+    {
+        std::lock_guard<std::mutex> lock(job->mutex);
+        job->finished.store(true, std::memory_order_release);
+        continuations.swap(job->continuations);
+    }
+
+    for (JobHandle &continuation : continuations)
+    {
+        if (continuation->pendingCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            push(std::move(continuation));
+        }
+    }
+}
+
+/**
+ * @brief Worker thread body: run or steal jobs, sleeping while there are none.
+ *
+ * @param index Queue index owned by this worker
+ */
+void JobSystem::workerLoop(unsigned int index)
+{
+    workerOwner = this;
+    workerQueueIndex = index;
+    Profiler::instance().setThreadName("Job worker " + std::to_string(index));
+
+    while (true)
+    {
+        if (runPendingJob())
+            continue;
+
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        wake_.wait(lock, [this]
+                   { return stopping_.load() || queuedJobs_.load() > 0; });
+        if (stopping_.load() && queuedJobs_.load() == 0)
+            break;
+    }
+
+    workerOwner = nullptr;
+}
@@ -0,0 +1,305 @@
+#ifndef JOBSYSTEM_H
+#define JOBSYSTEM_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Work-stealing task scheduler.
+ *
+ * Each worker thread owns a deque of ready jobs: it pushes and pops at the
+ * back (most recent first, for cache locality) and idle workers steal from
+ * the front of other deques. Threads that are not workers (e.g. the main
+ * thread) share one extra deque and help execute jobs while they wait.
+ *
+ * Jobs may depend on other jobs; a job becomes ready once every job it
+ * depends on has finished, which also makes it a continuation of those jobs.
+ *
+ * In deterministic mode parallelFor and parallelReduce split ranges into
+ * chunks whose size depends only on the range and grain size (not on the
+ * number of threads), and parallelReduce always combines chunk results in
+ * ascending chunk order, so results are bit-identical across runs and
+ * machines.
+ *
+ * Until start() is called (or after stop()) every job runs inline on the
+ * thread that submits or waits for it.
+ */
+class JobSystem
+{
+public:
+    /** @brief Work executed by a job */
+    using JobFunction = std::function<void()>;
+
+    /** @brief Internal job record (opaque to callers) */
+    struct Job;
+
+    /** @brief Shared reference to a job, used to submit, chain and wait on it */
+    using JobHandle = std::shared_ptr<Job>;
+
+    /** @brief Chunk size used by deterministic mode when no grain size is given */
+    static constexpr std::size_t DefaultDeterministicGrain = 256;
+
+    /**
+     * @brief Construct a job system with no worker threads.
+     */
+    JobSystem();
+
+    /**
+     * @brief Stop and join all worker threads.
+     */
+    ~JobSystem();
+
+    JobSystem(const JobSystem &) = delete;
+    JobSystem &operator=(const JobSystem &) = delete;
+
+    /**
+     * @brief Start the worker threads.
+     *
+     * @param workerCount Number of workers, or -1 for hardware concurrency minus one
+     */
+    void start(int workerCount = -1);
+
+    /**
+     * @brief Finish queued jobs and join the worker threads.
+     */
+    void stop();
+
+    /**
+     * @brief Check whether worker threads are running.
+     *
+     * @return true if jobs are executed on worker threads
+     */
+    bool isRunning() const { return !workers_.empty(); }
+
+    /**
+     * @brief Get the number of worker threads.
+     *
+     * @return Worker thread count (0 when not started)
+     */
+    unsigned int getWorkerCount() const { return static_cast<unsigned int>(workers_.size()); }
+
+    /**
+     * @brief Enable or disable deterministic chunking and reduction.
+     *
+     * @param deterministic true for fixed chunk sizes and reduction order
+     */
+    void setDeterministic(bool deterministic) { deterministic_ = deterministic; }
+
+    /**
+     * @brief Check whether deterministic mode is enabled.
+     *
+     * @return true if chunking and reduction order are fixed
+     */
+    bool isDeterministic() const { return deterministic_; }
+
+    /**
+     * @brief Create a job without scheduling it.
+     *
+     * Add dependencies with addDependency(), then call submit().
+     *
+     * @param function Work to execute
+     * @return Handle to the new job
+     */
+    JobHandle create(JobFunction function);
+
+    /**
+     * @brief Make a job wait for another job to finish.
+     *
+     * Must be called before the dependent job is submitted.
+     *
+     * @param job Job that must wait
+     * @param prerequisite Job that must finish first
+     */
+    void addDependency(const JobHandle &job, const JobHandle &prerequisite);
+
+    /**
+     * @brief Submit a created job; it runs once all its dependencies have finished.
+     *
+     * @param job Job returned by create()
+     */
+    void submit(const JobHandle &job);
+
+    /**
+     * @brief Create and submit a job with no dependencies.
+     *
+     * @param function Work to execute
+     * @return Handle to the scheduled job
+     */
+    JobHandle schedule(JobFunction function);
+
+    /**
+     * @brief Schedule a continuation that runs after another job finishes.
+     *
+     * @param prerequisite Job to follow
+     * @param function Work to execute afterwards
+     * @return Handle to the continuation job
+     */
+    JobHandle then(const JobHandle &prerequisite, JobFunction function);
+
+    /**
+     * @brief Wait for a job, executing other jobs meanwhile.
+     *
+     * @param job Job to wait for
+     * @throws Any exception thrown by the job's function
+     */
+    void wait(const JobHandle &job);
+
+    /**
+     * @brief Check whether a job has finished.
+     *
+     * @param job Job to check
+     * @return true if the job's function has run
+     */
+    static bool isFinished(const JobHandle &job);
+
+    /**
+     * @brief Execute one ready job on the calling thread, if any.
+     *
+     * Lets threads that are waiting on something else help with queued work.
+     *
+     * @return true if a job was executed
+     */
+    bool runPendingJob();
+
+    /**
+     * @brief Compute the chunk size used to split a range.
+     *
+     * @param count Number of elements in the range
+     * @param grainSize Requested minimum chunk size (0 for automatic)
+     * @return Elements per chunk
+     */
+    std::size_t chunkSize(std::size_t count, std::size_t grainSize) const;
+
+    /**
+     * @brief Run func over [begin, end) split into chunks across all threads.
+     *
+     * The calling thread executes chunks too and returns once every chunk has
+     * finished. func must only write to data owned by its own sub-range.
+     *
+     * @param begin First index
+     * @param end One past the last index
+     * @param grainSize Minimum elements per chunk (0 for automatic)
+     * @param func Callable taking (std::size_t first, std::size_t last)
+     * @throws The first exception thrown by any chunk
+     */
+    template <typename Func>
+    void parallelFor(std::size_t begin, std::size_t end, std::size_t grainSize, Func &&func)
+    {
+        if (end <= begin)
+            return;
+
+        const std::size_t chunk = chunkSize(end - begin, grainSize);
+        const std::size_t chunkCount = (end - begin + chunk - 1) / chunk;
+        forEachChunk(chunkCount, [&](std::size_t index)
+                     {
+            const std::size_t first = begin + index * chunk;
+            func(first, std::min(end, first + chunk)); });
+    }
+
+    /**
+     * @brief Map chunks of [begin, end) to values and fold them in chunk order.
+     *
+     * @param begin First index
+     * @param end One past the last index
+     * @param grainSize Minimum elements per chunk (0 for automatic)
+     * @param identity Initial value of the fold
+     * @param map Callable taking (std::size_t first, std::size_t last) and returning T
+     * @param reduce Callable taking (T accumulated, T chunkResult) and returning T
+     * @return identity folded with every chunk result in ascending chunk order
+     * @throws The first exception thrown by any chunk
+     */
+    template <typename T, typename Map, typename Reduce>
+    T parallelReduce(std::size_t begin, std::size_t end, std::size_t grainSize, T identity, Map &&map, Reduce &&reduce)
+    {
+        if (end <= begin)
+            return identity;
+
+        const std::size_t chunk = chunkSize(end - begin, grainSize);
+        const std::size_t chunkCount = (end - begin + chunk - 1) / chunk;
+        std::vector<T> partials(chunkCount, identity);
+        forEachChunk(chunkCount, [&](std::size_t index)
+                     {
+            const std::size_t first = begin + index * chunk;
+            partials[index] = map(first, std::min(end, first + chunk)); });
+
+        T result = identity;
+        for (const T &partial : partials)
+        {
+            result = reduce(result, partial);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Get the job system installed for code without an explicit reference.
+     *
+     * @return The current job system, or nullptr if none is installed
+     */
+    static JobSystem *current();
+
+    /**
+     * @brief Install the job system returned by current().
+     *
+     * @param jobSystem Job system to install, or nullptr to clear
+     */
+    static void setCurrent(JobSystem *jobSystem);
+
+private:
+    /**
+     * @brief Deque of ready jobs owned by one thread.
+     */
+    struct WorkQueue
+    {
+        std::mutex mutex;            /**< Guards jobs */
+        std::deque<JobHandle> jobs;  /**< Owner uses the back, thieves the front */
+    };
+
+    void forEachChunk(std::size_t chunkCount, const std::function<void(std::size_t)> &body);
+    void push(JobHandle job);
+    JobHandle pop();
+    void execute(const JobHandle &job);
+    void workerLoop(unsigned int index);
+
+    std::vector<std::unique_ptr<WorkQueue>> queues_; /**< Index 0 shared by non-worker threads, then one per worker */
+    std::vector<std::thread> workers_;               /**< Worker threads */
+    std::atomic<std::size_t> queuedJobs_;            /**< Jobs sitting in any queue */
+    std::atomic<bool> stopping_;                     /**< Set when workers should exit */
+    std::mutex sleepMutex_;                          /**< Paired with wake_ */
+    std::condition_variable wake_;                   /**< Wakes idle workers when work is queued */
+    bool deterministic_ = false;                     /**< Fixed chunking and reduction order */
+};
+
+/**
+ * @brief Run func over [begin, end) on the current job system, or inline if none is installed.
+ *
+ * Convenience for code (such as static generators) that has no JobSystem
+ * reference of its own.
+ *
+ * @param begin First index
+ * @param end One past the last index
+ * @param grainSize Minimum elements per chunk (0 for automatic)
+ * @param func Callable taking (std::size_t first, std::size_t last)
+ */
+template <typename Func>
+void parallelFor(std::size_t begin, std::size_t end, std::size_t grainSize, Func &&func)
+{
+    if (JobSystem *jobSystem = JobSystem::current())
+    {
+        jobSystem->parallelFor(begin, end, grainSize, std::forward<Func>(func));
+    }
+    else if (begin < end)
+    {
+        func(begin, end);
+    }
+}
+
+#endif
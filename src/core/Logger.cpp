@@ -0,0 +1,509 @@
+#include "Logger.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+std::atomic<int> Logger::runtimeLevel_{FPV_LOG_LEVEL};
+
+namespace
+{
+    /** How long the flush thread sleeps between drains when nobody wakes it */
+    constexpr std::chrono::milliseconds FlushInterval(5);
+
+    /**
+     * @brief Find the first occurrence of a character outside template brackets.
+     *
+     * @param text Text to search
+     * @param target Character to find
+     * @param from First position to examine
+     * @return Position of the character, or std::string::npos
+     */
+    std::size_t findAtTopLevel(const std::string &text, char target, std::size_t from = 0)
+    {
+        int depth = 0;
+        for (std::size_t i = from; i < text.size(); ++i)
+        {
+            const char c = text[i];
+            if (c == target && depth == 0)
+                return i;
+            if (c == '<')
+                ++depth;
+            else if (c == '>' && depth > 0)
+                --depth;
+        }
+        return std::string::npos;
+    }
+
+    /**
+     * @brief Find the last "::" outside template brackets.
+     *
+     * @param text Qualified name
+     * @return Position of the separator, or std::string::npos
+     */
+    std::size_t findLastScope(const std::string &text)
+    {
+        int depth = 0;
+        std::size_t last = std::string::npos;
+        for (std::size_t i = 0; i + 1 < text.size(); ++i)
+        {
+            const char c = text[i];
+            if (c == '<')
+                ++depth;
+            else if (c == '>' && depth > 0)
+                --depth;
+            else if (c == ':' && text[i + 1] == ':' && depth == 0)
+                last = i++;
+        }
+        return last;
+    }
+
+    /**
+     * @brief Format wall-clock milliseconds as HH:MM:SS.mmm local time.
+     *
+     * Only called with the output mutex held, so std::localtime is safe.
+     *
+     * @param timestampMs Milliseconds since the epoch
+     * @return Formatted time
+     */
+    std::string formatTimestamp(std::int64_t timestampMs)
+    {
+        const std::time_t seconds = static_cast<std::time_t>(timestampMs / 1000);
+        std::ostringstream ss;
+        ss << std::put_time(std::localtime(&seconds), "%H:%M:%S") << '.'
+           << std::setfill('0') << std::setw(3) << (timestampMs % 1000);
+        return ss.str();
+    }
+
+    /**
+     * @brief Read the wall clock in milliseconds.
+     *
+     * @return Milliseconds since the epoch
+     */
+    std::int64_t wallClockMs()
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+                   std::chrono::system_clock::now().time_since_epoch())
+            .count();
+    }
+}
+
+/**
+ * @brief Resolve the class and method of a function signature.
+ *
+ * Drops the parameter list and return type, then splits the qualified name
+ * at its last scope separator. Only the innermost enclosing scope is kept as
+ * the class, without template arguments, so it maps to one short file name.
+ *
+ * @param function __PRETTY_FUNCTION__ (GCC/Clang) or __FUNCTION__ (MSVC)
+ */
+LogSite::LogSite(const char *function)
+{
+    std::string name = function != nullptr ? function : "";
+
+    const std::size_t paren = findAtTopLevel(name, '(');
+    if (paren != std::string::npos)
+        name.erase(paren);
+
+    std::size_t space = std::string::npos;
+    for (std::size_t pos = findAtTopLevel(name, ' '); pos != std::string::npos; pos = findAtTopLevel(name, ' ', pos + 1))
+        space = pos;
+    if (space != std::string::npos)
+        name.erase(0, space + 1);
+
+    const std::size_t scope = findLastScope(name);
+    if (scope == std::string::npos)
+    {
+        className = "global";
+        methodName = name;
+        return;
+    }
+
+    methodName = name.substr(scope + 2);
+    className = name.substr(0, scope);
+    const std::size_t outer = findLastScope(className);
+    if (outer != std::string::npos)
+        className.erase(0, outer + 2);
+
+    // Template arguments are not valid in file names
+    const std::size_t bracket = className.find('<');
+    if (bracket != std::string::npos && bracket > 0)
+        className.erase(bracket);
+}
+
+/**
+ * @brief Construct an empty scratch buffer.
+ */
+Logger::ScratchBuffer::ScratchBuffer()
+{
+    reset();
+}
+
+/**
+ * @brief Discard the buffered message.
+ */
+void Logger::ScratchBuffer::reset()
+{
+    setp(buffer_, buffer_ + MaxMessageSize);
+}
+
+/**
+ * @brief Drop output past the end of the buffer.
+ *
+ * @param ch Character that did not fit
+ * @return ch, so the stream does not enter a failed state
+ */
+Logger::ScratchBuffer::int_type Logger::ScratchBuffer::overflow(int_type ch)
+{
+    return traits_type::not_eof(ch);
+}
+
+/**
+ * @brief Construct the state of a thread that has not logged yet.
+ */
+Logger::ThreadState::ThreadState() : stream(&scratch)
+{
+}
+
+/**
+ * @brief Hand the thread's ring to the flush thread for disposal.
+ */
+Logger::ThreadState::~ThreadState()
+{
+    if (ring)
+        ring->abandoned.store(true, std::memory_order_release);
+}
+
+/**
+ * @brief Get the process-wide logger, starting its flush thread on first use.
+ *
+ * The logger is never destroyed, so statements in static destructors stay
+ * valid; shutdown() runs at exit instead.
+ *
+ * @return The logger instance
+ */
+Logger &Logger::instance()
+{
+    static Logger *logger = []
+    {
+        Logger *created = new Logger();
+        std::atexit([]
+                    { Logger::instance().shutdown(); });
+        return created;
+    }();
+    return *logger;
+}
+
+/**
+ * @brief Construct the logger and start the flush thread.
+ */
+Logger::Logger()
+{
+    const std::time_t now = std::time(nullptr);
+    std::ostringstream directory;
+    directory << std::put_time(std::localtime(&now), "%M%H-%Y-%m-%d");
+    logDirectory_ = (std::filesystem::path("log") / directory.str()).string();
+
+    running_.store(true);
+    flushThread_ = std::thread(&Logger::flushLoop, this);
+}
+
+/**
+ * @brief Set the lowest level that is kept at runtime.
+ *
+ * Levels compiled out by FPV_LOG_LEVEL stay out regardless.
+ *
+ * @param level Minimum level
+ */
+void Logger::setLevel(LogLevel level)
+{
+    runtimeLevel_.store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+/**
+ * @brief Enable or disable echoing log lines to standard output.
+ *
+ * @param enabled true to echo (default)
+ */
+void Logger::setConsoleEcho(bool enabled)
+{
+    consoleEcho_.store(enabled, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Get the calling thread's scratch stream and clear it.
+ *
+ * @return Stream the message is formatted into
+ */
+std::ostream &Logger::beginRecord()
+{
+    ThreadState &state = threadState();
+    state.scratch.reset();
+    state.stream.clear();
+    return state.stream;
+}
+
+/**
+ * @brief Push the message formatted since beginRecord() to the calling thread's ring.
+ *
+ * Splits the message over as many records as it needs. After shutdown()
+ * the message is written synchronously instead.
+ *
+ * @param site Call site of the statement
+ * @param level Severity
+ */
+void Logger::commitRecord(const LogSite &site, LogLevel level)
+{
+    ThreadState &state = threadState();
+    const char *text = state.scratch.data();
+    std::size_t remaining = state.scratch.size();
+    const std::int64_t timestampMs = wallClockMs();
+
+    if (!running_.load(std::memory_order_acquire))
+    {
+        const std::string message(text, remaining);
+        state.scratch.reset();
+        std::lock_guard<std::mutex> lock(outputMutex_);
+        writeLine(site, timestampMs, message);
+        std::cout.flush();
+        for (auto &file : classFiles_)
+            file.second.flush();
+        return;
+    }
+
+    if (!state.ring)
+        state.ring = registerRing();
+
+    Record record;
+    record.site = &site;
+    record.timestampMs = timestampMs;
+    record.level = level;
+    do
+    {
+        const std::size_t length = std::min(remaining, RecordTextSize);
+        std::memcpy(record.text, text, length);
+        record.length = static_cast<std::uint16_t>(length);
+        text += length;
+        remaining -= length;
+        record.continued = remaining > 0;
+        pushRecord(*state.ring, record);
+    } while (remaining > 0);
+
+    state.scratch.reset();
+}
+
+/**
+ * @brief Block until every record pushed before the call has been written.
+ */
+void Logger::flush()
+{
+    const std::uint64_t target = pushed_.load(std::memory_order_acquire);
+    std::unique_lock<std::mutex> lock(wakeMutex_);
+    wake_.notify_one();
+    drained_.wait(lock, [this, target]
+                  { return written_.load(std::memory_order_acquire) >= target || !running_.load(); });
+}
+
+/**
+ * @brief Stop the flush thread after writing everything pending.
+ */
+void Logger::shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+        if (!running_.load())
+            return;
+        running_.store(false, std::memory_order_release);
+    }
+    wake_.notify_one();
+    if (flushThread_.joinable())
+        flushThread_.join();
+
+    // Records pushed while the thread was stopping
+    drain();
+    drained_.notify_all();
+}
+
+/**
+ * @brief Get the calling thread's logging state.
+ *
+ * @return Thread-local state
+ */
+Logger::ThreadState &Logger::threadState()
+{
+    thread_local ThreadState state;
+    return state;
+}
+
+/**
+ * @brief Create a ring for the calling thread and hand it to the flush thread.
+ *
+ * @return The new ring
+ */
+std::shared_ptr<Logger::ThreadRing> Logger::registerRing()
+{
+    auto ring = std::make_shared<ThreadRing>();
+    ring->records.reset(new Record[RecordsPerThread]);
+
+    std::lock_guard<std::mutex> lock(ringsMutex_);
+    rings_.push_back(ring);
+    return ring;
+}
+
+/**
+ * @brief Append one record to a ring, waiting for the flush thread if it is full.
+ *
+ * @param ring Calling thread's ring
+ * @param record Record to copy in
+ */
+void Logger::pushRecord(ThreadRing &ring, const Record &record)
+{
+    const std::uint64_t head = ring.head.load(std::memory_order_relaxed);
+    if (head - ring.tail.load(std::memory_order_acquire) >= RecordsPerThread)
+    {
+        stalls_.fetch_add(1, std::memory_order_relaxed);
+        wake_.notify_one();
+        while (head - ring.tail.load(std::memory_order_acquire) >= RecordsPerThread)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    ring.records[head % RecordsPerThread] = record;
+    ring.head.store(head + 1, std::memory_order_release);
+    pushed_.fetch_add(1, std::memory_order_release);
+}
+
+/**
+ * @brief Flush thread body: drain all rings, then sleep until woken or the interval passes.
+ */
+void Logger::flushLoop()
+{
+    while (true)
+    {
+        const bool stopping = !running_.load(std::memory_order_acquire);
+        drain();
+        drained_.notify_all();
+        if (stopping)
+            break;
+
+        std::unique_lock<std::mutex> lock(wakeMutex_);
+        wake_.wait_for(lock, FlushInterval);
+    }
+}
+
+/**
+ * @brief Write every record currently in the rings and flush the outputs once.
+ *
+ * Rings of exited threads are released once they are empty.
+ *
+ * @return true if anything was written
+ */
+bool Logger::drain()
+{
+    std::vector<std::shared_ptr<ThreadRing>> rings;
+    {
+        std::lock_guard<std::mutex> lock(ringsMutex_);
+        rings_.erase(std::remove_if(rings_.begin(), rings_.end(), [](const std::shared_ptr<ThreadRing> &ring)
+                                    { return ring->abandoned.load(std::memory_order_acquire) &&
+                                             ring->tail.load(std::memory_order_relaxed) == ring->head.load(std::memory_order_acquire); }),
+                     rings_.end());
+        rings = rings_;
+    }
+
+    std::lock_guard<std::mutex> lock(outputMutex_);
+    std::uint64_t count = 0;
+    for (const auto &ring : rings)
+    {
+        const std::uint64_t head = ring->head.load(std::memory_order_acquire);
+        std::uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+        for (; tail < head; ++tail)
+        {
+            writeRecord(*ring, ring->records[tail % RecordsPerThread]);
+            ++count;
+        }
+        ring->tail.store(tail, std::memory_order_release);
+    }
+
+    if (count == 0)
+        return false;
+
+    std::cout.flush();
+    for (auto &file : classFiles_)
+        file.second.flush();
+    written_.fetch_add(count, std::memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Write one record, joining continued records into a single line.
+ *
+ * @param ring Ring the record came from
+ * @param record Record to write
+ */
+void Logger::writeRecord(ThreadRing &ring, const Record &record)
+{
+    ring.pending.append(record.text, record.length);
+    if (record.continued)
+        return;
+
+    writeLine(*record.site, record.timestampMs, ring.pending);
+    ring.pending.clear();
+}
+
+/**
+ * @brief Format a line and write it to standard output and the class file.
+ *
+ * Called with the output mutex held.
+ *
+ * @param site Call site of the statement
+ * @param timestampMs Time the statement ran
+ * @param message Message text
+ */
+void Logger::writeLine(const LogSite &site, std::int64_t timestampMs, const std::string &message)
+{
+    std::string line;
+    line.reserve(message.size() + site.className.size() + site.methodName.size() + 24);
+    line += '[';
+    line += formatTimestamp(timestampMs);
+    line += "] [";
+    line += site.className;
+    line += "::";
+    line += site.methodName;
+    line += "]: ";
+    line += message;
+    line += '\n';
+
+    if (consoleEcho_.load(std::memory_order_relaxed))
+        std::cout << line;
+
+    std::ofstream &file = getClassFile(site.className);
+    if (file.is_open())
+        file << line;
+}
+
+/**
+ * @brief Get the log file of a class, opening it on first use.
+ *
+ * Called with the output mutex held.
+ *
+ * @param className Class name (file is log/<mmhh-date>/<className>.log)
+ * @return The file stream (not open if the file could not be created)
+ */
+std::ofstream &Logger::getClassFile(const std::string &className)
+{
+    auto it = classFiles_.find(className);
+    if (it != classFiles_.end())
+        return it->second;
+
+    std::error_code error;
+    std::filesystem::create_directories(logDirectory_, error);
+    std::ofstream &file = classFiles_[className];
+    file.open((std::filesystem::path(logDirectory_) / (className + ".log")).string(), std::ios::app);
+    return file;
+}
@@ -0,0 +1,301 @@
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Severity of a log record.
+ */
+enum class LogLevel : std::uint8_t
+{
+    Trace = 0,
+    Debug = 1,
+    Info = 2,
+    Warning = 3,
+    Error = 4
+};
+
+/**
+ * @brief Call site of a log statement, resolved once per site.
+ *
+ * The logging macros keep one static LogSite per statement, so the class
+ * and method name are parsed from the compiler's function signature the
+ * first time the statement runs instead of on every message. Sites are
+ * allocated once and never freed, so records still queued when static
+ * destructors run can be written out by the final drain.
+ */
+struct LogSite
+{
+    /**
+     * @brief Resolve the class and method of a function signature.
+     *
+     * @param function __PRETTY_FUNCTION__ (GCC/Clang) or __FUNCTION__ (MSVC)
+     */
+    explicit LogSite(const char *function);
+
+    std::string className;  /**< Class the statement is in, or "global" */
+    std::string methodName; /**< Function the statement is in */
+};
+
+/**
+ * @brief Asynchronous logger with per-thread lock-free buffers.
+ *
+ * A log statement formats its message into a thread-local scratch buffer
+ * and copies it into a fixed-size record in the calling thread's ring. The
+ * ring has one producer (the owning thread) and one consumer (the flush
+ * thread), so pushing is two atomic operations and never takes a lock.
+ *
+ * A background thread drains every ring a few hundred times a second,
+ * echoes each line to standard output and appends it to
+ * log/<mmhh-date>/<Class>.log. Each class file is opened once and flushed
+ * once per drain instead of once per message.
+ *
+ * Levels below FPV_LOG_LEVEL are compiled out, message expression
+ * included. Levels below the runtime level (setLevel()) cost one relaxed
+ * atomic load.
+ */
+class Logger
+{
+public:
+    /** Bytes of message text carried by one ring record */
+    static constexpr std::size_t RecordTextSize = 200;
+    /** Records per thread ring */
+    static constexpr std::size_t RecordsPerThread = 1024;
+    /** Longest message kept; longer messages are truncated */
+    static constexpr std::size_t MaxMessageSize = 4096;
+
+    /**
+     * @brief Get the process-wide logger, starting its flush thread on first use.
+     *
+     * @return The logger instance
+     */
+    static Logger &instance();
+
+    /**
+     * @brief Check whether records of a level are currently kept.
+     *
+     * @param level Level to test
+     * @return true if the level is at or above the runtime level
+     */
+    static bool isEnabled(LogLevel level)
+    {
+        return static_cast<int>(level) >= runtimeLevel_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Set the lowest level that is kept at runtime.
+     *
+     * @param level Minimum level
+     */
+    static void setLevel(LogLevel level);
+
+    /**
+     * @brief Enable or disable echoing log lines to standard output.
+     *
+     * @param enabled true to echo (default)
+     */
+    void setConsoleEcho(bool enabled);
+
+    /**
+     * @brief Get the calling thread's scratch stream and clear it.
+     *
+     * @return Stream the message is formatted into
+     */
+    std::ostream &beginRecord();
+
+    /**
+     * @brief Push the message formatted since beginRecord() to the calling thread's ring.
+     *
+     * @param site Call site of the statement
+     * @param level Severity
+     */
+    void commitRecord(const LogSite &site, LogLevel level);
+
+    /**
+     * @brief Block until every record pushed before the call has been written.
+     */
+    void flush();
+
+    /**
+     * @brief Stop the flush thread after writing everything pending.
+     *
+     * Records logged afterwards are written synchronously. Registered with
+     * std::atexit when the logger starts.
+     */
+    void shutdown();
+
+    /**
+     * @brief Get the number of times a producer waited for a full ring.
+     *
+     * @return Stalls since startup
+     */
+    std::uint64_t getStallCount() const { return stalls_.load(std::memory_order_relaxed); }
+
+private:
+    /**
+     * @brief One fixed-size piece of a message.
+     *
+     * Messages longer than RecordTextSize span consecutive records; all but
+     * the last have continued set.
+     */
+    struct Record
+    {
+        const LogSite *site = nullptr;    /**< Call site */
+        std::int64_t timestampMs = 0;     /**< Wall-clock time in milliseconds since the epoch */
+        LogLevel level = LogLevel::Debug; /**< Severity */
+        bool continued = false;           /**< Message continues in the next record */
+        std::uint16_t length = 0;         /**< Bytes used in text */
+        char text[RecordTextSize];        /**< Message bytes (not terminated) */
+    };
+
+    /**
+     * @brief Single-producer, single-consumer record ring of one thread.
+     */
+    struct ThreadRing
+    {
+        std::unique_ptr<Record[]> records;                   /**< RecordsPerThread records */
+        alignas(64) std::atomic<std::uint64_t> head{0};      /**< Next record written by the owner */
+        alignas(64) std::atomic<std::uint64_t> tail{0};      /**< Next record read by the flush thread */
+        std::atomic<bool> abandoned{false};                  /**< Owner thread has exited */
+        std::string pending;                                 /**< Flush thread only: message assembled from continued records */
+    };
+
+    /**
+     * @brief Stream buffer over a fixed character array; excess output is dropped.
+     */
+    class ScratchBuffer : public std::streambuf
+    {
+    public:
+        ScratchBuffer();
+        void reset();
+        const char *data() const { return pbase(); }
+        std::size_t size() const { return static_cast<std::size_t>(pptr() - pbase()); }
+
+    protected:
+        int_type overflow(int_type ch) override;
+
+    private:
+        char buffer_[MaxMessageSize];
+    };
+
+    /**
+     * @brief Per-thread logging state.
+     */
+    struct ThreadState
+    {
+        ThreadState();
+        ~ThreadState();
+
+        ScratchBuffer scratch;              /**< Message being formatted */
+        std::ostream stream;                /**< Stream over scratch */
+        std::shared_ptr<ThreadRing> ring;   /**< Ring shared with the logger */
+    };
+
+    Logger();
+    ~Logger() = delete;
+
+    Logger(const Logger &) = delete;
+    Logger &operator=(const Logger &) = delete;
+
+    static ThreadState &threadState();
+    std::shared_ptr<ThreadRing> registerRing();
+    void pushRecord(ThreadRing &ring, const Record &record);
+    void flushLoop();
+    bool drain();
+    void writeRecord(ThreadRing &ring, const Record &record);
+    void writeLine(const LogSite &site, std::int64_t timestampMs, const std::string &message);
+    std::ofstream &getClassFile(const std::string &className);
+
+    static std::atomic<int> runtimeLevel_; /**< Minimum level kept at runtime */
+
+    std::atomic<bool> consoleEcho_{true};     /**< Echo lines to stdout */
+    std::atomic<bool> running_{false};        /**< Flush thread is running */
+    std::atomic<std::uint64_t> stalls_{0};    /**< Producer waits on full rings */
+    std::atomic<std::uint64_t> pushed_{0};    /**< Records pushed */
+    std::atomic<std::uint64_t> written_{0};   /**< Records written */
+
+    std::mutex ringsMutex_;                          /**< Guards rings_ */
+    std::vector<std::shared_ptr<ThreadRing>> rings_; /**< Rings of all threads that logged */
+
+    std::mutex wakeMutex_;                 /**< Guards flush thread sleeps */
+    std::condition_variable wake_;         /**< Wakes the flush thread early */
+    std::condition_variable drained_;      /**< Signals flush() callers */
+    std::thread flushThread_;              /**< Background writer */
+
+    std::mutex outputMutex_;                            /**< Serializes writers (flush thread or synchronous fallback) */
+    std::string logDirectory_;                          /**< log/<mmhh-date> */
+    std::map<std::string, std::ofstream> classFiles_;   /**< Open per-class files */
+};
+
+#ifndef FPV_LOG_LEVEL
+#ifdef DEBUG
+#define FPV_LOG_LEVEL 1
+#else
+#define FPV_LOG_LEVEL 2
+#endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define FPV_LOG_FUNCTION __PRETTY_FUNCTION__
+#else
+#define FPV_LOG_FUNCTION __FUNCTION__
+#endif
+
+/** Log a message (anything streamable, e.g. "a" << x) at a level */
+#define FPV_LOG(level, message)                                    \
+    do                                                             \
+    {                                                              \
+        if (Logger::isEnabled(level))                              \
+        {                                                          \
+            static const LogSite &fpvLogSite_ =                    \
+                *new LogSite(FPV_LOG_FUNCTION);                    \
+            Logger &fpvLogger_ = Logger::instance();               \
+            fpvLogger_.beginRecord() << message;                   \
+            fpvLogger_.commitRecord(fpvLogSite_, level);           \
+        }                                                          \
+    } while (0)
+
+#define FPV_LOG_DISABLED(message) \
+    do                            \
+    {                             \
+    } while (0)
+
+#if FPV_LOG_LEVEL <= 0
+#define LOG_TRACE(message) FPV_LOG(LogLevel::Trace, message)
+#else
+#define LOG_TRACE(message) FPV_LOG_DISABLED(message)
+#endif
+
+#if FPV_LOG_LEVEL <= 1
+#define LOG_DEBUG(message) FPV_LOG(LogLevel::Debug, message)
+#else
+#define LOG_DEBUG(message) FPV_LOG_DISABLED(message)
+#endif
+
+#if FPV_LOG_LEVEL <= 2
+#define LOG_INFO(message) FPV_LOG(LogLevel::Info, message)
+#else
+#define LOG_INFO(message) FPV_LOG_DISABLED(message)
+#endif
+
+#if FPV_LOG_LEVEL <= 3
+#define LOG_WARNING(message) FPV_LOG(LogLevel::Warning, message)
+#else
+#define LOG_WARNING(message) FPV_LOG_DISABLED(message)
+#endif
+
+#define LOG_ERROR(message) FPV_LOG(LogLevel::Error, message)
+
+#endif
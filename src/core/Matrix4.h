@@ -0,0 +1,138 @@
+#pragma once
+#include "Vector3D.h"
+#include "Quaternion.h"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define FPV_MATRIX4_SSE 1
+#endif
+
+/**
+ * @brief 4x4 affine transformation matrix.
+ *
+ * Row-major with row vectors, like Math::float4x4: a point transforms as
+ * p' = p * M, the translation sits in the last row, and a child's world
+ * matrix is local * parentWorld. With that layout each result row is a sum
+ * of scaled rows of the right-hand matrix, which maps directly onto four
+ * SSE multiply-adds per row.
+ */
+struct alignas(16) Matrix4
+{
+    float m[16]; /**< Elements in row-major order; m[12..14] is the translation */
+
+    /**
+     * @brief Construct an identity matrix.
+     */
+    Matrix4() : m{1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f} {}
+
+    /**
+     * @brief Create an identity matrix.
+     *
+     * @return Matrix4 The identity matrix
+     */
+    static Matrix4 identity() { return Matrix4(); }
+
+    /**
+     * @brief Build the matrix that scales, then rotates, then translates.
+     *
+     * The quaternion does not have to be normalized.
+     *
+     * @param position Translation
+     * @param rotation Rotation
+     * @param scale Per-axis scale
+     * @return Matrix4 The composed transformation
+     */
+    static Matrix4 fromTransform(const Vector3D &position, const Quaternion &rotation, const Vector3D &scale)
+    {
+        const float lengthSq = rotation.w * rotation.w + rotation.x * rotation.x + rotation.y * rotation.y + rotation.z * rotation.z;
+        const float s = lengthSq > 0.0f ? 2.0f / lengthSq : 0.0f;
+        const float xx = rotation.x * rotation.x * s, yy = rotation.y * rotation.y * s, zz = rotation.z * rotation.z * s;
+        const float xy = rotation.x * rotation.y * s, xz = rotation.x * rotation.z * s, yz = rotation.y * rotation.z * s;
+        const float wx = rotation.w * rotation.x * s, wy = rotation.w * rotation.y * s, wz = rotation.w * rotation.z * s;
+
+        Matrix4 result;
+        result.m[0] = (1.0f - yy - zz) * scale.x;
+        result.m[1] = (xy + wz) * scale.x;
+        result.m[2] = (xz - wy) * scale.x;
+        result.m[4] = (xy - wz) * scale.y;
+        result.m[5] = (1.0f - xx - zz) * scale.y;
+        result.m[6] = (yz + wx) * scale.y;
+        result.m[8] = (xz + wy) * scale.z;
+        result.m[9] = (yz - wx) * scale.z;
+        result.m[10] = (1.0f - xx - yy) * scale.z;
+        result.m[12] = position.x;
+        result.m[13] = position.y;
+        result.m[14] = position.z;
+        return result;
+    }
+
+    /**
+     * @brief Multiply two matrices: out = a * b.
+     *
+     * out must not alias a or b.
+     *
+     * @param a Left-hand matrix (applied first to row vectors)
+     * @param b Right-hand matrix
+     * @param out Receives the product
+     */
+    static void multiply(const Matrix4 &a, const Matrix4 &b, Matrix4 &out)
+    {
+#ifdef FPV_MATRIX4_SSE
+        const __m128 b0 = _mm_load_ps(b.m);
+        const __m128 b1 = _mm_load_ps(b.m + 4);
+        const __m128 b2 = _mm_load_ps(b.m + 8);
+        const __m128 b3 = _mm_load_ps(b.m + 12);
+        for (int row = 0; row < 4; ++row)
+        {
+            const float *r = a.m + row * 4;
+            __m128 sum = _mm_mul_ps(_mm_set1_ps(r[0]), b0);
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(r[1]), b1));
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(r[2]), b2));
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(r[3]), b3));
+            _mm_store_ps(out.m + row * 4, sum);
+        }
+#else
+        for (int row = 0; row < 4; ++row)
+        {
+            for (int column = 0; column < 4; ++column)
+            {
+                out.m[row * 4 + column] = a.m[row * 4] * b.m[column] + a.m[row * 4 + 1] * b.m[4 + column] +
+                                          a.m[row * 4 + 2] * b.m[8 + column] + a.m[row * 4 + 3] * b.m[12 + column];
+            }
+        }
+#endif
+    }
+
+    /**
+     * @brief Multiply two matrices.
+     *
+     * @param other Right-hand matrix
+     * @return Matrix4 this * other
+     */
+    Matrix4 operator*(const Matrix4 &other) const
+    {
+        Matrix4 result;
+        multiply(*this, other, result);
+        return result;
+    }
+
+    /**
+     * @brief Transform a point, including the translation.
+     *
+     * @param point Point to transform
+     * @return Vector3D The transformed point
+     */
+    Vector3D transformPoint(const Vector3D &point) const
+    {
+        return Vector3D(point.x * m[0] + point.y * m[4] + point.z * m[8] + m[12],
+                        point.x * m[1] + point.y * m[5] + point.z * m[9] + m[13],
+                        point.x * m[2] + point.y * m[6] + point.z * m[10] + m[14]);
+    }
+
+    /**
+     * @brief Get the translation part.
+     *
+     * @return Vector3D The origin of the transformed space
+     */
+    Vector3D getTranslation() const { return Vector3D(m[12], m[13], m[14]); }
+};
@@ -0,0 +1,477 @@
+#include "Metrics.h"
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <ostream>
+#include <sstream>
+
+namespace
+{
+    /**
+     * @brief Get the number of bits needed to represent a value.
+     *
+     * @param value Value (non-zero)
+     * @return Position of the highest set bit plus one
+     */
+    unsigned bitWidth(std::uint64_t value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return 64u - static_cast<unsigned>(__builtin_clzll(value));
+#else
+        unsigned bits = 0;
+        while (value != 0)
+        {
+            value >>= 1;
+            ++bits;
+        }
+        return bits;
+#endif
+    }
+
+    /**
+     * @brief Get the value a percentile falls on from bucket counts.
+     *
+     * @param counts Count per bucket
+     * @param total Sum of counts
+     * @param fraction Percentile as a fraction (0.5 for p50)
+     * @param maxNs Largest recorded value, used to clamp the top bucket
+     * @return Midpoint of the bucket holding the percentile, in nanoseconds
+     */
+    double percentile(const std::vector<std::uint64_t> &counts, std::uint64_t total, double fraction, std::uint64_t maxNs)
+    {
+        const std::uint64_t rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(fraction * total)));
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < counts.size(); ++i)
+        {
+            seen += counts[i];
+            if (seen >= rank)
+            {
+                const std::uint64_t lower = Histogram::bucketLowerBound(i);
+                const std::uint64_t upper = i + 1 < Histogram::BucketCount ? Histogram::bucketLowerBound(i + 1) - 1 : lower;
+                const double midpoint = lower + (upper - lower) / 2.0;
+                return std::min(midpoint, static_cast<double>(maxNs));
+            }
+        }
+        return static_cast<double>(maxNs);
+    }
+
+    /**
+     * @brief Get the display name of a metric kind.
+     *
+     * @param kind Metric kind
+     * @return Lower-case kind name
+     */
+    const char *kindName(MetricKind kind)
+    {
+        switch (kind)
+        {
+        case MetricKind::Counter:
+            return "counter";
+        case MetricKind::Gauge:
+            return "gauge";
+        default:
+            return "histogram";
+        }
+    }
+
+    /** Nanoseconds per millisecond, for reporting */
+    constexpr double NsPerMs = 1.0e6;
+}
+
+/**
+ * @brief Record one duration. Safe from any thread.
+ *
+ * @param valueNs Duration in nanoseconds (clamped below 2^MaxValueBits)
+ */
+void Histogram::record(std::uint64_t valueNs)
+{
+    const std::uint64_t limit = (std::uint64_t{1} << MaxValueBits) - 1;
+    const std::uint64_t value = std::min(valueNs, limit);
+
+    buckets_[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(value, std::memory_order_relaxed);
+
+    std::uint64_t previous = max_.load(std::memory_order_relaxed);
+    while (value > previous && !max_.compare_exchange_weak(previous, value, std::memory_order_relaxed))
+    {
+    }
+}
+
+/**
+ * @brief Summarize the values recorded so far.
+ *
+ * @return Count, mean, percentiles and maximum
+ */
+Histogram::Summary Histogram::summarize() const
+{
+    std::vector<std::uint64_t> counts(BucketCount);
+    std::uint64_t total = 0;
+    for (std::size_t i = 0; i < BucketCount; ++i)
+    {
+        counts[i] = buckets_[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+
+    Summary summary;
+    if (total == 0)
+        return summary;
+
+    const std::uint64_t maxNs = max_.load(std::memory_order_relaxed);
+    summary.count = total;
+    summary.meanNs = static_cast<double>(sum_.load(std::memory_order_relaxed)) / static_cast<double>(count_.load(std::memory_order_relaxed));
+    summary.p50Ns = percentile(counts, total, 0.50, maxNs);
+    summary.p90Ns = percentile(counts, total, 0.90, maxNs);
+    summary.p99Ns = percentile(counts, total, 0.99, maxNs);
+    summary.maxNs = static_cast<double>(maxNs);
+    return summary;
+}
+
+/**
+ * @brief Discard every recorded value.
+ */
+void Histogram::reset()
+{
+    for (auto &bucket : buckets_)
+        bucket.store(0, std::memory_order_relaxed);
+    count_.store(0, std::memory_order_relaxed);
+    sum_.store(0, std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Get the bucket a value falls into.
+ *
+ * @param valueNs Value in nanoseconds (below 2^MaxValueBits)
+ * @return Bucket index
+ */
+std::size_t Histogram::bucketIndex(std::uint64_t valueNs)
+{
+    constexpr std::uint64_t linearLimit = std::uint64_t{1} << SubBucketBits;
+    constexpr std::uint64_t halfRange = linearLimit / 2;
+    if (valueNs < linearLimit)
+        return static_cast<std::size_t>(valueNs);
+
+    const unsigned shift = bitWidth(valueNs) - SubBucketBits;
+    return static_cast<std::size_t>(linearLimit + (shift - 1) * halfRange + ((valueNs >> shift) - halfRange));
+}
+
+/**
+ * @brief Get the smallest value that falls into a bucket.
+ *
+ * @param index Bucket index
+ * @return Lowest value of the bucket
+ */
+std::uint64_t Histogram::bucketLowerBound(std::size_t index)
+{
+    constexpr std::size_t linearLimit = std::size_t{1} << SubBucketBits;
+    constexpr std::size_t halfRange = linearLimit / 2;
+    if (index < linearLimit)
+        return index;
+
+    const std::size_t offset = index - linearLimit;
+    const unsigned shift = static_cast<unsigned>(offset / halfRange) + 1;
+    return static_cast<std::uint64_t>(offset % halfRange + halfRange) << shift;
+}
+
+/**
+ * @brief Get the process-wide registry.
+ *
+ * @return The registry instance
+ */
+MetricsRegistry &MetricsRegistry::instance()
+{
+    static MetricsRegistry registry;
+    return registry;
+}
+
+/**
+ * @brief Construct an empty registry.
+ */
+MetricsRegistry::MetricsRegistry() : start_(std::chrono::steady_clock::now())
+{
+}
+
+/**
+ * @brief Get or create a counter.
+ *
+ * @param name Metric name
+ * @return Counter that stays valid until exit
+ */
+Counter &MetricsRegistry::counter(const std::string &name)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    Entry &entry = getEntry(name);
+    if (!entry.counter)
+    {
+        if (entry.gauge || entry.histogram)
+            std::cerr << "MetricsRegistry: '" << name << "' is already registered with another kind" << std::endl;
+        entry.counter = std::make_unique<Counter>();
+    }
+    return *entry.counter;
+}
+
+/**
+ * @brief Get or create a gauge.
+ *
+ * @param name Metric name
+ * @return Gauge that stays valid until exit
+ */
+Gauge &MetricsRegistry::gauge(const std::string &name)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    Entry &entry = getEntry(name);
+    if (!entry.gauge)
+    {
+        if (entry.counter || entry.histogram)
+            std::cerr << "MetricsRegistry: '" << name << "' is already registered with another kind" << std::endl;
+        entry.gauge = std::make_unique<Gauge>();
+    }
+    return *entry.gauge;
+}
+
+/**
+ * @brief Get or create a latency histogram.
+ *
+ * @param name Metric name
+ * @return Histogram that stays valid until exit
+ */
+Histogram &MetricsRegistry::histogram(const std::string &name)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    Entry &entry = getEntry(name);
+    if (!entry.histogram)
+    {
+        if (entry.counter || entry.gauge)
+            std::cerr << "MetricsRegistry: '" << name << "' is already registered with another kind" << std::endl;
+        entry.histogram = std::make_unique<Histogram>();
+    }
+    return *entry.histogram;
+}
+
+/**
+ * @brief Read every metric whose name starts with a prefix of whole dotted segments.
+ *
+ * @param prefix Name prefix ("" for all); "physics" matches "physics" and "physics.*" but not "physicsX"
+ * @return Snapshots sorted by name
+ */
+std::vector<MetricSnapshot> MetricsRegistry::snapshot(const std::string &prefix) const
+{
+    const bool segmentEnd = prefix.empty() || prefix.back() == '.';
+    std::vector<MetricSnapshot> snapshots;
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto it = entries_.lower_bound(prefix); it != entries_.end() && it->first.compare(0, prefix.size(), prefix) == 0; ++it)
+    {
+        if (!segmentEnd && it->first.size() > prefix.size() && it->first[prefix.size()] != '.')
+            continue;
+        MetricSnapshot snapshot;
+        snapshot.name = it->first;
+        if (it->second.histogram)
+        {
+            snapshot.kind = MetricKind::Histogram;
+            snapshot.summary = it->second.histogram->summarize();
+            snapshot.value = static_cast<double>(snapshot.summary.count);
+        }
+        else if (it->second.gauge)
+        {
+            snapshot.kind = MetricKind::Gauge;
+            snapshot.value = it->second.gauge->get();
+        }
+        else
+        {
+            snapshot.kind = MetricKind::Counter;
+            snapshot.value = static_cast<double>(it->second.counter->get());
+        }
+        snapshots.push_back(std::move(snapshot));
+    }
+    return snapshots;
+}
+
+/**
+ * @brief Format snapshots as human-readable lines.
+ *
+ * @param snapshots Snapshots to format
+ * @return One line per metric, latencies in milliseconds
+ */
+std::vector<std::string> MetricsRegistry::formatSnapshot(const std::vector<MetricSnapshot> &snapshots)
+{
+    std::vector<std::string> lines;
+    lines.reserve(snapshots.size());
+    for (const MetricSnapshot &snapshot : snapshots)
+    {
+        std::ostringstream line;
+        line << std::fixed << std::setprecision(3) << snapshot.name << ": ";
+        if (snapshot.kind == MetricKind::Histogram)
+        {
+            const Histogram::Summary &s = snapshot.summary;
+            line << "n=" << s.count << " mean=" << s.meanNs / NsPerMs << "ms p50=" << s.p50Ns / NsPerMs
+                 << "ms p90=" << s.p90Ns / NsPerMs << "ms p99=" << s.p99Ns / NsPerMs << "ms max=" << s.maxNs / NsPerMs << "ms";
+        }
+        else if (snapshot.kind == MetricKind::Counter)
+        {
+            line << static_cast<std::uint64_t>(snapshot.value);
+        }
+        else
+        {
+            line << std::defaultfloat << snapshot.value;
+        }
+        lines.push_back(line.str());
+    }
+    return lines;
+}
+
+/**
+ * @brief Reset every metric to zero.
+ */
+void MetricsRegistry::reset()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &entry : entries_)
+    {
+        if (entry.second.counter)
+            entry.second.counter->reset();
+        if (entry.second.gauge)
+            entry.second.gauge->reset();
+        if (entry.second.histogram)
+            entry.second.histogram->reset();
+    }
+}
+
+/**
+ * @brief Configure periodic snapshot dumps.
+ *
+ * @param path Output file, or "" to disable dumping
+ * @param intervalSeconds Time between dumps
+ */
+void MetricsRegistry::setDumpFile(const std::string &path, double intervalSeconds)
+{
+    std::lock_guard<std::mutex> lock(dumpMutex_);
+    dumpPath_ = path;
+    dumpInterval_ = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(std::max(intervalSeconds, 0.0)));
+    nextDump_ = std::chrono::steady_clock::now() + dumpInterval_;
+    dumpHeaderWritten_ = false;
+    dumpEnabled_.store(!path.empty(), std::memory_order_relaxed);
+}
+
+/**
+ * @brief Dump a snapshot if the dump interval has elapsed.
+ */
+void MetricsRegistry::dumpIfDue()
+{
+    if (!dumpEnabled_.load(std::memory_order_relaxed))
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(dumpMutex_);
+        const auto now = std::chrono::steady_clock::now();
+        if (now < nextDump_)
+            return;
+        nextDump_ = now + dumpInterval_;
+    }
+    dump();
+}
+
+/**
+ * @brief Dump a snapshot to the configured file now.
+ *
+ * @return true if a file is configured and was written
+ */
+bool MetricsRegistry::dump()
+{
+    const std::vector<MetricSnapshot> snapshots = snapshot();
+    const double timeSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+
+    std::lock_guard<std::mutex> lock(dumpMutex_);
+    if (dumpPath_.empty())
+        return false;
+
+    const bool json = std::filesystem::path(dumpPath_).extension() == ".json";
+    std::ofstream file(dumpPath_, dumpHeaderWritten_ ? std::ios::app : std::ios::trunc);
+    if (!file)
+    {
+        std::cerr << "MetricsRegistry: could not open " << dumpPath_ << std::endl;
+        return false;
+    }
+
+    if (json)
+        writeJson(file, snapshots, timeSeconds);
+    else
+        writeCsv(file, snapshots, timeSeconds, !dumpHeaderWritten_);
+    dumpHeaderWritten_ = true;
+    return static_cast<bool>(file);
+}
+
+/**
+ * @brief Write snapshots as CSV rows.
+ *
+ * @param out Stream to write to
+ * @param snapshots Snapshots to write
+ * @param timeSeconds Seconds since the registry started
+ * @param header true to write the column header first
+ */
+void MetricsRegistry::writeCsv(std::ostream &out, const std::vector<MetricSnapshot> &snapshots, double timeSeconds, bool header)
+{
+    if (header)
+        out << "time_s,name,kind,value,count,mean_ms,p50_ms,p90_ms,p99_ms,max_ms\n";
+
+    for (const MetricSnapshot &snapshot : snapshots)
+    {
+        const Histogram::Summary &s = snapshot.summary;
+        out << timeSeconds << ',' << snapshot.name << ',' << kindName(snapshot.kind) << ',' << snapshot.value << ',';
+        if (snapshot.kind == MetricKind::Histogram)
+        {
+            out << s.count << ',' << s.meanNs / NsPerMs << ',' << s.p50Ns / NsPerMs << ',' << s.p90Ns / NsPerMs << ','
+                << s.p99Ns / NsPerMs << ',' << s.maxNs / NsPerMs;
+        }
+        else
+        {
+            out << ",,,,,";
+        }
+        out << '\n';
+    }
+}
+
+/**
+ * @brief Write snapshots as one JSON object on a single line.
+ *
+ * @param out Stream to write to
+ * @param snapshots Snapshots to write
+ * @param timeSeconds Seconds since the registry started
+ */
+void MetricsRegistry::writeJson(std::ostream &out, const std::vector<MetricSnapshot> &snapshots, double timeSeconds)
+{
+    out << "{\"time_s\":" << timeSeconds << ",\"metrics\":{";
+    bool first = true;
+    for (const MetricSnapshot &snapshot : snapshots)
+    {
+        // Metric names are dotted identifiers chosen in code, so they need no escaping
+        out << (first ? "" : ",") << '"' << snapshot.name << "\":";
+        first = false;
+        if (snapshot.kind == MetricKind::Histogram)
+        {
+            const Histogram::Summary &s = snapshot.summary;
+            out << "{\"count\":" << s.count << ",\"mean_ms\":" << s.meanNs / NsPerMs << ",\"p50_ms\":" << s.p50Ns / NsPerMs
+                << ",\"p90_ms\":" << s.p90Ns / NsPerMs << ",\"p99_ms\":" << s.p99Ns / NsPerMs << ",\"max_ms\":" << s.maxNs / NsPerMs << '}';
+        }
+        else
+        {
+            out << snapshot.value;
+        }
+    }
+    out << "}}\n";
+}
+
+/**
+ * @brief Find or insert the entry of a metric. Called with the lock held.
+ *
+ * @param name Metric name
+ * @return Entry (std::map never moves it)
+ */
+MetricsRegistry::Entry &MetricsRegistry::getEntry(const std::string &name)
+{
+    return entries_[name];
+}
@@ -0,0 +1,360 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Monotonically increasing event count.
+ */
+class Counter
+{
+public:
+    /**
+     * @brief Add to the counter. Safe from any thread.
+     *
+     * @param amount Amount to add
+     */
+    void add(std::uint64_t amount = 1) { value_.fetch_add(amount, std::memory_order_relaxed); }
+
+    /**
+     * @brief Get the current count.
+     *
+     * @return Count since startup or the last reset
+     */
+    std::uint64_t get() const { return value_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Set the count back to zero.
+     */
+    void reset() { value_.store(0, std::memory_order_relaxed); }
+
+private:
+    std::atomic<std::uint64_t> value_{0}; /**< Current count */
+};
+
+/**
+ * @brief Last-written value of a quantity (entity count, queue depth, ...).
+ */
+class Gauge
+{
+public:
+    /**
+     * @brief Set the gauge. Safe from any thread.
+     *
+     * @param value New value
+     */
+    void set(double value) { value_.store(value, std::memory_order_relaxed); }
+
+    /**
+     * @brief Get the last value set.
+     *
+     * @return Current value
+     */
+    double get() const { return value_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Set the gauge back to zero.
+     */
+    void reset() { value_.store(0.0, std::memory_order_relaxed); }
+
+private:
+    std::atomic<double> value_{0.0}; /**< Current value */
+};
+
+/**
+ * @brief Latency histogram with HDR-style log-linear buckets.
+ *
+ * Durations are recorded in nanoseconds. Values below 2^SubBucketBits get
+ * one bucket each; above that every power of two is split into
+ * 2^(SubBucketBits - 1) equal buckets, so any recorded value is reported
+ * within 1/64 (about 1.6%) of itself. Recording is one relaxed fetch_add on
+ * the bucket plus the count/sum/max updates; nothing allocates or locks.
+ */
+class Histogram
+{
+public:
+    /** Linear resolution bits: 7 gives 64 buckets per power of two */
+    static constexpr unsigned SubBucketBits = 7;
+    /** Values at or above 2^MaxValueBits ns (about 18 minutes) are clamped */
+    static constexpr unsigned MaxValueBits = 40;
+    /** Total number of buckets */
+    static constexpr std::size_t BucketCount =
+        (std::size_t{1} << SubBucketBits) + (MaxValueBits - SubBucketBits) * (std::size_t{1} << (SubBucketBits - 1));
+
+    /**
+     * @brief Summary of the recorded distribution.
+     */
+    struct Summary
+    {
+        std::uint64_t count = 0; /**< Recorded values */
+        double meanNs = 0.0;     /**< Mean value */
+        double p50Ns = 0.0;      /**< Median */
+        double p90Ns = 0.0;      /**< 90th percentile */
+        double p99Ns = 0.0;      /**< 99th percentile */
+        double maxNs = 0.0;      /**< Largest value */
+    };
+
+    /**
+     * @brief Record one duration. Safe from any thread.
+     *
+     * @param valueNs Duration in nanoseconds
+     */
+    void record(std::uint64_t valueNs);
+
+    /**
+     * @brief Record one duration.
+     *
+     * @param duration Duration to record
+     */
+    template <typename Rep, typename Period>
+    void record(std::chrono::duration<Rep, Period> duration)
+    {
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+        record(static_cast<std::uint64_t>(ns > 0 ? ns : 0));
+    }
+
+    /**
+     * @brief Summarize the values recorded so far.
+     *
+     * Concurrent recording may be partially included.
+     *
+     * @return Count, mean, percentiles and maximum
+     */
+    Summary summarize() const;
+
+    /**
+     * @brief Get the number of recorded values.
+     *
+     * @return Count since startup or the last reset
+     */
+    std::uint64_t getCount() const { return count_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Discard every recorded value.
+     */
+    void reset();
+
+    /**
+     * @brief Get the bucket a value falls into.
+     *
+     * @param valueNs Value in nanoseconds
+     * @return Bucket index
+     */
+    static std::size_t bucketIndex(std::uint64_t valueNs);
+
+    /**
+     * @brief Get the smallest value that falls into a bucket.
+     *
+     * @param index Bucket index
+     * @return Lowest value of the bucket
+     */
+    static std::uint64_t bucketLowerBound(std::size_t index);
+
+private:
+    std::array<std::atomic<std::uint64_t>, BucketCount> buckets_{}; /**< Values per bucket */
+    std::atomic<std::uint64_t> count_{0};                           /**< Recorded values */
+    std::atomic<std::uint64_t> sum_{0};                             /**< Sum of recorded values */
+    std::atomic<std::uint64_t> max_{0};                             /**< Largest recorded value */
+};
+
+/**
+ * @brief Records the lifetime of a scope into a histogram.
+ */
+class MetricTimer
+{
+public:
+    /**
+     * @brief Start timing.
+     *
+     * @param histogram Histogram that receives the duration
+     */
+    explicit MetricTimer(Histogram &histogram)
+        : histogram_(histogram), start_(std::chrono::steady_clock::now()) {}
+
+    /**
+     * @brief Stop timing and record the duration.
+     */
+    ~MetricTimer() { histogram_.record(std::chrono::steady_clock::now() - start_); }
+
+    MetricTimer(const MetricTimer &) = delete;
+    MetricTimer &operator=(const MetricTimer &) = delete;
+
+private:
+    Histogram &histogram_;                            /**< Destination */
+    std::chrono::steady_clock::time_point start_;     /**< Start time */
+};
+
+/**
+ * @brief Kind of a registered metric.
+ */
+enum class MetricKind
+{
+    Counter,
+    Gauge,
+    Histogram
+};
+
+/**
+ * @brief Point-in-time reading of one metric.
+ */
+struct MetricSnapshot
+{
+    std::string name;                      /**< Dotted metric name, e.g. "physics.step_time" */
+    MetricKind kind = MetricKind::Counter; /**< Metric kind */
+    double value = 0.0;                    /**< Counter or gauge value */
+    Histogram::Summary summary;            /**< Histogram summary (histograms only) */
+};
+
+/**
+ * @brief Process-wide registry of named counters, gauges and histograms.
+ *
+ * Metrics are created on first lookup and live until exit, so call sites
+ * look them up once and keep the reference:
+ *
+ *     static Histogram &stepTime = MetricsRegistry::instance().histogram("physics.step_time");
+ *
+ * Names are dotted; the first component groups related metrics for
+ * snapshot(prefix) and the console "stats" command. Snapshots can be
+ * appended periodically to a CSV file or a JSON-lines file.
+ */
+class MetricsRegistry
+{
+public:
+    /**
+     * @brief Get the process-wide registry.
+     *
+     * @return The registry instance
+     */
+    static MetricsRegistry &instance();
+
+    /**
+     * @brief Get or create a counter.
+     *
+     * @param name Metric name
+     * @return Counter that stays valid until exit
+     */
+    Counter &counter(const std::string &name);
+
+    /**
+     * @brief Get or create a gauge.
+     *
+     * @param name Metric name
+     * @return Gauge that stays valid until exit
+     */
+    Gauge &gauge(const std::string &name);
+
+    /**
+     * @brief Get or create a latency histogram.
+     *
+     * @param name Metric name
+     * @return Histogram that stays valid until exit
+     */
+    Histogram &histogram(const std::string &name);
+
+    /**
+     * @brief Read every metric whose name starts with a prefix of whole dotted segments.
+     *
+     * @param prefix Name prefix ("" for all); "physics" matches "physics" and "physics.*" but not "physicsX"
+     * @return Snapshots sorted by name
+     */
+    std::vector<MetricSnapshot> snapshot(const std::string &prefix = "") const;
+
+    /**
+     * @brief Format snapshots as human-readable lines.
+     *
+     * @param snapshots Snapshots to format
+     * @return One line per metric, latencies in milliseconds
+     */
+    static std::vector<std::string> formatSnapshot(const std::vector<MetricSnapshot> &snapshots);
+
+    /**
+     * @brief Reset every metric to zero.
+     */
+    void reset();
+
+    /**
+     * @brief Configure periodic snapshot dumps.
+     *
+     * Files ending in ".json" receive one JSON object per line; any other
+     * file receives CSV rows with a header. The file is truncated by the
+     * first dump after this call and appended to afterwards.
+     *
+     * @param path Output file, or "" to disable dumping
+     * @param intervalSeconds Time between dumps
+     */
+    void setDumpFile(const std::string &path, double intervalSeconds);
+
+    /**
+     * @brief Dump a snapshot if the dump interval has elapsed.
+     *
+     * Cheap enough to call once per frame.
+     */
+    void dumpIfDue();
+
+    /**
+     * @brief Dump a snapshot to the configured file now.
+     *
+     * @return true if a file is configured and was written
+     */
+    bool dump();
+
+    /**
+     * @brief Write snapshots as CSV rows.
+     *
+     * @param out Stream to write to
+     * @param snapshots Snapshots to write
+     * @param timeSeconds Seconds since the registry started
+     * @param header true to write the column header first
+     */
+    static void writeCsv(std::ostream &out, const std::vector<MetricSnapshot> &snapshots, double timeSeconds, bool header);
+
+    /**
+     * @brief Write snapshots as one JSON object on a single line.
+     *
+     * @param out Stream to write to
+     * @param snapshots Snapshots to write
+     * @param timeSeconds Seconds since the registry started
+     */
+    static void writeJson(std::ostream &out, const std::vector<MetricSnapshot> &snapshots, double timeSeconds);
+
+private:
+    /**
+     * @brief One registered metric; exactly one of the pointers is set.
+     */
+    struct Entry
+    {
+        std::unique_ptr<Counter> counter;     /**< Counter storage */
+        std::unique_ptr<Gauge> gauge;         /**< Gauge storage */
+        std::unique_ptr<Histogram> histogram; /**< Histogram storage */
+    };
+
+    MetricsRegistry();
+
+    MetricsRegistry(const MetricsRegistry &) = delete;
+    MetricsRegistry &operator=(const MetricsRegistry &) = delete;
+
+    Entry &getEntry(const std::string &name);
+
+    mutable std::mutex mutex_;            /**< Guards entries_ */
+    std::map<std::string, Entry> entries_; /**< Metrics by name */
+
+    std::mutex dumpMutex_;                                 /**< Guards the dump settings */
+    std::string dumpPath_;                                 /**< Dump file, empty when disabled */
+    std::chrono::steady_clock::duration dumpInterval_{};   /**< Time between dumps */
+    std::chrono::steady_clock::time_point nextDump_{};     /**< When dumpIfDue() writes next */
+    std::atomic<bool> dumpEnabled_{false};                 /**< dumpPath_ is set */
+    bool dumpHeaderWritten_ = false;                       /**< CSV header already written */
+    std::chrono::steady_clock::time_point start_;          /**< Registry creation time */
+};
+
+#endif
@@ -0,0 +1,160 @@
+#ifndef MPSCRING_H
+#define MPSCRING_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+/**
+ * @brief Bounded lock-free multi-producer, single-consumer ring buffer.
+ *
+ * Each cell carries a sequence number that tells producers and the consumer
+ * whose turn it is to use it (Vyukov's bounded queue). Producers claim a
+ * cell with one compare-and-swap on the enqueue position; the consumer never
+ * contends with anyone. No operation allocates or takes a lock.
+ *
+ * Values are constructed and consumed in place inside the cells, so a
+ * full/empty check is the only cost when the ring is at its limits.
+ *
+ * @tparam T Cell value type (must be default-constructible)
+ */
+template <typename T>
+class MpscRing
+{
+public:
+    /**
+     * @brief Construct a ring.
+     *
+     * @param capacity Number of cells, rounded up to a power of two (at least 2)
+     */
+    explicit MpscRing(std::size_t capacity)
+    {
+        std::size_t size = 2;
+        while (size < capacity)
+        {
+            size <<= 1;
+        }
+        mask_ = size - 1;
+        cells_.reset(new Cell[size]);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        enqueuePos_.store(0, std::memory_order_relaxed);
+        dequeuePos_.store(0, std::memory_order_relaxed);
+    }
+
+    MpscRing(const MpscRing &) = delete;
+    MpscRing &operator=(const MpscRing &) = delete;
+
+    /**
+     * @brief Claim a free cell and fill it in place. Safe from any thread.
+     *
+     * fill must not throw: the cell is claimed before it runs and is only
+     * published after it returns, so a throwing fill would stall the
+     * consumer on that cell for good.
+     *
+     * @param fill Callable taking (T &cell) that writes the value
+     * @return false if the ring is full (fill is not called)
+     */
+    template <typename Fill>
+    bool tryPush(Fill &&fill)
+    {
+        std::size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+        Cell *cell;
+        while (true)
+        {
+            cell = &cells_[pos & mask_];
+            const std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0)
+            {
+                if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = enqueuePos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        fill(cell->value);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Consume the oldest filled cell in place. Consumer thread only.
+     *
+     * @param consume Callable taking (T &cell); the cell is reused once it returns or throws
+     * @return false if the ring is empty (consume is not called)
+     */
+    template <typename Consume>
+    bool tryPop(Consume &&consume)
+    {
+        const std::size_t pos = dequeuePos_.load(std::memory_order_relaxed);
+        Cell &cell = cells_[pos & mask_];
+        const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        if (sequence != pos + 1)
+            return false;
+
+        // Release the cell even if consume throws, so it is never consumed twice
+        struct Release
+        {
+            MpscRing &ring;
+            Cell &cell;
+            std::size_t pos;
+            ~Release()
+            {
+                ring.dequeuePos_.store(pos + 1, std::memory_order_relaxed);
+                cell.sequence.store(pos + ring.mask_ + 1, std::memory_order_release);
+            }
+        } release{*this, cell, pos};
+
+        consume(cell.value);
+        return true;
+    }
+
+    /**
+     * @brief Get the number of cells.
+     *
+     * @return Ring capacity
+     */
+    std::size_t capacity() const { return mask_ + 1; }
+
+    /**
+     * @brief Get the approximate number of claimed cells.
+     *
+     * Exact when no push or pop is in progress.
+     *
+     * @return Cells claimed by producers and not yet consumed
+     */
+    std::size_t sizeApprox() const
+    {
+        const std::size_t head = dequeuePos_.load(std::memory_order_relaxed);
+        const std::size_t tail = enqueuePos_.load(std::memory_order_relaxed);
+        return tail > head ? tail - head : 0;
+    }
+
+private:
+    /**
+     * @brief One slot of the ring, padded to a cache line to avoid false sharing.
+     */
+    struct alignas(64) Cell
+    {
+        std::atomic<std::size_t> sequence; /**< Turn marker: pos when free, pos + 1 when filled */
+        T value;                           /**< Value constructed in place */
+    };
+
+    std::unique_ptr<Cell[]> cells_;                    /**< Ring storage */
+    std::size_t mask_ = 0;                             /**< capacity() - 1 */
+    alignas(64) std::atomic<std::size_t> enqueuePos_;  /**< Next position claimed by a producer */
+    alignas(64) std::atomic<std::size_t> dequeuePos_;  /**< Next position read by the consumer */
+};
+
+#endif
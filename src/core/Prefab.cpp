@@ -0,0 +1,139 @@
+#include "Prefab.h"
+#include "Entity.h"
+#include <algorithm>
+#include <iostream>
+#include <new>
+
+/**
+ * @brief Destroy the prototypes and release the component block.
+ */
+Prefab::~Prefab()
+{
+    release();
+}
+
+/**
+ * @brief Compile a template from an entity that is not attached to a World.
+ *
+ * The entity's pending components are laid out back to back in ascending
+ * type order, each at its own alignment, and copy-constructed into a single
+ * allocation. Name, active flag, lifetime and custom properties are copied
+ * as well.
+ *
+ * If a component's copy constructor throws, the copies made so far are
+ * destroyed and the exception propagates with the prefab left empty.
+ *
+ * @param source Detached entity holding the template's components
+ * @return false if the entity is attached or has a component that cannot be copied
+ */
+bool Prefab::compile(const Entity &source)
+{
+    release();
+    if (source.storage_ != nullptr)
+    {
+        std::cerr << "Prefab: cannot compile entity " << source.getId() << " while it is attached to a World" << std::endl;
+        return false;
+    }
+
+    std::vector<const Entity::PendingComponent *> pending;
+    pending.reserve(source.pendingComponents_.size());
+    for (const auto &component : source.pendingComponents_)
+    {
+        if (ComponentRegistry::getInfo(component.typeId).copyConstruct == nullptr)
+        {
+            std::cerr << "Prefab: component type " << component.typeId << " of entity '" << source.getName()
+                      << "' cannot be copied" << std::endl;
+            return false;
+        }
+        pending.push_back(&component);
+    }
+    std::sort(pending.begin(), pending.end(), [](const Entity::PendingComponent *a, const Entity::PendingComponent *b)
+              { return a->typeId < b->typeId; });
+
+    std::size_t offset = 0;
+    for (const Entity::PendingComponent *component : pending)
+    {
+        const ComponentInfo &info = ComponentRegistry::getInfo(component->typeId);
+        offset = (offset + info.alignment - 1) / info.alignment * info.alignment;
+        entries_.push_back(Entry{component->typeId, offset});
+        offset += info.size;
+        alignment_ = std::max(alignment_, info.alignment);
+        mask_.set(component->typeId);
+    }
+    byteSize_ = offset;
+
+    if (byteSize_ > 0)
+    {
+        data_ = static_cast<unsigned char *>(::operator new(byteSize_, std::align_val_t(alignment_)));
+    }
+    // prototypes_ counts the constructed entries, so a throwing copy leaves release() only those to destroy
+    prototypes_.reserve(entries_.size());
+    try
+    {
+        for (std::size_t i = 0; i < entries_.size(); ++i)
+        {
+            const ComponentInfo &info = ComponentRegistry::getInfo(entries_[i].typeId);
+            void *prototype = data_ + entries_[i].offset;
+            info.copyConstruct(prototype, info.fromBase(pending[i]->component.get()));
+            prototypes_.push_back(prototype);
+        }
+    }
+    catch (...)
+    {
+        release();
+        throw;
+    }
+
+    name_ = source.getName();
+    active_ = source.active_;
+    lifetime_ = source.lifetime_;
+    customProperties_ = source.customProperties_;
+    return true;
+}
+
+/**
+ * @brief Get the prototype of a component.
+ *
+ * @param typeId Dense component type ID
+ * @return Pointer to the prototype, or nullptr if the prefab lacks the type
+ */
+const void *Prefab::getComponent(ComponentTypeId typeId) const
+{
+    if (typeId >= MaxComponentTypes || !mask_.test(typeId))
+    {
+        return nullptr;
+    }
+    for (std::size_t i = 0; i < entries_.size(); ++i)
+    {
+        if (entries_[i].typeId == typeId)
+        {
+            return prototypes_[i];
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Destroy the constructed prototypes and reset to an empty prefab.
+ */
+void Prefab::release()
+{
+    for (std::size_t i = prototypes_.size(); i-- > 0;)
+    {
+        ComponentRegistry::getInfo(entries_[i].typeId).destroy(data_ + entries_[i].offset);
+    }
+    if (data_ != nullptr)
+    {
+        ::operator delete(data_, std::align_val_t(alignment_));
+    }
+    data_ = nullptr;
+    byteSize_ = 0;
+    alignment_ = alignof(std::max_align_t);
+    entries_.clear();
+    prototypes_.clear();
+    mask_.reset();
+    name_.clear();
+    active_ = true;
+    lifetime_ = -1.0f;
+    customProperties_.clear();
+}
@@ -0,0 +1,159 @@
+#ifndef PREFAB_H
+#define PREFAB_H
+
+#include "ComponentTypeId.h"
+#include "Quaternion.h"
+#include "Vector3D.h"
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class Entity;
+
+/**
+ * @brief Per-instance values applied when a Prefab is instantiated.
+ *
+ * The transform fields replace those of the prefab's TransformC (ignored if
+ * it has none); an empty name keeps the prefab's name.
+ */
+struct PrefabInstance
+{
+    Vector3D position;                   /**< TransformC::position */
+    Quaternion rotation;                 /**< TransformC::rotation */
+    Vector3D scale{1.0f, 1.0f, 1.0f};    /**< TransformC::scale */
+    std::string name;                    /**< Entity name, empty for the prefab's */
+};
+
+/**
+ * @brief An entity template compiled into a flat block of ready-made components.
+ *
+ * Compiling copies each of a source entity's components into one aligned
+ * buffer, in the ascending type order used by archetype columns, together
+ * with the archetype mask. Instantiating (World::instantiate) then needs no
+ * parsing, string conversion or per-component heap allocation: every clone
+ * is copy-constructed straight from the buffer into the archetype's columns,
+ * which are grown once for the whole batch.
+ *
+ * Prefabs are immutable once compiled and may be shared between threads.
+ */
+class Prefab
+{
+public:
+    Prefab() = default;
+    ~Prefab();
+
+    Prefab(const Prefab &) = delete;
+    Prefab &operator=(const Prefab &) = delete;
+
+    /**
+     * @brief Compile a template from an entity that is not attached to a World.
+     *
+     * The entity is left unchanged. Any previously compiled content is replaced.
+     * If copying a component throws, the prefab is left empty.
+     *
+     * @param source Detached entity holding the template's components
+     * @return false if the entity is attached or has a component that cannot be copied
+     */
+    bool compile(const Entity &source);
+
+    /**
+     * @brief Get the component signature of every instance.
+     *
+     * @return Component mask
+     */
+    const ComponentMask &getMask() const { return mask_; }
+
+    /**
+     * @brief Get the number of components per instance.
+     *
+     * @return Component count
+     */
+    std::size_t getComponentCount() const { return entries_.size(); }
+
+    /**
+     * @brief Get the size of the compiled component block.
+     *
+     * @return Size in bytes
+     */
+    std::size_t getByteSize() const { return byteSize_; }
+
+    /**
+     * @brief Get the prototype of a component.
+     *
+     * @param typeId Dense component type ID
+     * @return Pointer to the prototype, or nullptr if the prefab lacks the type
+     */
+    const void *getComponent(ComponentTypeId typeId) const;
+
+    /**
+     * @brief Get the prototype of a component.
+     *
+     * @tparam T Component type
+     * @return Pointer to the prototype, or nullptr if the prefab lacks the type
+     */
+    template <typename T>
+    const T *getComponent() const { return static_cast<const T *>(getComponent(componentTypeId<T>())); }
+
+    /**
+     * @brief Get the prototypes in ascending component type order.
+     *
+     * This is the column order of the archetype for getMask().
+     *
+     * @return One pointer per component
+     */
+    const std::vector<const void *> &getPrototypes() const { return prototypes_; }
+
+    /**
+     * @brief Get the name given to instances.
+     *
+     * @return Entity name
+     */
+    const std::string &getName() const { return name_; }
+
+    /**
+     * @brief Get whether instances start active.
+     *
+     * @return Active flag
+     */
+    bool isActive() const { return active_; }
+
+    /**
+     * @brief Get the lifetime given to instances.
+     *
+     * @return Lifetime in seconds, -1 for infinite
+     */
+    float getLifetime() const { return lifetime_; }
+
+    /**
+     * @brief Get the custom properties given to instances.
+     *
+     * @return Property name -> value
+     */
+    const std::unordered_map<std::string, std::string> &getCustomProperties() const { return customProperties_; }
+
+private:
+    /**
+     * @brief Location of one prototype in the component block.
+     */
+    struct Entry
+    {
+        ComponentTypeId typeId; /**< Dense component type ID */
+        std::size_t offset;     /**< Byte offset into data_ */
+    };
+
+    void release();
+
+    ComponentMask mask_;                                            /**< Component signature */
+    std::vector<Entry> entries_;                                    /**< Prototypes in ascending type order */
+    std::vector<const void *> prototypes_;                          /**< Constructed prototypes, parallel to entries_ */
+    unsigned char *data_ = nullptr;                                 /**< Component block (one allocation) */
+    std::size_t byteSize_ = 0;                                      /**< Size of data_ */
+    std::size_t alignment_ = alignof(std::max_align_t);             /**< Alignment data_ was allocated with */
+    std::string name_;                                              /**< Entity name */
+    bool active_ = true;                                            /**< Whether instances start active */
+    float lifetime_ = -1.0f;                                        /**< Lifetime in seconds, -1 for infinite */
+    std::unordered_map<std::string, std::string> customProperties_; /**< Custom entity properties */
+};
+
+#endif
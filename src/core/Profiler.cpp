@@ -0,0 +1,285 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <ostream>
+
+std::atomic<bool> Profiler::enabled_{false};
+
+namespace
+{
+    /** Open scopes on this thread */
+    thread_local std::uint32_t scopeDepth = 0;
+
+    /**
+     * @brief Read the monotonic clock in nanoseconds.
+     *
+     * @return Nanoseconds since an unspecified epoch
+     */
+    std::uint64_t steadyNowNs()
+    {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                              std::chrono::steady_clock::now().time_since_epoch())
+                                              .count());
+    }
+
+    /**
+     * @brief Write a string as a JSON string literal.
+     *
+     * @param out Stream to write to
+     * @param text Text to quote
+     */
+    void writeJsonString(std::ostream &out, const char *text)
+    {
+        out << '"';
+        for (const char *c = text; *c != '\0'; ++c)
+        {
+            switch (*c)
+            {
+            case '"':
+                out << "\\\"";
+                break;
+            case '\\':
+                out << "\\\\";
+                break;
+            case '\n':
+                out << "\\n";
+                break;
+            default:
+                if (static_cast<unsigned char>(*c) < 0x20)
+                    out << ' ';
+                else
+                    out << *c;
+            }
+        }
+        out << '"';
+    }
+}
+
+/**
+ * @brief Get the process-wide profiler.
+ *
+ * @return The profiler instance
+ */
+Profiler &Profiler::instance()
+{
+    static Profiler profiler;
+    return profiler;
+}
+
+/**
+ * @brief Construct the profiler and fix its clock epoch.
+ */
+Profiler::Profiler() : epochNs_(steadyNowNs())
+{
+}
+
+/**
+ * @brief Start or stop recording scopes.
+ *
+ * @param enabled true to record
+ */
+void Profiler::setEnabled(bool enabled)
+{
+    enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Name the calling thread in exported traces.
+ *
+ * @param name Thread name
+ */
+void Profiler::setThreadName(const std::string &name)
+{
+    ThreadBuffer &buffer = getThreadBuffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    buffer.name = name;
+}
+
+/**
+ * @brief Get the current time on the profiler clock.
+ *
+ * @return Nanoseconds since the profiler epoch
+ */
+std::uint64_t Profiler::now() const
+{
+    return steadyNowNs() - epochNs_;
+}
+
+/**
+ * @brief Enter a scope on the calling thread.
+ *
+ * @return Nesting depth of the new scope
+ */
+std::uint32_t Profiler::enterScope()
+{
+    return scopeDepth++;
+}
+
+/**
+ * @brief Leave the innermost scope on the calling thread and record it.
+ *
+ * @param name Scope name
+ * @param startNs Start time from now()
+ * @param depth Depth returned by enterScope()
+ */
+void Profiler::leaveScope(const char *name, std::uint64_t startNs, std::uint32_t depth)
+{
+    const std::uint64_t endNs = now();
+    scopeDepth = depth;
+
+    ThreadBuffer &buffer = getThreadBuffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    Event &event = buffer.events[buffer.written % buffer.events.size()];
+    event.name = name;
+    event.startNs = startNs;
+    event.endNs = endNs;
+    event.depth = depth;
+    ++buffer.written;
+}
+
+/**
+ * @brief Discard every recorded event, keeping the thread buffers.
+ */
+void Profiler::clear()
+{
+    std::lock_guard<std::mutex> lock(buffersMutex_);
+    for (const auto &buffer : buffers_)
+    {
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        buffer->written = 0;
+    }
+}
+
+/**
+ * @brief Get the number of events currently held across all threads.
+ *
+ * @return Recorded events not yet overwritten
+ */
+std::size_t Profiler::getEventCount() const
+{
+    std::size_t count = 0;
+    std::lock_guard<std::mutex> lock(buffersMutex_);
+    for (const auto &buffer : buffers_)
+    {
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        count += static_cast<std::size_t>(std::min<std::uint64_t>(buffer->written, buffer->events.size()));
+    }
+    return count;
+}
+
+/**
+ * @brief Get the number of events overwritten because a ring was full.
+ *
+ * @return Events lost since the last clear()
+ */
+std::uint64_t Profiler::getDroppedCount() const
+{
+    std::uint64_t dropped = 0;
+    std::lock_guard<std::mutex> lock(buffersMutex_);
+    for (const auto &buffer : buffers_)
+    {
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        if (buffer->written > buffer->events.size())
+            dropped += buffer->written - buffer->events.size();
+    }
+    return dropped;
+}
+
+/**
+ * @brief Write the recorded events as Chrome trace JSON.
+ *
+ * Each scope becomes a complete ("X") event with microsecond timestamps;
+ * each thread gets a thread_name metadata event.
+ *
+ * @param out Stream to write to
+ */
+void Profiler::writeChromeTrace(std::ostream &out) const
+{
+    const std::ios::fmtflags flags = out.flags();
+    const std::streamsize precision = out.precision();
+    out << std::fixed << std::setprecision(3);
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+
+    std::lock_guard<std::mutex> lock(buffersMutex_);
+    for (const auto &buffer : buffers_)
+    {
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+
+        if (!buffer->name.empty())
+        {
+            out << (first ? "\n" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+                << buffer->threadId << ",\"args\":{\"name\":";
+            writeJsonString(out, buffer->name.c_str());
+            out << "}}";
+            first = false;
+        }
+
+        const std::uint64_t capacity = buffer->events.size();
+        const std::uint64_t begin = buffer->written > capacity ? buffer->written - capacity : 0;
+        for (std::uint64_t i = begin; i < buffer->written; ++i)
+        {
+            const Event &event = buffer->events[i % capacity];
+            out << (first ? "\n" : ",\n") << "{\"name\":";
+            writeJsonString(out, event.name);
+            out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->threadId
+                << ",\"ts\":" << event.startNs / 1000.0
+                << ",\"dur\":" << (event.endNs - event.startNs) / 1000.0
+                << ",\"args\":{\"depth\":" << event.depth << "}}";
+            first = false;
+        }
+    }
+
+    out << "\n]}\n";
+    out.flags(flags);
+    out.precision(precision);
+}
+
+/**
+ * @brief Write the recorded events as Chrome trace JSON to a file.
+ *
+ * @param path Output file path
+ * @return true if the file was written
+ */
+bool Profiler::exportChromeTrace(const std::string &path) const
+{
+    std::ofstream file(path);
+    if (!file)
+    {
+        std::cerr << "Profiler: could not open trace file " << path << std::endl;
+        return false;
+    }
+
+    writeChromeTrace(file);
+    if (!file)
+    {
+        std::cerr << "Profiler: failed writing trace file " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Get the calling thread's event ring, creating it on first use.
+ *
+ * @return The thread's buffer
+ */
+Profiler::ThreadBuffer &Profiler::getThreadBuffer()
+{
+    thread_local ThreadBuffer *cached = nullptr;
+    if (cached != nullptr)
+        return *cached;
+
+    auto buffer = std::make_unique<ThreadBuffer>();
+    buffer->events.resize(DefaultEventsPerThread);
+
+    std::lock_guard<std::mutex> lock(buffersMutex_);
+    buffer->threadId = static_cast<std::uint32_t>(buffers_.size() + 1);
+    cached = buffer.get();
+    buffers_.push_back(std::move(buffer));
+    return *cached;
+}
@@ -0,0 +1,288 @@
+#include "Replay.h"
+#include "WorldSnapshot.h"
+#include "../debug.h"
+#include <iostream>
+#include <iterator>
+
+namespace
+{
+    constexpr std::uint32_t ReplayMagic = 0x52565046; // "FPVR"
+    constexpr std::uint32_t ReplayVersion = 1;
+
+    /**
+     * @brief Record tags following the header.
+     */
+    enum RecordTag : std::uint8_t
+    {
+        EndTag = 0,   /**< Clean end of the session */
+        StepTag = 1,  /**< One fixed step: actions and state hash */
+        SceneTag = 2  /**< Scene loaded before the first step */
+    };
+}
+
+/**
+ * @brief Create the replay file and write its header.
+ *
+ * @param path Output file
+ * @param header Session settings (sceneId is written by recordScene())
+ * @return true if the file could be created
+ */
+bool ReplayRecorder::open(const std::string &path, const ReplayHeader &header)
+{
+    close();
+    file_.open(path, std::ios::binary | std::ios::trunc);
+    if (!file_)
+    {
+        std::cerr << "ReplayRecorder: could not create " << path << std::endl;
+        return false;
+    }
+
+    path_ = path;
+    buffer_.clear();
+    actionTable_.clear();
+    writtenActions_ = 0;
+    pending_.clear();
+    steps_ = 0;
+
+    SnapshotWriter writer(buffer_);
+    writer.writeU32(ReplayMagic);
+    writer.writeU32(ReplayVersion);
+    writer.writeF64(header.fixedTimestep);
+    writer.writeU32(header.randomSeed);
+    writer.writeBool(header.deterministic);
+    flush();
+    return true;
+}
+
+/**
+ * @brief Record the scene loaded before the first step.
+ *
+ * @param sceneId Scene identifier
+ */
+void ReplayRecorder::recordScene(const std::string &sceneId)
+{
+    if (!isOpen())
+        return;
+
+    SnapshotWriter writer(buffer_);
+    writer.writeU8(SceneTag);
+    writer.writeString(sceneId);
+}
+
+/**
+ * @brief Queue an input action for the next step record.
+ *
+ * New action names are added to the string table here; the name itself is
+ * written with the first step that uses it.
+ *
+ * @param action Action name from the input configuration
+ */
+void ReplayRecorder::addAction(const std::string &action)
+{
+    if (!isOpen())
+        return;
+
+    std::uint32_t index = 0;
+    while (index < actionTable_.size() && actionTable_[index] != action)
+        ++index;
+    if (index == actionTable_.size())
+        actionTable_.push_back(action);
+    pending_.push_back(index);
+}
+
+/**
+ * @brief Write the record of a completed step with the actions queued since the last one.
+ *
+ * @param stateHash Hash of the World after the step
+ */
+void ReplayRecorder::recordStep(std::uint64_t stateHash)
+{
+    if (!isOpen())
+        return;
+
+    SnapshotWriter writer(buffer_);
+    writer.writeU8(StepTag);
+    writer.writeVarint(pending_.size());
+    for (std::uint32_t index : pending_)
+    {
+        writer.writeVarint(index);
+        // An index one past the names written so far introduces a new name
+        if (index == writtenActions_)
+        {
+            writer.writeString(actionTable_[index]);
+            ++writtenActions_;
+        }
+    }
+    writer.writeU64(stateHash);
+    pending_.clear();
+    ++steps_;
+
+    if (buffer_.size() >= FlushThreshold)
+        flush();
+}
+
+/**
+ * @brief Write the end marker and close the file.
+ */
+void ReplayRecorder::close()
+{
+    if (!isOpen())
+        return;
+
+    buffer_.push_back(EndTag);
+    flush();
+    file_.close();
+    LOG_INFO("Recorded " << steps_ << " steps to " << path_);
+}
+
+/**
+ * @brief Append the buffered bytes to the file.
+ */
+void ReplayRecorder::flush()
+{
+    file_.write(reinterpret_cast<const char *>(buffer_.data()), static_cast<std::streamsize>(buffer_.size()));
+    file_.flush();
+    if (!file_)
+        std::cerr << "ReplayRecorder: failed writing " << path_ << std::endl;
+    buffer_.clear();
+}
+
+/**
+ * @brief Load and decode a replay file.
+ *
+ * @param path Replay file written by ReplayRecorder
+ * @return true if the header was valid; a truncated tail is accepted
+ */
+bool ReplayPlayer::open(const std::string &path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        std::cerr << "ReplayPlayer: could not open " << path << std::endl;
+        return false;
+    }
+    const std::vector<std::uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    SnapshotReader reader(data.data(), data.size());
+    if (reader.readU32() != ReplayMagic || reader.readU32() != ReplayVersion)
+    {
+        std::cerr << "ReplayPlayer: " << path << " is not a replay file of this version" << std::endl;
+        return false;
+    }
+    header_.fixedTimestep = reader.readF64();
+    header_.randomSeed = reader.readU32();
+    header_.deterministic = reader.readBool();
+    if (!reader.ok() || !(header_.fixedTimestep > 0.0))
+    {
+        std::cerr << "ReplayPlayer: " << path << " has a corrupt header" << std::endl;
+        return false;
+    }
+
+    actionTable_.clear();
+    actions_.clear();
+    steps_.clear();
+    current_ = 0;
+    mismatches_ = 0;
+    firstMismatch_ = 0;
+
+    bool ended = false;
+    while (!ended && reader.remaining() > 0)
+    {
+        switch (reader.readU8())
+        {
+        case EndTag:
+            ended = true;
+            break;
+
+        case SceneTag:
+        {
+            std::string sceneId;
+            reader.readString(sceneId);
+            if (reader.ok() && header_.sceneId.empty())
+                header_.sceneId = sceneId;
+            break;
+        }
+
+        case StepTag:
+        {
+            Step step;
+            step.firstAction = static_cast<std::uint32_t>(actions_.size());
+            const std::uint64_t count = reader.readVarint();
+            for (std::uint64_t i = 0; i < count && reader.ok(); ++i)
+            {
+                const std::uint64_t index = reader.readVarint();
+                if (index == actionTable_.size())
+                {
+                    actionTable_.emplace_back();
+                    reader.readString(actionTable_.back());
+                }
+                else if (index > actionTable_.size())
+                {
+                    reader.skip(reader.remaining() + 1); // Corrupt: stop reading
+                }
+                actions_.push_back(static_cast<std::uint32_t>(index));
+            }
+            step.actionCount = static_cast<std::uint32_t>(count);
+            step.stateHash = reader.readU64();
+            if (reader.ok())
+                steps_.push_back(step);
+            else
+                actions_.resize(step.firstAction);
+            break;
+        }
+
+        default:
+            reader.skip(reader.remaining() + 1);
+            break;
+        }
+
+        if (!reader.ok())
+        {
+            std::cerr << "ReplayPlayer: " << path << " is truncated or corrupt after step " << steps_.size()
+                      << ", replaying the steps before it" << std::endl;
+            break;
+        }
+    }
+
+    LOG_INFO("Loaded replay " << path << ": " << steps_.size() << " steps, " << actionTable_.size()
+                              << " distinct actions, scene '" << header_.sceneId << "'");
+    return true;
+}
+
+/**
+ * @brief Advance to the next step.
+ *
+ * @param actions Receives the step's input actions (cleared first)
+ * @return false if no steps are left
+ */
+bool ReplayPlayer::nextStep(std::vector<std::string> &actions)
+{
+    actions.clear();
+    if (isFinished())
+        return false;
+
+    const Step &step = steps_[current_++];
+    for (std::uint32_t i = 0; i < step.actionCount; ++i)
+        actions.push_back(actionTable_[actions_[step.firstAction + i]]);
+    return true;
+}
+
+/**
+ * @brief Compare the state after the current step with the recording.
+ *
+ * @param stateHash Hash of the World after the step
+ * @return true if it matches
+ */
+bool ReplayPlayer::verifyStep(std::uint64_t stateHash)
+{
+    if (current_ == 0 || steps_[current_ - 1].stateHash == stateHash)
+        return true;
+
+    if (mismatches_++ == 0)
+    {
+        firstMismatch_ = current_;
+        std::cerr << "Replay diverged at step " << current_ << ": state hash " << std::hex << stateHash
+                  << ", recorded " << steps_[current_ - 1].stateHash << std::dec << std::endl;
+    }
+    return false;
+}
@@ -0,0 +1,196 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Settings a recorded session was simulated with.
+ *
+ * Replaying applies them before the systems are created, so the wind model
+ * gets the recorded seed and physics steps at the recorded rate.
+ */
+struct ReplayHeader
+{
+    double fixedTimestep = 0.01;   /**< Physics step in seconds */
+    std::uint32_t randomSeed = 0;  /**< Seed of the wind model and procedural generators */
+    bool deterministic = false;    /**< Job system ran in deterministic mode */
+    std::string sceneId;           /**< Scene loaded before the first step */
+};
+
+/**
+ * @brief Writes a session to a compact binary replay file.
+ *
+ * The file starts with a ReplayHeader, followed by one record per fixed
+ * step: the input actions that reached the simulation before the step and
+ * a hash of the World state after it. Actions are stored as varint indices
+ * into a string table that grows inline the first time an action occurs,
+ * so a quiet step costs ten bytes.
+ *
+ * Records are buffered and written in blocks; a file cut short by a crash
+ * is still readable up to the last complete block.
+ */
+class ReplayRecorder
+{
+public:
+    /** Buffered bytes that trigger a write to the file */
+    static constexpr std::size_t FlushThreshold = 64 * 1024;
+
+    /**
+     * @brief Create the replay file and write its header.
+     *
+     * @param path Output file
+     * @param header Session settings
+     * @return true if the file could be created
+     */
+    bool open(const std::string &path, const ReplayHeader &header);
+
+    /**
+     * @brief Check whether a file is being written.
+     *
+     * @return true between open() and close()
+     */
+    bool isOpen() const { return file_.is_open(); }
+
+    /**
+     * @brief Record the scene loaded before the first step.
+     *
+     * @param sceneId Scene identifier
+     */
+    void recordScene(const std::string &sceneId);
+
+    /**
+     * @brief Queue an input action for the next step record.
+     *
+     * @param action Action name from the input configuration
+     */
+    void addAction(const std::string &action);
+
+    /**
+     * @brief Write the record of a completed step with the actions queued since the last one.
+     *
+     * @param stateHash Hash of the World after the step
+     */
+    void recordStep(std::uint64_t stateHash);
+
+    /**
+     * @brief Write the end marker and close the file.
+     */
+    void close();
+
+    /**
+     * @brief Get the number of steps recorded.
+     *
+     * @return Step count
+     */
+    std::uint64_t getStepCount() const { return steps_; }
+
+    ~ReplayRecorder() { close(); }
+
+private:
+    void flush();
+
+    std::ofstream file_;                      /**< Output file */
+    std::string path_;                        /**< Output file path, for messages */
+    std::vector<std::uint8_t> buffer_;        /**< Bytes not yet written */
+    std::vector<std::string> actionTable_;    /**< Action names by index */
+    std::uint32_t writtenActions_ = 0;        /**< Names of actionTable_ already in the file */
+    std::vector<std::uint32_t> pending_;      /**< Action indices queued for the next step */
+    std::uint64_t steps_ = 0;                 /**< Steps recorded */
+};
+
+/**
+ * @brief Reads a replay file and checks a re-simulation against it.
+ *
+ * The whole file is decoded on open(). Each step the engine takes the
+ * step's input actions with nextStep() and, after simulating it, compares
+ * the World hash with verifyStep(). The first mismatch is reported with its
+ * step number; later ones are only counted, since one divergence makes
+ * every following state differ.
+ */
+class ReplayPlayer
+{
+public:
+    /**
+     * @brief Load and decode a replay file.
+     *
+     * @param path Replay file written by ReplayRecorder
+     * @return true if the header was valid; a truncated tail is accepted
+     */
+    bool open(const std::string &path);
+
+    /**
+     * @brief Get the session settings.
+     *
+     * @return Header of the loaded file
+     */
+    const ReplayHeader &getHeader() const { return header_; }
+
+    /**
+     * @brief Get the number of recorded steps.
+     *
+     * @return Step count
+     */
+    std::uint64_t getStepCount() const { return steps_.size(); }
+
+    /**
+     * @brief Check whether every recorded step has been played.
+     *
+     * @return true once nextStep() has returned the last step
+     */
+    bool isFinished() const { return current_ >= steps_.size(); }
+
+    /**
+     * @brief Advance to the next step.
+     *
+     * @param actions Receives the step's input actions (cleared first)
+     * @return false if no steps are left
+     */
+    bool nextStep(std::vector<std::string> &actions);
+
+    /**
+     * @brief Compare the state after the current step with the recording.
+     *
+     * @param stateHash Hash of the World after the step
+     * @return true if it matches
+     */
+    bool verifyStep(std::uint64_t stateHash);
+
+    /**
+     * @brief Get the number of steps whose state differed.
+     *
+     * @return Mismatch count
+     */
+    std::uint64_t getMismatchCount() const { return mismatches_; }
+
+    /**
+     * @brief Get the first step whose state differed.
+     *
+     * @return Step number (1-based), 0 if none did
+     */
+    std::uint64_t getFirstMismatchStep() const { return firstMismatch_; }
+
+private:
+    /**
+     * @brief One recorded step.
+     */
+    struct Step
+    {
+        std::uint32_t firstAction = 0; /**< Index of the step's first entry in actions_ */
+        std::uint32_t actionCount = 0; /**< Number of actions */
+        std::uint64_t stateHash = 0;   /**< Hash after the step */
+    };
+
+    ReplayHeader header_;                  /**< Session settings */
+    std::vector<std::string> actionTable_; /**< Action names by index */
+    std::vector<std::uint32_t> actions_;   /**< Action indices of all steps */
+    std::vector<Step> steps_;              /**< Recorded steps */
+    std::size_t current_ = 0;              /**< Steps handed out by nextStep() */
+    std::uint64_t mismatches_ = 0;         /**< Steps that differed */
+    std::uint64_t firstMismatch_ = 0;      /**< First step that differed */
+};
+
+#endif
@@ -0,0 +1,304 @@
+#include "RewindBuffer.h"
+#include "WorldSnapshot.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    /** Unchanged bytes in a row that end a literal run */
+    constexpr std::size_t MinZeroRun = 4;
+
+    void writeVarint(std::vector<std::uint8_t> &out, std::size_t value)
+    {
+        while (value >= 0x80)
+        {
+            out.push_back(static_cast<std::uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<std::uint8_t>(value));
+    }
+
+    bool readVarint(const std::vector<std::uint8_t> &in, std::size_t &offset, std::size_t &value)
+    {
+        value = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7)
+        {
+            if (offset >= in.size())
+                return false;
+            const std::uint8_t byte = in[offset++];
+            value |= static_cast<std::size_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0)
+                return true;
+        }
+        return false;
+    }
+}
+
+/**
+ * @brief Set how much history to keep, dropping frames that no longer fit.
+ *
+ * @param seconds Simulated seconds to keep, <= 0 to disable recording
+ * @param fixedTimestep Length of one fixed step in seconds
+ * @param maxBytes Upper bound on stored bytes
+ * @param keyframeInterval Frames per keyframe at most (at least 1)
+ */
+void RewindBuffer::configure(double seconds, double fixedTimestep, std::size_t maxBytes, std::size_t keyframeInterval)
+{
+    fixedTimestep_ = fixedTimestep;
+    maxFrames_ = seconds > 0.0 && fixedTimestep > 0.0 ? static_cast<std::size_t>(std::ceil(seconds / fixedTimestep - 1e-6)) + 1 : 0;
+    maxBytes_ = maxBytes;
+    keyframeInterval_ = std::max<std::size_t>(keyframeInterval, 1);
+
+    while (frames_.size() > maxFrames_ || (storedBytes_ > maxBytes_ && !frames_.empty()))
+        dropOldest();
+}
+
+/**
+ * @brief Capture the World as the newest frame.
+ *
+ * The snapshot becomes a keyframe when the interval is up or when its delta
+ * would exceed half the keyframe (entities spawned or destroyed shift the
+ * layout, which defeats byte-wise deltas).
+ *
+ * @param world World after a fixed step, at a sync point
+ * @param frame Step count and simulated time of the state
+ */
+void RewindBuffer::record(World &world, const FrameInfo &frame)
+{
+    if (!isEnabled())
+        return;
+
+    PROFILE_SCOPE("RewindBuffer::record");
+    WorldSnapshot::capture(world, scratch_);
+
+    Frame entry;
+    entry.info = frame;
+    entry.size = scratch_.size();
+
+    bool keyframe = frames_.empty() || framesSinceKeyframe_ >= keyframeInterval_;
+    if (!keyframe)
+    {
+        entry.keyframe = frames_.back().keyframe;
+        encodeDelta(*entry.keyframe, scratch_, entry.delta);
+        keyframe = entry.delta.size() > entry.keyframe->size() / 2;
+    }
+
+    if (keyframe)
+    {
+        entry.keyframe = std::make_shared<const std::vector<std::uint8_t>>(scratch_);
+        entry.delta = std::vector<std::uint8_t>();
+        entry.isKeyframe = true;
+        storedBytes_ += entry.keyframe->size();
+        framesSinceKeyframe_ = 0;
+    }
+    else
+    {
+        entry.delta.shrink_to_fit();
+        storedBytes_ += entry.delta.size();
+    }
+    ++framesSinceKeyframe_;
+    frames_.push_back(std::move(entry));
+
+    // Always keep the newest frame, even if it alone exceeds the budget
+    while (frames_.size() > maxFrames_ || (storedBytes_ > maxBytes_ && frames_.size() > 1))
+        dropOldest();
+}
+
+/**
+ * @brief Restore the newest frame at least some simulated time older than the newest one.
+ *
+ * @param world World to restore
+ * @param seconds Simulated seconds to go back (clamped to the oldest frame)
+ * @param restored Receives the restored frame
+ * @return true if a frame was restored
+ */
+bool RewindBuffer::rewind(World &world, double seconds, FrameInfo &restored)
+{
+    if (frames_.empty())
+        return false;
+
+    // Half a step of slack so "go back 1 s" lands on the frame 1 s ago despite rounding
+    const double target = frames_.back().info.simulationTime - seconds + 0.5 * fixedTimestep_;
+    std::size_t index = 0;
+    for (std::size_t i = frames_.size(); i-- > 0;)
+    {
+        if (frames_[i].info.simulationTime <= target)
+        {
+            index = i;
+            break;
+        }
+    }
+
+    if (!restoreFrame(world, index))
+        return false;
+    restored = frames_[index].info;
+
+    while (frames_.size() > index + 1)
+    {
+        Frame &newest = frames_.back();
+        storedBytes_ -= newest.delta.size();
+        if (newest.keyframe.use_count() == 1)
+            storedBytes_ -= newest.keyframe->size();
+        frames_.pop_back();
+    }
+    // Start the future timeline from a fresh keyframe
+    framesSinceKeyframe_ = keyframeInterval_;
+    return true;
+}
+
+/**
+ * @brief Restore a frame by index without discarding anything.
+ *
+ * @param world World to restore
+ * @param index 0 for the oldest frame, getFrameCount() - 1 for the newest
+ * @return true if the frame exists and was restored
+ */
+bool RewindBuffer::restoreFrame(World &world, std::size_t index)
+{
+    PROFILE_SCOPE("RewindBuffer::restoreFrame");
+    if (!decodeFrame(index, decodeScratch_))
+        return false;
+    return WorldSnapshot::restore(world, decodeScratch_.data(), decodeScratch_.size());
+}
+
+/**
+ * @brief Decode a frame into a full snapshot.
+ *
+ * @param index 0 for the oldest frame, getFrameCount() - 1 for the newest
+ * @param snapshot Receives the WorldSnapshot bytes
+ * @return true if the frame exists
+ */
+bool RewindBuffer::decodeFrame(std::size_t index, std::vector<std::uint8_t> &snapshot) const
+{
+    if (index >= frames_.size())
+        return false;
+
+    const Frame &frame = frames_[index];
+    if (frame.isKeyframe)
+    {
+        snapshot = *frame.keyframe;
+        return true;
+    }
+    return decodeDelta(*frame.keyframe, frame.delta, frame.size, snapshot);
+}
+
+/**
+ * @brief Get memory use and compression figures.
+ *
+ * @return Current statistics
+ */
+RewindBuffer::Stats RewindBuffer::getStats() const
+{
+    Stats stats;
+    stats.frames = frames_.size();
+    stats.storedBytes = storedBytes_;
+    for (const Frame &frame : frames_)
+    {
+        stats.keyframes += frame.isKeyframe ? 1 : 0;
+        stats.snapshotBytes += frame.size;
+    }
+    if (!frames_.empty())
+        stats.seconds = frames_.back().info.simulationTime - frames_.front().info.simulationTime;
+    return stats;
+}
+
+/**
+ * @brief Drop every frame.
+ */
+void RewindBuffer::clear()
+{
+    frames_.clear();
+    storedBytes_ = 0;
+    framesSinceKeyframe_ = 0;
+}
+
+/**
+ * @brief Drop the oldest frame, releasing its keyframe once no delta refers to it.
+ */
+void RewindBuffer::dropOldest()
+{
+    Frame &oldest = frames_.front();
+    storedBytes_ -= oldest.delta.size();
+    if (oldest.keyframe.use_count() == 1)
+        storedBytes_ -= oldest.keyframe->size();
+    frames_.pop_front();
+    if (frames_.empty())
+        framesSinceKeyframe_ = 0;
+}
+
+/**
+ * @brief XOR a snapshot against a keyframe and run-length encode the result.
+ *
+ * @param keyframe Reference snapshot
+ * @param snapshot Snapshot to encode
+ * @param delta Receives the encoded delta (previous contents are replaced)
+ */
+void RewindBuffer::encodeDelta(const std::vector<std::uint8_t> &keyframe, const std::vector<std::uint8_t> &snapshot,
+                               std::vector<std::uint8_t> &delta)
+{
+    delta.clear();
+    const std::size_t size = snapshot.size();
+    const std::size_t common = std::min(size, keyframe.size());
+    auto difference = [&](std::size_t i) -> std::uint8_t
+    { return static_cast<std::uint8_t>(snapshot[i] ^ (i < common ? keyframe[i] : 0)); };
+
+    std::size_t i = 0;
+    while (i < size)
+    {
+        const std::size_t zeroStart = i;
+        while (i < size && difference(i) == 0)
+            ++i;
+        const std::size_t zeroRun = i - zeroStart;
+
+        // Extend the literal run until MinZeroRun unchanged bytes in a row; shorter gaps are copied
+        const std::size_t literalStart = i;
+        std::size_t literalEnd = i;
+        while (i < size)
+        {
+            if (difference(i++) != 0)
+                literalEnd = i;
+            else if (i - literalEnd >= MinZeroRun)
+                break;
+        }
+        i = literalEnd;
+        const std::size_t literalRun = i - literalStart;
+
+        writeVarint(delta, zeroRun);
+        writeVarint(delta, literalRun);
+        for (std::size_t j = literalStart; j < i; ++j)
+            delta.push_back(difference(j));
+    }
+}
+
+/**
+ * @brief Rebuild a snapshot from its keyframe and delta.
+ *
+ * @param keyframe Reference snapshot passed to encodeDelta()
+ * @param delta Encoded delta
+ * @param size Size of the original snapshot
+ * @param snapshot Receives the snapshot
+ * @return true if the delta was well formed
+ */
+bool RewindBuffer::decodeDelta(const std::vector<std::uint8_t> &keyframe, const std::vector<std::uint8_t> &delta,
+                               std::size_t size, std::vector<std::uint8_t> &snapshot)
+{
+    snapshot.assign(size, 0);
+    std::copy_n(keyframe.begin(), std::min(size, keyframe.size()), snapshot.begin());
+
+    std::size_t offset = 0;
+    std::size_t position = 0;
+    while (offset < delta.size())
+    {
+        std::size_t zeroRun = 0;
+        std::size_t literalRun = 0;
+        if (!readVarint(delta, offset, zeroRun) || !readVarint(delta, offset, literalRun))
+            return false;
+        position += zeroRun;
+        if (position > size || literalRun > size - position || literalRun > delta.size() - offset)
+            return false;
+        for (std::size_t j = 0; j < literalRun; ++j)
+            snapshot[position++] ^= delta[offset++];
+    }
+    return position == size;
+}
@@ -0,0 +1,199 @@
+#ifndef REWINDBUFFER_H
+#define REWINDBUFFER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <vector>
+
+class World;
+
+/**
+ * @brief Ring of recent World snapshots for rewinding the simulation.
+ *
+ * One frame is recorded per fixed step. Every keyframeInterval frames (or
+ * sooner, when the world changed too much for a delta to pay off) the full
+ * snapshot is kept as a keyframe; the frames in between store only the
+ * bytes that differ from their keyframe, XOR-ed and run-length encoded. A
+ * flying drone changes a few dozen floats per step, so a delta is a small
+ * fraction of a keyframe.
+ *
+ * Since every delta is against its keyframe rather than the previous frame,
+ * restoring any frame costs one keyframe copy plus one delta decode.
+ *
+ * Memory is bounded twice: frames older than the configured duration are
+ * dropped, and the oldest frames are also dropped while the total exceeds
+ * the byte budget.
+ */
+class RewindBuffer
+{
+public:
+    /**
+     * @brief Description of a recorded frame.
+     */
+    struct FrameInfo
+    {
+        std::uint64_t step = 0;        /**< Fixed step count after the step */
+        double simulationTime = 0.0;   /**< Simulated time after the step */
+    };
+
+    /**
+     * @brief Memory use and compression of the recorded frames.
+     */
+    struct Stats
+    {
+        std::size_t frames = 0;        /**< Frames held */
+        std::size_t keyframes = 0;     /**< Keyframes held */
+        std::size_t storedBytes = 0;   /**< Bytes of keyframes and deltas held */
+        std::size_t snapshotBytes = 0; /**< Bytes the same frames take as full snapshots */
+        double seconds = 0.0;          /**< Simulated time covered */
+    };
+
+    /**
+     * @brief Construct a disabled buffer.
+     */
+    RewindBuffer() = default;
+
+    /**
+     * @brief Set how much history to keep, dropping frames that no longer fit.
+     *
+     * @param seconds Simulated seconds to keep, <= 0 to disable recording
+     * @param fixedTimestep Length of one fixed step in seconds
+     * @param maxBytes Upper bound on stored bytes
+     * @param keyframeInterval Frames per keyframe at most (at least 1)
+     */
+    void configure(double seconds, double fixedTimestep, std::size_t maxBytes = DefaultMaxBytes,
+                   std::size_t keyframeInterval = DefaultKeyframeInterval);
+
+    /**
+     * @brief Check whether frames are being recorded.
+     *
+     * @return true if configured with a positive duration
+     */
+    bool isEnabled() const { return maxFrames_ > 0; }
+
+    /**
+     * @brief Capture the World as the newest frame.
+     *
+     * @param world World after a fixed step, at a sync point
+     * @param frame Step count and simulated time of the state
+     */
+    void record(World &world, const FrameInfo &frame);
+
+    /**
+     * @brief Restore the newest frame at least some simulated time older than the newest one.
+     *
+     * Frames after the restored one are discarded, so recording continues
+     * from the restored state.
+     *
+     * @param world World to restore
+     * @param seconds Simulated seconds to go back (clamped to the oldest frame)
+     * @param restored Receives the restored frame
+     * @return true if a frame was restored
+     */
+    bool rewind(World &world, double seconds, FrameInfo &restored);
+
+    /**
+     * @brief Restore a frame by index without discarding anything.
+     *
+     * @param world World to restore
+     * @param index 0 for the oldest frame, getFrameCount() - 1 for the newest
+     * @return true if the frame exists and was restored
+     */
+    bool restoreFrame(World &world, std::size_t index);
+
+    /**
+     * @brief Decode a frame into a full snapshot.
+     *
+     * @param index 0 for the oldest frame, getFrameCount() - 1 for the newest
+     * @param snapshot Receives the WorldSnapshot bytes
+     * @return true if the frame exists
+     */
+    bool decodeFrame(std::size_t index, std::vector<std::uint8_t> &snapshot) const;
+
+    /**
+     * @brief Get the description of a frame.
+     *
+     * @param index 0 for the oldest frame, getFrameCount() - 1 for the newest
+     * @return Step and time of the frame
+     */
+    FrameInfo getFrameInfo(std::size_t index) const { return frames_[index].info; }
+
+    /**
+     * @brief Get the number of frames held.
+     *
+     * @return Frame count
+     */
+    std::size_t getFrameCount() const { return frames_.size(); }
+
+    /**
+     * @brief Get memory use and compression figures.
+     *
+     * @return Current statistics
+     */
+    Stats getStats() const;
+
+    /**
+     * @brief Drop every frame.
+     */
+    void clear();
+
+    /** Byte budget used when configure() is not given one */
+    static constexpr std::size_t DefaultMaxBytes = 256u * 1024u * 1024u;
+    /** Keyframe interval used when configure() is not given one */
+    static constexpr std::size_t DefaultKeyframeInterval = 120;
+
+    /**
+     * @brief XOR a snapshot against a keyframe and run-length encode the result.
+     *
+     * The output is a sequence of (zero run, literal run, literal bytes)
+     * tokens with varint lengths. Bytes past the end of the keyframe are
+     * XOR-ed against zero.
+     *
+     * @param keyframe Reference snapshot
+     * @param snapshot Snapshot to encode
+     * @param delta Receives the encoded delta (previous contents are replaced)
+     */
+    static void encodeDelta(const std::vector<std::uint8_t> &keyframe, const std::vector<std::uint8_t> &snapshot,
+                            std::vector<std::uint8_t> &delta);
+
+    /**
+     * @brief Rebuild a snapshot from its keyframe and delta.
+     *
+     * @param keyframe Reference snapshot passed to encodeDelta()
+     * @param delta Encoded delta
+     * @param size Size of the original snapshot
+     * @param snapshot Receives the snapshot
+     * @return true if the delta was well formed
+     */
+    static bool decodeDelta(const std::vector<std::uint8_t> &keyframe, const std::vector<std::uint8_t> &delta,
+                            std::size_t size, std::vector<std::uint8_t> &snapshot);
+
+private:
+    /**
+     * @brief One recorded frame; a keyframe when delta is empty and size matches.
+     */
+    struct Frame
+    {
+        FrameInfo info;                                          /**< Step and time */
+        std::shared_ptr<const std::vector<std::uint8_t>> keyframe; /**< Full snapshot this frame is relative to */
+        std::vector<std::uint8_t> delta;                         /**< Encoded difference (empty for keyframes) */
+        std::size_t size = 0;                                    /**< Size of the full snapshot */
+        bool isKeyframe = false;                                 /**< This frame owns keyframe */
+    };
+
+    void dropOldest();
+
+    std::deque<Frame> frames_;                /**< Oldest first */
+    std::size_t maxFrames_ = 0;               /**< Frames kept at most, 0 when disabled */
+    std::size_t maxBytes_ = DefaultMaxBytes;  /**< Stored bytes kept at most */
+    std::size_t keyframeInterval_ = DefaultKeyframeInterval; /**< Frames per keyframe at most */
+    std::size_t framesSinceKeyframe_ = 0;     /**< Frames recorded against the current keyframe */
+    std::size_t storedBytes_ = 0;             /**< Bytes of keyframes and deltas held */
+    double fixedTimestep_ = 0.0;              /**< Seconds per frame */
+    std::vector<std::uint8_t> scratch_;       /**< Reused capture / decode buffer */
+    std::vector<std::uint8_t> decodeScratch_; /**< Reused decode buffer for restores */
+};
+
+#endif
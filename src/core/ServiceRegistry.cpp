@@ -0,0 +1,33 @@
+#include "ServiceRegistry.h"
+#include <atomic>
+
+/**
+ * @brief Destroy the owned services, newest first.
+ *
+ * Later services may refer to earlier ones (a system to its models), so
+ * they are released in reverse order of addition.
+ */
+ServiceRegistry::~ServiceRegistry()
+{
+    slots_.clear();
+    while (!owned_.empty())
+    {
+        OwnedService service = owned_.back();
+        owned_.pop_back();
+        service.destroy(service.ptr);
+    }
+}
+
+/**
+ * @brief Assign the next dense service type index.
+ *
+ * Called once per service type from the function-local static inside
+ * serviceTypeId<T>().
+ *
+ * @return The newly assigned index
+ */
+std::size_t ServiceRegistry::registerServiceType()
+{
+    static std::atomic<std::size_t> nextIndex{0};
+    return nextIndex.fetch_add(1);
+}
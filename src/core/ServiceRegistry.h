@@ -0,0 +1,141 @@
+#ifndef SERVICEREGISTRY_H
+#define SERVICEREGISTRY_H
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Type-indexed registry of the objects systems depend on.
+ *
+ * Every service type T (a concrete class or an interface such as
+ * IWindModel) gets a dense index from serviceTypeId<T>() on first use, so a
+ * lookup is one bounds check and one array load: no string hashing and no
+ * dynamic_cast. Objects are stored as the pointer type they were registered
+ * under, so get<T>() returns a correctly adjusted T* even with multiple
+ * inheritance.
+ *
+ * The registry can own services (add()) or only expose objects owned
+ * elsewhere (provide()), e.g. to publish a system under an interface it
+ * implements. Owned services are destroyed in reverse order of addition,
+ * so a service may hold references to services added before it.
+ *
+ * Registration happens on the main thread during start-up; lookups are
+ * read-only and may run on worker threads once registration is done.
+ *
+ * Usage:
+ * @code
+ * IWindModel &wind = services.add<IWindModel>(std::make_unique<PerlinWindModel>(...));
+ * services.provide<IAudioSink>(audioSystem);
+ * IWindModel *model = services.get<IWindModel>();
+ * @endcode
+ */
+class ServiceRegistry
+{
+public:
+    ServiceRegistry() = default;
+    ServiceRegistry(const ServiceRegistry &) = delete;
+    ServiceRegistry &operator=(const ServiceRegistry &) = delete;
+
+    /**
+     * @brief Destroy the owned services, newest first.
+     */
+    ~ServiceRegistry();
+
+    /**
+     * @brief Take ownership of a service and register it under type Interface.
+     *
+     * Registering a type that is already registered replaces the lookup
+     * entry; an object owned under the old entry stays alive until the
+     * registry is destroyed, since others may still refer to it.
+     *
+     * @tparam Interface Type the service is looked up by (T or a base of T)
+     * @tparam T Concrete type of the service
+     * @param service Service to own (must not be null)
+     * @return Reference to the service as Interface
+     */
+    template <typename Interface, typename T>
+    Interface &add(std::unique_ptr<T> service)
+    {
+        static_assert(std::is_base_of<Interface, T>::value, "Services must be registered under their own type or a base");
+        Interface *typed = service.get();
+        owned_.reserve(owned_.size() + 1);
+        owned_.push_back(OwnedService{service.release(), [](void *ptr)
+                                      { delete static_cast<T *>(ptr); }});
+        provide<Interface>(typed);
+        return *typed;
+    }
+
+    /**
+     * @brief Register an object owned elsewhere under type Interface.
+     *
+     * @tparam Interface Type the object is looked up by
+     * @param service Object to expose (nullptr removes the entry)
+     */
+    template <typename Interface>
+    void provide(Interface *service)
+    {
+        const std::size_t index = serviceTypeId<Interface>();
+        if (index >= slots_.size())
+        {
+            slots_.resize(index + 1, nullptr);
+        }
+        slots_[index] = service;
+    }
+
+    /**
+     * @brief Look up the service registered under type T.
+     *
+     * @tparam T Type the service was registered under
+     * @return Pointer to the service, or nullptr if none is registered
+     */
+    template <typename T>
+    T *get() const
+    {
+        const std::size_t index = serviceTypeId<T>();
+        return index < slots_.size() ? static_cast<T *>(slots_[index]) : nullptr;
+    }
+
+    /**
+     * @brief Check whether a service is registered under type T.
+     *
+     * @tparam T Type to check
+     * @return true if get<T>() would return a service
+     */
+    template <typename T>
+    bool has() const { return get<T>() != nullptr; }
+
+    /**
+     * @brief Get the dense index of service type T, assigning one on first use.
+     *
+     * Indices are process-wide, so every registry uses the same index for T.
+     *
+     * @tparam T Service type
+     * @return The dense service type index
+     */
+    template <typename T>
+    static std::size_t serviceTypeId()
+    {
+        static const std::size_t index = registerServiceType();
+        return index;
+    }
+
+private:
+    /**
+     * @brief Owned service together with the deleter of its concrete type.
+     */
+    struct OwnedService
+    {
+        void *ptr;               /**< Service object */
+        void (*destroy)(void *); /**< Deletes ptr as its concrete type */
+    };
+
+    /** @brief Assign the next dense service type index */
+    static std::size_t registerServiceType();
+
+    std::vector<void *> slots_;        /**< Service type index -> service (already cast to that type) */
+    std::vector<OwnedService> owned_;  /**< Owned services in order of addition */
+};
+
+#endif
@@ -1,5 +1,7 @@
 #include "SimClock.h"
 #include "debug.h"
+#include <algorithm>
+#include <cmath>
 
 /**
  * @brief Construct a simulation clock with a fixed timestep.
@@ -8,57 +10,117 @@
  * the accumulator to zero.
  *
  * @param fixedTimestep The fixed time step for physics simulation in seconds
+ * @param maxSubsteps Maximum physics steps granted per tick (at least 1)
  */
-SimClock::SimClock(float fixedTimestep) : fixedTimestep_(fixedTimestep), accumulator_(0.0f)
+SimClock::SimClock(float fixedTimestep, int maxSubsteps)
+    : fixedTimestep_(fixedTimestep > 0.0f ? fixedTimestep : 0.01),
+      accumulator_(0.0),
+      timeScale_(1.0),
+      simulationTime_(0.0),
+      droppedTime_(0.0),
+      stepCount_(0),
+      maxSubsteps_(std::max(maxSubsteps, 1)),
+      stepsThisTick_(0),
+      stepsRemaining_(0),
+      requestedSteps_(0),
+      paused_(false)
 {
-    DEBUG_LOG("Creating SimClock with fixed timestep " + std::to_string(fixedTimestep));
+    DEBUG_LOG("Creating SimClock with fixed timestep " + std::to_string(fixedTimestep_) +
+              " (" + std::to_string(1.0 / fixedTimestep_) + " Hz), max substeps " + std::to_string(maxSubsteps_));
 }
 
 /**
  * @brief Advance the simulation clock by the given delta time.
  *
- * This method accumulates the real time that has passed, which will be
- * used to determine when physics steps should occur.
+ * Accumulates scaled real time and works out how many whole steps it covers.
+ * If that exceeds the substep cap, the excess is dropped so the simulation
+ * slows down instead of falling further behind each frame. Steps requested
+ * with requestStep() are granted on top, paused or not.
  *
- * @param deltaTime Time elapsed since the last tick in seconds
+ * Called once per frame, so unlike shouldStepPhysics() it may log.
+ *
+ * @param deltaTime Real time elapsed since the last tick in seconds
  */
 void SimClock::tick(float deltaTime)
 {
-    DEBUG_LOG("Ticking SimClock with deltaTime " + std::to_string(deltaTime) + ", accumulator now " + std::to_string(accumulator_ + deltaTime));
-    accumulator_ += deltaTime;
+    if (!paused_ && deltaTime > 0.0f)
+    {
+        accumulator_ += static_cast<double>(deltaTime) * timeScale_;
+    }
+
+    int steps = static_cast<int>(accumulator_ / fixedTimestep_);
+    if (steps > maxSubsteps_)
+    {
+        const double excess = accumulator_ - maxSubsteps_ * fixedTimestep_;
+        // Keep the fractional part so the alpha stays continuous
+        const double kept = std::fmod(excess, fixedTimestep_);
+        droppedTime_ += excess - kept;
+        accumulator_ = maxSubsteps_ * fixedTimestep_ + kept;
+        steps = maxSubsteps_;
+        DEBUG_LOG("SimClock falling behind, dropped " + std::to_string(excess - kept) + "s (total " + std::to_string(droppedTime_) + "s)");
+    }
+
+    // Explicit single steps run without consuming accumulated time
+    stepsRemaining_ = steps + requestedSteps_;
+    stepsThisTick_ = stepsRemaining_;
+    requestedSteps_ = 0;
 }
 
 /**
  * @brief Check if a physics step should be performed.
  *
- * This implements the fixed timestep logic. If enough time has accumulated
- * (at least one fixed timestep), it consumes that time and returns true.
- * This ensures physics simulation runs at a consistent rate.
+ * This implements the fixed timestep logic. If the current tick still has
+ * steps left, it consumes one timestep of accumulated time and returns true.
+ * Called up to several thousand times per second, so it never logs.
  *
  * @return true if physics should step, false otherwise
  */
 bool SimClock::shouldStepPhysics()
 {
+    if (stepsRemaining_ <= 0)
+    {
+        return false;
+    }
+
+    --stepsRemaining_;
     if (accumulator_ >= fixedTimestep_)
     {
-        DEBUG_LOG("Physics step triggered, accumulator " + std::to_string(accumulator_) + " >= " + std::to_string(fixedTimestep_));
         accumulator_ -= fixedTimestep_;
-        return true;
     }
-    DEBUG_LOG("No physics step, accumulator " + std::to_string(accumulator_) + " < " + std::to_string(fixedTimestep_));
-    return false;
+    simulationTime_ += fixedTimestep_;
+    ++stepCount_;
+    return true;
 }
 
 /**
- * @brief Get the fixed timestep value.
+ * @brief Move the clock to another point in simulated time, e.g. after a rewind.
  *
- * Returns the fixed timestep that was set during construction.
+ * Accumulated time and steps still pending for this tick are discarded, so
+ * the next step continues from the restored state.
  *
- * @return The fixed timestep in seconds
+ * @param simulationTime Simulated time of the restored state in seconds
+ * @param stepCount Step count of the restored state
  */
-float SimClock::getFixedTimestep()
+void SimClock::restoreTime(double simulationTime, unsigned long long stepCount)
 {
-    DEBUG_LOG("Getting fixed timestep: " + std::to_string(fixedTimestep_));
-    return fixedTimestep_;
+    simulationTime_ = simulationTime;
+    stepCount_ = stepCount;
+    accumulator_ = 0.0;
+    stepsRemaining_ = 0;
+    requestedSteps_ = 0;
 }
 
+/**
+ * @brief Change the fixed timestep.
+ *
+ * Accumulated time is kept, so the change takes effect from the next step.
+ *
+ * @param fixedTimestep New step length in seconds (must be positive)
+ */
+void SimClock::setFixedTimestep(float fixedTimestep)
+{
+    if (fixedTimestep > 0.0f)
+    {
+        fixedTimestep_ = fixedTimestep;
+    }
+}
@@ -6,7 +6,18 @@
  *
  * The SimClock implements a fixed timestep system for physics simulation,
  * accumulating real time and determining when physics steps should occur.
- * This ensures consistent physics behavior regardless of frame rate.
+ * This ensures consistent physics behavior regardless of frame rate, and
+ * decouples the physics rate (e.g. 1-2 kHz) from the render rate.
+ *
+ * Each frame the engine calls tick() once, then steps physics while
+ * shouldStepPhysics() returns true. At most maxSubsteps steps are granted
+ * per tick; time beyond that is dropped (and counted) so a slow frame
+ * cannot trigger a spiral of ever longer frames. After the steps,
+ * getAlpha() gives how far real time has advanced into the next step, for
+ * blending the previous and current physics states when rendering.
+ *
+ * Time is accumulated in double precision so sub-millisecond steps do not
+ * drift over long sessions.
  */
 class SimClock
 {
@@ -15,16 +26,18 @@ public:
      * @brief Construct a simulation clock with a fixed timestep.
      *
      * @param fixedTimestep The fixed time step for physics simulation in seconds
+     * @param maxSubsteps Maximum physics steps granted per tick (at least 1)
      */
-    SimClock(float fixedTimestep);
+    SimClock(float fixedTimestep, int maxSubsteps = 10);
 
     /**
      * @brief Advance the simulation clock by the given delta time.
      *
-     * Adds the delta time to the accumulator, which tracks how much time
-     * has passed since the last physics step.
+     * Adds the delta time, multiplied by the time scale, to the accumulator.
+     * Does nothing while paused. Accumulated time beyond maxSubsteps steps
+     * is discarded.
      *
-     * @param deltaTime Time elapsed since the last tick in seconds
+     * @param deltaTime Real time elapsed since the last tick in seconds
      */
     void tick(float deltaTime);
 
@@ -38,17 +51,130 @@ public:
      */
     bool shouldStepPhysics();
 
+    /**
+     * @brief Queue exactly one physics step, even while paused.
+     *
+     * Used for single-stepping a paused simulation.
+     */
+    void requestStep() { ++requestedSteps_; }
+
     /**
      * @brief Get the fixed timestep value.
      *
      * @return The fixed timestep in seconds
      */
-    float getFixedTimestep();
+    float getFixedTimestep() const { return static_cast<float>(fixedTimestep_); }
+
+    /**
+     * @brief Change the fixed timestep.
+     *
+     * @param fixedTimestep New step length in seconds (must be positive)
+     */
+    void setFixedTimestep(float fixedTimestep);
+
+    /**
+     * @brief Set the maximum number of physics steps granted per tick.
+     *
+     * @param maxSubsteps Step cap (values below 1 are treated as 1)
+     */
+    void setMaxSubsteps(int maxSubsteps) { maxSubsteps_ = maxSubsteps < 1 ? 1 : maxSubsteps; }
+
+    /**
+     * @brief Get the maximum number of physics steps granted per tick.
+     *
+     * @return Step cap
+     */
+    int getMaxSubsteps() const { return maxSubsteps_; }
+
+    /**
+     * @brief Set the ratio of simulated time to real time.
+     *
+     * @param timeScale 1 for real time, 0.5 for half speed, 2 for double speed (negative values are treated as 0)
+     */
+    void setTimeScale(float timeScale) { timeScale_ = timeScale < 0.0f ? 0.0 : timeScale; }
+
+    /**
+     * @brief Get the ratio of simulated time to real time.
+     *
+     * @return Time scale
+     */
+    float getTimeScale() const { return static_cast<float>(timeScale_); }
+
+    /**
+     * @brief Pause or resume the simulation.
+     *
+     * While paused, tick() accumulates nothing; the interpolation alpha is frozen.
+     *
+     * @param paused true to pause
+     */
+    void setPaused(bool paused) { paused_ = paused; }
+
+    /**
+     * @brief Check whether the simulation is paused.
+     *
+     * @return true if paused
+     */
+    bool isPaused() const { return paused_; }
+
+    /**
+     * @brief Get the interpolation factor between the previous and current physics states.
+     *
+     * @return Accumulated time as a fraction of one step, in [0, 1)
+     */
+    float getAlpha() const { return static_cast<float>(accumulator_ / fixedTimestep_); }
+
+    /**
+     * @brief Get the simulated time covered by all physics steps so far.
+     *
+     * @return Simulation time in seconds
+     */
+    double getSimulationTime() const { return simulationTime_; }
+
+    /**
+     * @brief Get the number of physics steps taken so far.
+     *
+     * @return Step count
+     */
+    unsigned long long getStepCount() const { return stepCount_; }
+
+    /**
+     * @brief Move the clock to another point in simulated time, e.g. after a rewind.
+     *
+     * Accumulated time and steps still pending for this tick are discarded.
+     *
+     * @param simulationTime Simulated time of the restored state in seconds
+     * @param stepCount Step count of the restored state
+     */
+    void restoreTime(double simulationTime, unsigned long long stepCount);
+
+    /**
+     * @brief Get the number of steps granted by the last tick().
+     *
+     * @return Steps taken (or still to take) for the current frame
+     */
+    int getStepsThisTick() const { return stepsThisTick_; }
+
+    /**
+     * @brief Get the scaled time discarded because of the substep cap.
+     *
+     * Non-zero values mean the machine cannot keep up with the physics rate.
+     *
+     * @return Dropped time in seconds since construction
+     */
+    double getDroppedTime() const { return droppedTime_; }
 
 private:
-    float fixedTimestep_; /**< The fixed time step for physics simulation */
-    float accumulator_;   /**< Accumulated time since last physics step */
+    double fixedTimestep_;               /**< The fixed time step for physics simulation */
+    double accumulator_;                 /**< Accumulated time since last physics step */
+    double timeScale_;                   /**< Simulated seconds per real second */
+    double simulationTime_;              /**< Simulated time of all steps taken */
+    double droppedTime_;                 /**< Time discarded by the substep cap */
+    unsigned long long stepCount_;       /**< Steps taken since construction */
+    int maxSubsteps_;                    /**< Steps granted per tick at most */
+    int stepsThisTick_;                  /**< Steps granted by the last tick */
+    int stepsRemaining_;                 /**< Steps still to take this tick */
+    int requestedSteps_;                 /**< Single steps requested while paused */
+    bool paused_;                        /**< Whether tick() accumulates time */
 };
 
 #endif
-
@@ -0,0 +1,533 @@
+#include "SpatialIndex.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <queue>
+#include <utility>
+
+namespace
+{
+    Frustum::Plane makePlane(float a, float b, float c, float d)
+    {
+        const float length = std::sqrt(a * a + b * b + c * c);
+        const float scale = length > 0.0f ? 1.0f / length : 0.0f;
+        Frustum::Plane plane;
+        plane.normal = Vector3D(a * scale, b * scale, c * scale);
+        plane.distance = d * scale;
+        return plane;
+    }
+}
+
+/**
+ * @brief Extract the planes of a view-projection matrix.
+ *
+ * With clip = p * M each clip coordinate is a dot product with a column of
+ * M, so the planes are sums and differences of the fourth column with the
+ * other three.
+ *
+ * @param viewProjection Combined view and projection matrix
+ * @return Frustum The normalized planes
+ */
+Frustum Frustum::fromMatrix(const Matrix4 &viewProjection)
+{
+    const float *m = viewProjection.m;
+    auto plane = [m](float sign, int k)
+    {
+        return makePlane(m[3] + sign * m[k], m[7] + sign * m[4 + k], m[11] + sign * m[8 + k], m[15] + sign * m[12 + k]);
+    };
+
+    Frustum frustum;
+    frustum.planes[0] = plane(1.0f, 0);  // Left: w + x >= 0
+    frustum.planes[1] = plane(-1.0f, 0); // Right: w - x >= 0
+    frustum.planes[2] = plane(1.0f, 1);  // Bottom
+    frustum.planes[3] = plane(-1.0f, 1); // Top
+    frustum.planes[4] = plane(1.0f, 2);  // Near
+    frustum.planes[5] = plane(-1.0f, 2); // Far
+    return frustum;
+}
+
+/**
+ * @brief Construct an empty index.
+ *
+ * @param margin Distance by which leaf boxes are enlarged on each side
+ */
+SpatialIndex::SpatialIndex(float margin) : margin_(margin) {}
+
+/**
+ * @brief Insert an entity's bounds.
+ *
+ * @param bounds Tight bounds of the entity
+ * @param entity Entity the proxy stands for
+ * @return Id of the new proxy
+ */
+SpatialIndex::ProxyId SpatialIndex::createProxy(const Aabb &bounds, EntityHandle entity)
+{
+    const std::int32_t leaf = allocateNode();
+    Node &node = nodes_[leaf];
+    node.tight = bounds;
+    node.fat = fatten(bounds);
+    node.entity = entity;
+    node.height = 0;
+    insertLeaf(leaf);
+    ++proxyCount_;
+    return leaf;
+}
+
+/**
+ * @brief Remove a proxy.
+ *
+ * @param proxy Id returned by createProxy()
+ */
+void SpatialIndex::destroyProxy(ProxyId proxy)
+{
+    removeLeaf(proxy);
+    freeNode(proxy);
+    --proxyCount_;
+}
+
+/**
+ * @brief Update a proxy's bounds.
+ *
+ * @param proxy Id returned by createProxy()
+ * @param bounds New tight bounds
+ * @return true if the proxy left its fat box and was reinserted
+ */
+bool SpatialIndex::moveProxy(ProxyId proxy, const Aabb &bounds)
+{
+    Node &node = nodes_[proxy];
+    node.tight = bounds;
+    if (node.fat.contains(bounds))
+    {
+        return false;
+    }
+
+    removeLeaf(proxy);
+    nodes_[proxy].fat = fatten(bounds);
+    insertLeaf(proxy);
+    return true;
+}
+
+/**
+ * @brief Find every entity whose bounds overlap a box.
+ *
+ * @param box Query box
+ * @param results Receives the entities (cleared first)
+ */
+void SpatialIndex::queryAabb(const Aabb &box, std::vector<EntityHandle> &results) const
+{
+    results.clear();
+    if (root_ == Null)
+        return;
+
+    std::int32_t stack[MaxStackDepth];
+    int top = 0;
+    stack[top++] = root_;
+    while (top > 0)
+    {
+        const Node &node = nodes_[stack[--top]];
+        if (!node.fat.overlaps(box))
+            continue;
+
+        if (node.child1 == Null)
+        {
+            if (node.tight.overlaps(box))
+                results.push_back(node.entity);
+        }
+        else
+        {
+            stack[top++] = node.child1;
+            stack[top++] = node.child2;
+        }
+    }
+}
+
+/**
+ * @brief Find every entity whose bounds intersect a sphere.
+ *
+ * @param center Sphere center
+ * @param radius Sphere radius
+ * @param results Receives the entities (cleared first)
+ */
+void SpatialIndex::querySphere(const Vector3D &center, float radius, std::vector<EntityHandle> &results) const
+{
+    results.clear();
+    if (root_ == Null)
+        return;
+
+    const float radiusSq = radius * radius;
+    std::int32_t stack[MaxStackDepth];
+    int top = 0;
+    stack[top++] = root_;
+    while (top > 0)
+    {
+        const Node &node = nodes_[stack[--top]];
+        if (node.fat.distanceSq(center) > radiusSq)
+            continue;
+
+        if (node.child1 == Null)
+        {
+            if (node.tight.distanceSq(center) <= radiusSq)
+                results.push_back(node.entity);
+        }
+        else
+        {
+            stack[top++] = node.child1;
+            stack[top++] = node.child2;
+        }
+    }
+}
+
+/**
+ * @brief Find every entity whose bounds are at least partly inside a frustum.
+ *
+ * Each stack entry carries the planes its box still straddles. A box fully
+ * inside a plane drops it for the whole subtree, so subtrees fully inside
+ * the frustum are collected without further plane tests.
+ *
+ * @param frustum View frustum
+ * @param results Receives the entities (cleared first)
+ */
+void SpatialIndex::queryFrustum(const Frustum &frustum, std::vector<EntityHandle> &results) const
+{
+    results.clear();
+    if (root_ == Null)
+        return;
+
+    std::pair<std::int32_t, std::uint8_t> stack[MaxStackDepth];
+    int top = 0;
+    stack[top++] = {root_, 0x3F};
+    while (top > 0)
+    {
+        const auto [index, parentMask] = stack[--top];
+        const Node &node = nodes_[index];
+        const Aabb &box = node.child1 == Null ? node.tight : node.fat;
+
+        std::uint8_t mask = parentMask;
+        bool outside = false;
+        for (int i = 0; i < 6; ++i)
+        {
+            if ((mask & (1u << i)) == 0)
+                continue;
+
+            const Frustum::Plane &plane = frustum.planes[i];
+            const Vector3D &n = plane.normal;
+            // Corner farthest along the normal decides "outside", the opposite one "fully inside"
+            const float farthest = n.x * (n.x >= 0.0f ? box.max.x : box.min.x) + n.y * (n.y >= 0.0f ? box.max.y : box.min.y) +
+                                   n.z * (n.z >= 0.0f ? box.max.z : box.min.z) + plane.distance;
+            if (farthest < 0.0f)
+            {
+                outside = true;
+                break;
+            }
+            const float nearest = n.x * (n.x >= 0.0f ? box.min.x : box.max.x) + n.y * (n.y >= 0.0f ? box.min.y : box.max.y) +
+                                  n.z * (n.z >= 0.0f ? box.min.z : box.max.z) + plane.distance;
+            if (nearest >= 0.0f)
+                mask &= static_cast<std::uint8_t>(~(1u << i));
+        }
+        if (outside)
+            continue;
+
+        if (node.child1 == Null)
+        {
+            results.push_back(node.entity);
+        }
+        else
+        {
+            stack[top++] = {node.child1, mask};
+            stack[top++] = {node.child2, mask};
+        }
+    }
+}
+
+/**
+ * @brief Find the entities whose bounds are nearest to a point.
+ *
+ * Best-first search: nodes are expanded in order of their box distance,
+ * and the search stops once the nearest unexpanded node is farther than
+ * the current k-th result.
+ *
+ * @param point Query point
+ * @param count Number of entities to return at most
+ * @param results Receives the entities, nearest first (cleared first)
+ * @param maxDistance Ignore entities farther away than this
+ */
+void SpatialIndex::queryNearest(const Vector3D &point, std::size_t count, std::vector<EntityHandle> &results,
+                                float maxDistance) const
+{
+    results.clear();
+    if (root_ == Null || count == 0)
+        return;
+
+    using Entry = std::pair<float, std::int32_t>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open; // Nearest node first
+    std::priority_queue<Entry> best;                                          // Farthest kept result first
+    const float maxDistanceSq = maxDistance < std::sqrt(std::numeric_limits<float>::max())
+                                    ? maxDistance * maxDistance
+                                    : std::numeric_limits<float>::max();
+    auto bound = [&]()
+    { return best.size() == count ? best.top().first : maxDistanceSq; };
+
+    open.push({nodes_[root_].fat.distanceSq(point), root_});
+    while (!open.empty())
+    {
+        const Entry entry = open.top();
+        open.pop();
+        if (entry.first > bound())
+            break;
+
+        const Node &node = nodes_[entry.second];
+        if (node.child1 == Null)
+        {
+            const float distanceSq = node.tight.distanceSq(point);
+            if (distanceSq <= bound())
+            {
+                if (best.size() == count)
+                    best.pop();
+                best.push({distanceSq, entry.second});
+            }
+            continue;
+        }
+
+        for (std::int32_t child : {node.child1, node.child2})
+        {
+            const float distanceSq = nodes_[child].fat.distanceSq(point);
+            if (distanceSq <= bound())
+                open.push({distanceSq, child});
+        }
+    }
+
+    results.resize(best.size());
+    for (std::size_t i = best.size(); i-- > 0;)
+    {
+        results[i] = nodes_[best.top().second].entity;
+        best.pop();
+    }
+}
+
+/**
+ * @brief Remove every proxy.
+ */
+void SpatialIndex::clear()
+{
+    nodes_.clear();
+    root_ = Null;
+    freeList_ = Null;
+    proxyCount_ = 0;
+}
+
+std::int32_t SpatialIndex::allocateNode()
+{
+    if (freeList_ == Null)
+    {
+        // Grow the pool and thread the new nodes onto the free list
+        const std::int32_t first = static_cast<std::int32_t>(nodes_.size());
+        const std::int32_t grown = std::max<std::int32_t>(16, first);
+        nodes_.resize(static_cast<std::size_t>(first + grown));
+        for (std::int32_t i = first; i < first + grown; ++i)
+        {
+            nodes_[i].parent = i + 1 < first + grown ? i + 1 : Null;
+            nodes_[i].height = -1;
+        }
+        freeList_ = first;
+    }
+
+    const std::int32_t index = freeList_;
+    Node &node = nodes_[index];
+    freeList_ = node.parent;
+    node.parent = Null;
+    node.child1 = Null;
+    node.child2 = Null;
+    node.height = 0;
+    node.entity = EntityHandle();
+    return index;
+}
+
+void SpatialIndex::freeNode(std::int32_t node)
+{
+    nodes_[node].parent = freeList_;
+    nodes_[node].height = -1;
+    freeList_ = node;
+}
+
+/**
+ * @brief Insert a leaf next to the sibling that increases total surface area least.
+ */
+void SpatialIndex::insertLeaf(std::int32_t leaf)
+{
+    if (root_ == Null)
+    {
+        root_ = leaf;
+        nodes_[leaf].parent = Null;
+        return;
+    }
+
+    const Aabb leafBox = nodes_[leaf].fat;
+    std::int32_t index = root_;
+    while (nodes_[index].child1 != Null)
+    {
+        const Node &node = nodes_[index];
+        const float area = node.fat.surfaceArea();
+        const float combinedArea = node.fat.merged(leafBox).surfaceArea();
+
+        // Cost of pairing the leaf with this node, and the growth every descendant choice inherits
+        const float cost = 2.0f * combinedArea;
+        const float inheritance = 2.0f * (combinedArea - area);
+
+        auto descendCost = [&](std::int32_t child)
+        {
+            const Node &c = nodes_[child];
+            const float merged = c.fat.merged(leafBox).surfaceArea();
+            return (c.child1 == Null ? merged : merged - c.fat.surfaceArea()) + inheritance;
+        };
+        const float cost1 = descendCost(node.child1);
+        const float cost2 = descendCost(node.child2);
+
+        if (cost < cost1 && cost < cost2)
+            break;
+        index = cost1 < cost2 ? node.child1 : node.child2;
+    }
+
+    const std::int32_t sibling = index;
+    const std::int32_t oldParent = nodes_[sibling].parent;
+    const std::int32_t newParent = allocateNode();
+    Node &parent = nodes_[newParent];
+    parent.parent = oldParent;
+    parent.fat = leafBox.merged(nodes_[sibling].fat);
+    parent.height = nodes_[sibling].height + 1;
+    parent.child1 = sibling;
+    parent.child2 = leaf;
+    nodes_[sibling].parent = newParent;
+    nodes_[leaf].parent = newParent;
+
+    if (oldParent == Null)
+    {
+        root_ = newParent;
+    }
+    else if (nodes_[oldParent].child1 == sibling)
+    {
+        nodes_[oldParent].child1 = newParent;
+    }
+    else
+    {
+        nodes_[oldParent].child2 = newParent;
+    }
+
+    refitAncestors(nodes_[leaf].parent);
+}
+
+/**
+ * @brief Detach a leaf, replacing its parent by its sibling.
+ */
+void SpatialIndex::removeLeaf(std::int32_t leaf)
+{
+    if (leaf == root_)
+    {
+        root_ = Null;
+        return;
+    }
+
+    const std::int32_t parent = nodes_[leaf].parent;
+    const std::int32_t grandParent = nodes_[parent].parent;
+    const std::int32_t sibling = nodes_[parent].child1 == leaf ? nodes_[parent].child2 : nodes_[parent].child1;
+
+    if (grandParent == Null)
+    {
+        root_ = sibling;
+        nodes_[sibling].parent = Null;
+        freeNode(parent);
+        return;
+    }
+
+    if (nodes_[grandParent].child1 == parent)
+        nodes_[grandParent].child1 = sibling;
+    else
+        nodes_[grandParent].child2 = sibling;
+    nodes_[sibling].parent = grandParent;
+    freeNode(parent);
+    refitAncestors(grandParent);
+}
+
+/**
+ * @brief Rebalance and recompute bounds and heights from a node up to the root.
+ */
+void SpatialIndex::refitAncestors(std::int32_t index)
+{
+    while (index != Null)
+    {
+        index = balance(index);
+        Node &node = nodes_[index];
+        const Node &child1 = nodes_[node.child1];
+        const Node &child2 = nodes_[node.child2];
+        node.height = 1 + std::max(child1.height, child2.height);
+        node.fat = child1.fat.merged(child2.fat);
+        index = node.parent;
+    }
+}
+
+/**
+ * @brief Rotate the taller child of a node up if the children's heights differ by more than one.
+ *
+ * @return Index of the node now at the position of the given one
+ */
+std::int32_t SpatialIndex::balance(std::int32_t iA)
+{
+    Node &a = nodes_[iA];
+    if (a.child1 == Null || a.height < 2)
+        return iA;
+
+    const std::int32_t iB = a.child1;
+    const std::int32_t iC = a.child2;
+    Node &b = nodes_[iB];
+    Node &c = nodes_[iC];
+    const std::int32_t heightDifference = c.height - b.height;
+
+    // Rotate whichever child is too tall into A's place; A takes the grandchild that keeps heights even
+    auto rotateUp = [&](std::int32_t iUp, Node &up, Node &other, bool upIsChild2) -> std::int32_t
+    {
+        const std::int32_t iF = up.child1;
+        const std::int32_t iG = up.child2;
+        Node &f = nodes_[iF];
+        Node &g = nodes_[iG];
+
+        up.child1 = iA;
+        up.parent = a.parent;
+        a.parent = iUp;
+        if (up.parent == Null)
+            root_ = iUp;
+        else if (nodes_[up.parent].child1 == iA)
+            nodes_[up.parent].child1 = iUp;
+        else
+            nodes_[up.parent].child2 = iUp;
+
+        const bool keepF = f.height > g.height;
+        const std::int32_t iKeep = keepF ? iF : iG;
+        const std::int32_t iGive = keepF ? iG : iF;
+        Node &keep = nodes_[iKeep];
+        Node &give = nodes_[iGive];
+
+        up.child2 = iKeep;
+        if (upIsChild2)
+            a.child2 = iGive;
+        else
+            a.child1 = iGive;
+        give.parent = iA;
+
+        a.fat = other.fat.merged(give.fat);
+        a.height = 1 + std::max(other.height, give.height);
+        up.fat = a.fat.merged(keep.fat);
+        up.height = 1 + std::max(a.height, keep.height);
+        return iUp;
+    };
+
+    if (heightDifference > 1)
+        return rotateUp(iC, c, b, true);
+    if (heightDifference < -1)
+        return rotateUp(iB, b, c, false);
+    return iA;
+}
+
+Aabb SpatialIndex::fatten(const Aabb &bounds) const
+{
+    return Aabb{Vector3D(bounds.min.x - margin_, bounds.min.y - margin_, bounds.min.z - margin_),
+                Vector3D(bounds.max.x + margin_, bounds.max.y + margin_, bounds.max.z + margin_)};
+}
@@ -0,0 +1,296 @@
+#ifndef SPATIALINDEX_H
+#define SPATIALINDEX_H
+
+#include "EntityHandle.h"
+#include "Matrix4.h"
+#include "Vector3D.h"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/**
+ * @brief Axis-aligned bounding box.
+ */
+struct Aabb
+{
+    Vector3D min; /**< Smallest corner */
+    Vector3D max; /**< Largest corner */
+
+    /**
+     * @brief Check whether another box lies entirely inside this one.
+     *
+     * @param other Box to test
+     * @return true if other is contained
+     */
+    bool contains(const Aabb &other) const
+    {
+        return min.x <= other.min.x && min.y <= other.min.y && min.z <= other.min.z &&
+               max.x >= other.max.x && max.y >= other.max.y && max.z >= other.max.z;
+    }
+
+    /**
+     * @brief Check whether two boxes intersect (touching counts).
+     *
+     * @param other Box to test
+     * @return true if the boxes overlap
+     */
+    bool overlaps(const Aabb &other) const
+    {
+        return min.x <= other.max.x && max.x >= other.min.x && min.y <= other.max.y && max.y >= other.min.y &&
+               min.z <= other.max.z && max.z >= other.min.z;
+    }
+
+    /**
+     * @brief Get the smallest box containing two boxes.
+     *
+     * @param other Box to merge with
+     * @return The union of both boxes
+     */
+    Aabb merged(const Aabb &other) const
+    {
+        return Aabb{Vector3D(min.x < other.min.x ? min.x : other.min.x, min.y < other.min.y ? min.y : other.min.y,
+                             min.z < other.min.z ? min.z : other.min.z),
+                    Vector3D(max.x > other.max.x ? max.x : other.max.x, max.y > other.max.y ? max.y : other.max.y,
+                             max.z > other.max.z ? max.z : other.max.z)};
+    }
+
+    /**
+     * @brief Get the surface area, the cost metric of the tree.
+     *
+     * @return Surface area of the box
+     */
+    float surfaceArea() const
+    {
+        const float dx = max.x - min.x, dy = max.y - min.y, dz = max.z - min.z;
+        return 2.0f * (dx * dy + dy * dz + dz * dx);
+    }
+
+    /**
+     * @brief Get the squared distance from a point to the box.
+     *
+     * @param point Point to measure from
+     * @return 0 if the point is inside, otherwise the squared distance to the nearest surface point
+     */
+    float distanceSq(const Vector3D &point) const
+    {
+        const float dx = point.x < min.x ? min.x - point.x : (point.x > max.x ? point.x - max.x : 0.0f);
+        const float dy = point.y < min.y ? min.y - point.y : (point.y > max.y ? point.y - max.y : 0.0f);
+        const float dz = point.z < min.z ? min.z - point.z : (point.z > max.z ? point.z - max.z : 0.0f);
+        return dx * dx + dy * dy + dz * dz;
+    }
+};
+
+/**
+ * @brief View frustum as six inward-facing planes.
+ *
+ * A point p is inside plane i when dot(normal, p) + distance >= 0.
+ */
+struct Frustum
+{
+    /**
+     * @brief Plane in Hessian normal form.
+     */
+    struct Plane
+    {
+        Vector3D normal;       /**< Unit normal pointing into the frustum */
+        float distance = 0.0f; /**< Signed offset from the origin */
+    };
+
+    Plane planes[6]; /**< Left, right, bottom, top, near, far */
+
+    /**
+     * @brief Extract the planes of a view-projection matrix.
+     *
+     * Expects the row-vector convention of Matrix4 (clip = p * viewProjection)
+     * and OpenGL clip space (-w <= z <= w).
+     *
+     * @param viewProjection Combined view and projection matrix
+     * @return Frustum The normalized planes
+     */
+    static Frustum fromMatrix(const Matrix4 &viewProjection);
+};
+
+/**
+ * @brief Dynamic bounding volume hierarchy over entity bounds.
+ *
+ * A binary tree of axis-aligned boxes, kept height-balanced by rotations as
+ * proxies are inserted and removed, with each insertion placed by the
+ * surface-area heuristic. Leaves store the entity's tight bounds plus a
+ * "fat" box enlarged by a margin; moving a proxy only touches the tree when
+ * the tight bounds leave the fat box, so jittering or slowly moving
+ * objects cost nothing but a containment test.
+ *
+ * Queries are const and allocation-free apart from their output (k-nearest
+ * uses a small heap), so any number of threads may query concurrently as
+ * long as nobody modifies the tree at the same time.
+ */
+class SpatialIndex
+{
+public:
+    /** @brief Identifies a proxy (a leaf of the tree) */
+    using ProxyId = std::int32_t;
+
+    /** @brief ProxyId that refers to no proxy */
+    static constexpr ProxyId InvalidProxy = -1;
+
+    /** @brief Margin added around tight bounds when none is given */
+    static constexpr float DefaultMargin = 0.5f;
+
+    /**
+     * @brief Construct an empty index.
+     *
+     * @param margin Distance by which leaf boxes are enlarged on each side
+     */
+    explicit SpatialIndex(float margin = DefaultMargin);
+
+    /**
+     * @brief Insert an entity's bounds.
+     *
+     * @param bounds Tight bounds of the entity
+     * @param entity Entity the proxy stands for
+     * @return Id of the new proxy
+     */
+    ProxyId createProxy(const Aabb &bounds, EntityHandle entity);
+
+    /**
+     * @brief Remove a proxy.
+     *
+     * @param proxy Id returned by createProxy()
+     */
+    void destroyProxy(ProxyId proxy);
+
+    /**
+     * @brief Update a proxy's bounds.
+     *
+     * @param proxy Id returned by createProxy()
+     * @param bounds New tight bounds
+     * @return true if the proxy left its fat box and was reinserted
+     */
+    bool moveProxy(ProxyId proxy, const Aabb &bounds);
+
+    /**
+     * @brief Record a proxy's new bounds if they still fit in its fat box.
+     *
+     * Never changes the tree, so it may be called concurrently for
+     * different proxies (e.g. from a parallel refit); the proxies it
+     * rejects are then passed to moveProxy() one at a time.
+     *
+     * @param proxy Id returned by createProxy()
+     * @param bounds New tight bounds
+     * @return false if the bounds left the fat box and were not recorded
+     */
+    bool setBounds(ProxyId proxy, const Aabb &bounds)
+    {
+        Node &node = nodes_[proxy];
+        if (!node.fat.contains(bounds))
+            return false;
+        node.tight = bounds;
+        return true;
+    }
+
+    /**
+     * @brief Get a proxy's tight bounds.
+     *
+     * @param proxy Id returned by createProxy()
+     * @return Bounds last passed to createProxy() or moveProxy()
+     */
+    const Aabb &getBounds(ProxyId proxy) const { return nodes_[proxy].tight; }
+
+    /**
+     * @brief Get the entity a proxy stands for.
+     *
+     * @param proxy Id returned by createProxy()
+     * @return Entity handle
+     */
+    EntityHandle getEntity(ProxyId proxy) const { return nodes_[proxy].entity; }
+
+    /**
+     * @brief Find every entity whose bounds overlap a box.
+     *
+     * @param box Query box
+     * @param results Receives the entities (cleared first)
+     */
+    void queryAabb(const Aabb &box, std::vector<EntityHandle> &results) const;
+
+    /**
+     * @brief Find every entity whose bounds intersect a sphere.
+     *
+     * @param center Sphere center
+     * @param radius Sphere radius
+     * @param results Receives the entities (cleared first)
+     */
+    void querySphere(const Vector3D &center, float radius, std::vector<EntityHandle> &results) const;
+
+    /**
+     * @brief Find every entity whose bounds are at least partly inside a frustum.
+     *
+     * @param frustum View frustum
+     * @param results Receives the entities (cleared first)
+     */
+    void queryFrustum(const Frustum &frustum, std::vector<EntityHandle> &results) const;
+
+    /**
+     * @brief Find the entities whose bounds are nearest to a point.
+     *
+     * @param point Query point
+     * @param count Number of entities to return at most
+     * @param results Receives the entities, nearest first (cleared first)
+     * @param maxDistance Ignore entities farther away than this
+     */
+    void queryNearest(const Vector3D &point, std::size_t count, std::vector<EntityHandle> &results,
+                      float maxDistance = std::numeric_limits<float>::max()) const;
+
+    /**
+     * @brief Get the number of proxies.
+     *
+     * @return Proxy count
+     */
+    std::size_t getProxyCount() const { return proxyCount_; }
+
+    /**
+     * @brief Get the height of the tree.
+     *
+     * @return 0 for an empty tree or a single leaf
+     */
+    int getHeight() const { return root_ == Null ? 0 : nodes_[root_].height; }
+
+    /**
+     * @brief Remove every proxy.
+     */
+    void clear();
+
+private:
+    static constexpr std::int32_t Null = -1;
+    static constexpr int MaxStackDepth = 256; /**< Traversal stack; balanced trees stay far below it */
+
+    /**
+     * @brief Node of the tree; leaves have child1 == Null.
+     */
+    struct Node
+    {
+        Aabb fat;                   /**< Enlarged bounds (leaves) or union of the children */
+        Aabb tight;                 /**< Exact bounds (leaves only) */
+        EntityHandle entity;        /**< Entity of a leaf */
+        std::int32_t parent = Null; /**< Parent node, or next free node while unused */
+        std::int32_t child1 = Null; /**< First child */
+        std::int32_t child2 = Null; /**< Second child */
+        std::int32_t height = -1;   /**< 0 for leaves, -1 for free nodes */
+    };
+
+    std::int32_t allocateNode();
+    void freeNode(std::int32_t node);
+    void insertLeaf(std::int32_t leaf);
+    void removeLeaf(std::int32_t leaf);
+    void refitAncestors(std::int32_t node);
+    std::int32_t balance(std::int32_t node);
+    Aabb fatten(const Aabb &bounds) const;
+
+    std::vector<Node> nodes_;         /**< Node pool */
+    std::int32_t root_ = Null;        /**< Root node */
+    std::int32_t freeList_ = Null;    /**< First unused node */
+    std::size_t proxyCount_ = 0;      /**< Leaves in the tree */
+    float margin_;                    /**< Fat box enlargement */
+};
+
+#endif
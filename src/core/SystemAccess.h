@@ -0,0 +1,124 @@
+#ifndef SYSTEMACCESS_H
+#define SYSTEMACCESS_H
+
+#include "ComponentTypeId.h"
+
+/**
+ * @brief Declares which component types a system reads and writes.
+ *
+ * The SystemScheduler uses these declarations to decide which systems may
+ * run concurrently: two systems conflict when either writes a component type
+ * the other reads or writes, or when either is exclusive. Conflicting systems
+ * keep their registration order; everything else may overlap on worker threads.
+ *
+ * A default-constructed SystemAccess is exclusive and main-thread bound, which
+ * reproduces the old strictly serial behaviour for systems that declare nothing.
+ *
+ * Usage:
+ * @code
+ * SystemAccess getAccess() const override
+ * {
+ *     return SystemAccess().read<PhysicsC>().write<TransformC>();
+ * }
+ * @endcode
+ */
+class SystemAccess
+{
+public:
+    /**
+     * @brief Declare read access to component type T.
+     *
+     * Marks the access as declared, so the system is no longer exclusive.
+     *
+     * @tparam T Component type read by the system
+     * @return Reference to this access set for chaining
+     */
+    template <typename T>
+    SystemAccess &read()
+    {
+        reads_.set(componentTypeId<T>());
+        declared_ = true;
+        return *this;
+    }
+
+    /**
+     * @brief Declare write access to component type T.
+     *
+     * Marks the access as declared, so the system is no longer exclusive.
+     *
+     * @tparam T Component type written by the system
+     * @return Reference to this access set for chaining
+     */
+    template <typename T>
+    SystemAccess &write()
+    {
+        writes_.set(componentTypeId<T>());
+        declared_ = true;
+        return *this;
+    }
+
+    /**
+     * @brief Require the system to run on the thread that drives the update.
+     *
+     * Use this for systems that touch thread-affine state such as the
+     * OpenGL context or the window message queue.
+     *
+     * @return Reference to this access set for chaining
+     */
+    SystemAccess &mainThread()
+    {
+        mainThread_ = true;
+        return *this;
+    }
+
+    /**
+     * @brief Check whether the system touches undeclared shared state.
+     *
+     * @return true if nothing was declared (the system conflicts with every other system)
+     */
+    bool isExclusive() const { return !declared_; }
+
+    /**
+     * @brief Check whether the system must run on the driving thread.
+     *
+     * @return true if the system is main-thread bound (always true for exclusive systems)
+     */
+    bool requiresMainThread() const { return mainThread_ || !declared_; }
+
+    /**
+     * @brief Get the set of component types read.
+     *
+     * @return Component mask of read types
+     */
+    const ComponentMask &getReads() const { return reads_; }
+
+    /**
+     * @brief Get the set of component types written.
+     *
+     * @return Component mask of written types
+     */
+    const ComponentMask &getWrites() const { return writes_; }
+
+    /**
+     * @brief Check whether two systems must not run at the same time.
+     *
+     * @param other Access set of the other system
+     * @return true if either is exclusive or one writes what the other touches
+     */
+    bool conflictsWith(const SystemAccess &other) const
+    {
+        if (isExclusive() || other.isExclusive())
+            return true;
+
+        return (writes_ & (other.reads_ | other.writes_)).any() ||
+               (other.writes_ & reads_).any();
+    }
+
+private:
+    ComponentMask reads_;     /**< Component types read */
+    ComponentMask writes_;    /**< Component types written */
+    bool declared_ = false;   /**< Whether any access was declared */
+    bool mainThread_ = false; /**< Whether the system is bound to the driving thread */
+};
+
+#endif
@@ -0,0 +1,290 @@
+#include "SystemScheduler.h"
+#include "Profiler.h"
+#include <iostream>
+
+/**
+ * @brief Construct a schedule for the given systems.
+ *
+ * @param systems Systems in registration order (not owned)
+ */
+SystemSchedule::SystemSchedule(std::vector<ISystem *> systems)
+{
+    setSystems(std::move(systems));
+}
+
+/**
+ * @brief Replace the scheduled systems and rebuild the dependency graph.
+ *
+ * @param systems Systems in registration order (not owned)
+ */
+void SystemSchedule::setSystems(std::vector<ISystem *> systems)
+{
+    systems_ = std::move(systems);
+    build();
+}
+
+/**
+ * @brief Build the dependency graph from the systems' declared access.
+ *
+ * Adds an edge from every system to each later system it conflicts with,
+ * so conflicting systems keep their registration order and all others are
+ * free to overlap.
+ */
+void SystemSchedule::build()
+{
+    const std::size_t count = systems_.size();
+
+    std::vector<SystemAccess> access;
+    access.reserve(count);
+    for (ISystem *system : systems_)
+    {
+        access.push_back(system->getAccess());
+    }
+
+    nodes_.assign(count, Node{false, 0, {}});
+    bool allMainThread = true;
+    bool chain = true;
+
+    for (std::size_t later = 0; later < count; ++later)
+    {
+        nodes_[later].mainThread = access[later].requiresMainThread();
+        allMainThread = allMainThread && nodes_[later].mainThread;
+
+        for (std::size_t earlier = 0; earlier < later; ++earlier)
+        {
+            if (access[later].conflictsWith(access[earlier]))
+            {
+                nodes_[earlier].successors.push_back(static_cast<std::uint32_t>(later));
+                ++nodes_[later].predecessorCount;
+            }
+        }
+
+        if (later > 0 && !access[later].conflictsWith(access[later - 1]))
+        {
+            chain = false;
+        }
+    }
+
+    serial_ = chain || allMainThread;
+}
+
+/**
+ * @brief Construct a scheduler.
+ *
+ * @param jobSystem Job system that runs worker-thread systems, or nullptr to run serially
+ */
+SystemScheduler::SystemScheduler(JobSystem *jobSystem) : jobSystem_(jobSystem)
+{
+}
+
+/**
+ * @brief Update every system in a schedule once.
+ *
+ * Releases systems that have no predecessors, then lets the calling thread
+ * run main-thread systems and help the job system with the others until
+ * every system has completed.
+ *
+ * @param world World passed to each system's update
+ * @param schedule Dependency graph to execute
+ * @param dt Time step passed to each system's update
+ */
+void SystemScheduler::run(World &world, const SystemSchedule &schedule, float dt)
+{
+    if (!parallelEnabled_ || jobSystem_ == nullptr || !jobSystem_->isRunning() || schedule.isSerial())
+    {
+        runSerial(world, schedule, dt);
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    schedule_ = &schedule;
+    world_ = &world;
+    dt_ = dt;
+    error_ = nullptr;
+    remaining_ = schedule.size();
+    pending_.resize(schedule.size());
+
+    for (std::uint32_t i = 0; i < schedule.size(); ++i)
+    {
+        pending_[i] = schedule.nodes_[i].predecessorCount;
+        if (pending_[i] == 0)
+        {
+            dispatch(i);
+        }
+    }
+
+    while (remaining_ > 0)
+    {
+        if (!mainQueue_.empty())
+        {
+            const std::uint32_t index = mainQueue_.front();
+            mainQueue_.pop_front();
+
+            lock.unlock();
+            execute(index);
+            lock.lock();
+            complete(index);
+            continue;
+        }
+
+        lock.unlock();
+        const bool helped = jobSystem_->runPendingJob();
+        lock.lock();
+
+        if (!helped && remaining_ > 0 && mainQueue_.empty())
+        {
+            mainWake_.wait(lock);
+        }
+    }
+
+    schedule_ = nullptr;
+    world_ = nullptr;
+
+    if (error_)
+    {
+        std::exception_ptr error = error_;
+        error_ = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+/**
+ * @brief Run every system inline in registration order.
+ *
+ * @param world World passed to each system's update
+ * @param schedule Schedule whose systems are run
+ * @param dt Time step passed to each system's update
+ */
+void SystemScheduler::runSerial(World &world, const SystemSchedule &schedule, float dt)
+{
+    const std::vector<ISystem *> &systems = schedule.getSystems();
+    for (std::uint32_t i = 0; i < systems.size(); ++i)
+    {
+        try
+        {
+            ProfileScope scope(systems[i]->getName());
+            systems[i]->update(world, dt);
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "ERROR updating system " << systems[i]->getName()
+                      << " (index: " << i << "): " << e.what() << std::endl;
+            throw;
+        }
+        catch (...)
+        {
+            std::cerr << "UNKNOWN ERROR updating system " << systems[i]->getName()
+                      << " (index: " << i << ")" << std::endl;
+            throw;
+        }
+    }
+}
+
+/**
+ * @brief Hand a ready system to the thread that must run it.
+ *
+ * Main-thread systems are queued for the driving thread; all others are
+ * submitted to the job system. Called with the lock held.
+ *
+ * @param index Position of the system in the schedule
+ */
+void SystemScheduler::dispatch(std::uint32_t index)
+{
+    if (schedule_->nodes_[index].mainThread)
+    {
+        mainQueue_.push_back(index);
+        mainWake_.notify_one();
+        return;
+    }
+
+    jobSystem_->schedule([this, index]
+                         {
+        execute(index);
+        std::lock_guard<std::mutex> lock(mutex_);
+        complete(index); });
+}
+
+/**
+ * @brief Update one system, capturing any exception it throws.
+ *
+ * Does nothing if an earlier system in this run has already failed.
+ * The update is recorded as a profiler scope named after the system.
+ * Called without the lock held.
+ *
+ * @param index Position of the system in the schedule
+ */
+void SystemScheduler::execute(std::uint32_t index)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (error_)
+            return;
+    }
+
+    try
+    {
+        ISystem *system = schedule_->systems_[index];
+        ProfileScope scope(system->getName());
+        system->update(*world_, dt_);
+    }
+    catch (const std::exception &e)
+    {
+        reportError(index, e.what());
+    }
+    catch (...)
+    {
+        reportError(index, nullptr);
+    }
+}
+
+/**
+ * @brief Mark a system finished and release the systems waiting on it.
+ *
+ * Called with the lock held.
+ *
+ * @param index Position of the system in the schedule
+ */
+void SystemScheduler::complete(std::uint32_t index)
+{
+    for (std::uint32_t successor : schedule_->nodes_[index].successors)
+    {
+        if (--pending_[successor] == 0)
+        {
+            dispatch(successor);
+        }
+    }
+
+    if (--remaining_ == 0)
+    {
+        mainWake_.notify_one();
+    }
+}
+
+/**
+ * @brief Log a failed system and keep the first exception for rethrowing.
+ *
+ * Must be called from inside the catch block handling the exception.
+ *
+ * @param index Position of the system in the schedule
+ * @param message Exception message, or nullptr for a non-standard exception
+ */
+void SystemScheduler::reportError(std::uint32_t index, const char *message)
+{
+    ISystem *system = schedule_->systems_[index];
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (message != nullptr)
+    {
+        std::cerr << "ERROR updating system " << system->getName()
+                  << " (index: " << index << "): " << message << std::endl;
+    }
+    else
+    {
+        std::cerr << "UNKNOWN ERROR updating system " << system->getName()
+                  << " (index: " << index << ")" << std::endl;
+    }
+
+    if (!error_)
+    {
+        error_ = std::current_exception();
+    }
+}
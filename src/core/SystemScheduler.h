@@ -0,0 +1,189 @@
+#ifndef SYSTEMSCHEDULER_H
+#define SYSTEMSCHEDULER_H
+
+#include "ISystem.h"
+#include "JobSystem.h"
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class World;
+
+/**
+ * @brief Dependency graph for an ordered list of systems.
+ *
+ * For every pair of systems whose access sets conflict, the one registered
+ * later depends on the one registered earlier. Systems without a path
+ * between them may run at the same time. The graph is built once from the
+ * systems' declared access and reused every frame.
+ */
+class SystemSchedule
+{
+public:
+    /**
+     * @brief Construct an empty schedule.
+     */
+    SystemSchedule() = default;
+
+    /**
+     * @brief Construct a schedule for the given systems.
+     *
+     * @param systems Systems in registration order (not owned)
+     */
+    explicit SystemSchedule(std::vector<ISystem *> systems);
+
+    /**
+     * @brief Replace the scheduled systems and rebuild the dependency graph.
+     *
+     * @param systems Systems in registration order (not owned)
+     */
+    void setSystems(std::vector<ISystem *> systems);
+
+    /**
+     * @brief Get the scheduled systems in registration order.
+     *
+     * @return Const reference to the system list
+     */
+    const std::vector<ISystem *> &getSystems() const { return systems_; }
+
+    /**
+     * @brief Get the number of scheduled systems.
+     *
+     * @return System count
+     */
+    std::size_t size() const { return systems_.size(); }
+
+    /**
+     * @brief Check whether the graph leaves no room for concurrency.
+     *
+     * True when every system depends on its predecessor, or all systems are
+     * main-thread bound; such schedules are run inline in registration order.
+     *
+     * @return true if the schedule is effectively serial
+     */
+    bool isSerial() const { return serial_; }
+
+    /**
+     * @brief Get the systems that must finish before a system may start.
+     *
+     * @param index Position of the system in registration order
+     * @return Number of direct predecessors
+     */
+    std::uint32_t getPredecessorCount(std::size_t index) const { return nodes_[index].predecessorCount; }
+
+    /**
+     * @brief Get the systems that wait for a system to finish.
+     *
+     * @param index Position of the system in registration order
+     * @return Indices of direct successors
+     */
+    const std::vector<std::uint32_t> &getSuccessors(std::size_t index) const { return nodes_[index].successors; }
+
+private:
+    friend class SystemScheduler;
+
+    /**
+     * @brief One system in the dependency graph.
+     */
+    struct Node
+    {
+        bool mainThread;                       /**< Must run on the driving thread */
+        std::uint32_t predecessorCount;        /**< Number of systems that must finish first */
+        std::vector<std::uint32_t> successors; /**< Systems released when this one finishes */
+    };
+
+    void build();
+
+    std::vector<ISystem *> systems_; /**< Systems in registration order */
+    std::vector<Node> nodes_;        /**< Graph node per system */
+    bool serial_ = true;             /**< Whether the graph is a single chain */
+};
+
+/**
+ * @brief Runs a SystemSchedule, overlapping non-conflicting systems on a JobSystem.
+ *
+ * Main-thread systems (including every exclusive system) run on the thread
+ * that calls run(); the others are submitted as jobs as soon as all of their
+ * predecessors have finished, and the calling thread helps with them while
+ * it has nothing else to do. Schedules with no concurrency, or a scheduler
+ * without a running job system, run inline exactly as a plain loop would.
+ *
+ * If a system throws, systems that have not started yet are skipped and the
+ * first exception is rethrown from run() after in-flight systems complete.
+ */
+class SystemScheduler
+{
+public:
+    /**
+     * @brief Construct a scheduler.
+     *
+     * @param jobSystem Job system that runs worker-thread systems, or nullptr to run serially
+     */
+    explicit SystemScheduler(JobSystem *jobSystem = nullptr);
+
+    SystemScheduler(const SystemScheduler &) = delete;
+    SystemScheduler &operator=(const SystemScheduler &) = delete;
+
+    /**
+     * @brief Update every system in a schedule once.
+     *
+     * @param world World passed to each system's update
+     * @param schedule Dependency graph to execute
+     * @param dt Time step passed to each system's update
+     */
+    void run(World &world, const SystemSchedule &schedule, float dt);
+
+    /**
+     * @brief Enable or disable parallel execution.
+     *
+     * @param enabled false forces every schedule to run serially on the calling thread
+     */
+    void setParallelEnabled(bool enabled) { parallelEnabled_ = enabled; }
+
+    /**
+     * @brief Check whether parallel execution is enabled.
+     *
+     * @return true if non-conflicting systems may overlap
+     */
+    bool isParallelEnabled() const { return parallelEnabled_; }
+
+    /**
+     * @brief Set the job system used for worker-thread systems.
+     *
+     * @param jobSystem Job system, or nullptr to run every schedule serially
+     */
+    void setJobSystem(JobSystem *jobSystem) { jobSystem_ = jobSystem; }
+
+    /**
+     * @brief Get the job system used for worker-thread systems.
+     *
+     * @return Job system, or nullptr if none is set
+     */
+    JobSystem *getJobSystem() const { return jobSystem_; }
+
+private:
+    void runSerial(World &world, const SystemSchedule &schedule, float dt);
+    void dispatch(std::uint32_t index);
+    void execute(std::uint32_t index);
+    void complete(std::uint32_t index);
+    void reportError(std::uint32_t index, const char *message);
+
+    JobSystem *jobSystem_;          /**< Runs worker-thread systems (not owned) */
+    bool parallelEnabled_ = true;   /**< Whether parallel runs are allowed */
+
+    std::mutex mutex_;                          /**< Guards all per-run state below */
+    std::condition_variable mainWake_;          /**< Signals the driving thread */
+    std::deque<std::uint32_t> mainQueue_;       /**< Ready systems bound to the driving thread */
+    std::vector<std::uint32_t> pending_;        /**< Unfinished predecessors per system */
+    std::size_t remaining_ = 0;                 /**< Systems not yet completed this run */
+    const SystemSchedule *schedule_ = nullptr;  /**< Schedule being run */
+    World *world_ = nullptr;                    /**< World being updated */
+    float dt_ = 0.0f;                           /**< Time step of the current run */
+    std::exception_ptr error_;                  /**< First exception thrown this run */
+};
+
+#endif
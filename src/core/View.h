@@ -0,0 +1,203 @@
+#ifndef VIEW_H
+#define VIEW_H
+
+#include "Archetype.h"
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Iterable view over all entities that have every component in Ts.
+ *
+ * A view walks the archetypes matching its component set (cached and kept
+ * up to date by ComponentStorage) and reads components straight out of the
+ * contiguous archetype columns, with no per-entity lookup.
+ *
+ * Entities must not gain or lose components while a view is being iterated.
+ *
+ * Usage:
+ * @code
+ * for (auto [entity, transform, renderable] : world.view<TransformC, RenderableC>())
+ * {
+ *     ...
+ * }
+ *
+ * world.view<TransformC>().each([](Entity &entity, TransformC &transform) { ... });
+ * @endcode
+ *
+ * @tparam Ts Component types every visited entity must have
+ */
+template <typename... Ts>
+class View
+{
+public:
+    static_assert(sizeof...(Ts) > 0, "A view needs at least one component type");
+
+    /** @brief Value produced when dereferencing a view iterator */
+    using value_type = std::tuple<Entity &, Ts &...>;
+
+    /**
+     * @brief Build the component mask for this view's component set.
+     *
+     * @return Mask with one bit set per component type in Ts
+     */
+    static ComponentMask mask()
+    {
+        ComponentMask result;
+        for (ComponentTypeId typeId : typeIds())
+        {
+            result.set(typeId);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Construct a view over a cached list of matching archetypes.
+     *
+     * @param archetypes Archetypes whose signature contains every type in Ts
+     */
+    explicit View(const std::vector<Archetype *> &archetypes) : archetypes_(&archetypes) {}
+
+    /**
+     * @brief Forward iterator over matching entities.
+     */
+    class Iterator
+    {
+    public:
+        Iterator(const std::vector<Archetype *> *archetypes, std::size_t archetypeIndex)
+            : archetypes_(archetypes), archetypeIndex_(archetypeIndex), row_(0)
+        {
+            skipEmpty();
+        }
+
+        value_type operator*() const
+        {
+            return dereference(std::index_sequence_for<Ts...>());
+        }
+
+        Iterator &operator++()
+        {
+            if (++row_ >= (*archetypes_)[archetypeIndex_]->size())
+            {
+                ++archetypeIndex_;
+                row_ = 0;
+                skipEmpty();
+            }
+            return *this;
+        }
+
+        bool operator==(const Iterator &other) const
+        {
+            return archetypeIndex_ == other.archetypeIndex_ && row_ == other.row_;
+        }
+
+        bool operator!=(const Iterator &other) const { return !(*this == other); }
+
+    private:
+        void skipEmpty()
+        {
+            while (archetypeIndex_ < archetypes_->size() && (*archetypes_)[archetypeIndex_]->size() == 0)
+            {
+                ++archetypeIndex_;
+            }
+            if (archetypeIndex_ < archetypes_->size())
+            {
+                bindColumns((*archetypes_)[archetypeIndex_], std::index_sequence_for<Ts...>());
+            }
+        }
+
+        template <std::size_t... Is>
+        void bindColumns(Archetype *archetype, std::index_sequence<Is...>)
+        {
+            ((std::get<Is>(columns_) = archetype->getColumn(typeIds()[Is])->template data<std::remove_const_t<Ts>>()), ...);
+        }
+
+        template <std::size_t... Is>
+        value_type dereference(std::index_sequence<Is...>) const
+        {
+            return value_type(*(*archetypes_)[archetypeIndex_]->getEntity(row_), std::get<Is>(columns_)[row_]...);
+        }
+
+        const std::vector<Archetype *> *archetypes_;
+        std::size_t archetypeIndex_;
+        std::size_t row_;
+        std::tuple<Ts *...> columns_;
+    };
+
+    Iterator begin() const { return Iterator(archetypes_, 0); }
+    Iterator end() const { return Iterator(archetypes_, archetypes_->size()); }
+
+    /**
+     * @brief Invoke a function for every matching entity.
+     *
+     * This is the fastest way to walk a view: component columns are
+     * resolved once per archetype and the inner loop indexes plain arrays.
+     *
+     * @param func Callable taking (Entity &, Ts &...)
+     */
+    template <typename Func>
+    void each(Func &&func) const
+    {
+        for (Archetype *archetype : *archetypes_)
+        {
+            eachInArchetype(*archetype, func, std::index_sequence_for<Ts...>());
+        }
+    }
+
+    /**
+     * @brief Count the entities currently matched by this view.
+     *
+     * @return Number of matching entities
+     */
+    std::size_t size() const
+    {
+        std::size_t count = 0;
+        for (const Archetype *archetype : *archetypes_)
+        {
+            count += archetype->size();
+        }
+        return count;
+    }
+
+    /**
+     * @brief Check whether the view matches no entities.
+     *
+     * @return true if no entity has all of the components
+     */
+    bool empty() const { return size() == 0; }
+
+    /**
+     * @brief Get the archetypes visited by this view.
+     *
+     * @return Const reference to the cached archetype list
+     */
+    const std::vector<Archetype *> &getArchetypes() const { return *archetypes_; }
+
+private:
+    static const std::array<ComponentTypeId, sizeof...(Ts)> &typeIds()
+    {
+        static const std::array<ComponentTypeId, sizeof...(Ts)> ids = {componentTypeId<std::remove_const_t<Ts>>()...};
+        return ids;
+    }
+
+    template <typename Func, std::size_t... Is>
+    static void eachInArchetype(Archetype &archetype, Func &func, std::index_sequence<Is...>)
+    {
+        const std::size_t count = archetype.size();
+        if (count == 0)
+            return;
+
+        std::tuple<Ts *...> columns(archetype.getColumn(typeIds()[Is])->template data<std::remove_const_t<Ts>>()...);
+        const std::vector<Entity *> &entities = archetype.getEntities();
+        for (std::size_t row = 0; row < count; ++row)
+        {
+            func(*entities[row], std::get<Is>(columns)[row]...);
+        }
+    }
+
+    const std::vector<Archetype *> *archetypes_; /**< Cached matching archetypes (owned by ComponentStorage) */
+};
+
+#endif
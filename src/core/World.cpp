@@ -1,6 +1,28 @@
 #include "World.h"
+#include "Profiler.h"
+#include "../components/TransformC.h"
 #include <iostream>
 #include "debug.h"
+#include <atomic>
+
+namespace
+{
+    std::atomic<std::uint64_t> nextWorldSerial{1};
+
+    /**
+     * @brief Last command buffer looked up by this thread.
+     *
+     * Keyed by World serial rather than address so a World allocated where a
+     * destroyed one used to live never sees the old buffer.
+     */
+    struct CachedCommandBuffer
+    {
+        std::uint64_t worldSerial = 0;   /**< Serial of the World owning buffer */
+        CommandBuffer *buffer = nullptr; /**< Buffer of this thread in that World */
+    };
+
+    thread_local CachedCommandBuffer cachedCommandBuffer;
+}
 
 /**
  * @brief Construct a world with an event bus for communication.
@@ -10,7 +32,7 @@
  *
  * @param eventBus Reference to the event bus used for inter-system communication
  */
-World::World(EventBus &eventBus) : eventBus_(eventBus)
+World::World(EventBus &eventBus) : eventBus_(eventBus), serial_(nextWorldSerial.fetch_add(1))
 {
     DEBUG_LOG("Creating World with EventBus");
 }
@@ -19,83 +41,365 @@ World::World(EventBus &eventBus) : eventBus_(eventBus)
  * @brief Add an entity to the world.
  *
  * The world takes ownership of the entity through the unique pointer,
- * ensuring proper memory management and lifetime control.
+ * ensuring proper memory management and lifetime control. Components the
+ * entity already carries are moved into the archetype storage. A slot is
+ * popped from the free list (or appended) and the entity receives a handle
+ * carrying that slot's current generation.
  *
  * @param entity Unique pointer to the entity to add
+ * @return Generational handle of the added entity
  */
-void World::addEntity(std::unique_ptr<Entity> entity)
+EntityHandle World::addEntity(std::unique_ptr<Entity> entity)
 {
+    assignSlot(*entity);
     DEBUG_LOG("Adding entity with ID " + std::to_string(entity->getId()) + " to World");
+
+    componentStorage_.attach(*entity);
     entities_.push_back(std::move(entity));
+    return entities_.back()->handle_;
+}
+
+/**
+ * @brief Give an entity an ID (if it has none) and a slot in the entity table.
+ *
+ * Recycles a freed slot when one is available. The slot's dense index
+ * points at the end of entities_, where the caller appends the entity.
+ *
+ * @param entity Entity about to be appended to entities_
+ */
+void World::assignSlot(Entity &entity)
+{
+    if (entity.id_ == 0)
+    {
+        entity.id_ = nextEntityId_++;
+    }
+    else if (entity.id_ >= nextEntityId_)
+    {
+        nextEntityId_ = entity.id_ + 1;
+    }
+
+    std::uint32_t index;
+    if (freeSlotHead_ != EntityHandle::InvalidIndex)
+    {
+        index = freeSlotHead_;
+        freeSlotHead_ = slots_[index].nextFree;
+    }
+    else
+    {
+        index = static_cast<std::uint32_t>(slots_.size());
+        slots_.push_back(EntitySlot{0, EntityHandle::InvalidIndex, EntityHandle::InvalidIndex});
+    }
+
+    EntitySlot &slot = slots_[index];
+    slot.denseIndex = static_cast<std::uint32_t>(entities_.size());
+    slot.nextFree = EntityHandle::InvalidIndex;
+
+    entity.handle_.index = index;
+    entity.handle_.generation = slot.generation;
+}
+
+/**
+ * @brief Create a batch of entities as copies of a compiled prefab.
+ *
+ * Entities are given slots and appended one after another, then attached to
+ * the component storage in a single batch so the archetype's columns grow at
+ * most once. Transform overrides are written into the stored TransformC.
+ * If anything throws, the entities created so far are removed again, their
+ * slots are freed and handles is restored before the exception propagates.
+ *
+ * @param prefab Compiled template to copy
+ * @param count Number of entities to create
+ * @param handles Receives the handles of the new entities (appended)
+ * @param instances Per-instance overrides (count entries), or nullptr
+ */
+void World::instantiate(const Prefab &prefab, std::size_t count, std::vector<EntityHandle> &handles,
+                        const PrefabInstance *instances)
+{
+    PROFILE_SCOPE("World::instantiate");
+    if (count == 0)
+    {
+        return;
+    }
+
+    const std::size_t first = entities_.size();
+    const std::size_t firstHandle = handles.size();
+    entities_.reserve(first + count);
+    handles.reserve(firstHandle + count);
+    std::vector<Entity *> batch;
+    batch.reserve(count);
+    try
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            auto entity = std::make_unique<Entity>();
+            entity->name_ = instances != nullptr && !instances[i].name.empty() ? instances[i].name : prefab.getName();
+            entity->active_ = prefab.isActive();
+            entity->lifetime_ = prefab.getLifetime();
+            entity->customProperties_ = prefab.getCustomProperties();
+            assignSlot(*entity);
+            batch.push_back(entity.get());
+            handles.push_back(entity->handle_);
+            entities_.push_back(std::move(entity));
+        }
+
+        componentStorage_.attachPrefab(batch.data(), count, prefab);
+    }
+    catch (...)
+    {
+        // attachPrefab leaves none of the batch attached, so only the table entries remain
+        for (std::size_t i = entities_.size(); i > first; --i)
+        {
+            releaseSlot(entities_[i - 1]->handle_.index);
+        }
+        entities_.erase(entities_.begin() + static_cast<std::ptrdiff_t>(first), entities_.end());
+        handles.erase(handles.begin() + static_cast<std::ptrdiff_t>(firstHandle), handles.end());
+        throw;
+    }
+
+    if (instances != nullptr && prefab.getMask().test(componentTypeId<TransformC>()))
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            TransformC &transform = *entities_[first + i]->getComponent<TransformC>();
+            transform.position = instances[i].position;
+            transform.previousPosition = instances[i].position;
+            transform.rotation = instances[i].rotation;
+            transform.scale = instances[i].scale;
+        }
+    }
+}
+
+/**
+ * @brief Create an empty entity owned by the world.
+ *
+ * @param name Optional entity name
+ * @return Reference to the new entity (valid until it is destroyed)
+ */
+Entity &World::createEntity(const std::string &name)
+{
+    auto entity = std::make_unique<Entity>();
+    entity->setName(name);
+    return *getEntity(addEntity(std::move(entity)));
+}
+
+/**
+ * @brief Destroy an entity in O(1).
+ *
+ * Detaches the entity's components from the archetype storage, swap-removes
+ * it from the dense entity list, patches the slot of the entity that moved
+ * into its place, then bumps the freed slot's generation and pushes it onto
+ * the free list.
+ *
+ * @param handle Handle of the entity to destroy
+ * @return true if the entity was alive and has been destroyed
+ */
+bool World::destroyEntity(EntityHandle handle)
+{
+    if (!isAlive(handle))
+    {
+        return false;
+    }
+
+    const std::uint32_t denseIndex = slots_[handle.index].denseIndex;
+
+    componentStorage_.detach(*entities_[denseIndex]);
+
+    const std::uint32_t lastIndex = static_cast<std::uint32_t>(entities_.size() - 1);
+    if (denseIndex != lastIndex)
+    {
+        entities_[denseIndex] = std::move(entities_[lastIndex]);
+        slots_[entities_[denseIndex]->handle_.index].denseIndex = denseIndex;
+    }
+    entities_.pop_back();
+
+    releaseSlot(handle.index);
+    return true;
 }
 
 /**
- * @brief Add a system to the world.
+ * @brief Return a slot to the free list.
  *
- * Systems are stored in the order they are added and will be updated
- * in that same order during the world's update cycle.
+ * Bumping the generation invalidates every handle that still names the slot.
  *
- * @param system Unique pointer to the system to add
+ * @param index Slot to free
  */
-void World::addSystem(std::unique_ptr<ISystem> system)
+void World::releaseSlot(std::uint32_t index)
+{
+    EntitySlot &slot = slots_[index];
+    ++slot.generation;
+    slot.denseIndex = EntityHandle::InvalidIndex;
+    slot.nextFree = freeSlotHead_;
+    freeSlotHead_ = index;
+}
+
+/**
+ * @brief Get the calling thread's command buffer.
+ *
+ * The common case is a thread-local cache hit. On a miss the thread's buffer
+ * is looked up (or created) under a lock, which only happens the first time
+ * a thread records into this World or after it switched between Worlds.
+ *
+ * @return Reference to the calling thread's command buffer
+ */
+CommandBuffer &World::getCommandBuffer()
+{
+    if (cachedCommandBuffer.worldSerial == serial_)
+    {
+        return *cachedCommandBuffer.buffer;
+    }
+
+    const std::thread::id thread = std::this_thread::get_id();
+    CommandBuffer *buffer = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(commandBuffersMutex_);
+        for (auto &entry : commandBuffers_)
+        {
+            if (entry.thread == thread)
+            {
+                buffer = entry.buffer.get();
+                break;
+            }
+        }
+        if (buffer == nullptr)
+        {
+            commandBuffers_.push_back(ThreadCommandBuffer{thread, std::make_unique<CommandBuffer>()});
+            buffer = commandBuffers_.back().buffer.get();
+        }
+    }
+
+    cachedCommandBuffer.worldSerial = serial_;
+    cachedCommandBuffer.buffer = buffer;
+    return *buffer;
+}
+
+/**
+ * @brief Apply every recorded command buffer.
+ *
+ * Reserves room for all spawned entities up front so the entity list and
+ * slot table grow at most once per flush, then replays each buffer in
+ * recording order. Commands whose target entity is no longer alive are
+ * skipped. Buffers are cleared but keep their capacity.
+ *
+ * @return Number of commands applied
+ */
+std::size_t World::flushCommands()
+{
+    PROFILE_SCOPE("World::flushCommands");
+
+    std::lock_guard<std::mutex> lock(commandBuffersMutex_);
+
+    std::size_t spawnCount = 0;
+    std::size_t commandCount = 0;
+    for (const auto &entry : commandBuffers_)
+    {
+        spawnCount += entry.buffer->getSpawnCount();
+        commandCount += entry.buffer->size();
+    }
+
+    if (commandCount == 0)
+    {
+        return 0;
+    }
+
+    entities_.reserve(entities_.size() + spawnCount);
+    slots_.reserve(entities_.size() + spawnCount);
+
+    for (auto &entry : commandBuffers_)
+    {
+        for (auto &command : entry.buffer->commands_)
+        {
+            switch (command.type)
+            {
+            case CommandBuffer::CommandType::Spawn:
+                addEntity(std::move(command.entity));
+                break;
+
+            case CommandBuffer::CommandType::Destroy:
+                destroyEntity(command.handle);
+                break;
+
+            case CommandBuffer::CommandType::AddComponent:
+                if (Entity *entity = getEntity(command.handle))
+                {
+                    componentStorage_.addComponent(*entity, command.typeId,
+                                                   ComponentRegistry::getInfo(command.typeId).fromBase(command.component.get()));
+                }
+                break;
+
+            case CommandBuffer::CommandType::RemoveComponent:
+                if (Entity *entity = getEntity(command.handle))
+                {
+                    componentStorage_.removeComponent(*entity, command.typeId);
+                }
+                break;
+            }
+        }
+        entry.buffer->clear();
+    }
+
+    return commandCount;
+}
+
+/**
+ * @brief Take ownership of a system and schedule it.
+ *
+ * Systems are stored in the order they are added; the dependency graph is
+ * rebuilt on the next update. addSystem() has already registered the system
+ * in the service registry.
+ *
+ * @param system System to add
+ */
+void World::storeSystem(std::unique_ptr<ISystem> system)
 {
     DEBUG_LOG("Adding system to World");
     systems_.push_back(std::move(system));
+    scheduleDirty_ = true;
 }
 
 /**
  * @brief Update all systems in the world.
  *
- * Iterates through all registered systems and calls their update methods,
- * passing the world reference and delta time. This is the main simulation
- * loop that drives all game logic.
+ * Rebuilds the system dependency graph if systems were added, then hands it
+ * to the scheduler. Systems with conflicting component access run in
+ * registration order; the rest may run concurrently on worker threads.
+ * Structural changes the systems recorded are applied afterwards.
+ * Exceptions thrown by a system are logged and rethrown to the engine.
  *
  * @param dt Time elapsed since the last update in seconds
  */
 void World::update(float dt)
 {
-    DEBUG_LOG("Updating World with dt " + std::to_string(dt));
+    PROFILE_SCOPE("World::update");
+
     // Static variable to control frequency of debug output
     static int frameCounter = 0;
     const int debugOutputFrequency = 300; // Show debug every 300 frames (every ~5 seconds at 60 fps)
     bool showDebug = (++frameCounter % debugOutputFrequency == 0);
 
-    if (showDebug)
+    if (scheduleDirty_ || schedule_.size() != systems_.size())
     {
-        DEBUG_LOG("---- Frame " + std::to_string(frameCounter) + " ----");
+        std::vector<ISystem *> systems;
+        systems.reserve(systems_.size());
+        for (auto &system : systems_)
+        {
+            systems.push_back(system.get());
+        }
+        schedule_.setSystems(std::move(systems));
+        scheduleDirty_ = false;
     }
 
-    int systemIndex = 0;
-    for (auto &system : systems_)
+    if (showDebug)
     {
-        try
-        {
-            // Debug output only periodically to avoid console spam
-            if (showDebug)
-            {
-                DEBUG_LOG("Updating system: " + std::string(system->getName()) + " (index: " + std::to_string(systemIndex) + ")");
-            }
-
-            system->update(*this, dt);
-            systemIndex++;
-        }
-        catch (const std::exception &e)
-        {
-            std::cerr << "ERROR updating system " << system->getName()
-                      << " (index: " << systemIndex << "): " << e.what() << std::endl;
-            throw; // Re-throw to handle it in the engine
-        }
-        catch (...)
-        {
-            std::cerr << "UNKNOWN ERROR updating system " << system->getName()
-                      << " (index: " << systemIndex << ")" << std::endl;
-            throw; // Re-throw to handle it in the engine
-        }
+        DEBUG_LOG("---- Frame " + std::to_string(frameCounter) + " ----");
+        DEBUG_LOG("Updating " + std::to_string(systems_.size()) + " systems (" +
+                  (schedule_.isSerial() ? "serial" : "parallel") + " schedule, dt " + std::to_string(dt) + ")");
     }
 
+    scheduler_.run(*this, schedule_, dt);
+    flushCommands();
+
     if (showDebug)
     {
         DEBUG_LOG("-----------------");
     }
 }
-
@@ -4,11 +4,18 @@
 #include "EventBus.h"
 #include "ISystem.h"
 #include "Entity.h"
+#include "EntityHandle.h"
+#include "View.h"
+#include "SystemScheduler.h"
+#include "CommandBuffer.h"
+#include "ServiceRegistry.h"
+#include "Prefab.h"
 #include <vector>
 #include <memory>
-#include <unordered_map>
-#include <functional>
+#include <mutex>
+#include <type_traits>
 #include <string>
+#include <thread>
 
 /**
  * @brief The central world class that manages all entities and systems in the ECS.
@@ -32,31 +39,150 @@ public:
      * @brief Add an entity to the world.
      *
      * The world takes ownership of the entity and will manage its lifetime.
+     * The entity's components are moved into the world's archetype storage,
+     * it is given a slot in the entity table (recycling a freed slot when one
+     * is available), and entities constructed with ID 0 get the next unique ID.
      *
      * @param entity Unique pointer to the entity to add
+     * @return Generational handle of the added entity
      */
-    void addEntity(std::unique_ptr<Entity> entity);
+    EntityHandle addEntity(std::unique_ptr<Entity> entity);
+
+    /**
+     * @brief Create an empty entity owned by the world.
+     *
+     * @param name Optional entity name
+     * @return Reference to the new entity (valid until it is destroyed)
+     */
+    Entity &createEntity(const std::string &name = "");
+
+    /**
+     * @brief Create a batch of entities as copies of a compiled prefab.
+     *
+     * Each instance gets the prefab's components, name, flags and custom
+     * properties; instances[i], if given, then overrides the transform and
+     * name of instance i. The entity table and the prefab's archetype are
+     * grown once for the whole batch. If a component copy throws, the batch
+     * is rolled back and the exception propagates.
+     *
+     * Must not be called while iterating getEntities() or a view.
+     *
+     * @param prefab Compiled template to copy
+     * @param count Number of entities to create
+     * @param handles Receives the handles of the new entities (appended)
+     * @param instances Per-instance overrides (count entries), or nullptr
+     */
+    void instantiate(const Prefab &prefab, std::size_t count, std::vector<EntityHandle> &handles,
+                     const PrefabInstance *instances = nullptr);
+
+    /**
+     * @brief Destroy an entity in O(1).
+     *
+     * The entity's components are destroyed, the last entity is moved into
+     * its place in getEntities(), and its slot is returned to the free list
+     * with a new generation so outstanding handles become stale.
+     *
+     * Must not be called while iterating getEntities() or a view; systems
+     * record the destruction in getCommandBuffer() instead.
+     *
+     * @param handle Handle of the entity to destroy
+     * @return true if the entity was alive and has been destroyed
+     */
+    bool destroyEntity(EntityHandle handle);
+
+    /**
+     * @brief Resolve a handle to its entity in O(1).
+     *
+     * @param handle Entity handle
+     * @return Pointer to the entity, or nullptr if the handle is stale or invalid
+     */
+    Entity *getEntity(EntityHandle handle)
+    {
+        if (!isAlive(handle))
+        {
+            return nullptr;
+        }
+        return entities_[slots_[handle.index].denseIndex].get();
+    }
+
+    /**
+     * @brief Check whether a handle refers to a live entity.
+     *
+     * @param handle Entity handle
+     * @return true if the entity exists and has not been destroyed
+     */
+    bool isAlive(EntityHandle handle) const
+    {
+        return handle.index < slots_.size() &&
+               slots_[handle.index].generation == handle.generation &&
+               slots_[handle.index].denseIndex != EntityHandle::InvalidIndex;
+    }
+
+    /**
+     * @brief Get the calling thread's command buffer.
+     *
+     * Systems record spawns, destructions and component additions/removals
+     * here during update; they take effect at the next flushCommands().
+     * Each thread gets its own buffer, so recording needs no locking.
+     *
+     * @return Reference to the calling thread's command buffer
+     */
+    CommandBuffer &getCommandBuffer();
+
+    /**
+     * @brief Apply every recorded command buffer.
+     *
+     * This is the sync point for structural changes. It must be called while
+     * no system is running; update() calls it after the systems have run.
+     *
+     * @return Number of commands applied
+     */
+    std::size_t flushCommands();
 
     /**
      * @brief Add a system to the world.
      *
-     * Systems are updated in the order they are added. The world takes
-     * ownership of the system and will manage its lifetime.
+     * Systems whose declared component access conflicts are updated in the
+     * order they are added. The world takes ownership of the system and will
+     * manage its lifetime. The system is also registered in the service
+     * registry under its static type T, which is what getSystem<T>() finds.
      *
+     * @tparam T Type the system is registered under (normally its concrete type)
      * @param system Unique pointer to the system to add
+     * @return Pointer to the added system
      */
-    void addSystem(std::unique_ptr<ISystem> system);
+    template <typename T>
+    T *addSystem(std::unique_ptr<T> system)
+    {
+        static_assert(std::is_base_of<ISystem, T>::value, "Systems must derive from ISystem");
+        T *typed = system.get();
+        services_.provide<T>(typed);
+        storeSystem(std::move(system));
+        return typed;
+    }
 
     /**
      * @brief Update all systems in the world.
      *
-     * This method iterates through all registered systems and calls their
-     * update methods with the current delta time.
+     * Runs every registered system once through the system scheduler, which
+     * overlaps systems whose declared component access does not conflict,
+     * then applies the structural changes they recorded.
      *
      * @param dt Time elapsed since the last update in seconds
      */
     void update(float dt);
 
+    /**
+     * @brief Get the scheduler used to run systems.
+     *
+     * Callers that update subsets of systems (e.g. fixed and variable
+     * timestep phases) can run their own SystemSchedule through it. Systems
+     * only run concurrently once a running JobSystem has been set on it.
+     *
+     * @return Reference to the system scheduler
+     */
+    SystemScheduler &getScheduler() { return scheduler_; }
+
     /**
      * @brief Get read-only access to all systems in the world.
      *
@@ -74,27 +200,37 @@ public:
     /**
      * @brief Get a system of a specific type from the world.
      *
-     * This method searches for the first system of the specified type T
-     * and returns a pointer to it. This provides type-safe system access
-     * without relying on magic indices.
+     * Resolves in O(1) through the service registry, without RTTI. Systems
+     * are found by the type they were added as; a system can be exposed
+     * under further types (e.g. an interface) with getServices().provide().
      *
-     * @tparam T The system type to search for
+     * @tparam T The system type to look up
      * @return Pointer to the system of type T, or nullptr if not found
      */
     template <typename T>
-    T *getSystem()
+    T *getSystem() const
     {
-        for (auto &system : systems_)
-        {
-            T *typedSystem = dynamic_cast<T *>(system.get());
-            if (typedSystem != nullptr)
-            {
-                return typedSystem;
-            }
-        }
-        return nullptr;
+        return services_.get<T>();
     }
 
+    /**
+     * @brief Get the registry of services shared between systems.
+     *
+     * Holds the objects systems depend on but that aren't systems themselves
+     * (physics models, the material manager) plus every added system, keyed
+     * by type.
+     *
+     * @return Reference to the service registry
+     */
+    ServiceRegistry &getServices() { return services_; }
+
+    /**
+     * @brief Get read-only access to the registry of shared services.
+     *
+     * @return Const reference to the service registry
+     */
+    const ServiceRegistry &getServices() const { return services_; }
+
     /**
      * @brief Get read-only access to all entities in the world.
      *
@@ -103,51 +239,88 @@ public:
     const std::vector<std::unique_ptr<Entity>> &getEntities() const { return entities_; }
 
     /**
-     * @brief Store a shared resource with the given name
+     * @brief Get a view over all entities that have every component in Ts.
      *
-     * This allows storing and retrieving shared resources that need to be accessed
-     * by multiple systems but aren't systems themselves, such as asset managers.
+     * The set of matching archetypes is cached per component set and updated
+     * incrementally as archetypes are created, so building a view is a single
+     * hash lookup and iterating it reads components from contiguous columns.
      *
-     * @tparam T The type of the resource
-     * @param name Unique name for the resource
-     * @param resource The resource to store
+     * @tparam Ts Required component types
+     * @return View over the matching entities
      */
-    template <typename T>
-    void storeSharedResource(const std::string &name, std::unique_ptr<T> resource)
+    template <typename... Ts>
+    View<Ts...> view()
     {
-        // Create a custom deleter that will properly delete the derived type
-        auto deleter = [](void *ptr)
-        {
-            T *typedPtr = static_cast<T *>(ptr);
-            delete typedPtr;
-        };
-
-        // Store the resource with its custom deleter
-        void *rawPtr = resource.release();
-        sharedResources_[name] = std::unique_ptr<void, std::function<void(void *)>>(rawPtr, deleter);
+        return View<Ts...>(componentStorage_.getMatchingArchetypes(View<Ts...>::mask()));
     }
 
     /**
-     * @brief Get a shared resource by name
+     * @brief Get the archetype storage holding the components of all entities.
      *
-     * @param name The name of the resource to retrieve
-     * @return void* Pointer to the resource, or nullptr if not found
+     * @return Reference to the component storage
      */
-    void *getSharedResource(const std::string &name)
-    {
-        auto it = sharedResources_.find(name);
-        if (it != sharedResources_.end())
-        {
-            return it->second.get();
-        }
-        return nullptr;
-    }
+    ComponentStorage &getComponentStorage() { return componentStorage_; }
 
 private:
+    friend class WorldSnapshot;
+
+    /**
+     * @brief Take ownership of a system and schedule it.
+     *
+     * @param system System to add
+     */
+    void storeSystem(std::unique_ptr<ISystem> system);
+
+    /**
+     * @brief Give an entity an ID (if it has none) and a slot in the entity table.
+     *
+     * @param entity Entity about to be appended to entities_
+     */
+    void assignSlot(Entity &entity);
+
+    /**
+     * @brief Return a slot to the free list.
+     *
+     * @param index Slot to free
+     */
+    void releaseSlot(std::uint32_t index);
+
+    /**
+     * @brief Entry in the entity table.
+     *
+     * A live slot stores the entity's position in entities_. A free slot has
+     * denseIndex == InvalidIndex and links to the next free slot.
+     */
+    struct EntitySlot
+    {
+        std::uint32_t generation; /**< Incremented each time the slot is freed */
+        std::uint32_t denseIndex; /**< Index into entities_, or InvalidIndex when free */
+        std::uint32_t nextFree;   /**< Next slot in the free list (free slots only) */
+    };
+
+    /**
+     * @brief Command buffer owned by one recording thread.
+     */
+    struct ThreadCommandBuffer
+    {
+        std::thread::id thread;                /**< Thread that records into the buffer */
+        std::unique_ptr<CommandBuffer> buffer; /**< Recorded commands (stable address) */
+    };
+
     EventBus &eventBus_;                                                                                  /**< Reference to the event bus for communication */
-    std::vector<std::unique_ptr<Entity>> entities_;                                                       /**< All entities in the world */
-    std::vector<std::unique_ptr<ISystem>> systems_;                                                       /**< All systems in the world, updated in order */
-    std::unordered_map<std::string, std::unique_ptr<void, std::function<void(void *)>>> sharedResources_; /**< Named shared resources */
+    ServiceRegistry services_;                                                                            /**< Shared services and systems by type (outlives systems_) */
+    ComponentStorage componentStorage_;                                                                   /**< Archetype SoA storage for entity components (outlives entities_) */
+    std::vector<std::unique_ptr<Entity>> entities_;                                                       /**< All entities in the world, densely packed */
+    std::vector<EntitySlot> slots_;                                                                       /**< Handle index -> entity slot */
+    std::uint32_t freeSlotHead_ = EntityHandle::InvalidIndex;                                             /**< First recyclable slot, or InvalidIndex */
+    unsigned int nextEntityId_ = 1;                                                                       /**< Next ID for entities added with ID 0 */
+    std::vector<std::unique_ptr<ISystem>> systems_;                                                       /**< All systems in the world, in registration order */
+    SystemSchedule schedule_;                                                                             /**< Dependency graph over systems_ */
+    bool scheduleDirty_ = false;                                                                          /**< Whether schedule_ must be rebuilt */
+    SystemScheduler scheduler_;                                                                           /**< Runs schedules, in parallel once given a JobSystem */
+    std::vector<ThreadCommandBuffer> commandBuffers_;                                                     /**< Per-thread deferred structural changes */
+    std::mutex commandBuffersMutex_;                                                                      /**< Guards registration in commandBuffers_ */
+    std::uint64_t serial_;                                                                                /**< Unique per World instance, keys the thread-local buffer cache */
 };
 
 #endif
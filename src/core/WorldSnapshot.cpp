@@ -0,0 +1,563 @@
+#include "WorldSnapshot.h"
+#include "World.h"
+#include "Archetype.h"
+#include "Profiler.h"
+#include "../components/TransformC.h"
+#include "../components/PhysicsC.h"
+#include "../components/RenderableC.h"
+#include "../components/VehicleC.h"
+#include "../components/AudioC.h"
+#include "../components/LightC.h"
+#include "../components/HierarchyC.h"
+#include "../components/MultirotorC.h"
+#include "../vehicles/DroneBuilder.h"
+#include <algorithm>
+#include <iostream>
+
+WorldSnapshot::Serializer WorldSnapshot::serializers_[MaxComponentTypes] = {};
+ComponentMask WorldSnapshot::registeredMask_;
+
+namespace
+{
+    constexpr std::uint32_t SnapshotMagic = 0x53565046; // "FPVS"
+    constexpr std::uint32_t SnapshotVersion = 5;
+
+    void writeVector(SnapshotWriter &writer, const Vector3D &value)
+    {
+        writer.writeF32(value.x);
+        writer.writeF32(value.y);
+        writer.writeF32(value.z);
+    }
+
+    void readVector(SnapshotReader &reader, Vector3D &value)
+    {
+        value.x = reader.readF32();
+        value.y = reader.readF32();
+        value.z = reader.readF32();
+    }
+}
+
+template <>
+struct SnapshotTraits<TransformC>
+{
+    static void save(const TransformC &transform, SnapshotWriter &writer)
+    {
+        writeVector(writer, transform.position);
+        writer.writeF32(transform.rotation.w);
+        writer.writeF32(transform.rotation.x);
+        writer.writeF32(transform.rotation.y);
+        writer.writeF32(transform.rotation.z);
+        writeVector(writer, transform.scale);
+        writeVector(writer, transform.previousPosition);
+    }
+
+    static void load(TransformC &transform, SnapshotReader &reader)
+    {
+        readVector(reader, transform.position);
+        transform.rotation.w = reader.readF32();
+        transform.rotation.x = reader.readF32();
+        transform.rotation.y = reader.readF32();
+        transform.rotation.z = reader.readF32();
+        readVector(reader, transform.scale);
+        readVector(reader, transform.previousPosition);
+    }
+};
+
+template <>
+struct SnapshotTraits<PhysicsC>
+{
+    static void save(const PhysicsC &physics, SnapshotWriter &writer)
+    {
+        writer.writeF32(physics.mass);
+        writer.writeF32(physics.friction);
+        writer.writeF32(physics.restitution);
+        writer.writeU8(static_cast<std::uint8_t>(physics.colliderType));
+        writer.writeBytes(physics.colliderSize, sizeof(physics.colliderSize));
+        writer.writeBool(physics.isKinematic);
+        writer.writeBool(physics.useGravity);
+        writeVector(writer, physics.velocity);
+        writeVector(writer, physics.angularVelocity);
+        writeVector(writer, physics.inertia);
+        writer.writeF32(physics.dragCoefficient);
+        writeVector(writer, physics.force);
+        writeVector(writer, physics.torque);
+        writer.writeBool(physics.isSleeping);
+        writer.writeF32(physics.sleepTime);
+        writer.writeU64(physics.sleepIsland.value());
+    }
+
+    static void load(PhysicsC &physics, SnapshotReader &reader)
+    {
+        physics.mass = reader.readF32();
+        physics.friction = reader.readF32();
+        physics.restitution = reader.readF32();
+        physics.colliderType = static_cast<ColliderType>(reader.readU8());
+        reader.readBytes(physics.colliderSize, sizeof(physics.colliderSize));
+        physics.isKinematic = reader.readBool();
+        physics.useGravity = reader.readBool();
+        readVector(reader, physics.velocity);
+        readVector(reader, physics.angularVelocity);
+        readVector(reader, physics.inertia);
+        physics.dragCoefficient = reader.readF32();
+        readVector(reader, physics.force);
+        readVector(reader, physics.torque);
+        physics.isSleeping = reader.readBool();
+        physics.sleepTime = reader.readF32();
+        physics.sleepIsland = EntityHandle::fromValue(reader.readU64());
+    }
+};
+
+template <>
+struct SnapshotTraits<RenderableC>
+{
+    static void save(const RenderableC &renderable, SnapshotWriter &writer)
+    {
+        writer.writeString(renderable.meshId);
+        writer.writeString(renderable.materialId);
+        writer.writeBool(renderable.isVisible);
+    }
+
+    static void load(RenderableC &renderable, SnapshotReader &reader)
+    {
+        reader.readString(renderable.meshId);
+        reader.readString(renderable.materialId);
+        renderable.isVisible = reader.readBool();
+    }
+};
+
+template <>
+struct SnapshotTraits<VehicleC>
+{
+    static void save(const VehicleC &vehicle, SnapshotWriter &writer)
+    {
+        writer.writeString(vehicle.vehicleType);
+        writer.writeF32(vehicle.maxSpeed);
+        writer.writeF32(vehicle.acceleration);
+        writer.writeF32(vehicle.maneuverability);
+        writer.writeString(vehicle.controllerType);
+    }
+
+    static void load(VehicleC &vehicle, SnapshotReader &reader)
+    {
+        reader.readString(vehicle.vehicleType);
+        vehicle.maxSpeed = reader.readF32();
+        vehicle.acceleration = reader.readF32();
+        vehicle.maneuverability = reader.readF32();
+        reader.readString(vehicle.controllerType);
+    }
+};
+
+template <>
+struct SnapshotTraits<AudioC>
+{
+    static void save(const AudioC &audio, SnapshotWriter &writer)
+    {
+        writer.writeString(audio.soundId);
+        writer.writeF32(audio.volume);
+        writer.writeBool(audio.loop);
+        writer.writeBool(audio.isPlaying);
+    }
+
+    static void load(AudioC &audio, SnapshotReader &reader)
+    {
+        reader.readString(audio.soundId);
+        audio.volume = reader.readF32();
+        audio.loop = reader.readBool();
+        audio.isPlaying = reader.readBool();
+    }
+};
+
+template <>
+struct SnapshotTraits<LightC>
+{
+    static void save(const LightC &light, SnapshotWriter &writer)
+    {
+        writer.writeString(light.lightType);
+        writer.writeBytes(light.color, sizeof(light.color));
+        writer.writeF32(light.intensity);
+        writer.writeF32(light.range);
+    }
+
+    static void load(LightC &light, SnapshotReader &reader)
+    {
+        reader.readString(light.lightType);
+        reader.readBytes(light.color, sizeof(light.color));
+        light.intensity = reader.readF32();
+        light.range = reader.readF32();
+    }
+};
+
+template <>
+struct SnapshotTraits<HierarchyC>
+{
+    static void save(const HierarchyC &hierarchy, SnapshotWriter &writer)
+    {
+        writer.writeU32(hierarchy.parent.index);
+        writer.writeU32(hierarchy.parent.generation);
+    }
+
+    static void load(HierarchyC &hierarchy, SnapshotReader &reader)
+    {
+        hierarchy.parent.index = reader.readU32();
+        hierarchy.parent.generation = reader.readU32();
+    }
+};
+
+template <>
+struct SnapshotTraits<MultirotorC>
+{
+    // The parameter block is shared and immutable, so only its source file is saved and restores re-link to it
+    static void save(const MultirotorC &multirotor, SnapshotWriter &writer)
+    {
+        writer.writeString(multirotor.params ? multirotor.params->source : std::string());
+        writer.writeF32(multirotor.input.roll);
+        writer.writeF32(multirotor.input.pitch);
+        writer.writeF32(multirotor.input.yaw);
+        writer.writeF32(multirotor.input.throttle);
+        writer.writeBytes(multirotor.state.rotorSpeed, sizeof(multirotor.state.rotorSpeed));
+        writer.writeF32(multirotor.state.stateOfCharge);
+        writer.writeF32(multirotor.state.voltage);
+        writer.writeF32(multirotor.state.current);
+    }
+
+    static void load(MultirotorC &multirotor, SnapshotReader &reader)
+    {
+        std::string source;
+        reader.readString(source);
+        if (source.empty())
+            multirotor.params = nullptr;
+        else if (!multirotor.params || multirotor.params->source != source)
+            multirotor.params = DroneBuilder::load(source);
+        multirotor.input.roll = reader.readF32();
+        multirotor.input.pitch = reader.readF32();
+        multirotor.input.yaw = reader.readF32();
+        multirotor.input.throttle = reader.readF32();
+        reader.readBytes(multirotor.state.rotorSpeed, sizeof(multirotor.state.rotorSpeed));
+        multirotor.state.stateOfCharge = reader.readF32();
+        multirotor.state.voltage = reader.readF32();
+        multirotor.state.current = reader.readF32();
+    }
+};
+
+/**
+ * @brief Register the serializer of a component type.
+ *
+ * Registration is not synchronized; do it from the main thread at startup.
+ *
+ * @param typeId Component type ID
+ * @param serializer Save/load functions
+ */
+void WorldSnapshot::registerSerializer(ComponentTypeId typeId, const Serializer &serializer)
+{
+    serializers_[typeId] = serializer;
+    registeredMask_.set(typeId);
+}
+
+/**
+ * @brief Register the engine's own component types, once.
+ */
+void WorldSnapshot::registerBuiltinComponents()
+{
+    static const bool registered = []
+    {
+        registerComponent<TransformC>();
+        registerComponent<PhysicsC>();
+        registerComponent<RenderableC>();
+        registerComponent<VehicleC>();
+        registerComponent<AudioC>();
+        registerComponent<LightC>();
+        registerComponent<HierarchyC>();
+        registerComponent<MultirotorC>();
+        return true;
+    }();
+    (void)registered;
+}
+
+/**
+ * @brief Serialize a World.
+ *
+ * Layout (little-endian): magic, version, slot count, free list head, next
+ * entity ID, entity count; per slot its generation and next free slot; per
+ * entity its slot index, ID, name, active flag, lifetime, custom properties
+ * (sorted by name so equal state gives equal bytes) and components, each as
+ * type ID, payload size and payload.
+ *
+ * @param world World to capture
+ * @param out Receives the snapshot (previous contents are replaced, capacity is reused)
+ */
+void WorldSnapshot::capture(World &world, std::vector<std::uint8_t> &out)
+{
+    PROFILE_SCOPE("WorldSnapshot::capture");
+    registerBuiltinComponents();
+
+    out.clear();
+    SnapshotWriter writer(out);
+    writer.writeU32(SnapshotMagic);
+    writer.writeU32(SnapshotVersion);
+    writer.writeU32(static_cast<std::uint32_t>(world.slots_.size()));
+    writer.writeU32(world.freeSlotHead_);
+    writer.writeU32(world.nextEntityId_);
+    writer.writeU32(static_cast<std::uint32_t>(world.entities_.size()));
+
+    for (const World::EntitySlot &slot : world.slots_)
+    {
+        writer.writeU32(slot.generation);
+        writer.writeU32(slot.nextFree);
+    }
+
+    std::vector<const std::pair<const std::string, std::string> *> properties;
+    for (const auto &entityPtr : world.entities_)
+    {
+        const Entity &entity = *entityPtr;
+        writer.writeU32(entity.handle_.index);
+        writer.writeU32(entity.id_);
+        writer.writeString(entity.name_);
+        writer.writeBool(entity.active_);
+        writer.writeF32(entity.lifetime_);
+
+        properties.clear();
+        for (const auto &property : entity.customProperties_)
+            properties.push_back(&property);
+        std::sort(properties.begin(), properties.end(), [](const auto *a, const auto *b)
+                  { return a->first < b->first; });
+        writer.writeU32(static_cast<std::uint32_t>(properties.size()));
+        for (const auto *property : properties)
+        {
+            writer.writeString(property->first);
+            writer.writeString(property->second);
+        }
+
+        const ComponentMask components = entity.archetype_->getMask() & registeredMask_;
+        writer.writeU8(static_cast<std::uint8_t>(components.count()));
+        for (ComponentTypeId typeId = 0; typeId < MaxComponentTypes; ++typeId)
+        {
+            if (!components.test(typeId))
+                continue;
+
+            writer.writeU8(static_cast<std::uint8_t>(typeId));
+            const std::size_t sizeOffset = writer.size();
+            writer.writeU32(0);
+            serializers_[typeId].save(entity.archetype_->getComponent(typeId, entity.row_), writer);
+            writer.patchU32(sizeOffset, static_cast<std::uint32_t>(writer.size() - sizeOffset - sizeof(std::uint32_t)));
+        }
+    }
+}
+
+/**
+ * @brief Check a snapshot's structure without applying it.
+ *
+ * @param data Snapshot bytes
+ * @param size Number of bytes
+ * @return true if every header, slot and entity record is consistent
+ */
+bool WorldSnapshot::validate(const std::uint8_t *data, std::size_t size)
+{
+    SnapshotReader reader(data, size);
+    if (reader.readU32() != SnapshotMagic || reader.readU32() != SnapshotVersion)
+        return false;
+
+    const std::uint32_t slotCount = reader.readU32();
+    reader.skip(2 * sizeof(std::uint32_t));
+    const std::uint32_t entityCount = reader.readU32();
+    if (!reader.ok() || slotCount > reader.remaining() / (2 * sizeof(std::uint32_t)) || entityCount > slotCount)
+        return false;
+
+    std::vector<std::uint32_t> generations(slotCount);
+    for (std::uint32_t i = 0; i < slotCount; ++i)
+    {
+        generations[i] = reader.readU32();
+        reader.skip(sizeof(std::uint32_t));
+    }
+
+    std::vector<bool> used(slotCount, false);
+    std::string text;
+    for (std::uint32_t i = 0; i < entityCount && reader.ok(); ++i)
+    {
+        const std::uint32_t index = reader.readU32();
+        if (index >= slotCount || used[index])
+            return false;
+        used[index] = true;
+
+        reader.skip(sizeof(std::uint32_t));
+        reader.readString(text);
+        reader.skip(1 + sizeof(float));
+        const std::uint32_t propertyCount = reader.readU32();
+        for (std::uint32_t p = 0; p < propertyCount && reader.ok(); ++p)
+        {
+            reader.readString(text);
+            reader.readString(text);
+        }
+
+        const std::uint8_t componentCount = reader.readU8();
+        for (std::uint8_t c = 0; c < componentCount && reader.ok(); ++c)
+        {
+            const std::uint8_t typeId = reader.readU8();
+            if (typeId >= MaxComponentTypes || !registeredMask_.test(typeId))
+                return false;
+            reader.skip(reader.readU32());
+        }
+    }
+
+    return reader.ok() && reader.remaining() == 0;
+}
+
+/**
+ * @brief Bring a World back to the state of a snapshot.
+ *
+ * Entities are matched by handle. Live entities whose handle is not in the
+ * snapshot are destroyed; surviving entities are overwritten in place
+ * (components of registered types they did not have are added, ones they
+ * gained since are removed); missing entities are recreated in their old
+ * slots. The slot table, free list and dense entity order are then set
+ * exactly as captured.
+ *
+ * @param world World to restore
+ * @param data Snapshot bytes from capture()
+ * @param size Number of bytes
+ * @return true if the snapshot was valid and has been applied
+ */
+bool WorldSnapshot::restore(World &world, const std::uint8_t *data, std::size_t size)
+{
+    PROFILE_SCOPE("WorldSnapshot::restore");
+    registerBuiltinComponents();
+
+    if (!validate(data, size))
+    {
+        std::cerr << "WorldSnapshot: invalid snapshot (" << size << " bytes), world left unchanged" << std::endl;
+        return false;
+    }
+
+    SnapshotReader reader(data, size);
+    reader.skip(2 * sizeof(std::uint32_t));
+    const std::uint32_t slotCount = reader.readU32();
+    const std::uint32_t freeSlotHead = reader.readU32();
+    const std::uint32_t nextEntityId = reader.readU32();
+    const std::uint32_t entityCount = reader.readU32();
+
+    std::vector<World::EntitySlot> slots(slotCount);
+    for (World::EntitySlot &slot : slots)
+    {
+        slot.generation = reader.readU32();
+        slot.nextFree = reader.readU32();
+        slot.denseIndex = EntityHandle::InvalidIndex;
+    }
+
+    // Mark which slots the snapshot holds an entity in; only the first field of each record is needed
+    std::vector<bool> captured(slotCount, false);
+    {
+        SnapshotReader scan = reader;
+        std::string text;
+        for (std::uint32_t i = 0; i < entityCount; ++i)
+        {
+            captured[scan.readU32()] = true;
+            scan.skip(sizeof(std::uint32_t));
+            scan.readString(text);
+            scan.skip(1 + sizeof(float));
+            const std::uint32_t propertyCount = scan.readU32();
+            for (std::uint32_t p = 0; p < propertyCount; ++p)
+            {
+                scan.readString(text);
+                scan.readString(text);
+            }
+            const std::uint8_t componentCount = scan.readU8();
+            for (std::uint8_t c = 0; c < componentCount; ++c)
+            {
+                scan.skip(1);
+                scan.skip(scan.readU32());
+            }
+        }
+    }
+
+    // Destroy entities the snapshot does not know, keep the rest indexed by slot
+    std::vector<EntityHandle> stale;
+    for (const auto &entity : world.entities_)
+    {
+        const EntityHandle handle = entity->handle_;
+        if (handle.index >= slotCount || !captured[handle.index] || slots[handle.index].generation != handle.generation)
+            stale.push_back(handle);
+    }
+    for (EntityHandle handle : stale)
+        world.destroyEntity(handle);
+
+    std::vector<std::unique_ptr<Entity>> bySlot(slotCount);
+    for (auto &entity : world.entities_)
+    {
+        const std::uint32_t index = entity->handle_.index;
+        bySlot[index] = std::move(entity);
+    }
+    world.entities_.clear();
+    world.entities_.reserve(entityCount);
+
+    ComponentStorage &storage = world.componentStorage_;
+    std::vector<ComponentTypeId> restoredTypes;
+    for (std::uint32_t i = 0; i < entityCount; ++i)
+    {
+        const std::uint32_t index = reader.readU32();
+        std::unique_ptr<Entity> entity = std::move(bySlot[index]);
+        if (!entity)
+        {
+            entity = std::make_unique<Entity>();
+            entity->handle_ = EntityHandle{index, slots[index].generation};
+            storage.attach(*entity);
+        }
+
+        entity->id_ = reader.readU32();
+        reader.readString(entity->name_);
+        entity->active_ = reader.readBool();
+        entity->lifetime_ = reader.readF32();
+
+        entity->customProperties_.clear();
+        const std::uint32_t propertyCount = reader.readU32();
+        std::string name;
+        for (std::uint32_t p = 0; p < propertyCount; ++p)
+        {
+            reader.readString(name);
+            reader.readString(entity->customProperties_[name]);
+        }
+
+        ComponentMask restoredMask;
+        const std::uint8_t componentCount = reader.readU8();
+        for (std::uint8_t c = 0; c < componentCount; ++c)
+        {
+            const ComponentTypeId typeId = reader.readU8();
+            const std::uint32_t payloadSize = reader.readU32();
+            SnapshotReader payload(data + reader.offset(), payloadSize);
+            serializers_[typeId].load(*entity, storage, typeId, payload);
+            reader.skip(payloadSize);
+            restoredMask.set(typeId);
+        }
+
+        const ComponentMask gained = (entity->archetype_->getMask() & registeredMask_) & ~restoredMask;
+        for (ComponentTypeId typeId = 0; gained.any() && typeId < MaxComponentTypes; ++typeId)
+        {
+            if (gained.test(typeId))
+                storage.removeComponent(*entity, typeId);
+        }
+
+        slots[index].denseIndex = static_cast<std::uint32_t>(world.entities_.size());
+        world.entities_.push_back(std::move(entity));
+    }
+
+    world.slots_ = std::move(slots);
+    world.freeSlotHead_ = freeSlotHead;
+    world.nextEntityId_ = nextEntityId;
+    return true;
+}
+
+/**
+ * @brief Hash a snapshot (64-bit FNV-1a).
+ *
+ * @param data Snapshot bytes
+ * @param size Number of bytes
+ * @return Hash of the bytes
+ */
+std::uint64_t WorldSnapshot::hash(const std::uint8_t *data, std::size_t size)
+{
+    std::uint64_t hash = 14695981039346656037ull;
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        hash ^= data[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
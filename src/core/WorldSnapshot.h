@@ -0,0 +1,345 @@
+#ifndef WORLDSNAPSHOT_H
+#define WORLDSNAPSHOT_H
+
+#include "ComponentTypeId.h"
+#include "Entity.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+class World;
+
+/**
+ * @brief Appends little-endian binary values to a byte buffer.
+ */
+class SnapshotWriter
+{
+public:
+    /**
+     * @brief Write into a buffer, appending after its current contents.
+     *
+     * @param buffer Destination buffer
+     */
+    explicit SnapshotWriter(std::vector<std::uint8_t> &buffer) : buffer_(buffer) {}
+
+    void writeU8(std::uint8_t value) { buffer_.push_back(value); }
+    void writeU32(std::uint32_t value) { writeBytes(&value, sizeof(value)); }
+    void writeU64(std::uint64_t value) { writeBytes(&value, sizeof(value)); }
+    void writeF32(float value) { writeBytes(&value, sizeof(value)); }
+    void writeF64(double value) { writeBytes(&value, sizeof(value)); }
+    void writeBool(bool value) { writeU8(value ? 1 : 0); }
+
+    /**
+     * @brief Write an unsigned integer in 7-bit groups (1 byte below 128).
+     *
+     * @param value Value to write
+     */
+    void writeVarint(std::uint64_t value)
+    {
+        while (value >= 0x80)
+        {
+            writeU8(static_cast<std::uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        writeU8(static_cast<std::uint8_t>(value));
+    }
+
+    /**
+     * @brief Write a length-prefixed string.
+     *
+     * @param value String to write
+     */
+    void writeString(const std::string &value)
+    {
+        writeU32(static_cast<std::uint32_t>(value.size()));
+        writeBytes(value.data(), value.size());
+    }
+
+    /**
+     * @brief Append raw bytes.
+     *
+     * @param data Bytes to append
+     * @param size Number of bytes
+     */
+    void writeBytes(const void *data, std::size_t size)
+    {
+        const std::size_t offset = buffer_.size();
+        buffer_.resize(offset + size);
+        if (size > 0)
+            std::memcpy(buffer_.data() + offset, data, size);
+    }
+
+    /**
+     * @brief Get the number of bytes in the buffer.
+     *
+     * @return Buffer size, including bytes written before this writer
+     */
+    std::size_t size() const { return buffer_.size(); }
+
+    /**
+     * @brief Overwrite a 32-bit value written earlier (e.g. a length placeholder).
+     *
+     * @param offset Byte offset of the value
+     * @param value New value
+     */
+    void patchU32(std::size_t offset, std::uint32_t value) { std::memcpy(buffer_.data() + offset, &value, sizeof(value)); }
+
+private:
+    std::vector<std::uint8_t> &buffer_; /**< Destination */
+};
+
+/**
+ * @brief Reads values written by SnapshotWriter with bounds checking.
+ *
+ * Reading past the end sets a sticky failure flag and yields zeros, so a
+ * sequence of reads can be checked once with ok() at the end.
+ */
+class SnapshotReader
+{
+public:
+    /**
+     * @brief Read from a byte range.
+     *
+     * @param data First byte
+     * @param size Number of bytes
+     */
+    SnapshotReader(const std::uint8_t *data, std::size_t size) : data_(data), size_(size) {}
+
+    std::uint8_t readU8()
+    {
+        std::uint8_t value = 0;
+        readBytes(&value, sizeof(value));
+        return value;
+    }
+    std::uint32_t readU32()
+    {
+        std::uint32_t value = 0;
+        readBytes(&value, sizeof(value));
+        return value;
+    }
+    std::uint64_t readU64()
+    {
+        std::uint64_t value = 0;
+        readBytes(&value, sizeof(value));
+        return value;
+    }
+    float readF32()
+    {
+        float value = 0.0f;
+        readBytes(&value, sizeof(value));
+        return value;
+    }
+    double readF64()
+    {
+        double value = 0.0;
+        readBytes(&value, sizeof(value));
+        return value;
+    }
+    bool readBool() { return readU8() != 0; }
+
+    /**
+     * @brief Read an integer written by SnapshotWriter::writeVarint().
+     *
+     * @return Value read (0 on failure)
+     */
+    std::uint64_t readVarint()
+    {
+        std::uint64_t value = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7)
+        {
+            const std::uint8_t byte = readU8();
+            value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0 || !ok())
+                return ok() ? value : 0;
+        }
+        failed_ = true;
+        return 0;
+    }
+
+    /**
+     * @brief Read a length-prefixed string.
+     *
+     * @param value Receives the string (its capacity is reused)
+     */
+    void readString(std::string &value)
+    {
+        const std::uint32_t length = readU32();
+        if (length > remaining())
+        {
+            failed_ = true;
+            value.clear();
+            return;
+        }
+        value.assign(reinterpret_cast<const char *>(data_ + offset_), length);
+        offset_ += length;
+    }
+
+    /**
+     * @brief Copy raw bytes out of the stream.
+     *
+     * @param destination Receives the bytes (zeroed on failure)
+     * @param size Number of bytes
+     */
+    void readBytes(void *destination, std::size_t size)
+    {
+        if (size > remaining())
+        {
+            failed_ = true;
+            offset_ = size_;
+            std::memset(destination, 0, size);
+            return;
+        }
+        std::memcpy(destination, data_ + offset_, size);
+        offset_ += size;
+    }
+
+    /**
+     * @brief Skip bytes without reading them.
+     *
+     * @param size Number of bytes
+     */
+    void skip(std::size_t size)
+    {
+        if (size > remaining())
+        {
+            failed_ = true;
+            offset_ = size_;
+            return;
+        }
+        offset_ += size;
+    }
+
+    std::size_t remaining() const { return size_ - offset_; }
+    std::size_t offset() const { return offset_; }
+
+    /**
+     * @brief Check whether every read so far was in bounds.
+     *
+     * @return false once a read ran past the end
+     */
+    bool ok() const { return !failed_; }
+
+private:
+    const std::uint8_t *data_; /**< First byte */
+    std::size_t size_;         /**< Number of bytes */
+    std::size_t offset_ = 0;   /**< Next byte to read */
+    bool failed_ = false;      /**< A read ran past the end */
+};
+
+/**
+ * @brief Field-wise binary encoding of a component type.
+ *
+ * Specialize with static save(const T &, SnapshotWriter &) and
+ * load(T &, SnapshotReader &) functions, then call
+ * WorldSnapshot::registerComponent<T>(). load() may be given a component
+ * that already holds older state and must overwrite every field it saved.
+ */
+template <typename T>
+struct SnapshotTraits;
+
+/**
+ * @brief Captures and restores the complete state of a World.
+ *
+ * A snapshot holds the entity slot table (generations and free list), every
+ * entity's ID, name, active flag and custom properties, and every component
+ * of a registered type, in the World's dense entity order. Restoring
+ * reproduces that state exactly: entities created since are destroyed,
+ * entities destroyed since are recreated under their old handles, and the
+ * slot allocator is rewound so later spawns receive the same handles as
+ * the first time round.
+ *
+ * Component types without SnapshotTraits are neither saved nor touched by
+ * restore. Component type IDs are assigned at runtime, so snapshots are
+ * only meaningful within the process that wrote them.
+ *
+ * Capture and restore must run at a sync point (no systems updating, no
+ * commands pending); restore invalidates pointers to components.
+ */
+class WorldSnapshot
+{
+public:
+    /**
+     * @brief Make a component type part of snapshots.
+     *
+     * Requires a SnapshotTraits<T> specialization. Registering twice is harmless.
+     */
+    template <typename T>
+    static void registerComponent()
+    {
+        registerSerializer(componentTypeId<T>(), Serializer{&saveComponent<T>, &loadComponent<T>});
+    }
+
+    /**
+     * @brief Serialize a World.
+     *
+     * @param world World to capture
+     * @param out Receives the snapshot (previous contents are replaced, capacity is reused)
+     */
+    static void capture(World &world, std::vector<std::uint8_t> &out);
+
+    /**
+     * @brief Bring a World back to the state of a snapshot.
+     *
+     * The snapshot is validated before anything is changed.
+     *
+     * @param world World to restore
+     * @param data Snapshot bytes from capture()
+     * @param size Number of bytes
+     * @return true if the snapshot was valid and has been applied
+     */
+    static bool restore(World &world, const std::uint8_t *data, std::size_t size);
+
+    /**
+     * @brief Hash a snapshot (64-bit FNV-1a).
+     *
+     * @param data Snapshot bytes
+     * @param size Number of bytes
+     * @return Hash of the bytes
+     */
+    static std::uint64_t hash(const std::uint8_t *data, std::size_t size);
+
+private:
+    /**
+     * @brief Type-erased save/load pair of one component type.
+     */
+    struct Serializer
+    {
+        void (*save)(const void *component, SnapshotWriter &writer);                                     /**< Write the fields */
+        void (*load)(Entity &entity, ComponentStorage &storage, ComponentTypeId typeId, SnapshotReader &reader); /**< Overwrite or add the component */
+    };
+
+    template <typename T>
+    static void saveComponent(const void *component, SnapshotWriter &writer)
+    {
+        SnapshotTraits<T>::save(*static_cast<const T *>(component), writer);
+    }
+
+    template <typename T>
+    static void loadComponent(Entity &entity, ComponentStorage &storage, ComponentTypeId typeId, SnapshotReader &reader);
+
+    static void registerSerializer(ComponentTypeId typeId, const Serializer &serializer);
+    static void registerBuiltinComponents();
+    static bool validate(const std::uint8_t *data, std::size_t size);
+
+    static Serializer serializers_[MaxComponentTypes]; /**< Indexed by component type ID, save == nullptr when unregistered */
+    static ComponentMask registeredMask_;              /**< Types with a serializer */
+};
+
+template <typename T>
+void WorldSnapshot::loadComponent(Entity &entity, ComponentStorage &storage, ComponentTypeId typeId, SnapshotReader &reader)
+{
+    if (T *existing = entity.getComponent<T>())
+    {
+        // Overwrite in place: no archetype move, and strings keep their capacity
+        SnapshotTraits<T>::load(*existing, reader);
+        return;
+    }
+
+    T component;
+    SnapshotTraits<T>::load(component, reader);
+    storage.addComponent(entity, typeId, &component);
+}
+
+#endif
@@ -1,5 +1,7 @@
 #pragma once
 #include "../core/IEvent.h"
+#include <string>
+#include <utility>
 
 /**
  * @file InputEvents.h
@@ -81,3 +83,28 @@ struct DebugModeToggled : public IEvent
     bool isActive;
 };
 
+/**
+ * @struct InputActionEvent
+ * @brief Event carrying an input action that reaches the simulation.
+ *
+ * Published by the input system for every triggered binding, and by the
+ * engine at the start of each fixed step when a replay is played back, so
+ * simulation code reacting to it behaves the same live and in replays.
+ */
+struct InputActionEvent : public IEvent
+{
+    /**
+     * @brief Construct a new InputActionEvent.
+     * @param action Action name from the input configuration
+     */
+    explicit InputActionEvent(std::string action) : action(std::move(action)) {}
+
+    /**
+     * @brief Get the event type identifier.
+     * @return EventType::InputAction
+     */
+    EventType getType() const override { return EventType::InputAction; }
+
+    /** @brief Action name from the input configuration */
+    std::string action;
+};
@@ -0,0 +1,35 @@
+#pragma once
+#include "../core/IEvent.h"
+
+/**
+ * @file SimulationEvents.h
+ * @brief Event definitions for controlling the running simulation.
+ *
+ * These events are raised by tools such as the developer console and
+ * handled by the engine at a sync point between frames.
+ */
+
+/**
+ * @struct RewindRequestEvent
+ * @brief Request to rewind the simulation using the rewind buffer.
+ *
+ * Queue it with EventBus::enqueue() so the engine restores the world after
+ * the physics steps rather than while systems are updating.
+ */
+struct RewindRequestEvent : public IEvent
+{
+    /**
+     * @brief Construct a new RewindRequestEvent.
+     * @param seconds Simulated seconds to go back
+     */
+    explicit RewindRequestEvent(double seconds) : seconds(seconds) {}
+
+    /**
+     * @brief Get the event type identifier.
+     * @return EventType::RewindRequested
+     */
+    EventType getType() const override { return EventType::RewindRequested; }
+
+    /** @brief Simulated seconds to go back */
+    double seconds;
+};
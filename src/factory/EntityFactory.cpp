@@ -2,6 +2,7 @@
 #include "systems/MaterialManager.h"
 #include "core/Entity.h"
 #include "core/EventBus.h"
+#include "core/World.h"
 #include "core/Vector3D.h"
 #include "core/Quaternion.h"
 #include "loaders/EntityXmlParser.h"
@@ -19,7 +20,7 @@ namespace EntityFactory
 {
 
     EntityFactory::EntityFactory(EventBus &eventBus, Material::MaterialManager &materialManager)
-        : eventBus_(eventBus), materialManager_(materialManager), nextEntityId_(1)
+        : eventBus_(eventBus), materialManager_(materialManager)
     {
         DEBUG_LOG("Initializing EntityFactory");
         initializeDefaultTemplates();
@@ -70,11 +71,6 @@ namespace EntityFactory
                                                               unsigned int entityId)
     {
         DEBUG_LOG("Creating entity from template '" + templateName + "' with name '" + entityName + "'");
-        if (entityId == 0)
-        {
-            entityId = getNextEntityId();
-        }
-
         // Create basic entity
         auto entity = std::make_unique<Entity>(entityId);
 
@@ -161,11 +157,6 @@ namespace EntityFactory
         const EntityConfig::EntityDefinition &definition, unsigned int entityId)
     {
         DEBUG_LOG("Creating entity from definition '" + definition.name + "' of type '" + definition.entityType + "'");
-        if (entityId == 0)
-        {
-            entityId = getNextEntityId();
-        }
-
         // Create basic entity
         auto entity = std::make_unique<Entity>(entityId);
 
@@ -178,6 +169,51 @@ namespace EntityFactory
         return entity;
     }
 
+    const Prefab *EntityFactory::getPrefab(const std::string &templateName)
+    {
+        auto cached = prefabs_.find(templateName);
+        if (cached != prefabs_.end())
+        {
+            return cached->second.get();
+        }
+
+        for (const auto &entityTemplate : entityTemplates_)
+        {
+            if (entityTemplate.templateId == templateName)
+            {
+                DEBUG_LOG("EntityFactory: Compiling prefab for template '" << templateName << "'");
+                // Build the components once on a detached entity, then freeze them into the prefab
+                Entity source;
+                addEntityComponents(source, entityTemplate.defaultDefinition);
+
+                auto prefab = std::make_unique<Prefab>();
+                if (!prefab->compile(source))
+                {
+                    std::cerr << "Failed to compile prefab for template: " << templateName << std::endl;
+                    return nullptr;
+                }
+                return (prefabs_[templateName] = std::move(prefab)).get();
+            }
+        }
+
+        std::cerr << "Entity template not found: " << templateName << std::endl;
+        return nullptr;
+    }
+
+    bool EntityFactory::instantiate(World &world, const std::string &templateName, std::size_t count,
+                                    std::vector<EntityHandle> &handles, const PrefabInstance *instances)
+    {
+        const Prefab *prefab = getPrefab(templateName);
+        if (prefab == nullptr)
+        {
+            return false;
+        }
+
+        DEBUG_LOG("EntityFactory: Instantiating " << count << " entities from template '" << templateName << "'");
+        world.instantiate(*prefab, count, handles, instances);
+        return true;
+    }
+
     void EntityFactory::initializeDefaultTemplates()
     {
         DEBUG_LOG("Initializing default entity templates");
@@ -342,7 +378,11 @@ namespace EntityFactory
             physicsComp->restitution = definition.physics->restitution;
             physicsComp->isKinematic = definition.physics->isKinematic;
             physicsComp->useGravity = definition.physics->useGravity;
-            physicsComp->colliderType = definition.physics->colliderType;
+            if (!parseColliderType(definition.physics->colliderType, physicsComp->colliderType))
+            {
+                std::cerr << "EntityFactory: unknown collider type '" << definition.physics->colliderType
+                          << "' for entity '" << definition.name << "', using a sphere" << std::endl;
+            }
 
             // Copy collider size
             physicsComp->colliderSize[0] = definition.physics->colliderSize[0];
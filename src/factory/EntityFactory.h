@@ -2,6 +2,7 @@
 
 #include "core/Entity.h"
 #include "core/EventBus.h"
+#include "core/Prefab.h"
 #include "config/EntityConfig.h"
 #include <memory>
 #include <string>
@@ -9,6 +10,8 @@
 #include <vector>
 
 // Forward declarations
+class World;
+
 namespace Material
 {
     class MaterialManager;
@@ -36,10 +39,12 @@ namespace EntityFactory
 
         /**
          * @brief Create entity from template name
+         *
+         * An entityId of 0 leaves the ID unassigned; World::addEntity allocates it.
          */
         std::unique_ptr<Entity> createFromTemplate(const std::string &templateName,
                                                    const std::string &entityName,
-                                                   unsigned int entityId);
+                                                   unsigned int entityId = 0);
 
         /**
          * @brief Create entity from XML file
@@ -53,14 +58,35 @@ namespace EntityFactory
         std::unique_ptr<Entity> createFromDefinition(const EntityConfig::EntityDefinition &definition,
                                                      unsigned int entityId = 0);
 
+        /**
+         * @brief Get the compiled prefab of a template
+         *
+         * The template is compiled on first use and the result cached, so its
+         * definition is converted to components only once.
+         *
+         * @return nullptr if the template does not exist or cannot be compiled
+         */
+        const Prefab *getPrefab(const std::string &templateName);
+
+        /**
+         * @brief Spawn copies of a template directly into a world
+         *
+         * Clones the template's compiled prefab count times with World::instantiate.
+         * instances, if given, holds count per-instance transform and name overrides.
+         *
+         * @return false if the template does not exist or cannot be compiled
+         */
+        bool instantiate(World &world, const std::string &templateName, std::size_t count,
+                         std::vector<EntityHandle> &handles, const PrefabInstance *instances = nullptr);
+
     private:
         EventBus &eventBus_;
         Material::MaterialManager &materialManager_;
-        unsigned int nextEntityId_;
 
         // Template and configuration storage
         std::unordered_map<std::string, std::string> templates_;
         std::vector<EntityConfig::EntityTemplate> entityTemplates_;
+        std::unordered_map<std::string, std::unique_ptr<Prefab>> prefabs_;
 
         void initializeDefaultTemplates();
 
@@ -68,14 +94,6 @@ namespace EntityFactory
          * @brief Add components to entity based on EntityDefinition
          */
         void addEntityComponents(Entity &entity, const EntityConfig::EntityDefinition &definition);
-
-        /**
-         * @brief Get a unique entity ID if one wasn't provided
-         */
-        unsigned int getNextEntityId()
-        {
-            return nextEntityId_++;
-        }
     };
 
 } // namespace EntityFactory
@@ -38,7 +38,7 @@ void EntityFactory::addEntityComponents(Entity &entity, const EntityConfig::Enti
         physicsComp->restitution = definition.physics->restitution;
         physicsComp->isKinematic = definition.physics->isKinematic;
         physicsComp->useGravity = definition.physics->useGravity;
-        physicsComp->colliderType = definition.physics->colliderType;
+        parseColliderType(definition.physics->colliderType, physicsComp->colliderType);
 
         // Copy collider size
         physicsComp->colliderSize.x = definition.physics->colliderSize[0];
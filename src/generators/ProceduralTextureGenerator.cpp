@@ -4,6 +4,7 @@
 #include <random>
 #include <sstream>
 #include "../debug.h"
+#include "../core/JobSystem.h"
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -224,45 +225,48 @@ namespace ProceduralTexture
         DEBUG_LOG("Generating noise texture with size " + std::to_string(width) + "x" + std::to_string(height));
         TextureData texture(width, height);
 
-        for (uint32_t y = 0; y < height; ++y)
-        {
-            for (uint32_t x = 0; x < width; ++x)
+        // Rows are independent, so they are spread over the job system
+        parallelFor(0, height, 16, [&](std::size_t firstRow, std::size_t lastRow)
+                    {
+            for (uint32_t y = static_cast<uint32_t>(firstRow); y < lastRow; ++y)
             {
-                float fx = static_cast<float>(x) / width;
-                float fy = static_cast<float>(y) / height;
-
-                float noise = 0.0f;
-                switch (params.type)
+                for (uint32_t x = 0; x < width; ++x)
                 {
-                case NoiseParams::Type::Perlin:
-                    noise = fractalNoise(fx * params.frequency, fy * params.frequency, params);
-                    break;
-                case NoiseParams::Type::Simplex:
-                    noise = simplexNoise(fx * params.frequency, fy * params.frequency, params.seed);
-                    break;
-                case NoiseParams::Type::Fractal:
-                    noise = fractalNoise(fx * params.frequency, fy * params.frequency, params);
+                    float fx = static_cast<float>(x) / width;
+                    float fy = static_cast<float>(y) / height;
+
+                    float noise = 0.0f;
+                    switch (params.type)
+                    {
+                    case NoiseParams::Type::Perlin:
+                        noise = fractalNoise(fx * params.frequency, fy * params.frequency, params);
+                        break;
+                    case NoiseParams::Type::Simplex:
+                        noise = simplexNoise(fx * params.frequency, fy * params.frequency, params.seed);
+                        break;
+                    case NoiseParams::Type::Fractal:
+                        noise = fractalNoise(fx * params.frequency, fy * params.frequency, params);
+                        break;
+                    case NoiseParams::Type::Cellular:
+                        noise = cellularNoise(fx * params.frequency, fy * params.frequency, params);
+                        break;
+                    case NoiseParams::Type::Voronoi:
+                        noise = voronoiNoise(fx * params.frequency, fy * params.frequency, params);
+                        break;
+                    case NoiseParams::Type::White:
+                    {
+                        std::mt19937 rng(params.seed + x * 1000 + y);
+                        std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+                        noise = dist(rng);
+                    }
                     break;
-                case NoiseParams::Type::Cellular:
-                    noise = cellularNoise(fx * params.frequency, fy * params.frequency, params);
-                    break;
-                case NoiseParams::Type::Voronoi:
-                    noise = voronoiNoise(fx * params.frequency, fy * params.frequency, params);
-                    break;
-                case NoiseParams::Type::White:
-                {
-                    std::mt19937 rng(params.seed + x * 1000 + y);
-                    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
-                    noise = dist(rng);
-                }
-                break;
-                }
+                    }
 
-                noise = std::clamp(noise, 0.0f, 1.0f);
-                uint8_t value = static_cast<uint8_t>(noise * 255);
-                texture.setPixel(x, y, Color(value, value, value, 255));
-            }
-        }
+                    noise = std::clamp(noise, 0.0f, 1.0f);
+                    uint8_t value = static_cast<uint8_t>(noise * 255);
+                    texture.setPixel(x, y, Color(value, value, value, 255));
+                }
+            } });
 
         return texture;
     }
@@ -272,29 +276,32 @@ namespace ProceduralTexture
         DEBUG_LOG("Generating gradient texture with size " + std::to_string(width) + "x" + std::to_string(height));
         TextureData texture(width, height);
 
-        for (uint32_t y = 0; y < height; ++y)
-        {
-            for (uint32_t x = 0; x < width; ++x)
+        // Rows are independent, so they are spread over the job system
+        parallelFor(0, height, 16, [&](std::size_t firstRow, std::size_t lastRow)
+                    {
+            for (uint32_t y = static_cast<uint32_t>(firstRow); y < lastRow; ++y)
             {
-                float fx = static_cast<float>(x) / width;
-                float fy = static_cast<float>(y) / height;
-
-                float t = calculateGradientPosition(params, fx, fy);
-                if (params.repeat)
-                {
-                    t = std::fmod(t, 1.0f);
-                    if (t < 0)
-                        t += 1.0f;
-                }
-                else
+                for (uint32_t x = 0; x < width; ++x)
                 {
-                    t = std::clamp(t, 0.0f, 1.0f);
+                    float fx = static_cast<float>(x) / width;
+                    float fy = static_cast<float>(y) / height;
+
+                    float t = calculateGradientPosition(params, fx, fy);
+                    if (params.repeat)
+                    {
+                        t = std::fmod(t, 1.0f);
+                        if (t < 0)
+                            t += 1.0f;
+                    }
+                    else
+                    {
+                        t = std::clamp(t, 0.0f, 1.0f);
+                    }
+
+                    Color color = evaluateGradient(params, t);
+                    texture.setPixel(x, y, color);
                 }
-
-                Color color = evaluateGradient(params, t);
-                texture.setPixel(x, y, color);
-            }
-        }
+            } });
 
         return texture;
     }
@@ -304,39 +311,42 @@ namespace ProceduralTexture
         DEBUG_LOG("Generating pattern texture with size " + std::to_string(width) + "x" + std::to_string(height));
         TextureData texture(width, height);
 
-        for (uint32_t y = 0; y < height; ++y)
-        {
-            for (uint32_t x = 0; x < width; ++x)
+        // Rows are independent, so they are spread over the job system
+        parallelFor(0, height, 16, [&](std::size_t firstRow, std::size_t lastRow)
+                    {
+            for (uint32_t y = static_cast<uint32_t>(firstRow); y < lastRow; ++y)
             {
-                float fx = static_cast<float>(x) / width;
-                float fy = static_cast<float>(y) / height;
-
-                Color color;
-                switch (params.type)
+                for (uint32_t x = 0; x < width; ++x)
                 {
-                case PatternParams::Type::Checkerboard:
-                    color = evaluateCheckerboard(params, fx, fy);
-                    break;
-                case PatternParams::Type::Stripes:
-                    color = evaluateStripes(params, fx, fy);
-                    break;
-                case PatternParams::Type::Dots:
-                    color = evaluateDots(params, fx, fy);
-                    break;
-                case PatternParams::Type::Grid:
-                    color = evaluateGrid(params, fx, fy);
-                    break;
-                case PatternParams::Type::Spiral:
-                    color = evaluateSpiral(params, fx, fy);
-                    break;
-                case PatternParams::Type::Waves:
-                    color = evaluateWaves(params, fx, fy);
-                    break;
+                    float fx = static_cast<float>(x) / width;
+                    float fy = static_cast<float>(y) / height;
+
+                    Color color;
+                    switch (params.type)
+                    {
+                    case PatternParams::Type::Checkerboard:
+                        color = evaluateCheckerboard(params, fx, fy);
+                        break;
+                    case PatternParams::Type::Stripes:
+                        color = evaluateStripes(params, fx, fy);
+                        break;
+                    case PatternParams::Type::Dots:
+                        color = evaluateDots(params, fx, fy);
+                        break;
+                    case PatternParams::Type::Grid:
+                        color = evaluateGrid(params, fx, fy);
+                        break;
+                    case PatternParams::Type::Spiral:
+                        color = evaluateSpiral(params, fx, fy);
+                        break;
+                    case PatternParams::Type::Waves:
+                        color = evaluateWaves(params, fx, fy);
+                        break;
+                    }
+
+                    texture.setPixel(x, y, color);
                 }
-
-                texture.setPixel(x, y, color);
-            }
-        }
+            } });
 
         return texture;
     }
@@ -1,8 +1,137 @@
 #include "core/Engine.h" // Essential for creating and managing the engine instance
+#include "core/Profiler.h" // For optional frame profiling and trace export
+#include "core/Metrics.h"  // For periodic metrics snapshots
 #include <iostream>      // For standard input/output operations, particularly error reporting
 #include <exception>     // For handling exceptions gracefully
+#include <cstdlib>       // For parsing numeric command-line values
+#include <string>        // For command-line argument handling
 #include "debug.h"       // Debug helper function
 
+namespace
+{
+    /**
+     * @brief Print command-line usage to standard output
+     *
+     * @param program Name the executable was invoked as
+     */
+    void printUsage(const char *program)
+    {
+        std::cout << "Usage: " << program << " [options]\n"
+                  << "  --headless           Run without window, renderer or input\n"
+                  << "  --scene <id>         Scene to load (default: DeveloperScene)\n"
+                  << "  --duration <s>       Simulated seconds to run headless, 0 = until stopped (default: 10)\n"
+                  << "  --speed <x>          Headless pacing as a multiple of real time, 0 = as fast as possible (default: 0)\n"
+                  << "  --profile <file>     Record profiler scopes and write them as Chrome trace JSON on exit\n"
+                  << "  --metrics <file>     Append metric snapshots (CSV, or JSON lines for .json) periodically and on exit\n"
+                  << "  --metrics-interval <s>  Seconds between metric snapshots (default: 10)\n"
+                  << "  --record <file>      Record the fixed timestep, seed, input actions and per-step state hashes\n"
+                  << "  --replay <file>      Re-simulate a recording headless and report the first step whose state differs\n"
+                  << "  --rewind <s>         Keep the last <s> simulated seconds for the console 'rewind' command (default: 0, off)\n"
+                  << "  --help               Show this message" << std::endl;
+    }
+
+    /**
+     * @brief Parse a non-negative number following an option
+     *
+     * @param option Option name, for error reporting
+     * @param text Text to parse
+     * @param value Receives the parsed value
+     * @return true if text is a non-negative number
+     */
+    bool parseNonNegative(const std::string &option, const char *text, double &value)
+    {
+        char *end = nullptr;
+        const double parsed = std::strtod(text, &end);
+        if (end == text || *end != '\0' || !(parsed >= 0.0))
+        {
+            std::cerr << "Invalid value for " << option << ": '" << text << "'" << std::endl;
+            return false;
+        }
+        value = parsed;
+        return true;
+    }
+
+    /**
+     * @brief Options given on the command line
+     */
+    struct CommandLineOptions
+    {
+        HeadlessConfig headless;      /**< Headless run settings */
+        std::string tracePath;        /**< Profiler trace output, empty when not profiling */
+        std::string metricsPath;      /**< Metrics snapshot output, empty when not dumping */
+        double metricsInterval = 10.0; /**< Seconds between metrics snapshots */
+        double rewindSeconds = 0.0;    /**< Rewind buffer length, 0 when disabled */
+        ReplayConfig replay;          /**< Session recording and playback files */
+        bool showHelp = false;        /**< --help was given */
+    };
+
+    /**
+     * @brief Parse the command line
+     *
+     * @param argc Argument count
+     * @param argv Argument values
+     * @param options Receives the parsed options
+     * @return true if every argument was understood
+     */
+    bool parseArguments(int argc, char *argv[], CommandLineOptions &options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            const bool hasValue = i + 1 < argc;
+
+            if (arg == "--headless")
+            {
+                options.headless.enabled = true;
+            }
+            else if (arg == "--help" || arg == "-h")
+            {
+                options.showHelp = true;
+            }
+            else if (arg == "--scene" || arg == "--duration" || arg == "--speed" || arg == "--profile" ||
+                     arg == "--metrics" || arg == "--metrics-interval" || arg == "--rewind" ||
+                     arg == "--record" || arg == "--replay")
+            {
+                if (!hasValue)
+                {
+                    std::cerr << "Missing value for " << arg << std::endl;
+                    return false;
+                }
+
+                const char *value = argv[++i];
+                bool valid = true;
+                if (arg == "--scene")
+                    options.headless.sceneId = value;
+                else if (arg == "--profile")
+                    options.tracePath = value;
+                else if (arg == "--metrics")
+                    options.metricsPath = value;
+                else if (arg == "--record")
+                    options.replay.recordPath = value;
+                else if (arg == "--replay")
+                    options.replay.playPath = value;
+                else if (arg == "--duration")
+                    valid = parseNonNegative(arg, value, options.headless.duration);
+                else if (arg == "--speed")
+                    valid = parseNonNegative(arg, value, options.headless.speedMultiplier);
+                else if (arg == "--rewind")
+                    valid = parseNonNegative(arg, value, options.rewindSeconds);
+                else
+                    valid = parseNonNegative(arg, value, options.metricsInterval);
+
+                if (!valid)
+                    return false;
+            }
+            else
+            {
+                std::cerr << "Unknown option: " << arg << std::endl;
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
 /**
  * @brief Main entry point for the FPV Flight Simulator
  *
@@ -15,13 +144,33 @@
  * 4. Request scene compilation and display
  * 5. Run the engine loop
  *
+ * With --headless the engine creates no window, renderer or input device and
+ * steps the fixed-timestep simulation for a set simulated duration, either as
+ * fast as possible or paced to a multiple of real time (see printUsage()).
+ * --replay runs headless too and exits with code 2 if the re-simulated
+ * state diverges from the recording.
+ *
  * This keeps the entry point lean, stable, and framework-like, delegating
  * all specific functionality to the appropriate subsystems.
  *
- * @return int Exit code (0 for success)
+ * @param argc Argument count
+ * @param argv Argument values
+ * @return int Exit code (0 for success, 2 for a diverged replay)
  */
-int main()
+int main(int argc, char *argv[])
 {
+    CommandLineOptions options;
+    if (!parseArguments(argc, argv, options))
+    {
+        printUsage(argv[0]);
+        return 1;
+    }
+    if (options.showHelp)
+    {
+        printUsage(argv[0]);
+        return 0;
+    }
+
     try
     {
         // ====================================================================
@@ -29,6 +178,10 @@ int main()
         // ====================================================================
         DEBUG_LOG("Starting FPV Flight Simulator engine initialization...");
         Engine engine; // Create the main engine instance
+        engine.setHeadlessConfig(options.headless);
+        engine.setRewindDuration(options.rewindSeconds);
+        engine.setReplayConfig(options.replay);
+        MetricsRegistry::instance().setDumpFile(options.metricsPath, options.metricsInterval);
 
         // Initialize the engine with paths to configuration files.
         // These configurations dictate fundamental engine behaviors,
@@ -70,17 +223,18 @@ int main()
         DEBUG_LOG("Assets resolved for runtime use.");
 
         // ====================================================================
-        // Step 4 & 5: Loading and Rendering (Developer Scene)
+        // Step 4 & 5: Loading and Rendering (Developer Scene by default)
         // ====================================================================
-        // Instead of a generic compiled scene, we explicitly load the developer scene.
+        // Instead of a generic compiled scene, we explicitly load the requested scene.
         // This demonstrates configuration-driven scene loading.
-        DEBUG_LOG("Requesting 'DeveloperScene' compilation and display...");
-        if (!engine.loadAndDisplayScene("DeveloperScene"))
+        const std::string &sceneId = options.headless.sceneId;
+        DEBUG_LOG("Requesting '" + sceneId + "' compilation and display...");
+        if (!engine.loadAndDisplayScene(sceneId))
         {
-            std::cerr << "Failed to load and display 'DeveloperScene'" << std::endl;
+            std::cerr << "Failed to load and display '" << sceneId << "'" << std::endl;
             return 1;
         }
-        DEBUG_LOG("'DeveloperScene' rendered successfully.");
+        DEBUG_LOG("'" + sceneId + "' rendered successfully.");
 
         // ====================================================================
         // Step 6: Looping (Engine Main Loop)
@@ -88,7 +242,18 @@ int main()
         // This is the heart of the simulation, where the engine continuously
         // updates its state, processes input, runs physics, and renders frames.
         DEBUG_LOG("Entering engine's main loop...");
-        return engine.run(); // Starts the game loop
+        Profiler::instance().setEnabled(!options.tracePath.empty());
+        const int exitCode = engine.run(); // Starts the game loop
+
+        if (!options.tracePath.empty() && Profiler::instance().exportChromeTrace(options.tracePath))
+        {
+            std::cout << "Wrote profiler trace to " << options.tracePath << std::endl;
+        }
+        if (!options.metricsPath.empty() && MetricsRegistry::instance().dump())
+        {
+            std::cout << "Wrote metrics snapshot to " << options.metricsPath << std::endl;
+        }
+        return exitCode;
     }
     catch (const std::exception &e)
     {
@@ -0,0 +1,68 @@
+/**
+ * @file ColliderType.h
+ * @brief Collision shapes understood by the narrowphase.
+ */
+#ifndef COLLIDERTYPE_H
+#define COLLIDERTYPE_H
+
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Shape of a PhysicsC collider, sized by PhysicsC::colliderSize.
+ */
+enum class ColliderType : std::uint8_t
+{
+    Sphere, /**< Diameter colliderSize[0] */
+    Box,    /**< Full extents colliderSize[0..2] */
+    Capsule /**< Diameter colliderSize[0], total height colliderSize[1] along local Y */
+};
+
+/**
+ * @brief Parse a collider type as written in entity definitions.
+ *
+ * @param name "sphere", "box" or "capsule"
+ * @param type [out] Parsed type, unchanged if the name is not recognized
+ * @return false if the name is not recognized
+ */
+inline bool parseColliderType(const std::string &name, ColliderType &type)
+{
+    if (name == "sphere")
+    {
+        type = ColliderType::Sphere;
+    }
+    else if (name == "box")
+    {
+        type = ColliderType::Box;
+    }
+    else if (name == "capsule")
+    {
+        type = ColliderType::Capsule;
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Get the name of a collider type as written in entity definitions.
+ *
+ * @param type Collider type
+ * @return "sphere", "box" or "capsule"
+ */
+inline const char *colliderTypeName(ColliderType type)
+{
+    switch (type)
+    {
+    case ColliderType::Box:
+        return "box";
+    case ColliderType::Capsule:
+        return "capsule";
+    default:
+        return "sphere";
+    }
+}
+
+#endif
@@ -0,0 +1,223 @@
+/**
+ * @file ContactSolver.cpp
+ * @brief Implementation of the sequential impulse contact solver.
+ */
+#include "ContactSolver.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    /** Fraction of the penetration beyond the slop removed per step */
+    constexpr float Baumgarte = 0.2f;
+
+    /** Penetration left alone so resting contacts persist (m) */
+    constexpr float LinearSlop = 0.005f;
+
+    /** Cap on the separating velocity used to push out deep penetration (m/s) */
+    constexpr float MaxCorrectionVelocity = 2.0f;
+
+    /** Closing speed below which contacts do not bounce (m/s) */
+    constexpr float RestitutionThreshold = 1.0f;
+
+    inline float dot(const Vector3D &a, const Vector3D &b)
+    {
+        return a.x * b.x + a.y * b.y + a.z * b.z;
+    }
+
+    inline Vector3D cross(const Vector3D &a, const Vector3D &b)
+    {
+        return Vector3D(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x);
+    }
+
+    /**
+     * @brief Multiply by a symmetric tensor stored as xx, yy, zz, xy, xz, yz.
+     */
+    inline Vector3D multiply(const float m[6], const Vector3D &v)
+    {
+        return Vector3D(m[0] * v.x + m[3] * v.y + m[4] * v.z, m[3] * v.x + m[1] * v.y + m[5] * v.z,
+                        m[4] * v.x + m[5] * v.y + m[2] * v.z);
+    }
+
+    Vector3D rotate(const Quaternion &q, const Vector3D &v)
+    {
+        const Vector3D u(q.x, q.y, q.z);
+        const Vector3D c = cross(u, v) * 2.0f;
+        return v + c * q.w + cross(u, c);
+    }
+
+    /**
+     * @brief Velocity of B's contact point relative to A's.
+     */
+    inline Vector3D relativeVelocity(const SolverBody &a, const SolverBody &b, const Vector3D &rA, const Vector3D &rB)
+    {
+        return b.velocity + cross(b.angularVelocity, rB) - a.velocity - cross(a.angularVelocity, rA);
+    }
+
+    /**
+     * @brief Apply impulse to b at rB and its opposite to a at rA.
+     */
+    inline void applyImpulse(SolverBody &a, SolverBody &b, const Vector3D &rA, const Vector3D &rB, const Vector3D &impulse)
+    {
+        if (a.invMass > 0.0f)
+        {
+            a.velocity = a.velocity - impulse * a.invMass;
+            a.angularVelocity = a.angularVelocity - multiply(a.invInertia, cross(rA, impulse));
+        }
+        if (b.invMass > 0.0f)
+        {
+            b.velocity = b.velocity + impulse * b.invMass;
+            b.angularVelocity = b.angularVelocity + multiply(b.invInertia, cross(rB, impulse));
+        }
+    }
+
+    float inverseEffectiveMass(const SolverBody &a, const SolverBody &b, const Vector3D &rA, const Vector3D &rB,
+                               const Vector3D &direction)
+    {
+        const Vector3D ra = cross(rA, direction), rb = cross(rB, direction);
+        const float k = a.invMass + b.invMass + dot(ra, multiply(a.invInertia, ra)) + dot(rb, multiply(b.invInertia, rb));
+        return k > 0.0f ? 1.0f / k : 0.0f;
+    }
+}
+
+/**
+ * @brief Set the world-space inverse inertia from the principal one: R diag(inverseInertia) R^T.
+ *
+ * @param rotation Orientation, body to world
+ * @param inverseInertia Inverse principal moments (0 locks the axis)
+ */
+void SolverBody::setInverseInertia(const Quaternion &rotation, const Vector3D &inverseInertia)
+{
+    const Vector3D c0 = rotate(rotation, Vector3D(1.0f, 0.0f, 0.0f));
+    const Vector3D c1 = rotate(rotation, Vector3D(0.0f, 1.0f, 0.0f));
+    const Vector3D c2 = rotate(rotation, Vector3D(0.0f, 0.0f, 1.0f));
+    const float d0 = inverseInertia.x, d1 = inverseInertia.y, d2 = inverseInertia.z;
+    invInertia[0] = d0 * c0.x * c0.x + d1 * c1.x * c1.x + d2 * c2.x * c2.x;
+    invInertia[1] = d0 * c0.y * c0.y + d1 * c1.y * c1.y + d2 * c2.y * c2.y;
+    invInertia[2] = d0 * c0.z * c0.z + d1 * c1.z * c1.z + d2 * c2.z * c2.z;
+    invInertia[3] = d0 * c0.x * c0.y + d1 * c1.x * c1.y + d2 * c2.x * c2.y;
+    invInertia[4] = d0 * c0.x * c0.z + d1 * c1.x * c1.z + d2 * c2.x * c2.z;
+    invInertia[5] = d0 * c0.y * c0.z + d1 * c1.y * c1.z + d2 * c2.y * c2.z;
+}
+
+ContactSolver::ContactSolver(int velocityIterations) : velocityIterations_(velocityIterations) {}
+
+/**
+ * @brief Compute the lever arms, effective masses and velocity targets of a manifold.
+ *
+ * A penetrating point's target pushes the bodies apart at a fraction of the
+ * penetration beyond the slop per step. A point that is still apart allows
+ * closing by exactly the gap, so fast bodies stop at the surface instead of
+ * tunnelling. Points that close faster than the restitution threshold during
+ * this step bounce.
+ *
+ * @param manifold Contact from the narrowphase
+ * @param bodies Body array the manifold's indices refer to
+ * @param friction Combined friction coefficient
+ * @param restitution Combined restitution coefficient
+ * @param dt Time step in seconds
+ * @param constraint [out] Prepared constraint
+ */
+void ContactSolver::prepare(const ContactManifold &manifold, const SolverBody *bodies, float friction, float restitution,
+                            float dt, ContactConstraint &constraint) const
+{
+    const SolverBody &a = bodies[manifold.bodyA];
+    const SolverBody &b = bodies[manifold.bodyB];
+    const Vector3D &n = manifold.normal;
+
+    constraint.bodyA = manifold.bodyA;
+    constraint.bodyB = manifold.bodyB;
+    constraint.normal = n;
+    constraint.friction = friction;
+    constraint.pointCount = manifold.pointCount;
+
+    // Friction directions depend on the normal only, so warm-started tangent impulses stay meaningful
+    Vector3D t0 = std::fabs(n.x) >= 0.57735f ? Vector3D(n.y, -n.x, 0.0f) : Vector3D(0.0f, n.z, -n.y);
+    t0 = t0 * (1.0f / std::sqrt(dot(t0, t0)));
+    constraint.tangents[0] = t0;
+    constraint.tangents[1] = cross(n, t0);
+
+    const float inverseDt = dt > 0.0f ? 1.0f / dt : 0.0f;
+    for (std::uint32_t i = 0; i < manifold.pointCount; ++i)
+    {
+        const ContactPoint &contact = manifold.points[i];
+        ContactConstraint::Point &point = constraint.points[i];
+        point.rA = contact.position - a.position;
+        point.rB = contact.position - b.position;
+        point.normalMass = inverseEffectiveMass(a, b, point.rA, point.rB, n);
+        point.tangentMass[0] = inverseEffectiveMass(a, b, point.rA, point.rB, constraint.tangents[0]);
+        point.tangentMass[1] = inverseEffectiveMass(a, b, point.rA, point.rB, constraint.tangents[1]);
+        point.impulse = ContactImpulse();
+
+        if (contact.depth < 0.0f)
+        {
+            point.bias = contact.depth * inverseDt;
+        }
+        else
+        {
+            point.bias = std::min(Baumgarte * std::max(contact.depth - LinearSlop, 0.0f) * inverseDt, MaxCorrectionVelocity);
+        }
+        const float normalVelocity = dot(relativeVelocity(a, b, point.rA, point.rB), n);
+        if (normalVelocity < -RestitutionThreshold && contact.depth - normalVelocity * dt >= 0.0f)
+        {
+            point.bias = std::max(point.bias, -restitution * normalVelocity);
+        }
+    }
+}
+
+/**
+ * @brief Apply the warm-start impulses, then iterate over the constraints of one island.
+ *
+ * Friction is solved before the normal impulse of each point so the
+ * non-penetration constraint, the more important one, has the last word.
+ *
+ * @param constraints Constraints of the island
+ * @param count Number of constraints
+ * @param bodies Body array the constraints' indices refer to
+ */
+void ContactSolver::solve(ContactConstraint *constraints, std::size_t count, SolverBody *bodies) const
+{
+    for (std::size_t c = 0; c < count; ++c)
+    {
+        const ContactConstraint &constraint = constraints[c];
+        SolverBody &a = bodies[constraint.bodyA];
+        SolverBody &b = bodies[constraint.bodyB];
+        for (std::uint32_t i = 0; i < constraint.pointCount; ++i)
+        {
+            const ContactConstraint::Point &point = constraint.points[i];
+            const Vector3D impulse = constraint.normal * point.impulse.normal +
+                                     constraint.tangents[0] * point.impulse.tangent[0] +
+                                     constraint.tangents[1] * point.impulse.tangent[1];
+            applyImpulse(a, b, point.rA, point.rB, impulse);
+        }
+    }
+
+    for (int iteration = 0; iteration < velocityIterations_; ++iteration)
+    {
+        for (std::size_t c = 0; c < count; ++c)
+        {
+            ContactConstraint &constraint = constraints[c];
+            SolverBody &a = bodies[constraint.bodyA];
+            SolverBody &b = bodies[constraint.bodyB];
+            for (std::uint32_t i = 0; i < constraint.pointCount; ++i)
+            {
+                ContactConstraint::Point &point = constraint.points[i];
+
+                const float maxFriction = constraint.friction * point.impulse.normal;
+                for (int k = 0; k < 2; ++k)
+                {
+                    const Vector3D &tangent = constraint.tangents[k];
+                    const float velocity = dot(relativeVelocity(a, b, point.rA, point.rB), tangent);
+                    const float previous = point.impulse.tangent[k];
+                    point.impulse.tangent[k] = std::max(-maxFriction, std::min(maxFriction, previous - velocity * point.tangentMass[k]));
+                    applyImpulse(a, b, point.rA, point.rB, tangent * (point.impulse.tangent[k] - previous));
+                }
+
+                const float velocity = dot(relativeVelocity(a, b, point.rA, point.rB), constraint.normal);
+                const float previous = point.impulse.normal;
+                point.impulse.normal = std::max(0.0f, previous + (point.bias - velocity) * point.normalMass);
+                applyImpulse(a, b, point.rA, point.rB, constraint.normal * (point.impulse.normal - previous));
+            }
+        }
+    }
+}
@@ -0,0 +1,136 @@
+/**
+ * @file ContactSolver.h
+ * @brief Sequential impulse solver for contact manifolds with friction and warm starting.
+ */
+#ifndef CONTACTSOLVER_H
+#define CONTACTSOLVER_H
+
+#include "Narrowphase.h"
+#include "../core/Quaternion.h"
+#include "../core/Vector3D.h"
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Velocity state and inverse mass of one body, as seen by the contact solver.
+ *
+ * Bodies with a zero inverse mass (static, kinematic or sleeping) keep their
+ * velocity; the solver never writes to them, so islands that share such a
+ * body can be solved concurrently.
+ */
+struct SolverBody
+{
+    Vector3D position;        /**< Center of mass in world space */
+    Vector3D velocity;        /**< Linear velocity (m/s) */
+    Vector3D angularVelocity; /**< Angular velocity in world space (rad/s) */
+    float invMass = 0.0f;     /**< 1 / mass, 0 for bodies that do not respond to impulses */
+    float invInertia[6] = {}; /**< World-space inverse inertia tensor: xx, yy, zz, xy, xz, yz */
+
+    /**
+     * @brief Set the world-space inverse inertia from the principal one.
+     *
+     * @param rotation Orientation, body to world
+     * @param inverseInertia Inverse principal moments (0 locks the axis)
+     */
+    void setInverseInertia(const Quaternion &rotation, const Vector3D &inverseInertia);
+};
+
+/**
+ * @brief Impulses accumulated at one contact point, kept between steps for warm starting.
+ */
+struct ContactImpulse
+{
+    float normal = 0.0f;             /**< Along the contact normal (N s) */
+    float tangent[2] = {0.0f, 0.0f}; /**< Along the two friction directions (N s) */
+};
+
+/**
+ * @brief A contact manifold prepared for solving.
+ */
+struct ContactConstraint
+{
+    /**
+     * @brief Per point lever arms, effective masses and impulses.
+     */
+    struct Point
+    {
+        Vector3D rA;             /**< Contact point relative to A's center */
+        Vector3D rB;             /**< Contact point relative to B's center */
+        float normalMass;        /**< Inverse effective mass along the normal */
+        float tangentMass[2];    /**< Inverse effective masses along the friction directions */
+        float bias;              /**< Smallest allowed separating velocity along the normal (m/s) */
+        ContactImpulse impulse;  /**< Accumulated impulses, seeded by warm starting */
+    };
+
+    std::uint32_t bodyA = 0;        /**< Index of the first body */
+    std::uint32_t bodyB = 0;        /**< Index of the second body */
+    Vector3D normal;                /**< Unit normal pointing from A to B */
+    Vector3D tangents[2];           /**< Friction directions, derived from the normal alone */
+    float friction = 0.0f;          /**< Combined friction coefficient */
+    std::uint32_t pointCount = 0;   /**< Valid entries of points */
+    Point points[MaxContactPoints]; /**< Contact points */
+};
+
+/**
+ * @class ContactSolver
+ * @brief Resolves contacts with sequential impulses (projected Gauss-Seidel).
+ *
+ * Each contact point carries a non-penetration impulse, clamped to push
+ * only, and two friction impulses bounded by the friction cone's box
+ * approximation. Impulses are accumulated over the iterations and start
+ * from the previous step's values (warm starting), which is what lets
+ * stacks come to rest within a few iterations. Penetration beyond a small
+ * slop is removed with a Baumgarte velocity bias; contacts that are still
+ * apart let the bodies close exactly the remaining gap in one step.
+ *
+ * A solve only touches the bodies its constraints name, so disjoint
+ * islands may be solved in parallel.
+ */
+class ContactSolver
+{
+public:
+    /**
+     * @brief Construct a solver.
+     *
+     * @param velocityIterations Passes over an island's constraints per step
+     */
+    explicit ContactSolver(int velocityIterations = 8);
+
+    /**
+     * @brief Compute the lever arms, effective masses and velocity targets of a manifold.
+     *
+     * Reads the bodies' current velocities, so call it after gravity and
+     * forces have been integrated. The points' impulses are zeroed; set them
+     * from the previous step before solve() to warm start.
+     *
+     * @param manifold Contact from the narrowphase
+     * @param bodies Body array the manifold's indices refer to
+     * @param friction Combined friction coefficient
+     * @param restitution Combined restitution coefficient
+     * @param dt Time step in seconds
+     * @param constraint [out] Prepared constraint
+     */
+    void prepare(const ContactManifold &manifold, const SolverBody *bodies, float friction, float restitution, float dt,
+                 ContactConstraint &constraint) const;
+
+    /**
+     * @brief Apply the warm-start impulses, then iterate over the constraints of one island.
+     *
+     * @param constraints Constraints of the island
+     * @param count Number of constraints
+     * @param bodies Body array the constraints' indices refer to
+     */
+    void solve(ContactConstraint *constraints, std::size_t count, SolverBody *bodies) const;
+
+    /**
+     * @brief Get the number of velocity iterations.
+     *
+     * @return Passes per step
+     */
+    int getVelocityIterations() const { return velocityIterations_; }
+
+private:
+    int velocityIterations_; /**< Passes over an island's constraints per step */
+};
+
+#endif
@@ -1,9 +1,5 @@
 /**
- * @file ExpExponentialAirDensityModel::ExponentialAirDensityModel(float seaLevelDensity, float scaleHeight)
-    : seaLevelDensity_(seaLevelDensity), scaleHeight_(scaleHeight)
-{
-    DEBUG_LOG("Initializing ExponentialAirDensityModel with sea level density " + std::to_string(seaLevelDensity) + " and scale height " + std::to_string(scaleHeight));
-}ialAirDensityModel.cpp
+ * @file ExponentialAirDensityModel.cpp
  * @brief Implementation of the exponential air density model.
  */
 
@@ -36,7 +32,6 @@ ExponentialAirDensityModel::ExponentialAirDensityModel(float seaLevelDensity, fl
  */
 float ExponentialAirDensityModel::getDensity(float altitude) const
 {
-    DEBUG_LOG("Calculating air density at altitude " + std::to_string(altitude));
     return seaLevelDensity_ * std::exp(-altitude / scaleHeight_);
 }
 
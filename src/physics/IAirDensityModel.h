@@ -10,6 +10,20 @@
 #ifndef IAIRDENSITYMODEL_H
 #define IAIRDENSITYMODEL_H
 
+#include <cmath>
+#include <cstddef>
+
+/**
+ * @brief State of the air at one altitude.
+ */
+struct AtmosphereState
+{
+    float density;      /**< Air density in kg/m³ */
+    float pressure;     /**< Static pressure in Pa */
+    float temperature;  /**< Static temperature in K */
+    float speedOfSound; /**< Speed of sound in m/s */
+};
+
 /**
  * @class IAirDensityModel
  * @brief Abstract interface for calculating air density at different altitudes.
@@ -31,6 +45,54 @@ public:
      * @return The air density in kg/m³ at the specified altitude
      */
     virtual float getDensity(float altitude) const = 0;
+
+    /**
+     * @brief Calculate density, pressure, temperature and speed of sound at a given altitude.
+     *
+     * The default assumes air at the ISA sea level temperature and derives
+     * pressure from getDensity() with the ideal gas law; models that know the
+     * temperature profile override it.
+     *
+     * @param altitude The altitude above sea level in meters
+     * @return The state of the air at the specified altitude
+     */
+    virtual AtmosphereState getState(float altitude) const
+    {
+        const float temperature = 288.15f;
+        const float density = getDensity(altitude);
+        return AtmosphereState{density, density * 287.05287f * temperature, temperature,
+                               std::sqrt(1.4f * 287.05287f * temperature)};
+    }
+
+    /**
+     * @brief Calculate air density at many altitudes.
+     *
+     * @param altitudes Altitudes above sea level in meters
+     * @param densities [out] Air densities in kg/m³
+     * @param count Number of altitudes
+     */
+    virtual void getDensityBatch(const float *altitudes, float *densities, std::size_t count) const
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            densities[i] = getDensity(altitudes[i]);
+        }
+    }
+
+    /**
+     * @brief Calculate the full state of the air at many altitudes.
+     *
+     * @param altitudes Altitudes above sea level in meters
+     * @param states [out] State of the air per altitude
+     * @param count Number of altitudes
+     */
+    virtual void getStateBatch(const float *altitudes, AtmosphereState *states, std::size_t count) const
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            states[i] = getState(altitudes[i]);
+        }
+    }
 };
 
 #endif
@@ -10,6 +10,8 @@
 #ifndef IWINDMODEL_H
 #define IWINDMODEL_H
 
+#include <cstddef>
+
 /**
  * @class IWindModel
  * @brief Abstract interface for calculating wind velocity at spatial positions.
@@ -35,6 +37,40 @@ public:
      * @param wz [out] Z component of wind velocity at the position
      */
     virtual void getWind(float x, float y, float z, float &wx, float &wy, float &wz) const = 0;
+
+    /**
+     * @brief Calculate wind velocity at many positions.
+     *
+     * Positions and results are split into component arrays so callers that
+     * keep their state as structure-of-arrays can pass it directly. The
+     * default samples each position through getWind().
+     *
+     * @param x X coordinates of the positions
+     * @param y Y coordinates of the positions
+     * @param z Z coordinates of the positions
+     * @param wx [out] X components of wind velocity
+     * @param wy [out] Y components of wind velocity
+     * @param wz [out] Z components of wind velocity
+     * @param count Number of positions
+     */
+    virtual void getWindBatch(const float *x, const float *y, const float *z, float *wx, float *wy, float *wz,
+                              std::size_t count) const
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            getWind(x[i], y[i], z[i], wx[i], wy[i], wz[i]);
+        }
+    }
+
+    /**
+     * @brief Set the simulation time the wind field is sampled at.
+     *
+     * Time-varying models derive their state from the time alone, so a
+     * rewound or replayed run sees the same wind. Steady models ignore it.
+     *
+     * @param seconds Simulation time in seconds
+     */
+    virtual void setTime(double seconds) { (void)seconds; }
 };
 
 #endif
@@ -0,0 +1,120 @@
+/**
+ * @file MultirotorModel.cpp
+ * @brief Implementation of the multirotor rotor, motor and battery model.
+ */
+#include "MultirotorModel.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    /** @brief LiPo open circuit voltage per cell at 0%, 10%, ..., 100% charge, at rest */
+    constexpr float CellVoltageCurve[] = {3.30f, 3.60f, 3.68f, 3.72f, 3.75f, 3.78f, 3.82f, 3.87f, 3.94f, 4.05f, 4.20f};
+
+    constexpr int CurveSegments = static_cast<int>(sizeof(CellVoltageCurve) / sizeof(CellVoltageCurve[0])) - 1;
+
+    /** @brief Rotor speed below which an unpowered rotor counts as stopped (rad/s) */
+    constexpr float StoppedSpeed = 1.0f;
+
+    inline float clamp01(float value)
+    {
+        return std::min(std::max(value, 0.0f), 1.0f);
+    }
+}
+
+/**
+ * @brief Advance one vehicle by dt in substeps and compute its mean rotor wrench.
+ *
+ * The commands and the open circuit voltage are held over the step; the
+ * charge drawn is taken from the battery at the end.
+ *
+ * @param params Vehicle type
+ * @param input Commands held over the step
+ * @param state [in,out] Rotor, motor and battery state
+ * @param dt Step length in seconds
+ * @param substeps Number of substeps, at least one
+ * @param force [out] Mean rotor force over the step, in the body frame (N)
+ * @param torque [out] Mean rotor torque about the center of mass, in the body frame (N m)
+ */
+void MultirotorModel::step(const MultirotorParams &params, const MultirotorInput &input, MultirotorState &state,
+                           float dt, int substeps, Vector3D &force, Vector3D &torque)
+{
+    constexpr int MaxRotors = MultirotorParams::MaxRotors;
+    const int rotors = std::min(std::max(params.rotorCount, 0), MaxRotors);
+    substeps = std::max(substeps, 1);
+    const float h = dt / static_cast<float>(substeps);
+
+    float targetPerVolt[MaxRotors];
+    float response[MaxRotors];
+    float meanSquare[MaxRotors];
+    for (int i = 0; i < rotors; ++i)
+    {
+        const float *mix = params.mixer[i];
+        const float command = clamp01(input.roll * mix[0] + input.pitch * mix[1] + input.yaw * mix[2] +
+                                      input.throttle * mix[3]);
+        targetPerVolt[i] = command * params.speedPerVolt[i];
+        response[i] = params.motorTimeConstant[i] > 0.0f ? 1.0f - std::exp(-h / params.motorTimeConstant[i]) : 1.0f;
+        meanSquare[i] = 0.0f;
+    }
+
+    const float openCircuit = static_cast<float>(params.cellCount) * cellVoltage(state.stateOfCharge);
+    float current = state.current;
+    float voltage = state.voltage;
+    float charge = 0.0f;
+    for (int s = 0; s < substeps; ++s)
+    {
+        voltage = std::max(openCircuit - params.internalResistance * current, 0.0f);
+        current = 0.0f;
+        for (int i = 0; i < rotors; ++i)
+        {
+            float &speed = state.rotorSpeed[i];
+            speed += response[i] * (targetPerVolt[i] * voltage - speed);
+            const float square = speed * speed;
+            meanSquare[i] += square;
+            current += params.currentCoefficient[i] * square;
+        }
+        charge += current * h;
+    }
+    for (int i = 0; i < rotors; ++i)
+    {
+        // Stop spun-down rotors outright, so an idle vehicle applies no force and may fall asleep
+        if (targetPerVolt[i] == 0.0f && state.rotorSpeed[i] < StoppedSpeed)
+            state.rotorSpeed[i] = 0.0f;
+    }
+
+    state.voltage = voltage;
+    state.current = current;
+    if (params.capacityAh > 0.0f)
+        state.stateOfCharge = clamp01(state.stateOfCharge - charge / (params.capacityAh * 3600.0f));
+
+    // Thrust T along +Y at hub r gives torque r x (0, T, 0) = (-r.z T, 0, r.x T); drag torque opposes the spin
+    const float inverseSubsteps = 1.0f / static_cast<float>(substeps);
+    float thrust = 0.0f;
+    float tx = 0.0f, ty = 0.0f, tz = 0.0f;
+    for (int i = 0; i < rotors; ++i)
+    {
+        const float square = meanSquare[i] * inverseSubsteps;
+        const float rotorThrust = params.thrustCoefficient[i] * square;
+        const Vector3D &r = params.rotorPosition[i];
+        thrust += rotorThrust;
+        tx -= r.z * rotorThrust;
+        ty -= params.spin[i] * params.torqueCoefficient[i] * square;
+        tz += r.x * rotorThrust;
+    }
+    force = Vector3D(0.0f, thrust, 0.0f);
+    torque = Vector3D(tx, ty, tz);
+}
+
+/**
+ * @brief Open circuit voltage of one LiPo cell, interpolated from a typical discharge curve.
+ *
+ * @param stateOfCharge Remaining charge as a fraction of capacity (0-1)
+ * @return Cell voltage in volts
+ */
+float MultirotorModel::cellVoltage(float stateOfCharge)
+{
+    const float position = clamp01(stateOfCharge) * static_cast<float>(CurveSegments);
+    const int segment = std::min(static_cast<int>(position), CurveSegments - 1);
+    const float t = position - static_cast<float>(segment);
+    return CellVoltageCurve[segment] + t * (CellVoltageCurve[segment + 1] - CellVoltageCurve[segment]);
+}
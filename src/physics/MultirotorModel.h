@@ -0,0 +1,150 @@
+/**
+ * @file MultirotorModel.h
+ * @brief Rotor, motor and battery model of an electric multirotor.
+ */
+#ifndef MULTIROTORMODEL_H
+#define MULTIROTORMODEL_H
+
+#include "../core/Vector3D.h"
+#include <string>
+
+/**
+ * @struct MultirotorParams
+ * @brief Compiled, immutable description of one multirotor type.
+ *
+ * Everything the model needs per step is a plain float in a fixed-size
+ * array, so a vehicle type is one small allocation shared by every drone
+ * built from it. Positions and axes are in the engine's body frame: +X
+ * forward, +Y up, +Z right; rotors thrust along +Y.
+ */
+struct MultirotorParams
+{
+    /** @brief Largest rotor count a parameter block can describe */
+    static constexpr int MaxRotors = 8;
+
+    /** @brief File the block was compiled from, which names it in snapshots */
+    std::string source;
+
+    /** @brief Number of rotors in use */
+    int rotorCount = 0;
+
+    /** @brief Take-off mass in kg */
+    float mass = 0.0f;
+
+    /** @brief Principal moments of inertia about the body axes (kg m^2) */
+    Vector3D inertia;
+
+    /** @brief Extent of the frame and rotor discs along the body axes (m) */
+    Vector3D frameSize;
+
+    /** @brief Rotor hub positions relative to the center of mass (m) */
+    Vector3D rotorPosition[MaxRotors];
+
+    /** @brief +1 for a rotor spinning counter-clockwise seen from above, -1 for clockwise */
+    float spin[MaxRotors] = {};
+
+    /** @brief Command per unit roll, pitch, yaw and throttle input, from the control-map */
+    float mixer[MaxRotors][4] = {};
+
+    /** @brief Thrust per squared rotor speed (N s^2 / rad^2) */
+    float thrustCoefficient[MaxRotors] = {};
+
+    /** @brief Drag torque per squared rotor speed (N m s^2 / rad^2) */
+    float torqueCoefficient[MaxRotors] = {};
+
+    /** @brief Steady rotor speed per volt at full command (rad/s/V): the motor's KV */
+    float speedPerVolt[MaxRotors] = {};
+
+    /** @brief Motor current per squared rotor speed (A s^2 / rad^2): drag torque over the torque constant */
+    float currentCoefficient[MaxRotors] = {};
+
+    /** @brief Time constant of the first-order motor response (s) */
+    float motorTimeConstant[MaxRotors] = {};
+
+    /** @brief Number of LiPo cells in series */
+    int cellCount = 0;
+
+    /** @brief Battery capacity in ampere-hours */
+    float capacityAh = 0.0f;
+
+    /** @brief Battery internal resistance, including wiring (ohm) */
+    float internalResistance = 0.0f;
+};
+
+/**
+ * @struct MultirotorState
+ * @brief Per-vehicle state of the rotors, motors and battery.
+ */
+struct MultirotorState
+{
+    /** @brief Rotor speeds (rad/s) */
+    float rotorSpeed[MultirotorParams::MaxRotors] = {};
+
+    /** @brief Remaining battery charge as a fraction of capacity (0-1) */
+    float stateOfCharge = 1.0f;
+
+    /** @brief Battery terminal voltage under the present load (V) */
+    float voltage = 0.0f;
+
+    /** @brief Total motor current drawn from the battery (A) */
+    float current = 0.0f;
+};
+
+/**
+ * @struct MultirotorInput
+ * @brief Pilot or controller commands, applied through the vehicle's control-map.
+ */
+struct MultirotorInput
+{
+    float roll = 0.0f;     /**< Roll command (-1 to 1) */
+    float pitch = 0.0f;    /**< Pitch command (-1 to 1) */
+    float yaw = 0.0f;      /**< Yaw command (-1 to 1) */
+    float throttle = 0.0f; /**< Collective throttle (0 to 1) */
+};
+
+/**
+ * @class MultirotorModel
+ * @brief Advances rotors, motors and battery in substeps and returns the mean rotor wrench.
+ *
+ * Per substep h and rotor i, with mixed command u_i in [0, 1], pack open
+ * circuit voltage E (from the LiPo discharge curve at the start of the step),
+ * internal resistance R and the current I drawn in the previous substep:
+ *
+ *   V    = E - R * I
+ *   w_i' = w_i + (1 - exp(-h / tau_i)) * (u_i * KV_i * V - w_i)
+ *   T_i  = kT_i * w_i'^2,   Q_i = kQ_i * w_i'^2,   I = sum(kI_i * w_i'^2)
+ *
+ * so sag under load slows the motors, which sheds thrust and current in
+ * turn. Each rotor thrusts along body +Y at its hub and its drag torque
+ * turns the body against its spin. Thrust and drag torque are linear in
+ * w^2, so the step only accumulates each rotor's mean w^2 across the
+ * substeps and forms the wrench once; a substep costs a handful of
+ * multiplies per rotor.
+ */
+class MultirotorModel
+{
+public:
+    /**
+     * @brief Advance one vehicle by dt in substeps and compute its mean rotor wrench.
+     *
+     * @param params Vehicle type
+     * @param input Commands held over the step
+     * @param state [in,out] Rotor, motor and battery state
+     * @param dt Step length in seconds
+     * @param substeps Number of substeps, at least one
+     * @param force [out] Mean rotor force over the step, in the body frame (N)
+     * @param torque [out] Mean rotor torque about the center of mass, in the body frame (N m)
+     */
+    static void step(const MultirotorParams &params, const MultirotorInput &input, MultirotorState &state,
+                     float dt, int substeps, Vector3D &force, Vector3D &torque);
+
+    /**
+     * @brief Open circuit voltage of one LiPo cell.
+     *
+     * @param stateOfCharge Remaining charge as a fraction of capacity (0-1)
+     * @return Cell voltage in volts
+     */
+    static float cellVoltage(float stateOfCharge);
+};
+
+#endif
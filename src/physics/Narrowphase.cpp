@@ -0,0 +1,678 @@
+/**
+ * @file Narrowphase.cpp
+ * @brief Implementation of sphere, box and capsule contact generation.
+ */
+#include "Narrowphase.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    /** Face axes are kept over edge axes and A's faces over B's unless the other separates this much better */
+    constexpr float AxisRelativeTolerance = 0.95f;
+    constexpr float AxisAbsoluteTolerance = 0.005f;
+
+    /** Iterations of the golden section search for the deepest point of a capsule in a box */
+    constexpr int CapsuleBoxIterations = 24;
+
+    /** Contact normal used when two centers coincide */
+    const Vector3D UpAxis(0.0f, 1.0f, 0.0f);
+
+    inline float dot(const Vector3D &a, const Vector3D &b)
+    {
+        return a.x * b.x + a.y * b.y + a.z * b.z;
+    }
+
+    inline Vector3D cross(const Vector3D &a, const Vector3D &b)
+    {
+        return Vector3D(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x);
+    }
+
+    inline float component(const Vector3D &v, int axis)
+    {
+        return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+    }
+
+    inline float clamp01(float value)
+    {
+        return value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+    }
+
+    /**
+     * @brief Rotate v by the unit quaternion q.
+     */
+    Vector3D rotate(const Quaternion &q, const Vector3D &v)
+    {
+        const Vector3D u(q.x, q.y, q.z);
+        const Vector3D c = cross(u, v) * 2.0f;
+        return v + c * q.w + cross(u, c);
+    }
+
+    void addPoint(ContactManifold &manifold, const Vector3D &position, float depth)
+    {
+        if (manifold.pointCount < MaxContactPoints)
+        {
+            manifold.points[manifold.pointCount++] = ContactPoint{position, depth};
+        }
+    }
+
+    /**
+     * @brief Closest point to x on the segment [p, q].
+     */
+    Vector3D closestOnSegment(const Vector3D &p, const Vector3D &q, const Vector3D &x)
+    {
+        const Vector3D d = q - p;
+        const float lengthSquared = dot(d, d);
+        if (lengthSquared <= 1e-12f)
+        {
+            return p;
+        }
+        return p + d * clamp01(dot(x - p, d) / lengthSquared);
+    }
+
+    /**
+     * @brief Closest points c1 on [p1, q1] and c2 on [p2, q2] (Ericson, Real-Time Collision Detection 5.1.9).
+     */
+    void closestBetweenSegments(const Vector3D &p1, const Vector3D &q1, const Vector3D &p2, const Vector3D &q2,
+                                Vector3D &c1, Vector3D &c2)
+    {
+        const float epsilon = 1e-12f;
+        const Vector3D d1 = q1 - p1, d2 = q2 - p2, r = p1 - p2;
+        const float a = dot(d1, d1), e = dot(d2, d2), f = dot(d2, r);
+        float s = 0.0f, t = 0.0f;
+        if (a > epsilon || e > epsilon)
+        {
+            if (a <= epsilon)
+            {
+                t = clamp01(f / e);
+            }
+            else
+            {
+                const float c = dot(d1, r);
+                if (e <= epsilon)
+                {
+                    s = clamp01(-c / a);
+                }
+                else
+                {
+                    const float b = dot(d1, d2);
+                    const float denominator = a * e - b * b;
+                    s = denominator > epsilon ? clamp01((b * f - c * e) / denominator) : 0.0f;
+                    t = (b * s + f) / e;
+                    if (t < 0.0f)
+                    {
+                        t = 0.0f;
+                        s = clamp01(-c / a);
+                    }
+                    else if (t > 1.0f)
+                    {
+                        t = 1.0f;
+                        s = clamp01((b - c) / a);
+                    }
+                }
+            }
+        }
+        c1 = p1 + d1 * s;
+        c2 = p2 + d2 * t;
+    }
+
+    void capsuleSegment(const CollisionShape &capsule, Vector3D &p0, Vector3D &p1)
+    {
+        const Vector3D half = capsule.axes[1] * capsule.halfExtents.y;
+        p0 = capsule.center - half;
+        p1 = capsule.center + half;
+    }
+
+    /**
+     * @brief Contact between spheres (pa, ra) and (pb, rb).
+     */
+    bool sphereSphere(const Vector3D &pa, float ra, const Vector3D &pb, float rb, float margin, ContactManifold &manifold)
+    {
+        const Vector3D d = pb - pa;
+        const float distanceSquared = dot(d, d);
+        const float reach = ra + rb + margin;
+        if (distanceSquared > reach * reach)
+        {
+            return false;
+        }
+        const float distance = std::sqrt(distanceSquared);
+        const Vector3D normal = distance > 1e-6f ? d * (1.0f / distance) : UpAxis;
+        const float depth = ra + rb - distance;
+        manifold.normal = normal;
+        manifold.pointCount = 0;
+        addPoint(manifold, pa + normal * (ra - 0.5f * depth), depth);
+        return true;
+    }
+
+    /**
+     * @brief Contact between the sphere (c, r) and a box, normal from the sphere to the box.
+     */
+    bool sphereBox(const Vector3D &c, float r, const CollisionShape &box, float margin, ContactManifold &manifold)
+    {
+        const Vector3D d = c - box.center;
+        const float local[3] = {dot(d, box.axes[0]), dot(d, box.axes[1]), dot(d, box.axes[2])};
+        const float half[3] = {box.halfExtents.x, box.halfExtents.y, box.halfExtents.z};
+
+        Vector3D closest = box.center;
+        for (int k = 0; k < 3; ++k)
+        {
+            closest = closest + box.axes[k] * std::max(-half[k], std::min(half[k], local[k]));
+        }
+        const Vector3D delta = c - closest;
+        const float distanceSquared = dot(delta, delta);
+
+        Vector3D outward;
+        Vector3D surface;
+        float depth;
+        if (distanceSquared > 1e-12f)
+        {
+            if (distanceSquared > (r + margin) * (r + margin))
+            {
+                return false;
+            }
+            const float distance = std::sqrt(distanceSquared);
+            outward = delta * (1.0f / distance);
+            surface = closest;
+            depth = r - distance;
+        }
+        else
+        {
+            // Center inside the box: push out through the nearest face
+            int face = 0;
+            float faceDistance = half[0] - std::fabs(local[0]);
+            for (int k = 1; k < 3; ++k)
+            {
+                const float distance = half[k] - std::fabs(local[k]);
+                if (distance < faceDistance)
+                {
+                    faceDistance = distance;
+                    face = k;
+                }
+            }
+            outward = local[face] >= 0.0f ? box.axes[face] : box.axes[face] * -1.0f;
+            surface = c + outward * faceDistance;
+            depth = r + faceDistance;
+        }
+        manifold.normal = outward * -1.0f;
+        manifold.pointCount = 0;
+        addPoint(manifold, (surface + c - outward * r) * 0.5f, depth);
+        return true;
+    }
+
+    float signedDistanceToBox(const Vector3D &point, const CollisionShape &box)
+    {
+        const Vector3D d = point - box.center;
+        const float q[3] = {std::fabs(dot(d, box.axes[0])) - box.halfExtents.x,
+                            std::fabs(dot(d, box.axes[1])) - box.halfExtents.y,
+                            std::fabs(dot(d, box.axes[2])) - box.halfExtents.z};
+        float outside = 0.0f;
+        for (float value : q)
+        {
+            outside += value > 0.0f ? value * value : 0.0f;
+        }
+        return std::sqrt(outside) + std::min(std::max(q[0], std::max(q[1], q[2])), 0.0f);
+    }
+
+    bool sphereCapsule(const CollisionShape &sphere, const CollisionShape &capsule, float margin, ContactManifold &manifold)
+    {
+        Vector3D p0, p1;
+        capsuleSegment(capsule, p0, p1);
+        return sphereSphere(sphere.center, sphere.radius, closestOnSegment(p0, p1, sphere.center), capsule.radius,
+                            margin, manifold);
+    }
+
+    /**
+     * @brief Contact between a box and a capsule, normal from the box to the capsule.
+     *
+     * The signed distance from the capsule's segment to the box is convex along
+     * the segment, so a golden section search finds the deepest point; both
+     * segment ends are tested as well, which gives a capsule lying on a face
+     * a point at each end. The interior point is only kept when it is deeper
+     * than the ends, since two end contacts already span a flat one.
+     */
+    bool boxCapsule(const CollisionShape &box, const CollisionShape &capsule, float margin, ContactManifold &manifold)
+    {
+        Vector3D p0, p1;
+        capsuleSegment(capsule, p0, p1);
+        const Vector3D d = p1 - p0;
+
+        float lo = 0.0f, hi = 1.0f;
+        const float inversePhi = 0.618034f;
+        float t1 = hi - inversePhi * (hi - lo), t2 = lo + inversePhi * (hi - lo);
+        float f1 = signedDistanceToBox(p0 + d * t1, box), f2 = signedDistanceToBox(p0 + d * t2, box);
+        for (int i = 0; i < CapsuleBoxIterations; ++i)
+        {
+            if (f1 < f2)
+            {
+                hi = t2;
+                t2 = t1;
+                f2 = f1;
+                t1 = hi - inversePhi * (hi - lo);
+                f1 = signedDistanceToBox(p0 + d * t1, box);
+            }
+            else
+            {
+                lo = t1;
+                t1 = t2;
+                f1 = f2;
+                t2 = lo + inversePhi * (hi - lo);
+                f2 = signedDistanceToBox(p0 + d * t2, box);
+            }
+        }
+
+        const float candidates[3] = {0.0f, 1.0f, 0.5f * (lo + hi)};
+        const float mergeDistance = 0.05f * capsule.radius + 1e-3f;
+        manifold.pointCount = 0;
+        float deepest = -1e30f;
+        for (float t : candidates)
+        {
+            ContactManifold single;
+            if (!sphereBox(p0 + d * t, capsule.radius, box, margin, single))
+            {
+                continue;
+            }
+            const ContactPoint &point = single.points[0];
+            if (manifold.pointCount == 2 && point.depth <= deepest + 1e-4f)
+            {
+                continue;
+            }
+            bool duplicate = false;
+            for (std::uint32_t i = 0; i < manifold.pointCount; ++i)
+            {
+                const Vector3D gap = manifold.points[i].position - point.position;
+                duplicate = duplicate || dot(gap, gap) < mergeDistance * mergeDistance;
+            }
+            if (duplicate)
+            {
+                continue;
+            }
+            if (point.depth > deepest)
+            {
+                deepest = point.depth;
+                manifold.normal = single.normal * -1.0f;
+            }
+            addPoint(manifold, point.position, point.depth);
+        }
+        return manifold.pointCount > 0;
+    }
+
+    /**
+     * @brief Contact between two capsules, with a point at each end of the overlap when they lie side by side.
+     */
+    bool capsuleCapsule(const CollisionShape &a, const CollisionShape &b, float margin, ContactManifold &manifold)
+    {
+        Vector3D a0, a1, b0, b1, ca, cb;
+        capsuleSegment(a, a0, a1);
+        capsuleSegment(b, b0, b1);
+        closestBetweenSegments(a0, a1, b0, b1, ca, cb);
+        if (!sphereSphere(ca, a.radius, cb, b.radius, margin, manifold))
+        {
+            return false;
+        }
+
+        const Vector3D crossed = cross(a.axes[1], b.axes[1]);
+        if (a.halfExtents.y <= 0.0f || b.halfExtents.y <= 0.0f || dot(crossed, crossed) > 1e-4f)
+        {
+            return true;
+        }
+        const float s0 = dot(b0 - a.center, a.axes[1]), s1 = dot(b1 - a.center, a.axes[1]);
+        const float lo = std::max(-a.halfExtents.y, std::min(s0, s1));
+        const float hi = std::min(a.halfExtents.y, std::max(s0, s1));
+        if (hi - lo <= 1e-4f)
+        {
+            return true;
+        }
+        const Vector3D normal = manifold.normal;
+        manifold.pointCount = 0;
+        for (float s : {lo, hi})
+        {
+            const Vector3D pa = a.center + a.axes[1] * s;
+            const Vector3D pb = closestOnSegment(b0, b1, pa);
+            const float depth = a.radius + b.radius - dot(pb - pa, normal);
+            if (depth >= -margin)
+            {
+                addPoint(manifold, pa + normal * (a.radius - 0.5f * depth), depth);
+            }
+        }
+        manifold.normal = normal;
+        return manifold.pointCount > 0;
+    }
+
+    /**
+     * @brief Clip a polygon to the half space dot(n, p) <= offset (Sutherland-Hodgman).
+     */
+    std::size_t clipPolygon(const Vector3D *in, std::size_t count, const Vector3D &n, float offset, Vector3D *out)
+    {
+        std::size_t outCount = 0;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const Vector3D &p = in[i];
+            const Vector3D &q = in[(i + 1) % count];
+            const float dp = dot(n, p) - offset, dq = dot(n, q) - offset;
+            if (dp <= 0.0f)
+            {
+                out[outCount++] = p;
+            }
+            if ((dp < 0.0f && dq > 0.0f) || (dp > 0.0f && dq < 0.0f))
+            {
+                out[outCount++] = p + (q - p) * (dp / (dp - dq));
+            }
+        }
+        return outCount;
+    }
+
+    /**
+     * @brief Contact points of a face contact: the incident box's face clipped against the reference face.
+     *
+     * @param reference Box owning the separating face
+     * @param incident The other box
+     * @param face Axis of the reference face
+     * @param outward Reference face normal, pointing towards the incident box
+     */
+    void clipFaces(const CollisionShape &reference, const CollisionShape &incident, int face, const Vector3D &outward,
+                   float margin, ContactManifold &manifold)
+    {
+        const float refHalf[3] = {reference.halfExtents.x, reference.halfExtents.y, reference.halfExtents.z};
+        const float incHalf[3] = {incident.halfExtents.x, incident.halfExtents.y, incident.halfExtents.z};
+
+        // Incident face: the one most opposed to the reference normal
+        int incFace = 0;
+        float best = -1.0f;
+        for (int k = 0; k < 3; ++k)
+        {
+            const float alignment = std::fabs(dot(incident.axes[k], outward));
+            if (alignment > best)
+            {
+                best = alignment;
+                incFace = k;
+            }
+        }
+        const Vector3D incNormal = dot(incident.axes[incFace], outward) > 0.0f ? incident.axes[incFace] * -1.0f
+                                                                              : incident.axes[incFace];
+        const Vector3D incCenter = incident.center + incNormal * incHalf[incFace];
+        const Vector3D u = incident.axes[(incFace + 1) % 3] * incHalf[(incFace + 1) % 3];
+        const Vector3D v = incident.axes[(incFace + 2) % 3] * incHalf[(incFace + 2) % 3];
+
+        Vector3D polygon[16] = {incCenter + u + v, incCenter - u + v, incCenter - u - v, incCenter + u - v};
+        Vector3D clipped[16];
+        std::size_t count = 4;
+        for (int side = 1; side <= 2; ++side)
+        {
+            const Vector3D &axis = reference.axes[(face + side) % 3];
+            const float center = dot(axis, reference.center);
+            const float half = refHalf[(face + side) % 3];
+            count = clipPolygon(polygon, count, axis, center + half, clipped);
+            count = clipPolygon(clipped, count, axis * -1.0f, -center + half, polygon);
+        }
+
+        const float faceOffset = dot(outward, reference.center) + refHalf[face];
+        ContactPoint points[16];
+        std::size_t pointCount = 0;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const float separation = dot(outward, polygon[i]) - faceOffset;
+            if (separation <= margin)
+            {
+                points[pointCount++] = ContactPoint{polygon[i] - outward * (0.5f * separation), -separation};
+            }
+        }
+
+        manifold.pointCount = 0;
+        if (pointCount <= MaxContactPoints)
+        {
+            for (std::size_t i = 0; i < pointCount; ++i)
+            {
+                addPoint(manifold, points[i].position, points[i].depth);
+            }
+            return;
+        }
+        // Keep the extreme points along the face diagonals
+        const Vector3D &tu = reference.axes[(face + 1) % 3];
+        const Vector3D &tv = reference.axes[(face + 2) % 3];
+        const Vector3D directions[4] = {tu + tv, tu - tv, tv - tu, (tu + tv) * -1.0f};
+        std::size_t chosen[4];
+        for (int k = 0; k < 4; ++k)
+        {
+            std::size_t best = 0;
+            for (std::size_t i = 1; i < pointCount; ++i)
+            {
+                if (dot(points[i].position, directions[k]) > dot(points[best].position, directions[k]))
+                {
+                    best = i;
+                }
+            }
+            chosen[k] = best;
+            if (std::find(chosen, chosen + k, best) == chosen + k)
+            {
+                addPoint(manifold, points[best].position, points[best].depth);
+            }
+        }
+    }
+
+    /**
+     * @brief Contact between two boxes by the separating axis test over 3 + 3 face and 9 edge axes.
+     */
+    bool boxBox(const CollisionShape &a, const CollisionShape &b, float margin, ContactManifold &manifold)
+    {
+        const Vector3D t = b.center - a.center;
+        const float ha[3] = {a.halfExtents.x, a.halfExtents.y, a.halfExtents.z};
+        const float hb[3] = {b.halfExtents.x, b.halfExtents.y, b.halfExtents.z};
+        float absR[3][3];
+        for (int i = 0; i < 3; ++i)
+        {
+            for (int j = 0; j < 3; ++j)
+            {
+                absR[i][j] = std::fabs(dot(a.axes[i], b.axes[j])) + 1e-6f;
+            }
+        }
+
+        // Face axes of A, then of B
+        float faceSeparation = -1e30f;
+        int faceAxis = 0;
+        bool faceOfA = true;
+        Vector3D faceNormal;
+        for (int i = 0; i < 3; ++i)
+        {
+            const float distance = dot(t, a.axes[i]);
+            const float separation = std::fabs(distance) - (ha[i] + hb[0] * absR[i][0] + hb[1] * absR[i][1] + hb[2] * absR[i][2]);
+            if (separation > margin)
+            {
+                return false;
+            }
+            if (separation > faceSeparation)
+            {
+                faceSeparation = separation;
+                faceAxis = i;
+                faceNormal = distance >= 0.0f ? a.axes[i] : a.axes[i] * -1.0f;
+            }
+        }
+        for (int j = 0; j < 3; ++j)
+        {
+            const float distance = dot(t, b.axes[j]);
+            const float separation = std::fabs(distance) - (hb[j] + ha[0] * absR[0][j] + ha[1] * absR[1][j] + ha[2] * absR[2][j]);
+            if (separation > margin)
+            {
+                return false;
+            }
+            if (separation > AxisRelativeTolerance * faceSeparation + AxisAbsoluteTolerance)
+            {
+                faceSeparation = separation;
+                faceAxis = j;
+                faceOfA = false;
+                faceNormal = distance >= 0.0f ? b.axes[j] : b.axes[j] * -1.0f;
+            }
+        }
+
+        // Edge-edge axes
+        float edgeSeparation = -1e30f;
+        int edgeA = -1, edgeB = -1;
+        Vector3D edgeNormal;
+        for (int i = 0; i < 3; ++i)
+        {
+            for (int j = 0; j < 3; ++j)
+            {
+                Vector3D n = cross(a.axes[i], b.axes[j]);
+                const float length = std::sqrt(dot(n, n));
+                if (length < 1e-4f)
+                {
+                    continue;
+                }
+                n = n * (1.0f / length);
+                const float distance = dot(t, n);
+                const float ra = ha[0] * std::fabs(dot(a.axes[0], n)) + ha[1] * std::fabs(dot(a.axes[1], n)) +
+                                 ha[2] * std::fabs(dot(a.axes[2], n));
+                const float rb = hb[0] * std::fabs(dot(b.axes[0], n)) + hb[1] * std::fabs(dot(b.axes[1], n)) +
+                                 hb[2] * std::fabs(dot(b.axes[2], n));
+                const float separation = std::fabs(distance) - (ra + rb);
+                if (separation > margin)
+                {
+                    return false;
+                }
+                if (separation > edgeSeparation)
+                {
+                    edgeSeparation = separation;
+                    edgeA = i;
+                    edgeB = j;
+                    edgeNormal = distance >= 0.0f ? n : n * -1.0f;
+                }
+            }
+        }
+
+        if (edgeA >= 0 && edgeSeparation > AxisRelativeTolerance * faceSeparation + AxisAbsoluteTolerance)
+        {
+            // Closest points between the edge of A nearest B and the edge of B nearest A
+            Vector3D pa = a.center, pb = b.center;
+            for (int k = 0; k < 3; ++k)
+            {
+                if (k != edgeA)
+                {
+                    pa = pa + a.axes[k] * (dot(a.axes[k], edgeNormal) > 0.0f ? ha[k] : -ha[k]);
+                }
+                if (k != edgeB)
+                {
+                    pb = pb + b.axes[k] * (dot(b.axes[k], edgeNormal) > 0.0f ? -hb[k] : hb[k]);
+                }
+            }
+            const Vector3D da = a.axes[edgeA] * ha[edgeA], db = b.axes[edgeB] * hb[edgeB];
+            Vector3D ca, cb;
+            closestBetweenSegments(pa - da, pa + da, pb - db, pb + db, ca, cb);
+            manifold.normal = edgeNormal;
+            manifold.pointCount = 0;
+            addPoint(manifold, (ca + cb) * 0.5f, -edgeSeparation);
+            return true;
+        }
+
+        manifold.normal = faceNormal;
+        if (faceOfA)
+        {
+            clipFaces(a, b, faceAxis, faceNormal, margin, manifold);
+        }
+        else
+        {
+            clipFaces(b, a, faceAxis, faceNormal * -1.0f, margin, manifold);
+        }
+        return manifold.pointCount > 0;
+    }
+}
+
+/**
+ * @brief Place a PhysicsC-sized collider.
+ *
+ * @param type Shape
+ * @param size Collider size (see ColliderType)
+ * @param scale Transform scale
+ * @param position Center in world space
+ * @param rotation Orientation, body to world
+ * @return The placed shape
+ */
+CollisionShape CollisionShape::make(ColliderType type, const float size[3], const Vector3D &scale,
+                                    const Vector3D &position, const Quaternion &rotation)
+{
+    CollisionShape shape;
+    shape.type = type;
+    shape.center = position;
+    shape.axes[0] = rotate(rotation, Vector3D(1.0f, 0.0f, 0.0f));
+    shape.axes[1] = rotate(rotation, Vector3D(0.0f, 1.0f, 0.0f));
+    shape.axes[2] = rotate(rotation, Vector3D(0.0f, 0.0f, 1.0f));
+    const float sx = std::fabs(scale.x), sy = std::fabs(scale.y), sz = std::fabs(scale.z);
+    switch (type)
+    {
+    case ColliderType::Box:
+        shape.halfExtents = Vector3D(0.5f * size[0] * sx, 0.5f * size[1] * sy, 0.5f * size[2] * sz);
+        break;
+    case ColliderType::Capsule:
+        shape.radius = 0.5f * size[0] * std::max(sx, sz);
+        shape.halfExtents = Vector3D(0.0f, std::max(0.0f, 0.5f * size[1] * sy - shape.radius), 0.0f);
+        break;
+    default:
+        shape.radius = 0.5f * size[0] * std::max(sx, std::max(sy, sz));
+        break;
+    }
+    return shape;
+}
+
+/**
+ * @brief Get the world-space bounding box.
+ *
+ * @param margin Distance added on every side
+ * @return Enclosing box
+ */
+Aabb CollisionShape::bounds(float margin) const
+{
+    float extent[3];
+    for (int k = 0; k < 3; ++k)
+    {
+        extent[k] = std::fabs(component(axes[0], k)) * halfExtents.x + std::fabs(component(axes[1], k)) * halfExtents.y +
+                    std::fabs(component(axes[2], k)) * halfExtents.z + radius + margin;
+    }
+    return Aabb{Vector3D(center.x - extent[0], center.y - extent[1], center.z - extent[2]),
+                Vector3D(center.x + extent[0], center.y + extent[1], center.z + extent[2])};
+}
+
+/**
+ * @brief Generate the contact manifold between two shapes.
+ *
+ * Pairs are dispatched with the lower ColliderType first; the normal is
+ * flipped back when the shapes were swapped.
+ *
+ * @param a First shape
+ * @param b Second shape
+ * @param margin Largest separation still reported
+ * @param manifold [out] Normal and points; bodyA and bodyB are left unchanged
+ * @return true if at least one point was found
+ */
+bool collide(const CollisionShape &a, const CollisionShape &b, float margin, ContactManifold &manifold)
+{
+    if (a.type > b.type)
+    {
+        if (!collide(b, a, margin, manifold))
+        {
+            return false;
+        }
+        manifold.normal = manifold.normal * -1.0f;
+        return true;
+    }
+
+    manifold.pointCount = 0;
+    switch (a.type)
+    {
+    case ColliderType::Sphere:
+        if (b.type == ColliderType::Sphere)
+        {
+            return sphereSphere(a.center, a.radius, b.center, b.radius, margin, manifold);
+        }
+        if (b.type == ColliderType::Box)
+        {
+            return sphereBox(a.center, a.radius, b, margin, manifold);
+        }
+        return sphereCapsule(a, b, margin, manifold);
+    case ColliderType::Box:
+        if (b.type == ColliderType::Box)
+        {
+            return boxBox(a, b, margin, manifold);
+        }
+        return boxCapsule(a, b, margin, manifold);
+    default:
+        return capsuleCapsule(a, b, margin, manifold);
+    }
+}
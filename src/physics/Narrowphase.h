@@ -0,0 +1,93 @@
+/**
+ * @file Narrowphase.h
+ * @brief Contact manifolds between sphere, box and capsule colliders.
+ */
+#ifndef NARROWPHASE_H
+#define NARROWPHASE_H
+
+#include "ColliderType.h"
+#include "../core/SpatialIndex.h"
+#include "../core/Quaternion.h"
+#include "../core/Vector3D.h"
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief A collider placed in the world, ready for contact generation.
+ */
+struct CollisionShape
+{
+    ColliderType type = ColliderType::Sphere; /**< Shape */
+    Vector3D center;                          /**< Center in world space */
+    Vector3D axes[3];                         /**< Local X, Y and Z axes in world space */
+    Vector3D halfExtents;                     /**< Box half extents; capsule half segment length in y */
+    float radius = 0.0f;                      /**< Sphere or capsule radius, 0 for a box */
+
+    /**
+     * @brief Place a PhysicsC-sized collider.
+     *
+     * Sizes follow PhysicsC::colliderSize and are multiplied by the scale;
+     * a capsule's segment runs along its local Y axis.
+     *
+     * @param type Shape
+     * @param size Collider size (see ColliderType)
+     * @param scale Transform scale
+     * @param position Center in world space
+     * @param rotation Orientation, body to world
+     * @return The placed shape
+     */
+    static CollisionShape make(ColliderType type, const float size[3], const Vector3D &scale,
+                               const Vector3D &position, const Quaternion &rotation);
+
+    /**
+     * @brief Get the world-space bounding box.
+     *
+     * @param margin Distance added on every side
+     * @return Enclosing box
+     */
+    Aabb bounds(float margin = 0.0f) const;
+};
+
+/**
+ * @brief One point of a contact manifold.
+ */
+struct ContactPoint
+{
+    Vector3D position; /**< Midpoint between the two surfaces, world space */
+    float depth;       /**< Penetration along the normal, negative while still apart */
+};
+
+/** @brief Most points a manifold holds; enough for a face resting on a face */
+constexpr std::size_t MaxContactPoints = 4;
+
+/**
+ * @brief The contact between two colliders: a shared normal and up to four points.
+ */
+struct ContactManifold
+{
+    std::uint32_t bodyA = 0;                  /**< Index of the first body */
+    std::uint32_t bodyB = 0;                  /**< Index of the second body */
+    Vector3D normal;                          /**< Unit normal pointing from A to B */
+    ContactPoint points[MaxContactPoints];    /**< Contact points */
+    std::uint32_t pointCount = 0;             /**< Valid entries of points */
+};
+
+/**
+ * @brief Generate the contact manifold between two shapes.
+ *
+ * Sphere, capsule and box pairs are handled exactly: boxes use the
+ * separating axis test over face and edge axes, face contacts are found by
+ * clipping the incident face against the reference face, and a capsule lying
+ * on a box or alongside another capsule yields a point at each end. Points
+ * closer than margin count as contacts with a negative depth, so a solver can
+ * stop bodies before they touch.
+ *
+ * @param a First shape
+ * @param b Second shape
+ * @param margin Largest separation still reported
+ * @param manifold [out] Normal and points; bodyA and bodyB are left unchanged
+ * @return true if at least one point was found
+ */
+bool collide(const CollisionShape &a, const CollisionShape &b, float margin, ContactManifold &manifold);
+
+#endif
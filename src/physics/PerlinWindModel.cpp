@@ -5,31 +5,258 @@
 
 #include "PerlinWindModel.h"
 #include "../debug.h"
+#include <cmath>
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FPV_WIND_SSE 1
+#endif
+
+namespace
+{
+    constexpr int Size = PerlinWindModel::LatticeSize;
+    constexpr int Mask = Size - 1;
+    constexpr int Shift = 5;
+    constexpr float InverseSize = 1.0f / Size;
+
+    /** Sideways drift of the gusts, as a fraction of their RMS speed, per axis */
+    constexpr float DriftFraction = 0.35f;
+
+    static_assert(1 << Shift == Size, "Shift must be log2 of LatticeSize");
+    static_assert(Size % PerlinWindModel::NodesPerFeature == 0, "The noise must tile over the lattice");
+
+    std::uint32_t hash(std::uint32_t x, std::uint32_t y, std::uint32_t z, std::uint32_t seed)
+    {
+        std::uint32_t h = seed * 0x9E3779B9u ^ x * 0x85EBCA6Bu ^ y * 0xC2B2AE35u ^ z * 0x27D4EB2Fu;
+        h ^= h >> 16;
+        h *= 0x7FEB352Du;
+        h ^= h >> 15;
+        h *= 0x846CA68Bu;
+        h ^= h >> 16;
+        return h;
+    }
+
+    /**
+     * @brief Dot product of the offset with one of Perlin's twelve cube-edge gradients.
+     */
+    float gradient(std::uint32_t h, float x, float y, float z)
+    {
+        switch (h % 12)
+        {
+        case 0: return x + y;
+        case 1: return -x + y;
+        case 2: return x - y;
+        case 3: return -x - y;
+        case 4: return x + z;
+        case 5: return -x + z;
+        case 6: return x - z;
+        case 7: return -x - z;
+        case 8: return y + z;
+        case 9: return -y + z;
+        case 10: return y - z;
+        default: return -y - z;
+        }
+    }
+
+    float fade(float t)
+    {
+        return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f);
+    }
+
+    float lerp(float a, float b, float t)
+    {
+        return a + (b - a) * t;
+    }
+
+    /**
+     * @brief Perlin gradient noise that repeats every period cells along each axis.
+     */
+    float periodicNoise(float x, float y, float z, int period, std::uint32_t seed)
+    {
+        const float fx = std::floor(x), fy = std::floor(y), fz = std::floor(z);
+        const float tx = x - fx, ty = y - fy, tz = z - fz;
+        const int ix = static_cast<int>(fx), iy = static_cast<int>(fy), iz = static_cast<int>(fz);
+        auto corner = [&](int dx, int dy, int dz)
+        {
+            const std::uint32_t h = hash(static_cast<std::uint32_t>((ix + dx) % period),
+                                         static_cast<std::uint32_t>((iy + dy) % period),
+                                         static_cast<std::uint32_t>((iz + dz) % period), seed);
+            return gradient(h, tx - dx, ty - dy, tz - dz);
+        };
+        const float u = fade(tx), v = fade(ty), w = fade(tz);
+        return lerp(lerp(lerp(corner(0, 0, 0), corner(1, 0, 0), u), lerp(corner(0, 1, 0), corner(1, 1, 0), u), v),
+                    lerp(lerp(corner(0, 0, 1), corner(1, 0, 1), u), lerp(corner(0, 1, 1), corner(1, 1, 1), u), v), w);
+    }
+
+    int nodeIndex(int x, int y, int z)
+    {
+        return ((z & Mask) * Size + (y & Mask)) * Size + (x & Mask);
+    }
+
+    /**
+     * @brief Bring a lattice coordinate into [0, LatticeSize) so it converts to int safely.
+     */
+    float wrap(float u)
+    {
+        return u - std::floor(u * InverseSize) * Size;
+    }
+
+#ifdef FPV_WIND_SSE
+    inline __m128 floorPs(__m128 v)
+    {
+        const __m128 truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(v));
+        return _mm_sub_ps(truncated, _mm_and_ps(_mm_cmpgt_ps(truncated, v), _mm_set1_ps(1.0f)));
+    }
+
+    inline __m128 wrapPs(__m128 u)
+    {
+        return _mm_sub_ps(u, _mm_mul_ps(floorPs(_mm_mul_ps(u, _mm_set1_ps(InverseSize))), _mm_set1_ps(static_cast<float>(Size))));
+    }
+#endif
+}
 
 /**
- * @brief Construct a new PerlinWindModel.
- *
- * Initializes the wind model with parameters for generating Perlin noise-based
- * wind fields. The parameters control the strength, frequency, and amplitude
- * of the wind variations.
+ * @brief Construct a new PerlinWindModel and bake its gust lattice.
  *
- * @param strength Base wind strength multiplier
- * @param frequency Spatial frequency of the wind variations
- * @param amplitude Maximum wind speed variation
+ * @param strength Mean wind speed along +X in m/s
+ * @param frequency Spatial frequency of the wind variations: features per meter
+ * @param amplitude RMS speed of the gusts in m/s
  * @param seed Random seed for reproducible wind patterns
  */
 PerlinWindModel::PerlinWindModel(float strength, float frequency, float amplitude, int seed)
-    : strength_(strength), frequency_(frequency), amplitude_(amplitude), seed_(seed)
+    : strength_(strength), frequency_(frequency), amplitude_(amplitude), seed_(seed),
+      latticeScale_(frequency > 0.0f ? frequency * NodesPerFeature : 0.0f)
 {
     DEBUG_LOG("Initializing PerlinWindModel with strength " + std::to_string(strength) + ", frequency " + std::to_string(frequency) + ", amplitude " + std::to_string(amplitude));
+    if (amplitude_ != 0.0f && latticeScale_ > 0.0f)
+    {
+        bake();
+    }
+}
+
+/**
+ * @brief Fill the lattice with the curl of a two-octave noise potential, normalized to unit RMS.
+ *
+ * The curl is taken with central differences on the lattice itself, so the
+ * baked field tiles exactly and is divergence-free in the discrete sense.
+ */
+void PerlinWindModel::bake()
+{
+    const int count = Size * Size * Size;
+    std::vector<float> potential[3];
+    for (int k = 0; k < 3; ++k)
+    {
+        potential[k].assign(count, 0.0f);
+    }
+
+    const std::uint32_t seed = static_cast<std::uint32_t>(seed_);
+    for (int octave = 0, nodesPerCell = NodesPerFeature; octave < 2 && nodesPerCell > 0; ++octave, nodesPerCell /= 2)
+    {
+        const int period = Size / nodesPerCell;
+        const float weight = 1.0f / static_cast<float>(1 << octave);
+        const float cellsPerNode = 1.0f / static_cast<float>(nodesPerCell);
+        for (int z = 0; z < Size; ++z)
+        {
+            for (int y = 0; y < Size; ++y)
+            {
+                for (int x = 0; x < Size; ++x)
+                {
+                    // Off the noise's own grid, where gradient noise is always zero
+                    const float nx = (x + 0.5f) * cellsPerNode, ny = (y + 0.5f) * cellsPerNode, nz = (z + 0.5f) * cellsPerNode;
+                    const int i = nodeIndex(x, y, z);
+                    for (int k = 0; k < 3; ++k)
+                    {
+                        potential[k][i] += weight * periodicNoise(nx, ny, nz, period, hash(k, octave, 0, seed));
+                    }
+                }
+            }
+        }
+    }
+
+    lattice_.assign(count, Node{0.0f, 0.0f, 0.0f, 0.0f});
+    double sumSquares = 0.0;
+    for (int z = 0; z < Size; ++z)
+    {
+        for (int y = 0; y < Size; ++y)
+        {
+            for (int x = 0; x < Size; ++x)
+            {
+                auto d = [&](int k, int dx, int dy, int dz)
+                {
+                    return 0.5f * (potential[k][nodeIndex(x + dx, y + dy, z + dz)] -
+                                   potential[k][nodeIndex(x - dx, y - dy, z - dz)]);
+                };
+                Node &node = lattice_[nodeIndex(x, y, z)];
+                node.x = d(2, 0, 1, 0) - d(1, 0, 0, 1);
+                node.y = d(0, 0, 0, 1) - d(2, 1, 0, 0);
+                node.z = d(1, 1, 0, 0) - d(0, 0, 1, 0);
+                sumSquares += node.x * node.x + node.y * node.y + node.z * node.z;
+            }
+        }
+    }
+
+    const float normalize = sumSquares > 0.0 ? static_cast<float>(1.0 / std::sqrt(sumSquares / count)) : 0.0f;
+    for (Node &node : lattice_)
+    {
+        node.x *= normalize;
+        node.y *= normalize;
+        node.z *= normalize;
+    }
 }
 
 /**
- * @brief Calculate wind velocity at a given position using Perlin noise.
+ * @brief Scroll the gust lattice to a simulation time.
  *
- * This is currently a stub implementation that returns constant wind in the X direction.
- * A full implementation would use Perlin noise functions to generate spatially coherent
- * wind velocity fields with realistic turbulence patterns.
+ * The offset is reduced modulo the lattice in double precision, so float
+ * sampling stays exact however long the simulation runs.
+ *
+ * @param seconds Simulation time in seconds
+ */
+void PerlinWindModel::setTime(double seconds)
+{
+    const double scale = static_cast<double>(latticeScale_) * seconds;
+    const double drift = static_cast<double>(DriftFraction) * amplitude_ * scale;
+    const double offsets[3] = {-static_cast<double>(strength_) * scale, drift, drift};
+    for (int k = 0; k < 3; ++k)
+    {
+        offset_[k] = static_cast<float>(offsets[k] - std::floor(offsets[k] / Size) * Size);
+    }
+}
+
+/**
+ * @brief Trilinearly interpolate the gust lattice at a position.
+ *
+ * @param x X coordinate of the position
+ * @param y Y coordinate of the position
+ * @param z Z coordinate of the position
+ * @param gx [out] X component, in units of the amplitude
+ * @param gy [out] Y component, in units of the amplitude
+ * @param gz [out] Z component, in units of the amplitude
+ */
+void PerlinWindModel::sampleGust(float x, float y, float z, float &gx, float &gy, float &gz) const
+{
+    const float u = wrap(x * latticeScale_ + offset_[0]);
+    const float v = wrap(y * latticeScale_ + offset_[1]);
+    const float w = wrap(z * latticeScale_ + offset_[2]);
+    const float fu = std::floor(u), fv = std::floor(v), fw = std::floor(w);
+    const float tu = u - fu, tv = v - fv, tw = w - fw;
+    const int iu = static_cast<int>(fu), iv = static_cast<int>(fv), iw = static_cast<int>(fw);
+
+    gx = gy = gz = 0.0f;
+    for (int corner = 0; corner < 8; ++corner)
+    {
+        const int dx = corner & 1, dy = (corner >> 1) & 1, dz = corner >> 2;
+        const float weight = (dx ? tu : 1.0f - tu) * (dy ? tv : 1.0f - tv) * (dz ? tw : 1.0f - tw);
+        const Node &node = lattice_[nodeIndex(iu + dx, iv + dy, iw + dz)];
+        gx += weight * node.x;
+        gy += weight * node.y;
+        gz += weight * node.z;
+    }
+}
+
+/**
+ * @brief Calculate wind velocity at a given position.
  *
  * @param x X coordinate of the position
  * @param y Y coordinate of the position
@@ -40,11 +267,101 @@ PerlinWindModel::PerlinWindModel(float strength, float frequency, float amplitud
  */
 void PerlinWindModel::getWind(float x, float y, float z, float &wx, float &wy, float &wz) const
 {
-    DEBUG_LOG("Getting wind at position (" + std::to_string(x) + ", " + std::to_string(y) + ", " + std::to_string(z) + ")");
-    // Stub: return constant wind in X direction
-    // TODO: Implement Perlin noise-based wind field generation
-    wx = strength_;
-    wy = 0.0f;
-    wz = 0.0f;
+    if (lattice_.empty())
+    {
+        wx = strength_;
+        wy = 0.0f;
+        wz = 0.0f;
+        return;
+    }
+    float gx, gy, gz;
+    sampleGust(x, y, z, gx, gy, gz);
+    wx = strength_ + amplitude_ * gx;
+    wy = amplitude_ * gy;
+    wz = amplitude_ * gz;
 }
 
+/**
+ * @brief Calculate wind velocity at many positions, four per iteration where SSE2 is available.
+ *
+ * Each group of four positions computes its cell indices and trilinear
+ * weights in SIMD lanes, loads the four lattice nodes of every cell corner
+ * and transposes them into component lanes. The results match getWind()
+ * up to float rounding.
+ *
+ * @param x X coordinates of the positions
+ * @param y Y coordinates of the positions
+ * @param z Z coordinates of the positions
+ * @param wx [out] X components of wind velocity
+ * @param wy [out] Y components of wind velocity
+ * @param wz [out] Z components of wind velocity
+ * @param count Number of positions
+ */
+void PerlinWindModel::getWindBatch(const float *x, const float *y, const float *z, float *wx, float *wy, float *wz,
+                                   std::size_t count) const
+{
+    if (lattice_.empty())
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            wx[i] = strength_;
+            wy[i] = 0.0f;
+            wz[i] = 0.0f;
+        }
+        return;
+    }
+
+    std::size_t i = 0;
+#ifdef FPV_WIND_SSE
+    const __m128 scale = _mm_set1_ps(latticeScale_);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 strength = _mm_set1_ps(strength_);
+    const __m128 amplitude = _mm_set1_ps(amplitude_);
+    const __m128i mask = _mm_set1_epi32(Mask);
+    const __m128i oneInt = _mm_set1_epi32(1);
+    const float *nodes = &lattice_[0].x;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128 u = wrapPs(_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(x + i), scale), _mm_set1_ps(offset_[0])));
+        const __m128 v = wrapPs(_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(y + i), scale), _mm_set1_ps(offset_[1])));
+        const __m128 w = wrapPs(_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(z + i), scale), _mm_set1_ps(offset_[2])));
+        const __m128 fu = floorPs(u), fv = floorPs(v), fw = floorPs(w);
+        const __m128 tu[2] = {_mm_sub_ps(one, _mm_sub_ps(u, fu)), _mm_sub_ps(u, fu)};
+        const __m128 tv[2] = {_mm_sub_ps(one, _mm_sub_ps(v, fv)), _mm_sub_ps(v, fv)};
+        const __m128 tw[2] = {_mm_sub_ps(one, _mm_sub_ps(w, fw)), _mm_sub_ps(w, fw)};
+
+        // Node offsets of the lower and upper corner along each axis
+        const __m128i iu = _mm_and_si128(_mm_cvttps_epi32(fu), mask);
+        const __m128i iv = _mm_and_si128(_mm_cvttps_epi32(fv), mask);
+        const __m128i iw = _mm_and_si128(_mm_cvttps_epi32(fw), mask);
+        const __m128i ou[2] = {iu, _mm_and_si128(_mm_add_epi32(iu, oneInt), mask)};
+        const __m128i ov[2] = {_mm_slli_epi32(iv, Shift), _mm_slli_epi32(_mm_and_si128(_mm_add_epi32(iv, oneInt), mask), Shift)};
+        const __m128i ow[2] = {_mm_slli_epi32(iw, 2 * Shift),
+                               _mm_slli_epi32(_mm_and_si128(_mm_add_epi32(iw, oneInt), mask), 2 * Shift)};
+
+        __m128 gx = _mm_setzero_ps(), gy = _mm_setzero_ps(), gz = _mm_setzero_ps();
+        for (int corner = 0; corner < 8; ++corner)
+        {
+            const int dx = corner & 1, dy = (corner >> 1) & 1, dz = corner >> 2;
+            alignas(16) std::int32_t index[4];
+            _mm_store_si128(reinterpret_cast<__m128i *>(index), _mm_add_epi32(ou[dx], _mm_add_epi32(ov[dy], ow[dz])));
+            __m128 n0 = _mm_load_ps(nodes + 4 * index[0]);
+            __m128 n1 = _mm_load_ps(nodes + 4 * index[1]);
+            __m128 n2 = _mm_load_ps(nodes + 4 * index[2]);
+            __m128 n3 = _mm_load_ps(nodes + 4 * index[3]);
+            _MM_TRANSPOSE4_PS(n0, n1, n2, n3);
+            const __m128 weight = _mm_mul_ps(tu[dx], _mm_mul_ps(tv[dy], tw[dz]));
+            gx = _mm_add_ps(gx, _mm_mul_ps(weight, n0));
+            gy = _mm_add_ps(gy, _mm_mul_ps(weight, n1));
+            gz = _mm_add_ps(gz, _mm_mul_ps(weight, n2));
+        }
+        _mm_storeu_ps(wx + i, _mm_add_ps(strength, _mm_mul_ps(amplitude, gx)));
+        _mm_storeu_ps(wy + i, _mm_mul_ps(amplitude, gy));
+        _mm_storeu_ps(wz + i, _mm_mul_ps(amplitude, gz));
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        getWind(x[i], y[i], z[i], wx[i], wy[i], wz[i]);
+    }
+}
@@ -11,35 +11,50 @@
 #define PERLINWINDMODEL_H
 
 #include "IWindModel.h"
+#include <vector>
 
 /**
  * @class PerlinWindModel
  * @brief Wind model using Perlin noise for realistic turbulence.
  *
- * This implementation generates wind velocity fields using Perlin noise,
- * creating natural-looking wind patterns with spatial coherence. The wind
- * varies smoothly in space and can include multiple octaves for complex
- * turbulence patterns.
+ * The wind is a steady mean wind of the base strength along +X plus
+ * turbulent gusts. The gusts are the curl of a vector potential made of two
+ * octaves of Perlin gradient noise, so they are (nearly) divergence-free and
+ * swirl like real eddies instead of pulsing in and out of points.
+ *
+ * The gust field is baked once at construction into a tileable lattice of
+ * LatticeSize^3 nodes, NodesPerFeature nodes per noise feature, and
+ * normalized so its RMS speed over the nodes is the amplitude. Sampling is
+ * a trilinear interpolation of that lattice: a few loads and multiplies per
+ * position, with no noise evaluation at runtime. The field repeats every
+ * LatticeSize / NodesPerFeature features, far beyond the distance over which
+ * a flyer can notice it.
+ *
+ * Over time the gusts are carried downwind with the mean wind (frozen
+ * turbulence) and drift slowly sideways at a fraction of the amplitude, so
+ * they keep evolving even without mean wind.
  */
 class PerlinWindModel : public IWindModel
 {
 public:
+    /** @brief Lattice nodes along each axis; a power of two */
+    static constexpr int LatticeSize = 32;
+
+    /** @brief Lattice nodes per wavelength of the coarsest noise octave */
+    static constexpr int NodesPerFeature = 4;
+
     /**
-     * @brief Construct a new PerlinWindModel.
+     * @brief Construct a new PerlinWindModel and bake its gust lattice.
      *
-     * @param strength Base wind strength multiplier
-     * @param frequency Spatial frequency of the wind variations
-     * @param amplitude Maximum wind speed variation
+     * @param strength Mean wind speed along +X in m/s
+     * @param frequency Spatial frequency of the wind variations: features per meter
+     * @param amplitude RMS speed of the gusts at the lattice nodes in m/s
      * @param seed Random seed for reproducible wind patterns
      */
     PerlinWindModel(float strength, float frequency, float amplitude, int seed);
 
     /**
-     * @brief Calculate wind velocity at a given position using Perlin noise.
-     *
-     * Uses Perlin noise functions to generate spatially coherent wind
-     * velocity components. The wind field varies smoothly and creates
-     * realistic turbulence patterns.
+     * @brief Calculate wind velocity at a given position.
      *
      * @param x X coordinate of the position
      * @param y Y coordinate of the position
@@ -50,19 +65,62 @@ public:
      */
     void getWind(float x, float y, float z, float &wx, float &wy, float &wz) const override;
 
+    /**
+     * @brief Calculate wind velocity at many positions, four per iteration where SSE2 is available.
+     *
+     * @param x X coordinates of the positions
+     * @param y Y coordinates of the positions
+     * @param z Z coordinates of the positions
+     * @param wx [out] X components of wind velocity
+     * @param wy [out] Y components of wind velocity
+     * @param wz [out] Z components of wind velocity
+     * @param count Number of positions
+     */
+    void getWindBatch(const float *x, const float *y, const float *z, float *wx, float *wy, float *wz,
+                      std::size_t count) const override;
+
+    /**
+     * @brief Scroll the gust lattice to a simulation time.
+     *
+     * @param seconds Simulation time in seconds
+     */
+    void setTime(double seconds) override;
+
 private:
-    /** @brief Base wind strength multiplier */
+    /**
+     * @brief Gust velocity at one lattice node, padded to 16 bytes for aligned loads.
+     */
+    struct alignas(16) Node
+    {
+        float x; /**< X component, in units of the amplitude */
+        float y; /**< Y component, in units of the amplitude */
+        float z; /**< Z component, in units of the amplitude */
+        float w; /**< Padding */
+    };
+
+    void bake();
+    void sampleGust(float x, float y, float z, float &gx, float &gy, float &gz) const;
+
+    /** @brief Mean wind speed along +X in m/s */
     float strength_;
 
-    /** @brief Spatial frequency of wind variations */
+    /** @brief Noise features per meter */
     float frequency_;
 
-    /** @brief Maximum wind speed variation */
+    /** @brief RMS gust speed in m/s */
     float amplitude_;
 
     /** @brief Random seed for reproducible patterns */
     int seed_;
+
+    /** @brief Lattice nodes per meter */
+    float latticeScale_;
+
+    /** @brief Scroll offset of the lattice at the current time, in nodes */
+    float offset_[3] = {0.0f, 0.0f, 0.0f};
+
+    /** @brief Gust field, x fastest, then y, then z */
+    std::vector<Node> lattice_;
 };
 
 #endif
-
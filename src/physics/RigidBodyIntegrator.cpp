@@ -0,0 +1,206 @@
+/**
+ * @file RigidBodyIntegrator.cpp
+ * @brief Implementation of the structure-of-arrays rigid body integrator.
+ */
+#include "RigidBodyIntegrator.h"
+#include <cmath>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define FPV_RIGIDBODY_SSE 1
+#endif
+
+namespace
+{
+    /**
+     * @brief Rotate v by the unit quaternion (w, x, y, z): v + 2w(u x v) + 2u x (u x v).
+     */
+    inline void rotate(float w, float x, float y, float z, float &vx, float &vy, float &vz)
+    {
+        const float cx = 2.0f * (y * vz - z * vy);
+        const float cy = 2.0f * (z * vx - x * vz);
+        const float cz = 2.0f * (x * vy - y * vx);
+        const float rx = vx + w * cx + (y * cz - z * cy);
+        const float ry = vy + w * cy + (z * cx - x * cz);
+        const float rz = vz + w * cz + (x * cy - y * cx);
+        vx = rx;
+        vy = ry;
+        vz = rz;
+    }
+}
+
+/**
+ * @brief Set the number of bodies, keeping the capacity of every array.
+ *
+ * @param count Number of bodies
+ */
+void RigidBodyIntegrator::resize(std::size_t count)
+{
+    for (std::vector<float> *array : {&px, &py, &pz, &vx, &vy, &vz, &qx, &qy, &qz, &wx, &wy, &wz, &invMass,
+                                      &inertiaX, &inertiaY, &inertiaZ, &invInertiaX, &invInertiaY, &invInertiaZ,
+                                      &fx, &fy, &fz, &tx, &ty, &tz, &gravityScale, &dragFactor,
+                                      &windX, &windY, &windZ})
+    {
+        array->resize(count, 0.0f);
+    }
+    qw.resize(count, 1.0f);
+}
+
+/**
+ * @brief Advance bodies [first, last) by one step.
+ *
+ * @param dt Time step in seconds
+ * @param gravity Gravitational acceleration in m/s^2 (applied along -Y)
+ * @param first First body
+ * @param last One past the last body
+ */
+void RigidBodyIntegrator::integrate(float dt, float gravity, std::size_t first, std::size_t last)
+{
+    integrateVelocity(dt, gravity, first, last);
+    integratePosition(dt, first, last);
+}
+
+/**
+ * @brief Advance the linear and angular velocities of bodies [first, last).
+ *
+ * @param dt Time step in seconds
+ * @param gravity Gravitational acceleration in m/s^2 (applied along -Y)
+ * @param first First body
+ * @param last One past the last body
+ */
+void RigidBodyIntegrator::integrateVelocity(float dt, float gravity, std::size_t first, std::size_t last)
+{
+    integrateLinearVelocity(dt, gravity, first, last);
+    integrateAngularVelocity(dt, first, last);
+}
+
+/**
+ * @brief Advance the positions and orientations of bodies [first, last) with their current velocities.
+ *
+ * @param dt Time step in seconds
+ * @param first First body
+ * @param last One past the last body
+ */
+void RigidBodyIntegrator::integratePosition(float dt, std::size_t first, std::size_t last)
+{
+    std::size_t i = first;
+#ifdef FPV_RIGIDBODY_SSE
+    const __m128 dtv = _mm_set1_ps(dt);
+    for (; i + 4 <= last; i += 4)
+    {
+        _mm_storeu_ps(&px[i], _mm_add_ps(_mm_loadu_ps(&px[i]), _mm_mul_ps(dtv, _mm_loadu_ps(&vx[i]))));
+        _mm_storeu_ps(&py[i], _mm_add_ps(_mm_loadu_ps(&py[i]), _mm_mul_ps(dtv, _mm_loadu_ps(&vy[i]))));
+        _mm_storeu_ps(&pz[i], _mm_add_ps(_mm_loadu_ps(&pz[i]), _mm_mul_ps(dtv, _mm_loadu_ps(&vz[i]))));
+    }
+#endif
+    for (; i < last; ++i)
+    {
+        px[i] += dt * vx[i];
+        py[i] += dt * vy[i];
+        pz[i] += dt * vz[i];
+    }
+
+    // dq = 0.5 * dt * (0, w) * q
+    const float h = 0.5f * dt;
+    for (i = first; i < last; ++i)
+    {
+        const float w = qw[i], x = qx[i], y = qy[i], z = qz[i];
+        const float o0 = wx[i], o1 = wy[i], o2 = wz[i];
+        const float nw = w + h * (-o0 * x - o1 * y - o2 * z);
+        const float nx = x + h * (o0 * w + o1 * z - o2 * y);
+        const float ny = y + h * (o1 * w + o2 * x - o0 * z);
+        const float nz = z + h * (o2 * w + o0 * y - o1 * x);
+        const float scale = 1.0f / std::sqrt(nw * nw + nx * nx + ny * ny + nz * nz);
+        qw[i] = nw * scale;
+        qx[i] = nx * scale;
+        qy[i] = ny * scale;
+        qz[i] = nz * scale;
+    }
+}
+
+/**
+ * @brief Advance linear velocity, four bodies per iteration where SSE is available.
+ *
+ * @param dt Time step in seconds
+ * @param gravity Gravitational acceleration in m/s^2
+ * @param first First body
+ * @param last One past the last body
+ */
+void RigidBodyIntegrator::integrateLinearVelocity(float dt, float gravity, std::size_t first, std::size_t last)
+{
+    std::size_t i = first;
+#ifdef FPV_RIGIDBODY_SSE
+    const __m128 dtv = _mm_set1_ps(dt);
+    const __m128 gv = _mm_set1_ps(gravity);
+    const __m128 one = _mm_set1_ps(1.0f);
+    for (; i + 4 <= last; i += 4)
+    {
+        const __m128 im = _mm_loadu_ps(&invMass[i]);
+        const __m128 v0 = _mm_loadu_ps(&vx[i]);
+        const __m128 v1 = _mm_loadu_ps(&vy[i]);
+        const __m128 v2 = _mm_loadu_ps(&vz[i]);
+        const __m128 u0 = _mm_loadu_ps(&windX[i]);
+        const __m128 u1 = _mm_loadu_ps(&windY[i]);
+        const __m128 u2 = _mm_loadu_ps(&windZ[i]);
+
+        const __m128 r0 = _mm_sub_ps(v0, u0);
+        const __m128 r1 = _mm_sub_ps(v1, u1);
+        const __m128 r2 = _mm_sub_ps(v2, u2);
+        const __m128 speed = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(r0, r0), _mm_mul_ps(r1, r1)), _mm_mul_ps(r2, r2)));
+        const __m128 c = _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(&dragFactor[i]), speed), im);
+        const __m128 denominator = _mm_add_ps(one, _mm_mul_ps(dtv, c));
+
+        const __m128 a0 = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&fx[i]), im), _mm_mul_ps(c, u0));
+        const __m128 a1 = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&fy[i]), im), _mm_mul_ps(c, u1)),
+                                     _mm_mul_ps(gv, _mm_loadu_ps(&gravityScale[i])));
+        const __m128 a2 = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&fz[i]), im), _mm_mul_ps(c, u2));
+
+        _mm_storeu_ps(&vx[i], _mm_div_ps(_mm_add_ps(v0, _mm_mul_ps(dtv, a0)), denominator));
+        _mm_storeu_ps(&vy[i], _mm_div_ps(_mm_add_ps(v1, _mm_mul_ps(dtv, a1)), denominator));
+        _mm_storeu_ps(&vz[i], _mm_div_ps(_mm_add_ps(v2, _mm_mul_ps(dtv, a2)), denominator));
+    }
+#endif
+    for (; i < last; ++i)
+    {
+        const float r0 = vx[i] - windX[i], r1 = vy[i] - windY[i], r2 = vz[i] - windZ[i];
+        const float c = dragFactor[i] * std::sqrt(r0 * r0 + r1 * r1 + r2 * r2) * invMass[i];
+        const float denominator = 1.0f + dt * c;
+        vx[i] = (vx[i] + dt * (fx[i] * invMass[i] + c * windX[i])) / denominator;
+        vy[i] = (vy[i] + dt * (fy[i] * invMass[i] + c * windY[i] - gravity * gravityScale[i])) / denominator;
+        vz[i] = (vz[i] + dt * (fz[i] * invMass[i] + c * windZ[i])) / denominator;
+    }
+}
+
+/**
+ * @brief Advance angular velocity in the principal frame.
+ *
+ * Branch-free per body so the compiler can vectorize the loop.
+ *
+ * @param dt Time step in seconds
+ * @param first First body
+ * @param last One past the last body
+ */
+void RigidBodyIntegrator::integrateAngularVelocity(float dt, std::size_t first, std::size_t last)
+{
+    for (std::size_t i = first; i < last; ++i)
+    {
+        const float w = qw[i], x = qx[i], y = qy[i], z = qz[i];
+
+        // World -> body with the conjugate rotation
+        float ob0 = wx[i], ob1 = wy[i], ob2 = wz[i];
+        float tb0 = tx[i], tb1 = ty[i], tb2 = tz[i];
+        rotate(w, -x, -y, -z, ob0, ob1, ob2);
+        rotate(w, -x, -y, -z, tb0, tb1, tb2);
+
+        // I dw/dt = T - w x (I w)
+        const float l0 = inertiaX[i] * ob0, l1 = inertiaY[i] * ob1, l2 = inertiaZ[i] * ob2;
+        ob0 += dt * invInertiaX[i] * (tb0 - (ob1 * l2 - ob2 * l1));
+        ob1 += dt * invInertiaY[i] * (tb1 - (ob2 * l0 - ob0 * l2));
+        ob2 += dt * invInertiaZ[i] * (tb2 - (ob0 * l1 - ob1 * l0));
+
+        rotate(w, x, y, z, ob0, ob1, ob2);
+        wx[i] = ob0;
+        wy[i] = ob1;
+        wz[i] = ob2;
+    }
+}
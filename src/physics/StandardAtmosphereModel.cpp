@@ -0,0 +1,227 @@
+/**
+ * @file StandardAtmosphereModel.cpp
+ * @brief Implementation of the tabulated standard atmosphere.
+ */
+
+#include "StandardAtmosphereModel.h"
+#include "../debug.h"
+#include <cmath>
+#include <string>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define FPV_ATMOSPHERE_SSE 1
+#endif
+
+namespace
+{
+    constexpr double SeaLevelTemperature = 288.15;   /**< K */
+    constexpr double SeaLevelPressure = 101325.0;    /**< Pa */
+    constexpr double SeaLevelDensity = 1.225;        /**< kg/m³, the ISA value the table is scaled from */
+    constexpr double GasConstant = 287.05287;        /**< Specific gas constant of dry air, J/(kg K) */
+    constexpr double StandardGravity = 9.80665;      /**< m/s² */
+    constexpr double HeatCapacityRatio = 1.4;        /**< Of dry air */
+    constexpr double EarthRadius = 6356766.0;        /**< Radius used to convert to geopotential altitude, m */
+
+    /**
+     * @brief One ISA layer: base geopotential altitude and temperature lapse rate.
+     */
+    struct Layer
+    {
+        double base;  /**< Geopotential altitude of the layer's bottom (m) */
+        double lapse; /**< Temperature gradient (K/m) */
+    };
+
+    constexpr Layer Layers[] = {{0.0, -0.0065}, {11000.0, 0.0},     {20000.0, 0.001},  {32000.0, 0.0028},
+                                {47000.0, 0.0}, {51000.0, -0.0028}, {71000.0, -0.002}};
+    constexpr int LayerCount = sizeof(Layers) / sizeof(Layers[0]);
+
+    constexpr float InverseStep = 1.0f / StandardAtmosphereModel::TableStep;
+
+    static_assert(sizeof(AtmosphereState) == 4 * sizeof(float), "AtmosphereState must be four packed floats");
+
+    /**
+     * @brief Temperature and pressure of a layer at a geopotential altitude, from its base values.
+     */
+    void layerState(const Layer &layer, double baseTemperature, double basePressure, double altitude,
+                    double &temperature, double &pressure)
+    {
+        temperature = baseTemperature + layer.lapse * (altitude - layer.base);
+        if (layer.lapse == 0.0)
+        {
+            pressure = basePressure * std::exp(-StandardGravity * (altitude - layer.base) / (GasConstant * baseTemperature));
+        }
+        else
+        {
+            pressure = basePressure * std::pow(temperature / baseTemperature, -StandardGravity / (GasConstant * layer.lapse));
+        }
+    }
+
+    /**
+     * @brief Find the table entry below an altitude and the fraction of the way to the next.
+     *
+     * @return false above the table
+     */
+    inline bool locate(float altitude, float lastEntry, std::size_t &index, float &fraction)
+    {
+        float u = (altitude - StandardAtmosphereModel::MinAltitude) * InverseStep;
+        if (!(u > 0.0f))
+        {
+            u = 0.0f; // Below the table, or NaN
+        }
+        if (u >= lastEntry)
+        {
+            return false;
+        }
+        index = static_cast<std::size_t>(u);
+        fraction = u - static_cast<float>(index);
+        return true;
+    }
+}
+
+/**
+ * @brief Construct the model and fill its table.
+ *
+ * @param seaLevelDensity Air density at sea level in kg/m³; density and pressure scale with it (ISA: 1.225)
+ */
+StandardAtmosphereModel::StandardAtmosphereModel(float seaLevelDensity)
+{
+    DEBUG_LOG("Initializing StandardAtmosphereModel with sea level density " + std::to_string(seaLevelDensity));
+
+    double baseTemperature[LayerCount];
+    double basePressure[LayerCount];
+    baseTemperature[0] = SeaLevelTemperature;
+    basePressure[0] = SeaLevelPressure;
+    for (int k = 1; k < LayerCount; ++k)
+    {
+        layerState(Layers[k - 1], baseTemperature[k - 1], basePressure[k - 1], Layers[k].base, baseTemperature[k],
+                   basePressure[k]);
+    }
+
+    const double scale = seaLevelDensity / SeaLevelDensity;
+    const int count = static_cast<int>((MaxAltitude - MinAltitude) / TableStep) + 1;
+    table_.resize(count);
+    for (int i = 0; i < count; ++i)
+    {
+        const double altitude = MinAltitude + i * static_cast<double>(TableStep);
+        const double geopotential = EarthRadius * altitude / (EarthRadius + altitude);
+        int k = LayerCount - 1;
+        while (k > 0 && geopotential < Layers[k].base)
+        {
+            --k;
+        }
+        double temperature, pressure;
+        layerState(Layers[k], baseTemperature[k], basePressure[k], geopotential, temperature, pressure);
+
+        AtmosphereState &state = table_[i];
+        state.density = static_cast<float>(scale * pressure / (GasConstant * temperature));
+        state.pressure = static_cast<float>(scale * pressure);
+        state.temperature = static_cast<float>(temperature);
+        state.speedOfSound = static_cast<float>(std::sqrt(HeatCapacityRatio * GasConstant * temperature));
+    }
+    topScaleHeight_ = static_cast<float>(GasConstant * table_.back().temperature / StandardGravity);
+}
+
+/**
+ * @brief State above the table: isothermal at the top temperature, density and pressure decaying exponentially.
+ *
+ * @param altitude The altitude above sea level in meters, at or above MaxAltitude
+ * @return The state of the air at the specified altitude
+ */
+AtmosphereState StandardAtmosphereModel::extrapolate(float altitude) const
+{
+    AtmosphereState state = table_.back();
+    const float decay = std::exp(-(altitude - MaxAltitude) / topScaleHeight_);
+    state.density *= decay;
+    state.pressure *= decay;
+    return state;
+}
+
+/**
+ * @brief Calculate air density at a given altitude.
+ *
+ * @param altitude The altitude above sea level in meters
+ * @return The air density in kg/m³ at the specified altitude
+ */
+float StandardAtmosphereModel::getDensity(float altitude) const
+{
+    std::size_t i;
+    float t;
+    if (!locate(altitude, static_cast<float>(table_.size() - 1), i, t))
+    {
+        return extrapolate(altitude).density;
+    }
+    return table_[i].density + (table_[i + 1].density - table_[i].density) * t;
+}
+
+/**
+ * @brief Calculate density, pressure, temperature and speed of sound at a given altitude.
+ *
+ * All four quantities are interpolated together, as one SSE operation where
+ * available.
+ *
+ * @param altitude The altitude above sea level in meters
+ * @return The state of the air at the specified altitude
+ */
+AtmosphereState StandardAtmosphereModel::getState(float altitude) const
+{
+    std::size_t i;
+    float t;
+    if (!locate(altitude, static_cast<float>(table_.size() - 1), i, t))
+    {
+        return extrapolate(altitude);
+    }
+    const AtmosphereState &a = table_[i];
+    const AtmosphereState &b = table_[i + 1];
+    AtmosphereState state;
+#ifdef FPV_ATMOSPHERE_SSE
+    const __m128 lower = _mm_loadu_ps(&a.density);
+    const __m128 upper = _mm_loadu_ps(&b.density);
+    _mm_storeu_ps(&state.density, _mm_add_ps(lower, _mm_mul_ps(_mm_sub_ps(upper, lower), _mm_set1_ps(t))));
+#else
+    state.density = a.density + (b.density - a.density) * t;
+    state.pressure = a.pressure + (b.pressure - a.pressure) * t;
+    state.temperature = a.temperature + (b.temperature - a.temperature) * t;
+    state.speedOfSound = a.speedOfSound + (b.speedOfSound - a.speedOfSound) * t;
+#endif
+    return state;
+}
+
+/**
+ * @brief Calculate air density at many altitudes.
+ *
+ * @param altitudes Altitudes above sea level in meters
+ * @param densities [out] Air densities in kg/m³
+ * @param count Number of altitudes
+ */
+void StandardAtmosphereModel::getDensityBatch(const float *altitudes, float *densities, std::size_t count) const
+{
+    const AtmosphereState *table = table_.data();
+    const float lastEntry = static_cast<float>(table_.size() - 1);
+    for (std::size_t k = 0; k < count; ++k)
+    {
+        std::size_t i;
+        float t;
+        if (!locate(altitudes[k], lastEntry, i, t))
+        {
+            densities[k] = extrapolate(altitudes[k]).density;
+            continue;
+        }
+        densities[k] = table[i].density + (table[i + 1].density - table[i].density) * t;
+    }
+}
+
+/**
+ * @brief Calculate the full state of the air at many altitudes.
+ *
+ * @param altitudes Altitudes above sea level in meters
+ * @param states [out] State of the air per altitude
+ * @param count Number of altitudes
+ */
+void StandardAtmosphereModel::getStateBatch(const float *altitudes, AtmosphereState *states, std::size_t count) const
+{
+    for (std::size_t k = 0; k < count; ++k)
+    {
+        states[k] = StandardAtmosphereModel::getState(altitudes[k]);
+    }
+}
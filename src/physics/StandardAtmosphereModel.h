@@ -0,0 +1,91 @@
+/**
+ * @file StandardAtmosphereModel.h
+ * @brief International Standard Atmosphere backed by a precomputed lookup table.
+ */
+
+#ifndef STANDARDATMOSPHEREMODEL_H
+#define STANDARDATMOSPHEREMODEL_H
+
+#include "IAirDensityModel.h"
+#include <vector>
+
+/**
+ * @class StandardAtmosphereModel
+ * @brief Air density, pressure, temperature and speed of sound of the 1976 standard atmosphere.
+ *
+ * The seven ISA layers up to 86 km, each with a constant temperature lapse
+ * rate, are evaluated once at construction, in double precision, into a
+ * table with one entry every TableStep meters of geometric altitude. A query
+ * linearly interpolates two neighbouring entries, so it costs a multiply, a
+ * conversion and a few loads instead of a pow() or exp(). At this spacing
+ * the interpolated density and pressure are within 1e-4 of the closed form.
+ *
+ * Above the table the air is extended isothermally with the temperature at
+ * its top; below it the lowest entry is held. Unlike a single exponential,
+ * the model follows the tropopause at 11 km, where the temperature stops
+ * falling and density drops faster.
+ */
+class StandardAtmosphereModel : public IAirDensityModel
+{
+public:
+    /** @brief Lowest tabulated altitude in meters */
+    static constexpr float MinAltitude = -2000.0f;
+
+    /** @brief Highest tabulated altitude in meters, the top of the ISA layers */
+    static constexpr float MaxAltitude = 86000.0f;
+
+    /** @brief Altitude between table entries in meters */
+    static constexpr float TableStep = 100.0f;
+
+    /**
+     * @brief Construct the model and fill its table.
+     *
+     * @param seaLevelDensity Air density at sea level in kg/m³; density and pressure scale with it (ISA: 1.225)
+     */
+    explicit StandardAtmosphereModel(float seaLevelDensity = 1.225f);
+
+    /**
+     * @brief Calculate air density at a given altitude.
+     *
+     * @param altitude The altitude above sea level in meters
+     * @return The air density in kg/m³ at the specified altitude
+     */
+    float getDensity(float altitude) const override;
+
+    /**
+     * @brief Calculate density, pressure, temperature and speed of sound at a given altitude.
+     *
+     * @param altitude The altitude above sea level in meters
+     * @return The state of the air at the specified altitude
+     */
+    AtmosphereState getState(float altitude) const override;
+
+    /**
+     * @brief Calculate air density at many altitudes.
+     *
+     * @param altitudes Altitudes above sea level in meters
+     * @param densities [out] Air densities in kg/m³
+     * @param count Number of altitudes
+     */
+    void getDensityBatch(const float *altitudes, float *densities, std::size_t count) const override;
+
+    /**
+     * @brief Calculate the full state of the air at many altitudes.
+     *
+     * @param altitudes Altitudes above sea level in meters
+     * @param states [out] State of the air per altitude
+     * @param count Number of altitudes
+     */
+    void getStateBatch(const float *altitudes, AtmosphereState *states, std::size_t count) const override;
+
+private:
+    AtmosphereState extrapolate(float altitude) const;
+
+    /** @brief Air state every TableStep meters from MinAltitude to MaxAltitude */
+    std::vector<AtmosphereState> table_;
+
+    /** @brief Isothermal scale height above the table in meters */
+    float topScaleHeight_;
+};
+
+#endif
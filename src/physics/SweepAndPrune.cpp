@@ -0,0 +1,171 @@
+/**
+ * @file SweepAndPrune.cpp
+ * @brief Implementation of the sort-and-sweep broadphase.
+ */
+#include "SweepAndPrune.h"
+#include <algorithm>
+
+namespace
+{
+    /** A new sweep axis must spread the boxes this much more than the current one */
+    constexpr double AxisHysteresis = 1.5;
+
+    inline float component(const Vector3D &v, int axis)
+    {
+        return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+    }
+}
+
+/**
+ * @brief Find every overlapping pair of boxes.
+ *
+ * @param bounds World-space box per body
+ * @param keys Stable identity per body, or nullptr if box i is the same body in every update
+ * @param count Number of boxes
+ * @param dynamicCount Number of leading boxes that belong to moving bodies
+ * @param pairs [out] Overlapping pairs, replaced
+ */
+void SweepAndPrune::update(const Aabb *bounds, const EntityHandle *keys, std::size_t count, std::size_t dynamicCount,
+                           std::vector<BroadphasePair> &pairs)
+{
+    pairs.clear();
+
+    const int axis = chooseAxis(bounds, count);
+    const bool rebuild = axis != axis_ || endpoints_.size() != count || (keys != nullptr && !remap(keys, count));
+    axis_ = axis;
+    if (rebuild)
+    {
+        endpoints_.resize(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            endpoints_[i].index = static_cast<std::uint32_t>(i);
+            endpoints_[i].key = keys != nullptr ? keys[i].index : static_cast<std::uint32_t>(i);
+        }
+    }
+    const int other0 = (axis_ + 1) % 3, other1 = (axis_ + 2) % 3;
+    for (Endpoint &endpoint : endpoints_)
+    {
+        const Aabb &box = bounds[endpoint.index];
+        endpoint.min = component(box.min, axis_);
+        endpoint.max = component(box.max, axis_);
+        endpoint.otherMin[0] = component(box.min, other0);
+        endpoint.otherMin[1] = component(box.min, other1);
+        endpoint.otherMax[0] = component(box.max, other0);
+        endpoint.otherMax[1] = component(box.max, other1);
+    }
+
+    if (rebuild)
+    {
+        std::sort(endpoints_.begin(), endpoints_.end(), [](const Endpoint &a, const Endpoint &b)
+                  { return a.min < b.min; });
+    }
+    else
+    {
+        // The order of the previous update is nearly sorted
+        for (std::size_t i = 1; i < count; ++i)
+        {
+            const Endpoint key = endpoints_[i];
+            std::size_t j = i;
+            for (; j > 0 && endpoints_[j - 1].min > key.min; --j)
+            {
+                endpoints_[j] = endpoints_[j - 1];
+            }
+            endpoints_[j] = key;
+        }
+    }
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const Endpoint &a = endpoints_[i];
+        const bool staticA = a.index >= dynamicCount;
+        for (std::size_t j = i + 1; j < count && endpoints_[j].min <= a.max; ++j)
+        {
+            // Most candidates fail one of these about half the time, so combine them without branches
+            const Endpoint &b = endpoints_[j];
+            const bool overlap = (b.otherMin[0] <= a.otherMax[0]) & (b.otherMax[0] >= a.otherMin[0]) &
+                                 (b.otherMin[1] <= a.otherMax[1]) & (b.otherMax[1] >= a.otherMin[1]) &
+                                 !(staticA & (b.index >= dynamicCount));
+            if (!overlap)
+            {
+                continue;
+            }
+            pairs.push_back(a.index < b.index ? BroadphasePair{a.index, b.index} : BroadphasePair{b.index, a.index});
+        }
+    }
+
+    std::sort(pairs.begin(), pairs.end(), [](const BroadphasePair &a, const BroadphasePair &b)
+              { return a.first != b.first ? a.first < b.first : a.second < b.second; });
+}
+
+/**
+ * @brief Point the kept endpoints at the bodies' indices in this update.
+ *
+ * Keys are unique and the count is unchanged, so finding every endpoint's
+ * key means the body set is the same and only its order may differ.
+ *
+ * @param keys Stable identity per body
+ * @param count Number of boxes (equal to the number of endpoints)
+ * @return false if some body of the last update is gone
+ */
+bool SweepAndPrune::remap(const EntityHandle *keys, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (keys[i].index >= indexByKey_.size())
+        {
+            indexByKey_.resize(keys[i].index + 1, InvalidIndex);
+        }
+        indexByKey_[keys[i].index] = static_cast<std::uint32_t>(i);
+    }
+
+    bool complete = true;
+    for (Endpoint &endpoint : endpoints_)
+    {
+        const std::uint32_t index = endpoint.key < indexByKey_.size() ? indexByKey_[endpoint.key] : InvalidIndex;
+        if (index == InvalidIndex)
+        {
+            complete = false;
+            break;
+        }
+        endpoint.index = index;
+    }
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        indexByKey_[keys[i].index] = InvalidIndex;
+    }
+    return complete;
+}
+
+/**
+ * @brief Pick the axis with the largest variance of box centers.
+ *
+ * @param bounds World-space box per body
+ * @param count Number of boxes
+ * @return The new sweep axis, or the current one unless another is clearly better
+ */
+int SweepAndPrune::chooseAxis(const Aabb *bounds, std::size_t count) const
+{
+    if (count < 2)
+    {
+        return axis_;
+    }
+    double sum[3] = {0.0, 0.0, 0.0};
+    double sumSquares[3] = {0.0, 0.0, 0.0};
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            const double center = 0.5 * (component(bounds[i].min, axis) + component(bounds[i].max, axis));
+            sum[axis] += center;
+            sumSquares[axis] += center * center;
+        }
+    }
+    double variance[3];
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        variance[axis] = sumSquares[axis] - sum[axis] * sum[axis] / static_cast<double>(count);
+    }
+    const int best = variance[0] >= variance[1] ? (variance[0] >= variance[2] ? 0 : 2) : (variance[1] >= variance[2] ? 1 : 2);
+    return variance[best] > AxisHysteresis * variance[axis_] ? best : axis_;
+}
@@ -0,0 +1,95 @@
+/**
+ * @file SweepAndPrune.h
+ * @brief Incremental sort-and-sweep broadphase over per-body bounding boxes.
+ */
+#ifndef SWEEPANDPRUNE_H
+#define SWEEPANDPRUNE_H
+
+#include "../core/SpatialIndex.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Two bodies whose bounding boxes overlap, with first < second.
+ */
+struct BroadphasePair
+{
+    std::uint32_t first;  /**< Lower body index */
+    std::uint32_t second; /**< Higher body index */
+};
+
+/**
+ * @class SweepAndPrune
+ * @brief Finds overlapping bounding boxes by sorting them along one axis.
+ *
+ * The boxes are kept sorted by their lower bound on the sweep axis between
+ * updates. Bodies move little per step, so the previous order is nearly
+ * sorted and an insertion sort restores it in close to linear time; only a
+ * change of body count, body set or sweep axis falls back to a full
+ * O(n log n) sort.
+ *
+ * Callers may hand the boxes over in a different order each update (the
+ * physics gather regroups bodies as they sleep, wake or start moving). Each
+ * box therefore carries a stable key, and the kept order is remapped from
+ * keys to the new box indices before sorting, so a reorder costs nothing.
+ * The sweep then walks the sorted list and tests the other two axes of each
+ * box against the boxes that start before it ends.
+ *
+ * The sweep axis is the one along which the box centers are most spread
+ * out, with hysteresis so it does not flip between nearly equal axes.
+ */
+class SweepAndPrune
+{
+public:
+    /**
+     * @brief Find every overlapping pair of boxes.
+     *
+     * Boxes [0, dynamicCount) belong to moving bodies and the rest to static
+     * ones; pairs of two static boxes are not reported. Pairs come out sorted,
+     * so the result depends only on the boxes and not on the sort history.
+     *
+     * @param bounds World-space box per body
+     * @param keys Stable identity per body (its entity handle), or nullptr if
+     *             box i is the same body in every update
+     * @param count Number of boxes
+     * @param dynamicCount Number of leading boxes that belong to moving bodies
+     * @param pairs [out] Overlapping pairs, replaced
+     */
+    void update(const Aabb *bounds, const EntityHandle *keys, std::size_t count, std::size_t dynamicCount, std::vector<BroadphasePair> &pairs);
+
+    /**
+     * @brief Get the axis the last update swept along.
+     *
+     * @return 0, 1 or 2 for X, Y or Z
+     */
+    int getAxis() const { return axis_; }
+
+private:
+    /**
+     * @brief A box as seen by the sweep: its interval on the sweep axis, then on the other two.
+     *
+     * The whole box is copied in so the sweep reads the sorted array
+     * sequentially instead of looking boxes up by body index.
+     */
+    struct Endpoint
+    {
+        float min;           /**< Lower bound on the sweep axis */
+        float max;           /**< Upper bound on the sweep axis */
+        float otherMin[2];   /**< Lower bounds on the other two axes */
+        float otherMax[2];   /**< Upper bounds on the other two axes */
+        std::uint32_t index; /**< Body index */
+        std::uint32_t key;   /**< Stable key of the body (entity slot) */
+    };
+
+    static constexpr std::uint32_t InvalidIndex = 0xFFFFFFFFu;
+
+    int chooseAxis(const Aabb *bounds, std::size_t count) const;
+    bool remap(const EntityHandle *keys, std::size_t count);
+
+    std::vector<Endpoint> endpoints_;        /**< Boxes in ascending min order along axis_ */
+    std::vector<std::uint32_t> indexByKey_;  /**< Key -> body index during remap(), InvalidIndex otherwise */
+    int axis_ = 0;                           /**< Current sweep axis */
+};
+
+#endif
@@ -4,6 +4,7 @@
  */
 
 #include "AssetHotReloadSystem.h"
+#include "../core/Profiler.h"
 #include "../debug.h"
 #include <iostream>
 #include <filesystem>
@@ -150,6 +151,7 @@ int AssetHotReloadSystem::watchAllPackages(const std::string &packagesDirectory)
  */
 bool AssetHotReloadSystem::checkForChanges()
 {
+    PROFILE_SCOPE("AssetHotReloadSystem::checkForChanges");
     bool hasChanges = false;
 
     for (auto &pair : watchedFiles_)
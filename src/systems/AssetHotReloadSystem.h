@@ -51,6 +51,13 @@ public:
      */
     void update(World &world, float deltaTime) override;
 
+    /**
+     * @brief Get the system name used in logs and profiler traces
+     *
+     * @return "AssetHotReloadSystem"
+     */
+    const char *getName() const override { return "AssetHotReloadSystem"; }
+
     /**
      * @brief Add a package to the watch list for change monitoring.
      *
@@ -16,6 +16,7 @@ public:
     virtual ~BootstrapSystem() = default;
 
     void update(World &world, float deltaTime) override;
+    const char *getName() const override { return "BootstrapSystem"; }
     void Init();
     void PostFrameUpdate();
 
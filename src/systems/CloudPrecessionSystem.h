@@ -20,6 +20,7 @@
 #include "../math/MathUtils.h"
 #include "../components/VoxelCloudC.h"
 #include "../components/TransformC.h"
+#include "../core/World.h"
 #include <vector>
 #include <memory>
 #include <unordered_map>
@@ -40,6 +41,7 @@ public:
     struct CloudEntity
     {
         uint32_t entityId;                     /**< Entity identifier */
+        EntityHandle handle;                   /**< World entity of a spawned cloud; invalid for registered ones */
         std::shared_ptr<VoxelCloudC> cloud;    /**< Voxel cloud component */
         std::shared_ptr<TransformC> transform; /**< Transform component */
         bool active;                           /**< Whether entity is active */
@@ -135,14 +137,18 @@ private:
     /** @brief Queue of entities to be removed */
     std::queue<uint32_t> removalQueue;
 
+    /** @brief World that owns the entities of spawned clouds */
+    World &world;
+
 public:
     /**
      * @brief Construct a new CloudPrecessionSystem
      *
+     * @param world World that owns the entities of spawned clouds
      * @param center Global center point for cloud motion
      */
-    CloudPrecessionSystem(const Math::float3 &center = {0, 0, 0})
-        : globalTime(0.0f), globalTimeScale(1.0f), systemActive(true), spawnTimer(0.0f), globalCenter(center), randomState(12345)
+    CloudPrecessionSystem(World &world, const Math::float3 &center = {0, 0, 0})
+        : globalTime(0.0f), globalTimeScale(1.0f), systemActive(true), spawnTimer(0.0f), globalCenter(center), randomState(12345), world(world)
     {
         // Create default formation
         formations["default"] = CloudFormation("default");
@@ -528,11 +534,12 @@ private:
         // Set initial transform
         transform->setPosition(spawnPos);
 
-        // Generate unique entity ID
-        uint32_t newEntityId = static_cast<uint32_t>(entities.size()) + 1000;
+        // Let the World assign the ID, so spawned clouds never collide with other entities
+        EntityHandle handle = world.addEntity(std::make_unique<Entity>());
 
         // Register the new entity
-        registerEntity(newEntityId, cloud, transform, "default");
+        registerEntity(world.getEntity(handle)->getId(), cloud, transform, "default");
+        entities.back().handle = handle;
     }
 
     /**
@@ -544,6 +551,11 @@ private:
         {
             uint32_t entityId = removalQueue.front();
             removalQueue.pop();
+            for (const auto &entity : entities)
+            {
+                if (entity.entityId == entityId && entity.handle.isValid())
+                    world.destroyEntity(entity.handle);
+            }
             unregisterEntity(entityId);
         }
     }
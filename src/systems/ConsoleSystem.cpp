@@ -1,5 +1,9 @@
 #include "ConsoleSystem.h"
 #include "../core/World.h"
+#include "../core/Profiler.h"
+#include "../core/Metrics.h"
+#include "../events/SimulationEvents.h"
+#include <cstdlib>
 #include <iostream>
 #include "../debug.h"
 
@@ -8,10 +12,7 @@ ConsoleSystem::ConsoleSystem(EventBus &eventBus)
 {
     DEBUG_LOG("Initializing ConsoleSystem");
     // Subscribe to console toggle events
-    eventBus.subscribe(EventType::ConsoleToggle, [this](const IEvent &event)
-                       {
-        const auto& toggleEvent = static_cast<const ConsoleToggleEvent&>(event);
-        OnConsoleToggle(toggleEvent); });
+    eventBus.subscribe<ConsoleToggleEvent, ConsoleSystem, &ConsoleSystem::OnConsoleToggle>(this);
 
     AddOutput("Console initialized. Press ~ to toggle visibility.");
 }
@@ -43,6 +44,11 @@ void ConsoleSystem::ExecuteCommand(const std::string &command)
         AddOutput("  help - Show this help");
         AddOutput("  clear - Clear console");
         AddOutput("  quit - Exit application");
+        AddOutput("  profile on|off|clear|status - Control the frame profiler");
+        AddOutput("  profile dump <file> - Write recorded scopes as Chrome trace JSON");
+        AddOutput("  stats [prefix] - Show metrics, e.g. 'stats physics'");
+        AddOutput("  stats reset - Reset all metrics");
+        AddOutput("  rewind <seconds> - Restore the simulation from the rewind buffer ('stats rewind' for its size)");
     }
     else if (command == "clear")
     {
@@ -54,12 +60,88 @@ void ConsoleSystem::ExecuteCommand(const std::string &command)
         AddOutput("Quitting application...");
         // TODO: Publish quit event
     }
+    else if (command == "stats reset")
+    {
+        MetricsRegistry::instance().reset();
+        AddOutput("Metrics reset.");
+    }
+    else if (command == "stats" || command.rfind("stats ", 0) == 0)
+    {
+        const std::string prefix = command.size() > 6 ? command.substr(6) : std::string();
+        const auto lines = MetricsRegistry::formatSnapshot(MetricsRegistry::instance().snapshot(prefix));
+        if (lines.empty())
+            AddOutput("No metrics match '" + prefix + "'");
+        for (const std::string &line : lines)
+            AddOutput(line);
+    }
+    else if (command.rfind("profile", 0) == 0)
+    {
+        ExecuteProfileCommand(command.size() > 8 ? command.substr(8) : std::string());
+    }
+    else if (command.rfind("rewind", 0) == 0)
+    {
+        ExecuteRewindCommand(command.size() > 7 ? command.substr(7) : std::string());
+    }
     else
     {
         AddOutput("Unknown command: " + command);
     }
 }
 
+void ConsoleSystem::ExecuteProfileCommand(const std::string &arguments)
+{
+    Profiler &profiler = Profiler::instance();
+
+    if (arguments == "on")
+    {
+        profiler.setEnabled(true);
+        AddOutput("Profiler recording.");
+    }
+    else if (arguments == "off")
+    {
+        profiler.setEnabled(false);
+        AddOutput("Profiler stopped.");
+    }
+    else if (arguments == "clear")
+    {
+        profiler.clear();
+        AddOutput("Profiler events cleared.");
+    }
+    else if (arguments.rfind("dump ", 0) == 0 && arguments.size() > 5)
+    {
+        const std::string path = arguments.substr(5);
+        if (profiler.exportChromeTrace(path))
+            AddOutput("Wrote " + std::to_string(profiler.getEventCount()) + " events to " + path);
+        else
+            AddOutput("Could not write trace to " + path);
+    }
+    else if (arguments.empty() || arguments == "status")
+    {
+        AddOutput(std::string("Profiler ") + (Profiler::isEnabled() ? "recording" : "stopped") + ", " +
+                  std::to_string(profiler.getEventCount()) + " events held, " +
+                  std::to_string(profiler.getDroppedCount()) + " overwritten");
+    }
+    else
+    {
+        AddOutput("Usage: profile on|off|clear|status|dump <file>");
+    }
+}
+
+void ConsoleSystem::ExecuteRewindCommand(const std::string &arguments)
+{
+    char *end = nullptr;
+    const double seconds = std::strtod(arguments.c_str(), &end);
+    if (arguments.empty() || *end != '\0' || !(seconds >= 0.0))
+    {
+        AddOutput("Usage: rewind <seconds>");
+        return;
+    }
+
+    // Applied by the engine after the next physics steps, outside any system update
+    eventBus.enqueue(RewindRequestEvent(seconds));
+    AddOutput("Rewinding " + arguments + " s...");
+}
+
 void ConsoleSystem::ToggleVisibility()
 {
     DEBUG_LOG("Toggling console visibility");
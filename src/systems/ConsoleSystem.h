@@ -18,6 +18,7 @@ public:
     virtual ~ConsoleSystem() = default;
 
     void update(World &world, float deltaTime) override;
+    const char *getName() const override { return "ConsoleSystem"; }
 
     void AddOutput(const std::string &message);
     void ExecuteCommand(const std::string &command);
@@ -32,5 +33,7 @@ private:
     std::vector<std::string> outputBuffer;
 
     void OnConsoleToggle(const ConsoleToggleEvent &event);
+    void ExecuteProfileCommand(const std::string &arguments);
+    void ExecuteRewindCommand(const std::string &arguments);
 };
 
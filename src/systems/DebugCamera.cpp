@@ -21,10 +21,7 @@ DebugCamera::DebugCamera(EventBus& eventBus)
     debugTargetDirection_ = (Vector3(0.0f, 0.0f, 0.0f) - debugTargetPosition_).normalized();
 
     // Subscribe to debug mode events
-    eventBus_.subscribe(EventType::DebugModeToggled, [this](const IEvent &event) {
-        const auto& debugEvent = static_cast<const DebugModeToggled&>(event);
-        onDebugModeToggled(debugEvent);
-    });
+    eventBus_.subscribe<DebugModeToggled, DebugCamera, &DebugCamera::onDebugModeToggled>(this);
 
     DEBUG_LOG("DebugCamera initialized");
 }
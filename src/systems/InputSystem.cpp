@@ -189,6 +189,9 @@ void InputSystem::processGamepadInput()
 void InputSystem::triggerInputAction(const std::string &action)
 {
     DEBUG_LOG("Triggering input action '" + action + "'");
+    // Recorded into replays and delivered to simulation code
+    eventBus_.publish(InputActionEvent{action});
+
     // Handle specific actions
     if (action == "ToggleDebugConsole")
     {
@@ -59,6 +59,13 @@ public:
      */
     void update(World &world, float dt) override;
 
+    /**
+     * @brief Get the system name used in logs and profiler traces
+     *
+     * @return "InputSystem"
+     */
+    const char *getName() const override { return "InputSystem"; }
+
 private:
     EventBus &eventBus_;
     IInputDevice &inputDevice_;
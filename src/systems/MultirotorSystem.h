@@ -0,0 +1,80 @@
+#ifndef MULTIROTORSYSTEM_H
+#define MULTIROTORSYSTEM_H
+
+#include "core/ISystem.h"
+#include "core/EventBus.h"
+#include <vector>
+
+struct TransformC;
+struct PhysicsC;
+struct MultirotorC;
+
+/**
+ * @brief Turns multirotor commands into rotor thrust and torque on the PhysicsC.
+ *
+ * Each fixed step, every entity with a TransformC, a PhysicsC and a powered
+ * MultirotorC has its rotors, motors and battery advanced by a
+ * MultirotorModel in substeps at the configured rate. The mean rotor wrench
+ * over the step is rotated into world space and added to PhysicsC::force and
+ * PhysicsC::torque, which the PhysicsSystem integrates next, so the motor
+ * lag and voltage sag are resolved at kilohertz rates while the rigid body
+ * takes one step per tick. Vehicles are independent and are stepped in
+ * parallel.
+ */
+class MultirotorSystem : public ISystem
+{
+public:
+    /** @brief Lowest supported substep rate in Hz */
+    static constexpr float MinSubstepRate = 2000.0f;
+
+    /** @brief Highest supported substep rate in Hz */
+    static constexpr float MaxSubstepRate = 8000.0f;
+
+    /** @brief Substep rate used unless configured otherwise, in Hz */
+    static constexpr float DefaultSubstepRate = 4000.0f;
+
+    /**
+     * @brief Construct the system.
+     *
+     * @param eventBus Event bus for simulation events
+     * @param substepRate Rotor, motor and battery substeps per second, clamped to [MinSubstepRate, MaxSubstepRate]
+     */
+    MultirotorSystem(EventBus &eventBus, float substepRate = DefaultSubstepRate);
+    void update(World &world, float dt) override;
+    const char *getName() const override { return "MultirotorSystem"; }
+    SystemAccess getAccess() const override;
+
+    /**
+     * @brief Get the substep rate.
+     *
+     * @return Substeps per second
+     */
+    float getSubstepRate() const { return substepRate_; }
+
+    /**
+     * @brief Get the number of substeps taken per vehicle by the last update.
+     *
+     * @return Substep count
+     */
+    int getSubstepCount() const { return substepCount_; }
+
+private:
+    /**
+     * @brief Components of one vehicle gathered for an update.
+     */
+    struct Vehicle
+    {
+        const TransformC *transform; /**< Orientation of the body */
+        PhysicsC *physics;           /**< Receives the rotor wrench */
+        MultirotorC *multirotor;     /**< Commands, parameters and state */
+    };
+
+    EventBus &eventBus_;
+    float substepRate_;
+    int substepCount_ = 0;
+
+    /** @brief Vehicles gathered by the last update */
+    std::vector<Vehicle> vehicles_;
+};
+
+#endif
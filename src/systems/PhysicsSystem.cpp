@@ -1,12 +1,713 @@
 #include "PhysicsSystem.h"
 #include "core/World.h"
+#include "core/JobSystem.h"
+#include "core/Profiler.h"
+#include "core/Metrics.h"
+#include "components/TransformC.h"
+#include "components/PhysicsC.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
-PhysicsSystem::PhysicsSystem(EventBus &eventBus, IAirDensityModel &airDensityModel, IWindModel &windModel, ICollisionResolver &collisionResolver)
-    : eventBus_(eventBus), airDensityModel_(airDensityModel), windModel_(windModel), collisionResolver_(collisionResolver) {}
+namespace
+{
+    constexpr float Pi = 3.14159265358979f;
+
+    /**
+     * @brief Principal moments of inertia: PhysicsC::inertia if set, else a solid sphere, cylinder or box filling the collider.
+     */
+    Vector3D principalInertia(const PhysicsC &physics)
+    {
+        if (physics.inertia.x != 0.0f || physics.inertia.y != 0.0f || physics.inertia.z != 0.0f)
+        {
+            return physics.inertia;
+        }
+        const float sx = physics.colliderSize[0], sy = physics.colliderSize[1], sz = physics.colliderSize[2];
+        if (physics.colliderType == ColliderType::Sphere)
+        {
+            const float moment = 0.1f * physics.mass * sx * sx; // 2/5 m r^2 with r = sx / 2
+            return Vector3D(moment, moment, moment);
+        }
+        if (physics.colliderType == ColliderType::Capsule)
+        {
+            // Solid cylinder of the capsule's diameter and height along Y
+            const float axial = 0.125f * physics.mass * sx * sx;
+            const float transverse = physics.mass * (0.75f * sx * sx + sy * sy) / 12.0f;
+            return Vector3D(transverse, axial, transverse);
+        }
+        const float k = physics.mass / 12.0f;
+        return Vector3D(k * (sy * sy + sz * sz), k * (sx * sx + sz * sz), k * (sx * sx + sy * sy));
+    }
+
+    /**
+     * @brief Drag reference area: a sphere's cross-section, or the mean face area of the collider box.
+     */
+    float referenceArea(const PhysicsC &physics)
+    {
+        const float sx = physics.colliderSize[0], sy = physics.colliderSize[1], sz = physics.colliderSize[2];
+        if (physics.colliderType == ColliderType::Sphere)
+        {
+            return 0.25f * Pi * sx * sx;
+        }
+        return (sx * sy + sy * sz + sz * sx) / 3.0f;
+    }
+
+    float inverse(float value)
+    {
+        return value > 0.0f ? 1.0f / value : 0.0f;
+    }
+
+    /** Distance within which a new contact point inherits a cached point's impulses (m) */
+    constexpr float ContactMatchDistance = 0.05f;
 
+    inline float lengthSquared(const Vector3D &v)
+    {
+        return v.x * v.x + v.y * v.y + v.z * v.z;
+    }
+
+    inline bool isZero(const Vector3D &v)
+    {
+        return v.x == 0.0f && v.y == 0.0f && v.z == 0.0f;
+    }
+
+    /**
+     * @brief Whether anything set on a resting body asks it to move.
+     */
+    bool isDisturbed(const PhysicsC &physics)
+    {
+        return !isZero(physics.force) || !isZero(physics.torque) || !isZero(physics.velocity) ||
+               !isZero(physics.angularVelocity);
+    }
+
+    /**
+     * @brief Key shared by the bodies of a sleeping island; a body put to sleep by hand forms its own.
+     */
+    std::uint64_t sleepKey(const PhysicsC &physics, EntityHandle handle)
+    {
+        return physics.sleepIsland.isValid() ? physics.sleepIsland.value() : handle.value();
+    }
+}
+
+PhysicsSystem::PhysicsSystem(EventBus &eventBus, IAirDensityModel &airDensityModel, IWindModel &windModel,
+                             float gravity)
+    : eventBus_(eventBus), airDensityModel_(airDensityModel), windModel_(windModel), gravity_(gravity) {}
+
+SystemAccess PhysicsSystem::getAccess() const
+{
+    return SystemAccess().read<PhysicsC>().write<TransformC>().write<PhysicsC>();
+}
+
+/**
+ * @brief Advance every awake dynamic body by dt and resolve its contacts.
+ *
+ * Velocities are integrated first, per chunk on one worker, and copied into
+ * the solver bodies. Contacts are then found at the start-of-step positions,
+ * solved per island, and positions are integrated with the solved
+ * velocities, so resting contacts cancel gravity before it moves anything.
+ *
+ * @param world World containing the bodies
+ * @param dt Fixed time step in seconds
+ */
 void PhysicsSystem::update(World &world, float dt)
 {
-    // Stub: update physics for entities
+    PROFILE_SCOPE("PhysicsSystem::update");
+    static Gauge &bodyCount = MetricsRegistry::instance().gauge("physics.bodies");
+    static Gauge &islandCount = MetricsRegistry::instance().gauge("physics.islands");
+    static Gauge &sleepingCount = MetricsRegistry::instance().gauge("physics.sleeping");
+
+    gatherBodies(world);
+    bodies_.resize(dynamicCount_);
+    solverBodies_.resize(transforms_.size());
+    bodyCount.set(static_cast<double>(dynamicCount_));
+
+    parallelFor(0, dynamicCount_, 512, [this, dt](std::size_t first, std::size_t last)
+                {
+        loadBodies(first, last);
+        sampleEnvironment(first, last);
+        bodies_.integrateVelocity(dt, gravity_, first, last);
+        const RigidBodyIntegrator &b = bodies_;
+        for (std::size_t i = first; i < last; ++i)
+        {
+            SolverBody &body = solverBodies_[i];
+            body.position = Vector3D(b.px[i], b.py[i], b.pz[i]);
+            body.velocity = Vector3D(b.vx[i], b.vy[i], b.vz[i]);
+            body.angularVelocity = Vector3D(b.wx[i], b.wy[i], b.wz[i]);
+            body.invMass = b.invMass[i];
+            body.setInverseInertia(Quaternion(b.qw[i], b.qx[i], b.qy[i], b.qz[i]),
+                                   Vector3D(b.invInertiaX[i], b.invInertiaY[i], b.invInertiaZ[i]));
+        } });
+
+    for (std::size_t i = dynamicCount_; i < transforms_.size(); ++i)
+    {
+        const PhysicsC &physics = *physics_[i];
+        SolverBody &body = solverBodies_[i];
+        body = SolverBody();
+        body.position = transforms_[i]->position;
+        if (!physics.isSleeping)
+        {
+            body.velocity = physics.velocity;
+            body.angularVelocity = physics.angularVelocity;
+        }
+    }
+
+    detectContacts();
+    buildIslands();
+    prepareConstraints(dt);
+    solveIslands(dt);
+
+    parallelFor(0, dynamicCount_, 512, [this, dt](std::size_t first, std::size_t last)
+                {
+        RigidBodyIntegrator &b = bodies_;
+        for (std::size_t i = first; i < last; ++i)
+        {
+            const SolverBody &body = solverBodies_[i];
+            b.vx[i] = body.velocity.x;
+            b.vy[i] = body.velocity.y;
+            b.vz[i] = body.velocity.z;
+            b.wx[i] = body.angularVelocity.x;
+            b.wy[i] = body.angularVelocity.y;
+            b.wz[i] = body.angularVelocity.z;
+        }
+        bodies_.integratePosition(dt, first, last);
+        storeBodies(first, last); });
+
+    cacheImpulses();
+    islandCount.set(static_cast<double>(getIslandCount()));
+    sleepingCount.set(static_cast<double>(sleepingCount_));
+}
+
+/**
+ * @brief Collect every collider: awake dynamic bodies, then moving kinematic ones, then the rest.
+ *
+ * Sleeping bodies wake here when something was set on them since the last
+ * update or when the last update found their island touched; waking takes
+ * the whole island along.
+ *
+ * @param world World containing the bodies
+ */
+void PhysicsSystem::gatherBodies(World &world)
+{
+    transforms_.clear();
+    physics_.clear();
+    handles_.clear();
+    moving_.clear();
+    resting_.clear();
+    sleepers_.clear();
+    world.view<TransformC, PhysicsC>().each([this](Entity &entity, TransformC &transform, PhysicsC &physics)
+                                            {
+        const GatheredBody body{&transform, &physics, entity.getHandle()};
+        if (physics.isKinematic || physics.mass <= 0.0f)
+        {
+            if (isZero(physics.velocity) && isZero(physics.angularVelocity))
+            {
+                resting_.push_back(body);
+            }
+            else
+            {
+                moving_.push_back(body);
+            }
+        }
+        else if (physics.isSleeping)
+        {
+            if (isDisturbed(physics))
+            {
+                wakeIslands_.push_back(sleepKey(physics, body.handle));
+            }
+            sleepers_.push_back(body);
+        }
+        else
+        {
+            appendBody(body);
+        } });
+
+    std::sort(wakeIslands_.begin(), wakeIslands_.end());
+    sleepingCount_ = 0;
+    for (const GatheredBody &body : sleepers_)
+    {
+        PhysicsC &physics = *body.physics;
+        if (std::binary_search(wakeIslands_.begin(), wakeIslands_.end(), sleepKey(physics, body.handle)))
+        {
+            physics.isSleeping = false;
+            physics.sleepTime = 0.0f;
+            physics.sleepIsland = EntityHandle();
+            appendBody(body);
+        }
+        else
+        {
+            resting_.push_back(body);
+            ++sleepingCount_;
+        }
+    }
+    wakeIslands_.clear();
+
+    dynamicCount_ = transforms_.size();
+    for (const GatheredBody &body : moving_)
+    {
+        appendBody(body);
+    }
+    activeCount_ = transforms_.size();
+    for (const GatheredBody &body : resting_)
+    {
+        appendBody(body);
+    }
+}
+
+/**
+ * @brief Append a collider to the gathered lists.
+ *
+ * @param body Collider to append
+ */
+void PhysicsSystem::appendBody(const GatheredBody &body)
+{
+    transforms_.push_back(body.transform);
+    physics_.push_back(body.physics);
+    handles_.push_back(body.handle);
+}
+
+/**
+ * @brief Find the contact manifolds that involve an awake or moving collider.
+ *
+ * Shapes and bounds are placed in parallel, the broadphase sweeps serially,
+ * and the narrowphase runs in parallel with one result slot per pair so the
+ * compacted contact list keeps the broadphase's deterministic order. A
+ * contact that reaches into a sleeping island marks it to wake at the next
+ * gather.
+ */
+void PhysicsSystem::detectContacts()
+{
+    PROFILE_SCOPE("PhysicsSystem::detectContacts");
+    static Gauge &pairCount = MetricsRegistry::instance().gauge("physics.pairs");
+    static Gauge &contactCount = MetricsRegistry::instance().gauge("physics.contacts");
+
+    const std::size_t count = transforms_.size();
+    shapes_.resize(count);
+    bounds_.resize(count);
+    parallelFor(0, count, 512, [this](std::size_t first, std::size_t last)
+                {
+        for (std::size_t i = first; i < last; ++i)
+        {
+            const TransformC &transform = *transforms_[i];
+            const PhysicsC &physics = *physics_[i];
+            shapes_[i] = CollisionShape::make(physics.colliderType, physics.colliderSize, transform.scale,
+                                              transform.position, transform.rotation);
+            bounds_[i] = shapes_[i].bounds(ContactMargin);
+        } });
+
+    broadphase_.update(bounds_.data(), handles_.data(), count, activeCount_, pairs_);
+
+    manifolds_.resize(pairs_.size());
+    parallelFor(0, pairs_.size(), 64, [this](std::size_t first, std::size_t last)
+                {
+        for (std::size_t k = first; k < last; ++k)
+        {
+            const BroadphasePair &pair = pairs_[k];
+            ContactManifold &manifold = manifolds_[k];
+            manifold.bodyA = pair.first;
+            manifold.bodyB = pair.second;
+            if (!collide(shapes_[pair.first], shapes_[pair.second], ContactMargin, manifold))
+            {
+                manifold.pointCount = 0;
+            }
+        } });
+
+    contacts_.clear();
+    for (const ContactManifold &manifold : manifolds_)
+    {
+        if (manifold.pointCount == 0)
+        {
+            continue;
+        }
+        contacts_.push_back(manifold);
+        // Active colliders come first, so only B can be asleep
+        const PhysicsC &other = *physics_[manifold.bodyB];
+        if (manifold.bodyB >= activeCount_ && other.isSleeping)
+        {
+            wakeIslands_.push_back(sleepKey(other, handles_[manifold.bodyB]));
+        }
+    }
+    pairCount.set(static_cast<double>(pairs_.size()));
+    contactCount.set(static_cast<double>(contacts_.size()));
+}
+
+/**
+ * @brief Group the awake dynamic bodies into islands connected by contacts.
+ *
+ * Static, kinematic and sleeping colliders do not join islands, so a floor
+ * under a thousand separate crates does not merge them into one island. A
+ * contact belongs to the island of its dynamic body. Islands are numbered by
+ * their lowest body index and list their bodies and contacts in ascending
+ * order, so the result does not depend on the thread count.
+ */
+void PhysicsSystem::buildIslands()
+{
+    PROFILE_SCOPE("PhysicsSystem::buildIslands");
+    const std::uint32_t count = static_cast<std::uint32_t>(dynamicCount_);
+    islandParent_.resize(count);
+    for (std::uint32_t i = 0; i < count; ++i)
+    {
+        islandParent_[i] = i;
+    }
+    auto find = [this](std::uint32_t i)
+    {
+        while (islandParent_[i] != i)
+        {
+            islandParent_[i] = islandParent_[islandParent_[i]];
+            i = islandParent_[i];
+        }
+        return i;
+    };
+    for (const ContactManifold &manifold : contacts_)
+    {
+        if (manifold.bodyB >= count)
+        {
+            continue;
+        }
+        const std::uint32_t a = find(manifold.bodyA), b = find(manifold.bodyB);
+        // The lower index becomes the root, so a set's root is its lowest body
+        if (a < b)
+        {
+            islandParent_[b] = a;
+        }
+        else if (b < a)
+        {
+            islandParent_[a] = b;
+        }
+    }
+
+    // Roots precede their members, so one ascending pass numbers the islands
+    islandOf_.resize(count);
+    islandBodyStart_.clear();
+    for (std::uint32_t i = 0; i < count; ++i)
+    {
+        const std::uint32_t root = find(i);
+        if (root == i)
+        {
+            islandOf_[i] = static_cast<std::uint32_t>(islandBodyStart_.size());
+            islandBodyStart_.push_back(0);
+        }
+        else
+        {
+            islandOf_[i] = islandOf_[root];
+        }
+        ++islandBodyStart_[islandOf_[i]];
+    }
+    const std::size_t islands = islandBodyStart_.size();
+
+    // Counting sort of bodies and contacts by island
+    std::uint32_t offset = 0;
+    for (std::size_t k = 0; k < islands; ++k)
+    {
+        const std::uint32_t size = islandBodyStart_[k];
+        islandBodyStart_[k] = offset;
+        offset += size;
+    }
+    islandBodyStart_.push_back(offset);
+    islandBodies_.resize(count);
+    for (std::uint32_t i = 0; i < count; ++i)
+    {
+        islandBodies_[islandBodyStart_[islandOf_[i]]++] = i;
+    }
+    for (std::size_t k = islands; k > 0; --k)
+    {
+        islandBodyStart_[k] = islandBodyStart_[k - 1];
+    }
+    if (islands > 0)
+    {
+        islandBodyStart_[0] = 0;
+    }
+
+    islandContactStart_.assign(islands + 1, 0);
+    for (const ContactManifold &manifold : contacts_)
+    {
+        if (manifold.bodyA < count)
+        {
+            ++islandContactStart_[islandOf_[manifold.bodyA] + 1];
+        }
+    }
+    for (std::size_t k = 0; k < islands; ++k)
+    {
+        islandContactStart_[k + 1] += islandContactStart_[k];
+    }
+    islandContacts_.resize(islandContactStart_[islands]);
+    for (std::uint32_t k = 0, end = static_cast<std::uint32_t>(contacts_.size()); k < end; ++k)
+    {
+        const std::uint32_t a = contacts_[k].bodyA;
+        if (a < count)
+        {
+            islandContacts_[islandContactStart_[islandOf_[a]]++] = k;
+        }
+    }
+    for (std::size_t k = islands; k > 0; --k)
+    {
+        islandContactStart_[k] = islandContactStart_[k - 1];
+    }
+    islandContactStart_[0] = 0;
+}
+
+/**
+ * @brief Prepare the constraints of every island and seed them from the previous step.
+ *
+ * Friction combines as the geometric mean, so a frictionless surface stays
+ * frictionless whatever touches it, and restitution as the maximum, so a
+ * bouncy ball bounces off any floor. A point inherits the impulses of the
+ * nearest cached point of the same pair within ContactMatchDistance.
+ *
+ * @param dt Time step in seconds
+ */
+void PhysicsSystem::prepareConstraints(float dt)
+{
+    PROFILE_SCOPE("PhysicsSystem::prepareConstraints");
+    constraints_.resize(islandContacts_.size());
+    parallelFor(0, islandContacts_.size(), 64, [this, dt](std::size_t first, std::size_t last)
+                {
+        for (std::size_t k = first; k < last; ++k)
+        {
+            const ContactManifold &manifold = contacts_[islandContacts_[k]];
+            const PhysicsC &a = *physics_[manifold.bodyA];
+            const PhysicsC &b = *physics_[manifold.bodyB];
+            ContactConstraint &constraint = constraints_[k];
+            solver_.prepare(manifold, solverBodies_.data(), std::sqrt(std::max(a.friction * b.friction, 0.0f)),
+                            std::max(a.restitution, b.restitution), dt, constraint);
+
+            const std::uint64_t key = cacheKey(manifold.bodyA, manifold.bodyB);
+            const auto cached = std::lower_bound(contactCache_.begin(), contactCache_.end(), key,
+                                                 [](const CachedContact &entry, std::uint64_t value)
+                                                 { return entry.key < value; });
+            if (cached == contactCache_.end() || cached->key != key || cached->bodyA != handles_[manifold.bodyA] ||
+                cached->bodyB != handles_[manifold.bodyB])
+            {
+                continue;
+            }
+            for (std::uint32_t i = 0; i < manifold.pointCount; ++i)
+            {
+                float nearest = ContactMatchDistance * ContactMatchDistance;
+                for (std::uint32_t j = 0; j < cached->pointCount; ++j)
+                {
+                    const float distance = lengthSquared(manifold.points[i].position - cached->positions[j]);
+                    if (distance <= nearest)
+                    {
+                        nearest = distance;
+                        constraint.points[i].impulse = cached->impulses[j];
+                    }
+                }
+            }
+        } });
+}
+
+/**
+ * @brief Solve every island, in parallel, and put islands that have come to rest to sleep.
+ *
+ * Islands share no dynamic body and the solver never writes to static,
+ * kinematic or sleeping ones, so islands need no synchronisation.
+ *
+ * @param dt Time step in seconds
+ */
+void PhysicsSystem::solveIslands(float dt)
+{
+    PROFILE_SCOPE("PhysicsSystem::solveIslands");
+    parallelFor(0, getIslandCount(), 16, [this, dt](std::size_t first, std::size_t last)
+                {
+        constexpr float LinearTolerance2 = LinearSleepTolerance * LinearSleepTolerance;
+        constexpr float AngularTolerance2 = AngularSleepTolerance * AngularSleepTolerance;
+        for (std::size_t island = first; island < last; ++island)
+        {
+            const std::uint32_t contactBegin = islandContactStart_[island];
+            const std::uint32_t contactEnd = islandContactStart_[island + 1];
+            solver_.solve(constraints_.data() + contactBegin, contactEnd - contactBegin, solverBodies_.data());
+
+            const std::uint32_t bodyBegin = islandBodyStart_[island];
+            const std::uint32_t bodyEnd = islandBodyStart_[island + 1];
+            float restTime = std::numeric_limits<float>::max();
+            for (std::uint32_t k = bodyBegin; k < bodyEnd; ++k)
+            {
+                const std::uint32_t i = islandBodies_[k];
+                PhysicsC &physics = *physics_[i];
+                const SolverBody &body = solverBodies_[i];
+                if (lengthSquared(body.velocity) > LinearTolerance2 ||
+                    lengthSquared(body.angularVelocity) > AngularTolerance2 || !isZero(physics.force) ||
+                    !isZero(physics.torque))
+                {
+                    physics.sleepTime = 0.0f;
+                }
+                else
+                {
+                    physics.sleepTime += dt;
+                }
+                restTime = std::min(restTime, physics.sleepTime);
+            }
+            if (restTime < TimeToSleep)
+            {
+                continue;
+            }
+
+            const EntityHandle key = handles_[islandBodies_[bodyBegin]];
+            for (std::uint32_t k = bodyBegin; k < bodyEnd; ++k)
+            {
+                const std::uint32_t i = islandBodies_[k];
+                PhysicsC &physics = *physics_[i];
+                solverBodies_[i].velocity = Vector3D();
+                solverBodies_[i].angularVelocity = Vector3D();
+                physics.isSleeping = true;
+                physics.sleepIsland = key;
+            }
+        } });
+}
+
+/**
+ * @brief Keep this step's accumulated impulses for warm starting the next one.
+ *
+ * Points are stored at their world position at the start of this step;
+ * bodies in resting contact barely move, so the next step's points land
+ * close to them.
+ */
+void PhysicsSystem::cacheImpulses()
+{
+    nextContactCache_.resize(constraints_.size());
+    for (std::size_t k = 0; k < constraints_.size(); ++k)
+    {
+        const ContactConstraint &constraint = constraints_[k];
+        CachedContact &entry = nextContactCache_[k];
+        entry.key = cacheKey(constraint.bodyA, constraint.bodyB);
+        entry.bodyA = handles_[constraint.bodyA];
+        entry.bodyB = handles_[constraint.bodyB];
+        entry.pointCount = constraint.pointCount;
+        const Vector3D &center = solverBodies_[constraint.bodyA].position;
+        for (std::uint32_t i = 0; i < constraint.pointCount; ++i)
+        {
+            entry.positions[i] = center + constraint.points[i].rA;
+            entry.impulses[i] = constraint.points[i].impulse;
+        }
+    }
+    std::sort(nextContactCache_.begin(), nextContactCache_.end(),
+              [](const CachedContact &x, const CachedContact &y)
+              { return x.key < y.key; });
+    contactCache_.swap(nextContactCache_);
+}
+
+/**
+ * @brief Forget the impulses and island wakes carried over from the last update.
+ *
+ * Cache entries are matched by entity handle, which a restored snapshot
+ * keeps, so stale impulses would otherwise warm start the restored contacts.
+ */
+void PhysicsSystem::resetContacts()
+{
+    contactCache_.clear();
+    nextContactCache_.clear();
+    wakeIslands_.clear();
 }
 
+/**
+ * @brief Key of a pair of gathered colliders in the impulse cache.
+ *
+ * Gather indices change from step to step, so the key uses the entities'
+ * slot indices; the cached handles tell a recycled slot apart.
+ *
+ * @param bodyA Lower gather index
+ * @param bodyB Higher gather index
+ * @return Slot of A in the high 32 bits, slot of B in the low 32 bits
+ */
+std::uint64_t PhysicsSystem::cacheKey(std::uint32_t bodyA, std::uint32_t bodyB) const
+{
+    return (static_cast<std::uint64_t>(handles_[bodyA].index) << 32) | handles_[bodyB].index;
+}
+
+/**
+ * @brief Copy the gathered components of bodies [first, last) into the integrator.
+ *
+ * The drag factor is left as Cd * A; sampleEnvironment() scales it by the
+ * local dynamic pressure factor.
+ *
+ * @param first First body
+ * @param last One past the last body
+ */
+void PhysicsSystem::loadBodies(std::size_t first, std::size_t last)
+{
+    RigidBodyIntegrator &b = bodies_;
+    for (std::size_t i = first; i < last; ++i)
+    {
+        const TransformC &transform = *transforms_[i];
+        const PhysicsC &physics = *physics_[i];
+        const Vector3D inertia = principalInertia(physics);
 
+        b.px[i] = transform.position.x;
+        b.py[i] = transform.position.y;
+        b.pz[i] = transform.position.z;
+        b.qw[i] = transform.rotation.w;
+        b.qx[i] = transform.rotation.x;
+        b.qy[i] = transform.rotation.y;
+        b.qz[i] = transform.rotation.z;
+        b.vx[i] = physics.velocity.x;
+        b.vy[i] = physics.velocity.y;
+        b.vz[i] = physics.velocity.z;
+        b.wx[i] = physics.angularVelocity.x;
+        b.wy[i] = physics.angularVelocity.y;
+        b.wz[i] = physics.angularVelocity.z;
+        b.invMass[i] = 1.0f / physics.mass;
+        b.inertiaX[i] = inertia.x;
+        b.inertiaY[i] = inertia.y;
+        b.inertiaZ[i] = inertia.z;
+        b.invInertiaX[i] = inverse(inertia.x);
+        b.invInertiaY[i] = inverse(inertia.y);
+        b.invInertiaZ[i] = inverse(inertia.z);
+        b.fx[i] = physics.force.x;
+        b.fy[i] = physics.force.y;
+        b.fz[i] = physics.force.z;
+        b.tx[i] = physics.torque.x;
+        b.ty[i] = physics.torque.y;
+        b.tz[i] = physics.torque.z;
+        b.gravityScale[i] = physics.useGravity ? 1.0f : 0.0f;
+        b.dragFactor[i] = physics.dragCoefficient * referenceArea(physics);
+    }
+}
+
+/**
+ * @brief Sample air density and wind at bodies [first, last).
+ *
+ * Both come from batched calls over the range, the density in blocks on
+ * the stack so chunks on different workers share no scratch memory.
+ *
+ * @param first First body
+ * @param last One past the last body
+ */
+void PhysicsSystem::sampleEnvironment(std::size_t first, std::size_t last)
+{
+    RigidBodyIntegrator &b = bodies_;
+    windModel_.getWindBatch(b.px.data() + first, b.py.data() + first, b.pz.data() + first, b.windX.data() + first,
+                            b.windY.data() + first, b.windZ.data() + first, last - first);
+
+    constexpr std::size_t Block = 64;
+    float density[Block];
+    for (std::size_t begin = first; begin < last; begin += Block)
+    {
+        const std::size_t count = std::min(Block, last - begin);
+        airDensityModel_.getDensityBatch(b.py.data() + begin, density, count);
+        for (std::size_t k = 0; k < count; ++k)
+        {
+            float &dragFactor = b.dragFactor[begin + k];
+            dragFactor = dragFactor > 0.0f ? dragFactor * 0.5f * density[k] : 0.0f;
+        }
+    }
+}
+
+/**
+ * @brief Write the integrated state of bodies [first, last) back and clear their accumulators.
+ *
+ * @param first First body
+ * @param last One past the last body
+ */
+void PhysicsSystem::storeBodies(std::size_t first, std::size_t last)
+{
+    const RigidBodyIntegrator &b = bodies_;
+    for (std::size_t i = first; i < last; ++i)
+    {
+        TransformC &transform = *transforms_[i];
+        PhysicsC &physics = *physics_[i];
+        transform.position = Vector3D(b.px[i], b.py[i], b.pz[i]);
+        transform.rotation = Quaternion(b.qw[i], b.qx[i], b.qy[i], b.qz[i]);
+        physics.velocity = Vector3D(b.vx[i], b.vy[i], b.vz[i]);
+        physics.angularVelocity = Vector3D(b.wx[i], b.wy[i], b.wz[i]);
+        physics.force = Vector3D();
+        physics.torque = Vector3D();
+    }
+}
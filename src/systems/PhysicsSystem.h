@@ -3,22 +3,182 @@
 
 #include "core/ISystem.h"
 #include "core/EventBus.h"
+#include "core/EntityHandle.h"
 #include "physics/IAirDensityModel.h"
 #include "physics/IWindModel.h"
-#include "physics/ICollisionResolver.h"
+#include "physics/RigidBodyIntegrator.h"
+#include "physics/SweepAndPrune.h"
+#include "physics/Narrowphase.h"
+#include "physics/ContactSolver.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
 
+struct TransformC;
+struct PhysicsC;
+
+/**
+ * @brief Steps every dynamic rigid body of the World and resolves its contacts.
+ *
+ * Each update gathers the entities with a TransformC and a PhysicsC, the
+ * awake dynamic bodies (non-kinematic, positive mass) into the
+ * structure-of-arrays buffers of a RigidBodyIntegrator, and then:
+ *
+ * 1. samples air density and wind and integrates gravity, drag and the
+ *    forces and torques accumulated in PhysicsC into the velocities;
+ * 2. places every collider and finds contacts with a sweep-and-prune
+ *    broadphase and the narrowphase;
+ * 3. splits the awake bodies into islands connected by contacts and solves
+ *    each island's contacts with warm-started sequential impulses, islands
+ *    in parallel;
+ * 4. integrates positions and orientations and writes the bodies back.
+ *
+ * An island whose bodies have all stayed nearly still for TimeToSleep falls
+ * asleep: its bodies keep their place, are skipped by integration and
+ * solving, and pairs among sleeping and static colliders are not tested at
+ * all. A sleeping island wakes as a whole when an awake or moving kinematic
+ * body touches it, or when a force, torque or velocity is set on one of its
+ * bodies. Clear PhysicsC::isSleeping to wake a body for any other reason,
+ * e.g. after teleporting it or removing what it rests on. +Y is up.
+ */
 class PhysicsSystem : public ISystem
 {
 public:
-    PhysicsSystem(EventBus &eventBus, IAirDensityModel &airDensityModel, IWindModel &windModel, ICollisionResolver &collisionResolver);
+    /**
+     * @brief Construct the system.
+     *
+     * @param eventBus Event bus for simulation events
+     * @param airDensityModel Air density by altitude, for drag
+     * @param windModel Wind velocity by position, for drag
+     * @param gravity Gravitational acceleration in m/s^2
+     */
+    PhysicsSystem(EventBus &eventBus, IAirDensityModel &airDensityModel, IWindModel &windModel,
+                  float gravity = 9.81f);
     void update(World &world, float dt) override;
+    const char *getName() const override { return "PhysicsSystem"; }
+    SystemAccess getAccess() const override;
+
+    /**
+     * @brief Get the number of bodies stepped by the last update.
+     *
+     * @return Awake dynamic body count
+     */
+    std::size_t getBodyCount() const { return dynamicCount_; }
+
+    /**
+     * @brief Get the contacts found by the last update.
+     *
+     * bodyA and bodyB index the colliders gathered by that update: awake
+     * dynamic bodies first (in integrator order), then moving kinematic
+     * bodies, then sleeping and static colliders.
+     *
+     * @return One manifold per touching pair, ordered by body indices
+     */
+    const std::vector<ContactManifold> &getContacts() const { return contacts_; }
+
+    /**
+     * @brief Get the number of islands solved by the last update.
+     *
+     * @return Island count, including awake bodies without contacts
+     */
+    std::size_t getIslandCount() const { return islandBodyStart_.empty() ? 0 : islandBodyStart_.size() - 1; }
+
+    /**
+     * @brief Get the number of dynamic bodies that were asleep during the last update.
+     *
+     * @return Sleeping body count
+     */
+    std::size_t getSleepingCount() const { return sleepingCount_; }
+
+    /**
+     * @brief Forget the impulses and island wakes carried over from the last update.
+     *
+     * Call whenever the world's state is replaced rather than stepped, e.g.
+     * after a rewind or before a replay starts, so the next update neither
+     * warm starts from nor wakes islands of a state that no longer exists.
+     */
+    void resetContacts();
+
+    /** @brief Separation below which colliders are reported as in contact (m) */
+    static constexpr float ContactMargin = 0.01f;
+
+    /** @brief Speed below which a body counts as resting (m/s) */
+    static constexpr float LinearSleepTolerance = 0.05f;
+
+    /** @brief Angular speed below which a body counts as resting (rad/s) */
+    static constexpr float AngularSleepTolerance = 0.05f;
+
+    /** @brief Time every body of an island must rest before the island sleeps (s) */
+    static constexpr float TimeToSleep = 0.5f;
 
 private:
+    /**
+     * @brief Impulses of one manifold, kept for warm starting the next step.
+     */
+    struct CachedContact
+    {
+        std::uint64_t key;                                /**< Slot indices of both entities */
+        EntityHandle bodyA;                               /**< First entity */
+        EntityHandle bodyB;                               /**< Second entity */
+        std::uint32_t pointCount;                         /**< Valid entries below */
+        Vector3D positions[MaxContactPoints];             /**< Point positions in world space */
+        ContactImpulse impulses[MaxContactPoints];        /**< Accumulated impulses per point */
+    };
+
+    /**
+     * @brief A collider found by the gather, before it is placed in its range.
+     */
+    struct GatheredBody
+    {
+        TransformC *transform; /**< Its TransformC */
+        PhysicsC *physics;     /**< Its PhysicsC */
+        EntityHandle handle;   /**< Its entity */
+    };
+
+    void gatherBodies(World &world);
+    void appendBody(const GatheredBody &body);
+    void loadBodies(std::size_t first, std::size_t last);
+    void sampleEnvironment(std::size_t first, std::size_t last);
+    void storeBodies(std::size_t first, std::size_t last);
+    void detectContacts();
+    void buildIslands();
+    void prepareConstraints(float dt);
+    void solveIslands(float dt);
+    void cacheImpulses();
+    std::uint64_t cacheKey(std::uint32_t bodyA, std::uint32_t bodyB) const;
+
     EventBus &eventBus_;
     IAirDensityModel &airDensityModel_;
     IWindModel &windModel_;
-    ICollisionResolver &collisionResolver_;
+    float gravity_;                                 /**< Gravitational acceleration in m/s^2 */
+    RigidBodyIntegrator bodies_;                    /**< Packed state of the bodies being stepped */
+    ContactSolver solver_;                          /**< Sequential impulse contact solver */
+    std::vector<TransformC *> transforms_;          /**< Per collider: TransformC gathered this update, dynamic first */
+    std::vector<PhysicsC *> physics_;               /**< Per collider: PhysicsC gathered this update, dynamic first */
+    std::vector<EntityHandle> handles_;             /**< Per collider: entity gathered this update */
+    std::vector<GatheredBody> moving_;              /**< Scratch: moving kinematic bodies */
+    std::vector<GatheredBody> resting_;             /**< Scratch: sleeping and static colliders */
+    std::vector<GatheredBody> sleepers_;            /**< Scratch: bodies that were asleep at the gather */
+    std::vector<std::uint64_t> wakeIslands_;        /**< Sleeping islands to wake at the next gather */
+    std::size_t dynamicCount_ = 0;                  /**< Number of leading colliders that are integrated */
+    std::size_t activeCount_ = 0;                   /**< Dynamic plus moving kinematic colliders */
+    std::size_t sleepingCount_ = 0;                 /**< Sleeping dynamic bodies in the last update */
+    std::vector<CollisionShape> shapes_;            /**< Per collider: placed shape */
+    std::vector<Aabb> bounds_;                      /**< Per collider: bounding box including ContactMargin */
+    SweepAndPrune broadphase_;                      /**< Pair finder, keeps its sort order between updates */
+    std::vector<BroadphasePair> pairs_;             /**< Overlapping pairs of the last update */
+    std::vector<ContactManifold> manifolds_;        /**< Per pair: narrowphase result, empty if not touching */
+    std::vector<ContactManifold> contacts_;         /**< Touching pairs of the last update */
+    std::vector<SolverBody> solverBodies_;          /**< Per collider: velocity state for the solver */
+    std::vector<std::uint32_t> islandParent_;       /**< Per dynamic body: union-find parent, the lowest index of the set at the root */
+    std::vector<std::uint32_t> islandOf_;           /**< Per dynamic body: island index */
+    std::vector<std::uint32_t> islandBodyStart_;    /**< Per island: first entry in islandBodies_, plus an end marker */
+    std::vector<std::uint32_t> islandBodies_;       /**< Dynamic bodies grouped by island */
+    std::vector<std::uint32_t> islandContactStart_; /**< Per island: first entry in constraints_, plus an end marker */
+    std::vector<std::uint32_t> islandContacts_;     /**< Indices into contacts_, grouped by island */
+    std::vector<ContactConstraint> constraints_;    /**< Prepared constraints, parallel to islandContacts_ */
+    std::vector<CachedContact> contactCache_;       /**< Impulses of the previous step, sorted by key */
+    std::vector<CachedContact> nextContactCache_;   /**< Scratch: impulses of this step */
 };
 
 #endif
-
@@ -0,0 +1,178 @@
+#include "SpatialIndexSystem.h"
+#include "TransformSystem.h"
+#include "core/World.h"
+#include "core/JobSystem.h"
+#include "core/Profiler.h"
+#include "core/Metrics.h"
+#include "components/TransformC.h"
+#include "components/PhysicsC.h"
+#include <cmath>
+
+namespace
+{
+    /** Half extents given to entities without a PhysicsC: a unit box */
+    const Vector3D DefaultHalfExtents(0.5f, 0.5f, 0.5f);
+
+    Vector3D halfExtentsOf(Entity &entity)
+    {
+        const PhysicsC *physics = entity.getComponent<PhysicsC>();
+        if (physics == nullptr)
+        {
+            return DefaultHalfExtents;
+        }
+        return Vector3D(0.5f * physics->colliderSize[0], 0.5f * physics->colliderSize[1],
+                        0.5f * physics->colliderSize[2]);
+    }
+}
+
+SpatialIndexSystem::SpatialIndexSystem(World &world, float margin) : world_(world), index_(margin) {}
+
+/**
+ * @brief Refit the index to the current transforms.
+ *
+ * Runs with exclusive access (the default SystemAccess) because it reads the
+ * TransformSystem's cached world matrices, which are not a component; the
+ * bounds themselves are computed with parallelFor.
+ *
+ * @param world World containing the entities (the one given to the constructor)
+ * @param dt Unused
+ */
+void SpatialIndexSystem::update(World &world, float dt)
+{
+    PROFILE_SCOPE("SpatialIndexSystem::update");
+    static Gauge &proxyGauge = MetricsRegistry::instance().gauge("spatial.proxies");
+    static Counter &reinserts = MetricsRegistry::instance().counter("spatial.reinserts");
+
+    ComponentStorage &storage = world.getComponentStorage();
+    if (!synchronized_ || storage.getTypeVersion(componentTypeId<TransformC>()) != transformVersion_ ||
+        storage.getTypeVersion(componentTypeId<PhysicsC>()) != physicsVersion_)
+    {
+        synchronize();
+    }
+
+    const TransformSystem *transforms = world.getSystem<TransformSystem>();
+    parallelFor(0, proxies_.size(), 256, [this, transforms](std::size_t first, std::size_t last)
+                {
+        for (std::size_t i = first; i < last; ++i)
+        {
+            Proxy &proxy = proxies_[i];
+            proxy.bounds = computeBounds(proxy, transforms);
+            proxy.moved = proxy.id == SpatialIndex::InvalidProxy || !index_.setBounds(proxy.id, proxy.bounds);
+        } });
+
+    // Tree edits stay serial and in proxy order so the tree shape is reproducible
+    reinsertedCount_ = 0;
+    for (Proxy &proxy : proxies_)
+    {
+        if (!proxy.moved)
+        {
+            continue;
+        }
+        if (proxy.id == SpatialIndex::InvalidProxy)
+        {
+            proxy.id = index_.createProxy(proxy.bounds, proxy.handle);
+        }
+        else if (index_.moveProxy(proxy.id, proxy.bounds))
+        {
+            ++reinsertedCount_;
+        }
+    }
+
+    proxyGauge.set(static_cast<double>(index_.getProxyCount()));
+    reinserts.add(reinsertedCount_);
+}
+
+/**
+ * @brief Match the proxies to the entities that currently have a TransformC.
+ *
+ * New entities get a proxy slot whose tree proxy is created by the update's
+ * serial pass; proxies of entities that are gone (or lost their TransformC)
+ * are destroyed.
+ */
+void SpatialIndexSystem::synchronize()
+{
+    PROFILE_SCOPE("SpatialIndexSystem::synchronize");
+    ComponentStorage &storage = world_.getComponentStorage();
+    transformVersion_ = storage.getTypeVersion(componentTypeId<TransformC>());
+    physicsVersion_ = storage.getTypeVersion(componentTypeId<PhysicsC>());
+    synchronized_ = true;
+    ++pass_;
+
+    world_.view<TransformC>().each([this](Entity &entity, TransformC &)
+                                   {
+        const EntityHandle handle = entity.getHandle();
+        if (handle.index >= proxyBySlot_.size())
+        {
+            proxyBySlot_.resize(handle.index + 1, InvalidSlot);
+        }
+        std::uint32_t &slot = proxyBySlot_[handle.index];
+        if (slot != InvalidSlot && proxies_[slot].handle == handle)
+        {
+            Proxy &proxy = proxies_[slot];
+            proxy.entity = &entity;
+            proxy.seen = pass_;
+            return;
+        }
+        slot = static_cast<std::uint32_t>(proxies_.size());
+        proxies_.push_back(Proxy{&entity, handle, SpatialIndex::InvalidProxy, Aabb(), true, pass_}); });
+
+    for (std::size_t i = 0; i < proxies_.size();)
+    {
+        Proxy &proxy = proxies_[i];
+        if (proxy.seen == pass_)
+        {
+            ++i;
+            continue;
+        }
+        if (proxy.id != SpatialIndex::InvalidProxy)
+        {
+            index_.destroyProxy(proxy.id);
+        }
+        // A new entity may already have taken over the slot
+        if (proxyBySlot_[proxy.handle.index] == i)
+        {
+            proxyBySlot_[proxy.handle.index] = InvalidSlot;
+        }
+        if (i + 1 != proxies_.size())
+        {
+            proxy = proxies_.back();
+            proxyBySlot_[proxy.handle.index] = static_cast<std::uint32_t>(i);
+        }
+        proxies_.pop_back();
+    }
+}
+
+/**
+ * @brief Compute a proxy's world-space bounds.
+ *
+ * The local box is read from the entity's PhysicsC on every call, so a
+ * collider resized in place takes effect at the next update. It is carried
+ * through the world matrix: the center is the
+ * matrix translation and each world extent is the sum of the absolute
+ * rotated-and-scaled local half extents along that axis. Entities the
+ * TransformSystem has not seen yet use their own TransformC as world space.
+ *
+ * @param proxy Proxy to bound
+ * @param transforms TransformSystem providing world matrices, or nullptr
+ * @return Aabb World-space bounds
+ */
+Aabb SpatialIndexSystem::computeBounds(const Proxy &proxy, const TransformSystem *transforms) const
+{
+    const Matrix4 *matrix = transforms != nullptr ? transforms->getWorldMatrix(proxy.handle) : nullptr;
+    Matrix4 fallback;
+    if (matrix == nullptr)
+    {
+        const TransformC &transform = *proxy.entity->getComponent<TransformC>();
+        fallback = Matrix4::fromTransform(transform.position, transform.rotation, transform.scale);
+        matrix = &fallback;
+    }
+
+    const float *m = matrix->m;
+    const Vector3D h = halfExtentsOf(*proxy.entity);
+    const Vector3D center = matrix->getTranslation();
+    const Vector3D extent(std::fabs(m[0]) * h.x + std::fabs(m[4]) * h.y + std::fabs(m[8]) * h.z,
+                          std::fabs(m[1]) * h.x + std::fabs(m[5]) * h.y + std::fabs(m[9]) * h.z,
+                          std::fabs(m[2]) * h.x + std::fabs(m[6]) * h.y + std::fabs(m[10]) * h.z);
+    return Aabb{Vector3D(center.x - extent.x, center.y - extent.y, center.z - extent.z),
+                Vector3D(center.x + extent.x, center.y + extent.y, center.z + extent.z)};
+}
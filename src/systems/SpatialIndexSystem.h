@@ -0,0 +1,97 @@
+#ifndef SPATIALINDEXSYSTEM_H
+#define SPATIALINDEXSYSTEM_H
+
+#include "core/ISystem.h"
+#include "core/SpatialIndex.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class World;
+class Entity;
+class TransformSystem;
+
+/**
+ * @brief Keeps a SpatialIndex in step with the World's transforms.
+ *
+ * Every entity with a TransformC gets a proxy whose bounds are its local box
+ * (sized by PhysicsC::colliderSize, or a unit box without a PhysicsC)
+ * carried into world space by the TransformSystem's cached world matrix.
+ *
+ * Each update recomputes all bounds in parallel, reading the collider size
+ * afresh so resized colliders are picked up, and records those that still
+ * fit their proxy's fat box in the same pass; only proxies that left it are
+ * reinserted, serially and in a fixed order so the tree is deterministic.
+ * Proxies are created and destroyed when the set of entities with a
+ * TransformC or PhysicsC changes.
+ *
+ * Engine publishes the index in the World's service registry, so frustum
+ * culling, the physics broadphase, LOD selection and sensors can query it
+ * through world.getServices().get<SpatialIndex>().
+ */
+class SpatialIndexSystem : public ISystem
+{
+public:
+    /**
+     * @brief Construct the system.
+     *
+     * @param world World whose entities are indexed
+     * @param margin Fat box margin passed to the SpatialIndex
+     */
+    explicit SpatialIndexSystem(World &world, float margin = SpatialIndex::DefaultMargin);
+
+    void update(World &world, float dt) override;
+    const char *getName() const override { return "SpatialIndexSystem"; }
+
+    /**
+     * @brief Get the index as of the last update.
+     *
+     * @return The spatial index
+     */
+    SpatialIndex &getIndex() { return index_; }
+
+    /**
+     * @brief Get the index as of the last update.
+     *
+     * @return The spatial index
+     */
+    const SpatialIndex &getIndex() const { return index_; }
+
+    /**
+     * @brief Get the number of proxies reinserted by the last update.
+     *
+     * @return Proxies that left their fat box
+     */
+    std::size_t getReinsertedCount() const { return reinsertedCount_; }
+
+private:
+    /**
+     * @brief One indexed entity.
+     */
+    struct Proxy
+    {
+        Entity *entity;                /**< Entity (stable address while it lives) */
+        EntityHandle handle;           /**< Handle of entity */
+        SpatialIndex::ProxyId id;      /**< Proxy in index_ */
+        Aabb bounds;                   /**< World bounds computed this update */
+        bool moved;                    /**< Whether bounds left the fat box this update */
+        std::uint32_t seen;            /**< Synchronization pass that last found the entity */
+    };
+
+    static constexpr std::uint32_t InvalidSlot = 0xFFFFFFFFu;
+
+    void synchronize();
+    Aabb computeBounds(const Proxy &proxy, const TransformSystem *transforms) const;
+
+    World &world_;                              /**< World holding the entities */
+    SpatialIndex index_;                        /**< The index being maintained */
+    std::vector<Proxy> proxies_;                /**< Indexed entities */
+    std::vector<std::uint32_t> proxyBySlot_;    /**< Entity slot index -> position in proxies_ */
+    std::uint64_t transformVersion_ = 0;        /**< TransformC membership version at the last synchronization */
+    std::uint64_t physicsVersion_ = 0;          /**< PhysicsC membership version at the last synchronization */
+    std::uint32_t pass_ = 0;                    /**< Synchronization pass counter */
+    bool synchronized_ = false;                 /**< Whether synchronize() has run at least once */
+    std::size_t reinsertedCount_ = 0;           /**< Proxies reinserted by the last update */
+};
+
+#endif
@@ -0,0 +1,341 @@
+#include "TransformSystem.h"
+#include "core/World.h"
+#include "core/Profiler.h"
+#include "core/Metrics.h"
+#include "components/TransformC.h"
+#include "components/HierarchyC.h"
+#include <algorithm>
+#include <iostream>
+#include <limits>
+
+namespace
+{
+    bool sameLocal(const Vector3D &a, const Vector3D &b)
+    {
+        return a.x == b.x && a.y == b.y && a.z == b.z;
+    }
+
+    bool sameLocal(const Quaternion &a, const Quaternion &b)
+    {
+        return a.w == b.w && a.x == b.x && a.y == b.y && a.z == b.z;
+    }
+}
+
+TransformSystem::TransformSystem(World &world) : world_(world) {}
+
+SystemAccess TransformSystem::getAccess() const
+{
+    return SystemAccess().read<TransformC>().read<HierarchyC>();
+}
+
+/**
+ * @brief Recompute the world matrices of every node that changed.
+ *
+ * Levels are processed in depth order. For each level a first pass finds
+ * the dirty nodes and rebuilds their local matrices; a second pass runs the
+ * level's local * parentWorld multiplies back to back.
+ *
+ * @param world World containing the entities (the one given to the constructor)
+ * @param dt Unused
+ */
+void TransformSystem::update(World &world, float dt)
+{
+    PROFILE_SCOPE("TransformSystem::update");
+    static Counter &worldUpdates = MetricsRegistry::instance().counter("transform.world_updates");
+
+    ComponentStorage &storage = world.getComponentStorage();
+    if (structureDirty_ || storage.getTypeVersion(componentTypeId<TransformC>()) != transformVersion_ ||
+        storage.getTypeVersion(componentTypeId<HierarchyC>()) != hierarchyVersion_ || linksChanged())
+    {
+        rebuild();
+    }
+
+    updatedCount_ = 0;
+    for (std::size_t level = 0; level + 1 < levelStart_.size(); ++level)
+    {
+        batch_.clear();
+        for (std::uint32_t i = levelStart_[level]; i < levelStart_[level + 1]; ++i)
+        {
+            const TransformC &transform = *nodes_[i].entity->getComponent<TransformC>();
+            LocalTransform &local = locals_[i];
+            bool dirty = false;
+            if (!sameLocal(transform.position, local.position) || !sameLocal(transform.rotation, local.rotation) ||
+                !sameLocal(transform.scale, local.scale))
+            {
+                local.position = transform.position;
+                local.rotation = transform.rotation;
+                local.scale = transform.scale;
+                localMatrices_[i] = Matrix4::fromTransform(local.position, local.rotation, local.scale);
+                dirty = true;
+            }
+
+            const std::uint32_t parent = nodes_[i].parent;
+            if (dirty || (parent != InvalidNode && dirty_[parent]))
+            {
+                batch_.push_back(i);
+            }
+        }
+
+        // Mark after scanning the level: parents live in earlier levels, so their flags are final
+        for (std::uint32_t i = levelStart_[level]; i < levelStart_[level + 1]; ++i)
+        {
+            dirty_[i] = 0;
+        }
+        for (std::uint32_t i : batch_)
+        {
+            const std::uint32_t parent = nodes_[i].parent;
+            if (parent == InvalidNode)
+            {
+                worldMatrices_[i] = localMatrices_[i];
+            }
+            else
+            {
+                Matrix4::multiply(localMatrices_[i], worldMatrices_[parent], worldMatrices_[i]);
+            }
+            dirty_[i] = 1;
+        }
+        updatedCount_ += batch_.size();
+    }
+    worldUpdates.add(updatedCount_);
+}
+
+/**
+ * @brief Make one entity's transform relative to another.
+ *
+ * The parent chain is walked through the entities' HierarchyC components
+ * rather than the cached nodes, so links made since the last update are
+ * taken into account when checking for cycles.
+ *
+ * @param child Entity to re-parent (must have a TransformC)
+ * @param parent New parent (must have a TransformC), or an invalid handle to make child a root
+ * @return false if either entity is missing or the link would create a cycle
+ */
+bool TransformSystem::setParent(EntityHandle child, EntityHandle parent)
+{
+    Entity *childEntity = world_.getEntity(child);
+    if (childEntity == nullptr || !childEntity->hasComponent<TransformC>())
+    {
+        std::cerr << "TransformSystem: cannot parent an entity without a TransformC" << std::endl;
+        return false;
+    }
+
+    if (!parent.isValid())
+    {
+        if (childEntity->removeComponent<HierarchyC>())
+        {
+            structureDirty_ = true;
+        }
+        return true;
+    }
+
+    Entity *ancestor = world_.getEntity(parent);
+    if (ancestor == nullptr || !ancestor->hasComponent<TransformC>())
+    {
+        std::cerr << "TransformSystem: parent entity does not exist or has no TransformC" << std::endl;
+        return false;
+    }
+    for (std::size_t steps = 0; ancestor != nullptr && steps <= world_.getEntities().size(); ++steps)
+    {
+        if (ancestor->getHandle() == child)
+        {
+            std::cerr << "TransformSystem: parenting entity " << childEntity->getId() << " would create a cycle" << std::endl;
+            return false;
+        }
+        const HierarchyC *link = ancestor->getComponent<HierarchyC>();
+        ancestor = link != nullptr ? world_.getEntity(link->parent) : nullptr;
+    }
+
+    if (HierarchyC *link = childEntity->getComponent<HierarchyC>())
+    {
+        link->parent = parent;
+    }
+    else
+    {
+        childEntity->addComponent(std::make_unique<HierarchyC>(parent));
+    }
+    structureDirty_ = true;
+    return true;
+}
+
+/**
+ * @brief Get the parent of an entity.
+ *
+ * @param child Entity to query
+ * @return Parent handle, invalid for roots and unknown entities
+ */
+EntityHandle TransformSystem::getParent(EntityHandle child) const
+{
+    Entity *entity = world_.getEntity(child);
+    const HierarchyC *link = entity != nullptr ? entity->getComponent<HierarchyC>() : nullptr;
+    return link != nullptr ? link->parent : EntityHandle();
+}
+
+/**
+ * @brief Get an entity's world matrix as of the last update.
+ *
+ * @param entity Entity to query
+ * @return Pointer to the cached matrix, or nullptr if the entity was not part
+ *         of the hierarchy at the last update
+ */
+const Matrix4 *TransformSystem::getWorldMatrix(EntityHandle entity) const
+{
+    if (entity.index >= nodeBySlot_.size())
+    {
+        return nullptr;
+    }
+    const std::uint32_t node = nodeBySlot_[entity.index];
+    if (node == InvalidNode || nodes_[node].handle != entity)
+    {
+        return nullptr;
+    }
+    return &worldMatrices_[node];
+}
+
+/**
+ * @brief Rebuild the depth-sorted node arrays from the World.
+ *
+ * Parent links to entities that are gone or have no TransformC are ignored,
+ * making the child a root. A cycle (only possible by editing HierarchyC
+ * directly) is cut at the link that closes it. Every node is recomputed by
+ * the update that triggered the rebuild.
+ */
+void TransformSystem::rebuild()
+{
+    PROFILE_SCOPE("TransformSystem::rebuild");
+    ComponentStorage &storage = world_.getComponentStorage();
+    transformVersion_ = storage.getTypeVersion(componentTypeId<TransformC>());
+    hierarchyVersion_ = storage.getTypeVersion(componentTypeId<HierarchyC>());
+    structureDirty_ = false;
+
+    // Gather in archetype order, indexing the provisional positions by slot
+    std::vector<Entity *> entities;
+    entities.reserve(nodes_.size());
+    world_.view<TransformC>().each([&entities](Entity &entity, TransformC &)
+                                   { entities.push_back(&entity); });
+    const std::uint32_t count = static_cast<std::uint32_t>(entities.size());
+
+    std::uint32_t slotCount = 0;
+    for (Entity *entity : entities)
+    {
+        slotCount = std::max(slotCount, entity->getHandle().index + 1);
+    }
+    nodeBySlot_.assign(slotCount, InvalidNode);
+    for (std::uint32_t i = 0; i < count; ++i)
+    {
+        nodeBySlot_[entities[i]->getHandle().index] = i;
+    }
+
+    std::vector<EntityHandle> links(count);
+    std::vector<std::uint32_t> parents(count, InvalidNode);
+    for (std::uint32_t i = 0; i < count; ++i)
+    {
+        if (const HierarchyC *link = entities[i]->getComponent<HierarchyC>())
+        {
+            links[i] = link->parent;
+            const EntityHandle parent = link->parent;
+            if (parent.index < slotCount && nodeBySlot_[parent.index] != InvalidNode &&
+                entities[nodeBySlot_[parent.index]]->getHandle() == parent)
+            {
+                parents[i] = nodeBySlot_[parent.index];
+            }
+        }
+    }
+
+    // Depth of every node, walking each chain once
+    enum : std::uint8_t
+    {
+        Unvisited,
+        Visiting,
+        Done
+    };
+    std::vector<std::uint8_t> state(count, Unvisited);
+    std::vector<std::uint32_t> depths(count, 0);
+    std::vector<std::uint32_t> chain;
+    std::uint32_t maxDepth = 0;
+    for (std::uint32_t i = 0; i < count; ++i)
+    {
+        chain.clear();
+        for (std::uint32_t j = i; state[j] == Unvisited;)
+        {
+            state[j] = Visiting;
+            chain.push_back(j);
+            const std::uint32_t parent = parents[j];
+            if (parent == InvalidNode || state[parent] == Done)
+            {
+                break;
+            }
+            if (state[parent] == Visiting)
+            {
+                std::cerr << "TransformSystem: transform hierarchy contains a cycle, entity "
+                          << entities[j]->getId() << " treated as a root" << std::endl;
+                parents[j] = InvalidNode;
+                break;
+            }
+            j = parent;
+        }
+        while (!chain.empty())
+        {
+            const std::uint32_t j = chain.back();
+            chain.pop_back();
+            depths[j] = parents[j] == InvalidNode ? 0 : depths[parents[j]] + 1;
+            maxDepth = std::max(maxDepth, depths[j]);
+            state[j] = Done;
+        }
+    }
+
+    // Counting sort by depth; order within a level follows archetype order
+    levelStart_.assign(count > 0 ? maxDepth + 2 : 1, 0);
+    for (std::uint32_t i = 0; i < count; ++i)
+    {
+        ++levelStart_[depths[i] + 1];
+    }
+    for (std::size_t level = 1; level < levelStart_.size(); ++level)
+    {
+        levelStart_[level] += levelStart_[level - 1];
+    }
+    std::vector<std::uint32_t> sorted(count);
+    std::vector<std::uint32_t> next(levelStart_.begin(), levelStart_.end() - 1);
+    for (std::uint32_t i = 0; i < count; ++i)
+    {
+        sorted[i] = next[depths[i]]++;
+    }
+
+    nodes_.resize(count);
+    linkedNodes_.clear();
+    for (std::uint32_t i = 0; i < count; ++i)
+    {
+        const std::uint32_t node = sorted[i];
+        nodes_[node] = Node{entities[i], entities[i]->getHandle(), links[i],
+                            parents[i] == InvalidNode ? InvalidNode : sorted[parents[i]]};
+        nodeBySlot_[entities[i]->getHandle().index] = node;
+        if (links[i].isValid())
+        {
+            linkedNodes_.push_back(node);
+        }
+    }
+
+    // NaN never compares equal, so every node's local matrix is built on the next update
+    const float unset = std::numeric_limits<float>::quiet_NaN();
+    locals_.assign(count, LocalTransform{Vector3D(unset, unset, unset), Quaternion(), Vector3D()});
+    localMatrices_.assign(count, Matrix4());
+    worldMatrices_.assign(count, Matrix4());
+    dirty_.assign(count, 0);
+}
+
+/**
+ * @brief Check whether any parent link was edited in place since the last rebuild.
+ *
+ * @return true if a HierarchyC no longer matches its node
+ */
+bool TransformSystem::linksChanged() const
+{
+    for (std::uint32_t node : linkedNodes_)
+    {
+        const HierarchyC *link = nodes_[node].entity->getComponent<HierarchyC>();
+        if (link == nullptr || link->parent != nodes_[node].link)
+        {
+            return true;
+        }
+    }
+    return false;
+}
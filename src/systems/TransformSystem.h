@@ -0,0 +1,131 @@
+#ifndef TRANSFORMSYSTEM_H
+#define TRANSFORMSYSTEM_H
+
+#include "core/ISystem.h"
+#include "core/EntityHandle.h"
+#include "core/Matrix4.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class World;
+class Entity;
+
+/**
+ * @brief Resolves the transform hierarchy and caches world matrices.
+ *
+ * Every entity with a TransformC is a node; entities with a HierarchyC are
+ * children whose TransformC is relative to their parent. The system keeps
+ * the nodes in flat arrays sorted by depth, so each parent is processed
+ * before its children and no recursion or pointer chasing is needed.
+ *
+ * Each update compares every node's TransformC with the local transform it
+ * last saw. A node is dirty when its own transform changed or its parent's
+ * world matrix was recomputed this update; only dirty nodes are recomputed,
+ * one depth level at a time, as a batch of SIMD matrix multiplies. A static
+ * aircraft whose rotors spin recomputes the rotors and nothing else.
+ *
+ * The node arrays are rebuilt only when the set of entities with a
+ * TransformC or HierarchyC changes or a parent link is edited.
+ */
+class TransformSystem : public ISystem
+{
+public:
+    /**
+     * @brief Construct the system.
+     *
+     * @param world World whose entities form the hierarchy
+     */
+    explicit TransformSystem(World &world);
+
+    void update(World &world, float dt) override;
+    const char *getName() const override { return "TransformSystem"; }
+    SystemAccess getAccess() const override;
+
+    /**
+     * @brief Make one entity's transform relative to another.
+     *
+     * The child keeps its TransformC, which from now on is interpreted in
+     * the parent's space. Takes effect at the next update.
+     *
+     * @param child Entity to re-parent (must have a TransformC)
+     * @param parent New parent (must have a TransformC), or an invalid handle to make child a root
+     * @return false if either entity is missing or the link would create a cycle
+     */
+    bool setParent(EntityHandle child, EntityHandle parent);
+
+    /**
+     * @brief Get the parent of an entity.
+     *
+     * @param child Entity to query
+     * @return Parent handle, invalid for roots and unknown entities
+     */
+    EntityHandle getParent(EntityHandle child) const;
+
+    /**
+     * @brief Get an entity's world matrix as of the last update.
+     *
+     * @param entity Entity to query
+     * @return Pointer to the cached matrix (valid until the next update), or nullptr
+     *         if the entity was not part of the hierarchy at the last update
+     */
+    const Matrix4 *getWorldMatrix(EntityHandle entity) const;
+
+    /**
+     * @brief Get the number of nodes in the hierarchy.
+     *
+     * @return Entities with a TransformC at the last update
+     */
+    std::size_t getNodeCount() const { return nodes_.size(); }
+
+    /**
+     * @brief Get the number of world matrices recomputed by the last update.
+     *
+     * @return Dirty nodes in the last update
+     */
+    std::size_t getUpdatedCount() const { return updatedCount_; }
+
+private:
+    /**
+     * @brief One entity of the hierarchy.
+     */
+    struct Node
+    {
+        Entity *entity;           /**< Entity (stable address while it lives) */
+        EntityHandle handle;      /**< Handle of entity */
+        EntityHandle link;        /**< HierarchyC::parent as last seen, invalid without a HierarchyC */
+        std::uint32_t parent;     /**< Index of the parent node, InvalidNode for roots */
+    };
+
+    /**
+     * @brief Local transform a node's matrix was last built from.
+     */
+    struct LocalTransform
+    {
+        Vector3D position;   /**< TransformC::position */
+        Quaternion rotation; /**< TransformC::rotation */
+        Vector3D scale;      /**< TransformC::scale */
+    };
+
+    static constexpr std::uint32_t InvalidNode = 0xFFFFFFFFu;
+
+    void rebuild();
+    bool linksChanged() const;
+
+    World &world_;                              /**< World holding the entities */
+    std::vector<Node> nodes_;                   /**< Nodes sorted by depth */
+    std::vector<std::uint32_t> levelStart_;     /**< First node of each depth, plus nodes_.size() */
+    std::vector<std::uint32_t> linkedNodes_;    /**< Nodes that have a HierarchyC */
+    std::vector<std::uint32_t> nodeBySlot_;     /**< Entity slot index -> node index */
+    std::vector<LocalTransform> locals_;        /**< Per node: local transform last seen */
+    std::vector<Matrix4> localMatrices_;        /**< Per node: matrix of locals_ */
+    std::vector<Matrix4> worldMatrices_;        /**< Per node: cached world matrix */
+    std::vector<std::uint8_t> dirty_;           /**< Per node: recomputed in the current update */
+    std::vector<std::uint32_t> batch_;          /**< Dirty nodes of the level being processed */
+    std::uint64_t transformVersion_ = 0;        /**< TransformC membership version at the last rebuild */
+    std::uint64_t hierarchyVersion_ = 0;        /**< HierarchyC membership version at the last rebuild */
+    bool structureDirty_ = true;                /**< Whether the node arrays must be rebuilt */
+    std::size_t updatedCount_ = 0;              /**< World matrices recomputed by the last update */
+};
+
+#endif
@@ -1,8 +1,15 @@
 #include "VehicleControlSystem.h"
 #include "core/World.h"
+#include "components/VehicleC.h"
+#include "components/PhysicsC.h"
 
 VehicleControlSystem::VehicleControlSystem(EventBus &eventBus) : eventBus_(eventBus) {}
 
+SystemAccess VehicleControlSystem::getAccess() const
+{
+    return SystemAccess().read<VehicleC>().write<PhysicsC>();
+}
+
 void VehicleControlSystem::update(World &world, float dt)
 {
     // Stub: control vehicles
@@ -9,6 +9,8 @@ class VehicleControlSystem : public ISystem
 public:
     VehicleControlSystem(EventBus &eventBus);
     void update(World &world, float dt) override;
+    const char *getName() const override { return "VehicleControlSystem"; }
+    SystemAccess getAccess() const override;
 
 private:
     EventBus &eventBus_;
@@ -1,5 +1,6 @@
 #include "VisualizationSystem.h"
 #include "../core/AssetIds.h"
+#include "../core/Profiler.h"
 #include "../debug.h"
 #include <iostream>
 #include <string>
@@ -7,44 +8,14 @@
 #include <memory>
 #include <unordered_map>
 
-// Component definitions
-#include "core/IComponent.h"
+#include "../components/TransformC.h"
+#include "../components/RenderableC.h"
+#include "../components/PhysicsC.h"
+#include "../components/HierarchyC.h"
+#include "TransformSystem.h"
 
-struct TransformC : public IComponent
-{
-    struct Vector3
-    {
-        float x, y, z;
-        Vector3(float x = 0.0f, float y = 0.0f, float z = 0.0f) : x(x), y(y), z(z) {}
-    };
-
-    struct Quaternion
-    {
-        float x, y, z, w;
-        Quaternion(float x = 0.0f, float y = 0.0f, float z = 0.0f, float w = 1.0f) : x(x), y(y), z(z), w(w) {}
-        static Quaternion Identity() { return Quaternion(0, 0, 0, 1); }
-    };
-
-    Vector3 position;
-    Quaternion orientation;
-    Vector3 scale;
-
-    TransformC(Vector3 pos = Vector3(), Quaternion rot = Quaternion::Identity(), Vector3 scl = Vector3(1, 1, 1))
-        : position(pos), orientation(rot), scale(scl) {}
-};
-
-struct RenderableC : public IComponent
-{
-    std::string meshId;
-    std::string materialId;
-    bool isVisible;
-
-    RenderableC(std::string mesh = "", std::string material = "", bool visible = true)
-        : meshId(mesh), materialId(material), isVisible(visible) {}
-};
-
-VisualizationSystem::VisualizationSystem(EventBus &eventBus, World &world, HWND windowHandle, Material::MaterialManager &materialManager, const Render::RenderConfiguration &renderConfig)
-    : eventBus(eventBus), worldRef(world), hwnd(windowHandle), materialManager_(materialManager), renderConfig_(renderConfig),
+VisualizationSystem::VisualizationSystem(EventBus &eventBus, World &world, HWND windowHandle, Material::MaterialManager &materialManager, const Render::RenderConfiguration &renderConfig, const SimClock &simClock)
+    : eventBus(eventBus), worldRef(world), hwnd(windowHandle), materialManager_(materialManager), renderConfig_(renderConfig), simClock_(simClock),
       debugModeActive(false), displayNoPackagesMessage(false), consoleVisible(false), rotationAngle(0.0f)
 {
     DEBUG_LOG("Initializing VisualizationSystem with OpenGL rendering...");
@@ -88,20 +59,9 @@ VisualizationSystem::VisualizationSystem(EventBus &eventBus, World &world, HWND
     DEBUG_LOG("OpenGL-based VisualizationSystem initialized successfully");
 
     // Subscribe to events
-    eventBus.subscribe(EventType::NoPackagesFound, [this](const IEvent &event)
-                       {
-        const auto& packagesEvent = static_cast<const NoPackagesFoundEvent&>(event);
-        OnNoPackagesFound(packagesEvent); });
-
-    eventBus.subscribe(EventType::ConsoleVisibilityChanged, [this](const IEvent &event)
-                       {
-        const auto& visibilityEvent = static_cast<const ConsoleVisibilityChangedEvent&>(event);
-        OnConsoleVisibilityChanged(visibilityEvent); });
-
-    eventBus.subscribe(EventType::DebugModeToggled, [this](const IEvent &event)
-                       {
-        const auto& debugEvent = static_cast<const DebugModeToggled&>(event);
-        OnDebugModeToggled(debugEvent); });
+    eventBus.subscribe<NoPackagesFoundEvent, VisualizationSystem, &VisualizationSystem::OnNoPackagesFound>(this);
+    eventBus.subscribe<ConsoleVisibilityChangedEvent, VisualizationSystem, &VisualizationSystem::OnConsoleVisibilityChanged>(this);
+    eventBus.subscribe<DebugModeToggled, VisualizationSystem, &VisualizationSystem::OnDebugModeToggled>(this);
 }
 
 VisualizationSystem::~VisualizationSystem()
@@ -109,6 +69,12 @@ VisualizationSystem::~VisualizationSystem()
     // OpenGL context cleanup is handled by OpenGLContext destructor
 }
 
+SystemAccess VisualizationSystem::getAccess() const
+{
+    // Reads scene components only (PhysicsC to pick interpolated bodies), but owns the OpenGL context
+    return SystemAccess().read<TransformC>().read<RenderableC>().read<PhysicsC>().mainThread();
+}
+
 void VisualizationSystem::update(World &world, float deltaTime)
 {
     // Ensure OpenGL context is current
@@ -213,6 +179,7 @@ void VisualizationSystem::update(World &world, float deltaTime)
     }
 
     // End frame and swap buffers
+    PROFILE_SCOPE("VisualizationSystem::Present");
     glRenderer.EndFrame();
     glContext.SwapBuffers();
 
@@ -251,22 +218,17 @@ void VisualizationSystem::OnDebugModeToggled(const DebugModeToggled &event)
 
 void VisualizationSystem::RenderEntities()
 {
+    PROFILE_SCOPE("VisualizationSystem::RenderEntities");
+
+    // Only entities with both a transform and a renderable are visited
+    auto renderables = worldRef.view<TransformC, RenderableC>();
+
     // Debug information - print entity count
     static int frameCount = 0;
     if (frameCount++ % 60 == 0)
     { // Print more frequently for debugging
         DEBUG_LOG("VisualizationSystem: Rendering " + std::to_string(worldRef.getEntities().size()) + " entities");
-
-        // Count entities with required rendering components
-        int entitiesWithRenderComponents = 0;
-        for (const auto &entity : worldRef.getEntities())
-        {
-            if (entity->getComponent<TransformC>() && entity->getComponent<RenderableC>())
-            {
-                entitiesWithRenderComponents++;
-            }
-        }
-        DEBUG_LOG("Entities with rendering components: " + std::to_string(entitiesWithRenderComponents));
+        DEBUG_LOG("Entities with rendering components: " + std::to_string(renderables.size()));
 
         // Output camera position for debugging
         if (camera)
@@ -296,61 +258,51 @@ void VisualizationSystem::RenderEntities()
         return;
     }
 
-    // Render all entities using OpenGL 3D rendering
-    for (const auto &entity : worldRef.getEntities())
-    {
-        auto transform = entity->getComponent<TransformC>();
-        auto renderable = entity->getComponent<RenderableC>();
+    // Physics bodies are drawn between their last two fixed-step positions
+    const float alpha = simClock_.getAlpha();
 
-        // Debug output for missing components
-        if (!transform && frameCount % 300 == 0)
-        {
-            DEBUG_LOG("Entity " + std::to_string(entity->getId()) + " missing TransformC component");
-        }
-        if (!renderable && frameCount % 300 == 0)
-        {
-            DEBUG_LOG("Entity " + std::to_string(entity->getId()) + " missing RenderableC component");
-        }
-        if (renderable && !renderable->isVisible && frameCount % 300 == 0)
+    // Parts attached to a parent are drawn at their cached world position
+    const TransformSystem *transforms = worldRef.getSystem<TransformSystem>();
+
+    // Render all entities using OpenGL 3D rendering
+    renderables.each([this, alpha, transforms](Entity &entity, TransformC &transform, RenderableC &renderable)
+                     {
+        if (!renderable.isVisible)
         {
-            DEBUG_LOG("Entity " + std::to_string(entity->getId()) + " has invisible RenderableC");
+            if (frameCount % 300 == 0)
+            {
+                DEBUG_LOG("Entity " + std::to_string(entity.getId()) + " has invisible RenderableC");
+            }
+            return;
         }
 
-        if (transform && renderable && renderable->isVisible)
+        // Use 3D world coordinates directly
+        Vector3D position = entity.hasComponent<PhysicsC>() ? transform.interpolatedPosition(alpha) : transform.position;
+        if (transforms && entity.hasComponent<HierarchyC>())
         {
-            // Use 3D world coordinates directly
-            float x = transform->position.x;
-            float y = transform->position.y;
-            float z = transform->position.z;
-            float radius = 1.0f; // Default radius
-
-            // Load color dynamically from MaterialManager using XML-defined material properties
-            Color color = GetMaterialColor(renderable->materialId);
-
-            // Debug output for rendered entities (occasional)
-            if (frameCount % 600 == 0)
+            if (const Matrix4 *world = transforms->getWorldMatrix(entity.getHandle()))
             {
-                DEBUG_LOG("Rendering entity: " + entity->getName() +
-                          " at (" + std::to_string(x) + ", " + std::to_string(y) + ", " + std::to_string(z) + ")" +
-                          " with material: " + renderable->materialId);
+                position = world->getTranslation();
             }
-
-            // Draw 3D sphere at world position
-            DrawSphere(x, y, z, radius, color.r, color.g, color.b);
         }
-        else if (frameCount % 300 == 0)
+        float x = position.x;
+        float y = position.y;
+        float z = position.z;
+        float radius = 1.0f; // Default radius
+
+        // Load color dynamically from MaterialManager using XML-defined material properties
+        Color color = GetMaterialColor(renderable.materialId);
+
+        // Debug output for rendered entities (occasional)
+        if (frameCount % 600 == 0)
         {
-            // Debug for entities missing components
-            std::string missing = "Entity " + entity->getName() + " is missing ";
-            if (!transform)
-                missing += "transform ";
-            if (!renderable)
-                missing += "renderable ";
-            if (renderable && !renderable->isVisible)
-                missing += "(not visible) ";
-            DEBUG_LOG(missing);
+            DEBUG_LOG("Rendering entity: " + entity.getName() +
+                      " at (" + std::to_string(x) + ", " + std::to_string(y) + ", " + std::to_string(z) + ")" +
+                      " with material: " + renderable.materialId);
         }
-    }
+
+        // Draw 3D sphere at world position
+        DrawSphere(x, y, z, radius, color.r, color.g, color.b); });
 }
 
 void VisualizationSystem::RenderConsole()
@@ -533,6 +485,8 @@ void VisualizationSystem::DrawCube(float x, float y, float z, float size, float
  */
 VisualizationSystem::Color VisualizationSystem::GetMaterialColor(const std::string &materialId)
 {
+    PROFILE_SCOPE("VisualizationSystem::GetMaterialColor");
+
     // Try to get material from MaterialManager
     auto materialOpt = materialManager_.GetMaterial(materialId);
     if (materialOpt.has_value())
@@ -4,6 +4,7 @@
 #include "core/ISystem.h"
 #include "core/EventBus.h"
 #include "core/World.h"
+#include "core/SimClock.h"
 #include "events/InputEvents.h"
 #include "events/WorldGenEvents.h"
 #include "MaterialManager.h"
@@ -19,10 +20,12 @@
 class VisualizationSystem : public ISystem
 {
 public:
-    VisualizationSystem(EventBus &eventBus, World &world, HWND hwnd, Material::MaterialManager &materialManager, const Render::RenderConfiguration &renderConfig);
+    VisualizationSystem(EventBus &eventBus, World &world, HWND hwnd, Material::MaterialManager &materialManager, const Render::RenderConfiguration &renderConfig, const SimClock &simClock);
     ~VisualizationSystem();
 
     void update(World &world, float deltaTime) override;
+    const char *getName() const override { return "VisualizationSystem"; }
+    SystemAccess getAccess() const override;
 
 private:
     EventBus &eventBus;
@@ -30,6 +33,7 @@ private:
     HWND hwnd;
     Material::MaterialManager &materialManager_;
     const Render::RenderConfiguration &renderConfig_;
+    const SimClock &simClock_; // Interpolation alpha for blending physics states
 
     // OpenGL components
     OpenGLContext glContext;
@@ -9,30 +9,9 @@
 #include <fstream>
 #include "../debug.h"
 
-// Component definitions (using Math:: types)
-#include "../core/IComponent.h"
-
-struct TransformC : public IComponent
-{
-    Math::float3 position;
-    Math::float4 orientation; // Quaternion (x, y, z, w)
-    Math::float3 scale;
-
-    TransformC(Math::float3 pos = {0.0f, 0.0f, 0.0f},
-               Math::float4 rot = {0.0f, 0.0f, 0.0f, 1.0f},
-               Math::float3 scl = {1.0f, 1.0f, 1.0f})
-        : position(pos), orientation(rot), scale(scl) {}
-};
-
-struct RenderableC : public IComponent
-{
-    std::string meshId;
-    std::string materialId;
-    bool isVisible;
-
-    RenderableC(std::string mesh = "", std::string material = "", bool visible = true)
-        : meshId(mesh), materialId(material), isVisible(visible) {}
-};
+#include "../components/TransformC.h"
+#include "../components/HierarchyC.h"
+#include "../components/RenderableC.h"
 
 WorldGenSystem::WorldGenSystem(EventBus &eventBus, World &world, AssetRegistry &assetRegistry, Material::MaterialManager &materialManager)
     : eventBus(eventBus), worldRef(world), assetRegistry_(assetRegistry), materialManager_(materialManager), sceneLoaded(false)
@@ -50,16 +29,10 @@ WorldGenSystem::WorldGenSystem(EventBus &eventBus, World &world, AssetRegistry &
     materialManager_.SetTextureGenerator(textureGenerator_.get());
 
     // Subscribe to no packages found event
-    eventBus.subscribe(EventType::NoPackagesFound, [this](const IEvent &event)
-                       {
-        const auto& packagesEvent = static_cast<const NoPackagesFoundEvent&>(event);
-        OnNoPackagesFound(packagesEvent); });
+    eventBus.subscribe<NoPackagesFoundEvent, WorldGenSystem, &WorldGenSystem::OnNoPackagesFound>(this);
 
     // Subscribe to default world generated event (when we have XML configuration)
-    eventBus.subscribe(EventType::DefaultWorldGenerated, [this](const IEvent &event)
-                       {
-        const auto& worldEvent = static_cast<const DefaultWorldGeneratedEvent&>(event);
-        OnDefaultWorldRequested(worldEvent); });
+    eventBus.subscribe<DefaultWorldGeneratedEvent, WorldGenSystem, &WorldGenSystem::OnDefaultWorldRequested>(this);
 }
 
 WorldGenSystem::~WorldGenSystem() = default;
@@ -145,10 +118,8 @@ void WorldGenSystem::GenerateLoadingIndicatorWorld()
         DEBUG_LOG("Generating simplified loading indicator world...");
     }
 
-    static unsigned int nextEntityId = 1;
-
     // Create central globe entity using EntityFactory
-    auto globeEntity = entityFactory_->createFromTemplate("earth_sphere", "LoadingGlobe", nextEntityId++);
+    auto globeEntity = entityFactory_->createFromTemplate("earth_sphere", "LoadingGlobe");
     if (globeEntity)
     {
         worldRef.addEntity(std::move(globeEntity));
@@ -159,7 +130,7 @@ void WorldGenSystem::GenerateLoadingIndicatorWorld()
     }
 
     // Create first orbiting aircraft
-    auto aircraft1Entity = entityFactory_->createFromTemplate("basic_drone", "OrbitingAircraft1", nextEntityId++);
+    auto aircraft1Entity = entityFactory_->createFromTemplate("basic_drone", "OrbitingAircraft1");
     if (aircraft1Entity)
     {
         worldRef.addEntity(std::move(aircraft1Entity));
@@ -170,7 +141,7 @@ void WorldGenSystem::GenerateLoadingIndicatorWorld()
     }
 
     // Create second orbiting aircraft
-    auto aircraft2Entity = entityFactory_->createFromTemplate("basic_drone", "OrbitingAircraft2", nextEntityId++);
+    auto aircraft2Entity = entityFactory_->createFromTemplate("basic_drone", "OrbitingAircraft2");
     if (aircraft2Entity)
     {
         worldRef.addEntity(std::move(aircraft2Entity));
@@ -183,7 +154,7 @@ void WorldGenSystem::GenerateLoadingIndicatorWorld()
     // Create cloud entities
     for (int i = 0; i < 5; i++)
     {
-        auto cloudEntity = entityFactory_->createFromTemplate("cloud_object", "LoadingCloud" + std::to_string(i), nextEntityId++);
+        auto cloudEntity = entityFactory_->createFromTemplate("cloud_object", "LoadingCloud" + std::to_string(i));
         if (cloudEntity)
         {
             worldRef.addEntity(std::move(cloudEntity));
@@ -206,7 +177,6 @@ void WorldGenSystem::LoadSceneEntities(const SceneConfig::Scene &sceneData)
         DEBUG_LOG("Scene: " << sceneData.name << " (ID: " << sceneData.id << ")");
     }
 
-    static unsigned int nextEntityId = 1;
     int entitiesCreated = 0;
 
     // If scene has parsed entities, use them
@@ -217,39 +187,7 @@ void WorldGenSystem::LoadSceneEntities(const SceneConfig::Scene &sceneData)
             if (!entityPtr)
                 continue;
 
-            const auto &entityData = *entityPtr;
-
-            try
-            {
-                // Create ECS entity with transform component
-                auto entity = std::make_unique<Entity>(nextEntityId++);
-
-                // Add transform component
-                entity->addComponent(std::make_unique<TransformC>(
-                    Math::float3(entityData.transform.position.x,
-                                 entityData.transform.position.y,
-                                 entityData.transform.position.z),
-                    Math::float4(entityData.transform.rotation.x,
-                                 entityData.transform.rotation.y,
-                                 entityData.transform.rotation.z,
-                                 entityData.transform.rotation.w),
-                    Math::float3(entityData.transform.scale.x,
-                                 entityData.transform.scale.y,
-                                 entityData.transform.scale.z)));
-
-                // Add entity to world
-                worldRef.addEntity(std::move(entity));
-                entitiesCreated++;
-
-                if (Debug())
-                {
-                    DEBUG_LOG("Created entity: " << entityData.id << " (type: " << entityData.type << ")");
-                }
-            }
-            catch (const std::exception &e)
-            {
-                std::cerr << "Error creating entity " << entityData.id << ": " << e.what() << std::endl;
-            }
+            CreateSceneEntity(*entityPtr, EntityHandle(), entitiesCreated);
         }
     }
     else
@@ -267,11 +205,11 @@ void WorldGenSystem::LoadSceneEntities(const SceneConfig::Scene &sceneData)
         if (sceneData.id == "loading_indicator")
         {
             // Create loading indicator entities programmatically based on XML structure
-            CreateLoadingIndicatorEntitiesFromXmlStructure(nextEntityId, entitiesCreated);
+            CreateLoadingIndicatorEntitiesFromXmlStructure(entitiesCreated);
         }
         else if (sceneData.id == "default_sphere_world" || sceneData.id == "procedural_earth_like")
         {
-            CreateDefaultSphereEntitiesFromXmlStructure(nextEntityId, entitiesCreated);
+            CreateDefaultSphereEntitiesFromXmlStructure(entitiesCreated);
         }
         else
         {
@@ -288,6 +226,55 @@ void WorldGenSystem::LoadSceneEntities(const SceneConfig::Scene &sceneData)
     }
 }
 
+void WorldGenSystem::CreateSceneEntity(const SceneConfig::Entity &entityData, EntityHandle parent, int &entitiesCreated)
+{
+    EntityHandle handle;
+    try
+    {
+        // Create ECS entity with transform component
+        auto entity = std::make_unique<Entity>();
+
+        // Add transform component; for children it is relative to the parent
+        entity->addComponent(std::make_unique<TransformC>(
+            Vector3D(entityData.transform.position.x,
+                     entityData.transform.position.y,
+                     entityData.transform.position.z),
+            Quaternion(entityData.transform.rotation.w,
+                       entityData.transform.rotation.x,
+                       entityData.transform.rotation.y,
+                       entityData.transform.rotation.z),
+            Vector3D(entityData.transform.scale.x,
+                     entityData.transform.scale.y,
+                     entityData.transform.scale.z)));
+        if (parent.isValid())
+        {
+            entity->addComponent(std::make_unique<HierarchyC>(parent));
+        }
+
+        // Add entity to world
+        handle = worldRef.addEntity(std::move(entity));
+        entitiesCreated++;
+
+        if (Debug())
+        {
+            DEBUG_LOG("Created entity: " << entityData.id << " (type: " << entityData.type << ")");
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error creating entity " << entityData.id << ": " << e.what() << std::endl;
+        return;
+    }
+
+    for (const auto &child : entityData.children)
+    {
+        if (child)
+        {
+            CreateSceneEntity(*child, handle, entitiesCreated);
+        }
+    }
+}
+
 AssetId WorldGenSystem::GenerateVoxelMesh(const SceneConfig::CompoundMesh &meshConfig)
 {
     if (Debug())
@@ -396,10 +383,8 @@ void WorldGenSystem::GenerateDefaultSphereWorld()
         DEBUG_LOG("Generating default Earth-like sphere world...");
     }
 
-    static unsigned int nextEntityId = 1;
-
     // Create Earth entity using EntityFactory
-    auto earthEntity = entityFactory_->createFromTemplate("earth_sphere", "Earth", nextEntityId++);
+    auto earthEntity = entityFactory_->createFromTemplate("earth_sphere", "Earth");
     if (earthEntity)
     {
         // Override position and scale for Earth
@@ -420,7 +405,7 @@ void WorldGenSystem::GenerateDefaultSphereWorld()
     }
 
     // Create atmosphere entity using EntityFactory
-    auto atmosphereEntity = entityFactory_->createFromTemplate("earth_sphere", "Atmosphere", nextEntityId++);
+    auto atmosphereEntity = entityFactory_->createFromTemplate("earth_sphere", "Atmosphere");
     if (atmosphereEntity)
     {
         // Override settings for atmosphere
@@ -440,7 +425,7 @@ void WorldGenSystem::GenerateDefaultSphereWorld()
     }
 
     // Create cloud entity using EntityFactory
-    auto cloudEntity = entityFactory_->createFromTemplate("cloud_object", "GlobalClouds", nextEntityId++);
+    auto cloudEntity = entityFactory_->createFromTemplate("cloud_object", "GlobalClouds");
     if (cloudEntity)
     {
         // Override settings for global cloud layer
@@ -549,16 +534,16 @@ AssetId WorldGenSystem::GetCloudMaterialId()
     return MaterialIdToAssetId(materialId);
 }
 
-void WorldGenSystem::CreateLoadingIndicatorEntitiesFromXmlStructure(unsigned int &nextEntityId, int &entitiesCreated)
+void WorldGenSystem::CreateLoadingIndicatorEntitiesFromXmlStructure(int &entitiesCreated)
 {
     DEBUG_LOG("Creating loading indicator entities based on XML structure...");
 
     // Create central globe entity (from XML: central_globe)
-    auto globeEntity = std::make_unique<Entity>(nextEntityId++);
+    auto globeEntity = std::make_unique<Entity>();
     globeEntity->addComponent(std::make_unique<TransformC>(
-        Math::float3(0.0f, 0.0f, 0.0f),
-        Math::float4(0.0f, 0.0f, 0.0f, 1.0f),
-        Math::float3(2.0f, 2.0f, 2.0f))); // Scale from XML
+        Vector3D(0.0f, 0.0f, 0.0f),
+        Quaternion::identity(),
+        Vector3D(2.0f, 2.0f, 2.0f))); // Scale from XML
 
     std::string globeMaterialId = materialManager_.HasMaterial("LandMaterial") ? "LandMaterial" : materialManager_.CreateEarthMaterial(2.0f, 1);
     globeEntity->addComponent(std::make_unique<RenderableC>(
@@ -571,12 +556,12 @@ void WorldGenSystem::CreateLoadingIndicatorEntitiesFromXmlStructure(unsigned int
     // Create 2 aircraft entities (from XML: aircraft_1, aircraft_2)
     for (int i = 0; i < 2; ++i)
     {
-        auto aircraftEntity = std::make_unique<Entity>(nextEntityId++);
+        auto aircraftEntity = std::make_unique<Entity>();
         float xPos = (i == 0) ? 5.0f : -5.0f; // From XML positions
         aircraftEntity->addComponent(std::make_unique<TransformC>(
-            Math::float3(xPos, 0.0f, 0.0f),
-            Math::float4(0.0f, 0.0f, 0.0f, 1.0f),
-            Math::float3(0.5f, 0.5f, 0.5f))); // Scale from XML
+            Vector3D(xPos, 0.0f, 0.0f),
+            Quaternion::identity(),
+            Vector3D(0.5f, 0.5f, 0.5f))); // Scale from XML
 
         std::string aircraftMaterialId = materialManager_.HasMaterial("AircraftBodyMaterial") ? "AircraftBodyMaterial" : materialManager_.CreateContrailMaterial({0.8f, 0.2f, 0.2f});
         aircraftEntity->addComponent(std::make_unique<RenderableC>(
@@ -588,16 +573,16 @@ void WorldGenSystem::CreateLoadingIndicatorEntitiesFromXmlStructure(unsigned int
     }
 
     // Create 6 cloud entities (from XML: cloud_1 to cloud_6)
-    Math::float3 cloudPositions[] = {
+    Vector3D cloudPositions[] = {
         {3.0f, 2.0f, 1.0f}, {-3.0f, 2.0f, -1.0f}, {1.0f, -2.0f, 3.0f}, {-1.0f, -2.0f, -3.0f}, {2.0f, 0.0f, 4.0f}, {-2.0f, 0.0f, -4.0f}};
 
     for (int i = 0; i < 6; ++i)
     {
-        auto cloudEntity = std::make_unique<Entity>(nextEntityId++);
+        auto cloudEntity = std::make_unique<Entity>();
         cloudEntity->addComponent(std::make_unique<TransformC>(
             cloudPositions[i],
-            Math::float4(0.0f, 0.0f, 0.0f, 1.0f),
-            Math::float3(1.0f, 1.0f, 1.0f)));
+            Quaternion::identity(),
+            Vector3D(1.0f, 1.0f, 1.0f)));
 
         std::string cloudMaterialId = materialManager_.HasMaterial("CloudMaterial") ? "CloudMaterial" : materialManager_.CreateCloudMaterial(0.8f, 0.4f);
         cloudEntity->addComponent(std::make_unique<RenderableC>(
@@ -611,12 +596,12 @@ void WorldGenSystem::CreateLoadingIndicatorEntitiesFromXmlStructure(unsigned int
     DEBUG_LOG("Created " << entitiesCreated << " entities based on loading_indicator.xml structure");
 }
 
-void WorldGenSystem::CreateDefaultSphereEntitiesFromXmlStructure(unsigned int &nextEntityId, int &entitiesCreated)
+void WorldGenSystem::CreateDefaultSphereEntitiesFromXmlStructure(int &entitiesCreated)
 {
     DEBUG_LOG("Creating default sphere entities based on XML structure...");
 
     // Create earth sphere entity using EntityFactory (from XML: earth_sphere)
-    auto earthEntity = entityFactory_->createFromTemplate("earth_sphere", "Earth", nextEntityId++);
+    auto earthEntity = entityFactory_->createFromTemplate("earth_sphere", "Earth");
     if (earthEntity)
     {
         // Override settings based on XML structure
@@ -637,7 +622,7 @@ void WorldGenSystem::CreateDefaultSphereEntitiesFromXmlStructure(unsigned int &n
     }
 
     // Create atmosphere layer using EntityFactory (from XML: atmosphere_layer_1)
-    auto atmosphereEntity = entityFactory_->createFromTemplate("earth_sphere", "Atmosphere", nextEntityId++);
+    auto atmosphereEntity = entityFactory_->createFromTemplate("earth_sphere", "Atmosphere");
     if (atmosphereEntity)
     {
         // Override settings based on XML structure
@@ -658,7 +643,7 @@ void WorldGenSystem::CreateDefaultSphereEntitiesFromXmlStructure(unsigned int &n
     }
 
     // Create cloud layer using EntityFactory (from XML: cloud_layer)
-    auto cloudEntity = entityFactory_->createFromTemplate("cloud_object", "Clouds", nextEntityId++);
+    auto cloudEntity = entityFactory_->createFromTemplate("cloud_object", "Clouds");
     if (cloudEntity)
     {
         // Override settings based on XML structure
@@ -29,6 +29,7 @@ public:
     ~WorldGenSystem();
 
     void update(World &world, float deltaTime) override;
+    const char *getName() const override { return "WorldGenSystem"; }
     void GenerateDefaultSphereWorld();
     void GenerateWorldFromXMLScene(const std::string &sceneXml);
     void GenerateWorldFromSceneFile(const std::string &sceneFilePath);
@@ -51,6 +52,7 @@ private:
     // Core scene loading methods
     void GenerateLoadingIndicatorWorld();
     void LoadSceneEntities(const SceneConfig::Scene &scene);
+    void CreateSceneEntity(const SceneConfig::Entity &entityData, EntityHandle parent, int &entitiesCreated);
     AssetId GenerateVoxelMesh(const SceneConfig::CompoundMesh &meshConfig);
 
     // Event handlers
@@ -58,8 +60,8 @@ private:
     void OnDefaultWorldRequested(const DefaultWorldGeneratedEvent &event);
 
     // XML-based entity creation helpers
-    void CreateLoadingIndicatorEntitiesFromXmlStructure(unsigned int &nextEntityId, int &entitiesCreated);
-    void CreateDefaultSphereEntitiesFromXmlStructure(unsigned int &nextEntityId, int &entitiesCreated);
+    void CreateLoadingIndicatorEntitiesFromXmlStructure(int &entitiesCreated);
+    void CreateDefaultSphereEntitiesFromXmlStructure(int &entitiesCreated);
 
     // Legacy material methods (will be removed when MaterialManager is fully integrated)
     AssetId GetEarthMaterialId();
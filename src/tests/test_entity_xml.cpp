@@ -91,7 +91,7 @@ bool testEntityXmlLoading()
     if (Debug())
     {
         DEBUG_LOG("Physics: mass=" << physics->mass
-                  << ", collider=" << physics->colliderType);
+                  << ", collider=" << colliderTypeName(physics->colliderType));
     }
 
     // Vehicle component
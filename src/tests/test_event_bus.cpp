@@ -0,0 +1,250 @@
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "core/EventBus.h"
+
+namespace
+{
+    struct CountedEvent
+    {
+        unsigned producer;
+        unsigned sequence;
+    };
+
+    struct FirstEvent
+    {
+        int value;
+    };
+
+    struct SecondEvent
+    {
+        int value;
+    };
+
+    struct UnheardEvent
+    {
+        int value;
+    };
+
+    /** @brief Receiver for member-function subscriptions */
+    struct Recorder
+    {
+        std::string log;
+        void onFirst(const FirstEvent &event) { log += "m" + std::to_string(event.value); }
+    };
+
+    constexpr unsigned Producers = 4;
+    constexpr unsigned EventsPerProducer = 50000;
+}
+
+/**
+ * @brief Several threads post into a small ring with Block; every event arrives once, in order per producer.
+ */
+bool testPostStress()
+{
+    EventBus bus(64);
+    bus.setOverflowPolicy(EventBus::OverflowPolicy::Block);
+
+    std::vector<unsigned> nextSequence(Producers, 0);
+    bool ordered = true;
+    bus.subscribe<CountedEvent>([&](const CountedEvent &event)
+                                {
+        if (event.producer >= Producers || event.sequence != nextSequence[event.producer])
+            ordered = false;
+        else
+            ++nextSequence[event.producer]; });
+
+    std::vector<std::thread> producers;
+    for (unsigned p = 0; p < Producers; ++p)
+    {
+        producers.emplace_back([&bus, p]()
+                               {
+            for (unsigned i = 0; i < EventsPerProducer; ++i)
+                bus.post(CountedEvent{p, i}); });
+    }
+
+    std::size_t received = 0;
+    while (received < Producers * EventsPerProducer)
+    {
+        received += bus.dispatchPosted();
+        std::this_thread::yield();
+    }
+    for (std::thread &producer : producers)
+        producer.join();
+    received += bus.dispatchPosted();
+
+    const EventBus::PostedStats stats = bus.getPostedStats();
+    if (!ordered || received != Producers * EventsPerProducer)
+    {
+        std::cerr << "Posted events lost or reordered: received " << received << std::endl;
+        return false;
+    }
+    if (stats.posted != Producers * EventsPerProducer || stats.dropped != 0 || stats.highWater > stats.capacity)
+    {
+        std::cerr << "Unexpected posted stats: posted " << stats.posted << ", dropped " << stats.dropped
+                  << ", high water " << stats.highWater << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief With DropNewest a full ring rejects and counts the overflow, and the accepted events still arrive.
+ */
+bool testPostDropNewest()
+{
+    EventBus bus(8);
+    std::size_t delivered = 0;
+    bus.subscribe<CountedEvent>([&delivered](const CountedEvent &)
+                                { ++delivered; });
+
+    unsigned accepted = 0;
+    for (unsigned i = 0; i < 20; ++i)
+        accepted += bus.post(CountedEvent{0, i}) ? 1 : 0;
+
+    const EventBus::PostedStats stats = bus.getPostedStats();
+    if (accepted != 8 || stats.dropped != 12 || bus.dispatchPosted() != 8 || delivered != 8)
+    {
+        std::cerr << "DropNewest accepted " << accepted << ", dropped " << stats.dropped << ", delivered "
+                  << delivered << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief publish() reaches the handlers of its own type only, in subscription order.
+ */
+bool testPublishTyped()
+{
+    EventBus bus;
+    Recorder recorder;
+    std::string log;
+    bus.subscribe<FirstEvent>([&log](const FirstEvent &event)
+                              { log += "a" + std::to_string(event.value); });
+    bus.subscribe<FirstEvent, Recorder, &Recorder::onFirst>(&recorder);
+    bus.subscribe<FirstEvent>([&log, &recorder](const FirstEvent &event)
+                              { log += "b" + std::to_string(event.value) + recorder.log; });
+    bus.subscribe<SecondEvent>([&log](const SecondEvent &event)
+                               { log += "s" + std::to_string(event.value); });
+
+    bus.publish(FirstEvent{1});
+    bus.publish(SecondEvent{2});
+    bus.publish(UnheardEvent{3});
+
+    if (log != "a1b1m1s2" || recorder.log != "m1" || bus.getSubscriberCount<FirstEvent>() != 3 ||
+        bus.getSubscriberCount<UnheardEvent>() != 0)
+    {
+        std::cerr << "Typed publish delivered '" << log << "'" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief dispatchQueued() drains types in order, keeps each type's order, and delivers re-queued events correctly.
+ */
+bool testQueuedOrder()
+{
+    EventBus bus;
+    std::string log;
+    // FirstEvent was registered before SecondEvent, so its channel drains first
+    bus.subscribe<FirstEvent>([&](const FirstEvent &event)
+                              {
+        log += "f" + std::to_string(event.value);
+        if (event.value == 2)
+            bus.enqueue(FirstEvent{3}); });
+    bus.subscribe<SecondEvent>([&](const SecondEvent &event)
+                               {
+        log += "s" + std::to_string(event.value);
+        if (event.value == 1)
+            bus.enqueue(FirstEvent{4}); });
+
+    bus.enqueue(SecondEvent{1});
+    bus.enqueue(FirstEvent{1});
+    bus.enqueue(UnheardEvent{0});
+    bus.enqueue(FirstEvent{2});
+    bus.enqueue(SecondEvent{2});
+    if (!log.empty())
+    {
+        std::cerr << "enqueue() delivered immediately" << std::endl;
+        return false;
+    }
+
+    // FirstEvent{3} joins the channel being drained; FirstEvent{4} arrives after that channel is done
+    const std::size_t first = bus.dispatchQueued();
+    if (first != 5 || log != "f1f2f3s1s2")
+    {
+        std::cerr << "First drain delivered " << first << ": '" << log << "'" << std::endl;
+        return false;
+    }
+    const std::size_t second = bus.dispatchQueued();
+    if (second != 1 || log != "f1f2f3s1s2f4" || bus.dispatchQueued() != 0)
+    {
+        std::cerr << "Second drain delivered " << second << ": '" << log << "'" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Handlers removed during a dispatch are skipped at once; handlers added during it wait for the next one.
+ */
+bool testUnsubscribeDuringDispatch()
+{
+    EventBus bus;
+    std::string log;
+    EventBus::SubscriptionId self = 0;
+    EventBus::SubscriptionId later = 0;
+    bool subscribed = false;
+
+    bus.subscribe<FirstEvent>([&](const FirstEvent &)
+                              {
+        log += "a";
+        bus.unsubscribe(later);
+        if (!subscribed)
+        {
+            subscribed = true;
+            bus.subscribe<FirstEvent>([&log](const FirstEvent &)
+                                      { log += "n"; });
+        } });
+    self = bus.subscribe<FirstEvent>([&](const FirstEvent &)
+                                     {
+        log += "s";
+        bus.unsubscribe(self); });
+    later = bus.subscribe<FirstEvent>([&log](const FirstEvent &)
+                                      { log += "x"; });
+
+    bus.publish(FirstEvent{1});
+    if (log != "as" || bus.getSubscriberCount<FirstEvent>() != 2)
+    {
+        std::cerr << "First publish delivered '" << log << "' to " << bus.getSubscriberCount<FirstEvent>()
+                  << " remaining handlers" << std::endl;
+        return false;
+    }
+
+    bus.publish(FirstEvent{2});
+    if (log != "asan" || bus.unsubscribe(self) || bus.unsubscribe(later))
+    {
+        std::cerr << "Second publish delivered '" << log << "'" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main()
+{
+    bool passed = true;
+    passed = testPublishTyped() && passed;
+    passed = testQueuedOrder() && passed;
+    passed = testUnsubscribeDuringDispatch() && passed;
+    passed = testPostStress() && passed;
+    passed = testPostDropNewest() && passed;
+    if (!passed)
+    {
+        std::cerr << "EventBus Test: FAILED" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,142 @@
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <vector>
+#include "core/JobSystem.h"
+
+namespace
+{
+    /**
+     * @brief Values spanning many magnitudes, so a float sum depends on the order it is taken in.
+     */
+    std::vector<float> makeValues(std::size_t count)
+    {
+        std::vector<float> values(count);
+        std::uint32_t state = 12345;
+        for (float &value : values)
+        {
+            state = state * 1664525u + 1013904223u;
+            const float mantissa = static_cast<float>(state >> 8) / static_cast<float>(1u << 24);
+            value = (mantissa - 0.5f) * std::pow(10.0f, static_cast<float>(state % 13) - 6.0f);
+        }
+        return values;
+    }
+
+    float sum(JobSystem &jobs, const std::vector<float> &values, std::size_t grainSize)
+    {
+        return jobs.parallelReduce(
+            0, values.size(), grainSize, 0.0f,
+            [&values](std::size_t first, std::size_t last)
+            {
+                float partial = 0.0f;
+                for (std::size_t i = first; i < last; ++i)
+                    partial += values[i];
+                return partial;
+            },
+            [](float a, float b)
+            { return a + b; });
+    }
+
+    bool sameBits(float a, float b)
+    {
+        return std::memcmp(&a, &b, sizeof(float)) == 0;
+    }
+}
+
+/**
+ * @brief A deterministic float reduction gives the same bits inline, with one worker and with several.
+ */
+bool testDeterministicReduce()
+{
+    const std::vector<float> values = makeValues(100003);
+    const std::size_t grains[] = {0, 64, 777, 4096};
+    const int workerCounts[] = {0, 1, 4};
+
+    bool passed = true;
+    for (std::size_t grain : grains)
+    {
+        float reference = 0.0f;
+        for (int workers : workerCounts)
+        {
+            JobSystem jobs;
+            jobs.setDeterministic(true);
+            if (workers > 0)
+                jobs.start(workers);
+
+            // Repeat so chunks land on different threads from run to run
+            for (int run = 0; run < 5; ++run)
+            {
+                const float result = sum(jobs, values, grain);
+                if (workers == 0 && run == 0)
+                    reference = result;
+                else if (!sameBits(result, reference))
+                {
+                    std::cerr << "Grain " << grain << " with " << workers << " workers summed to " << result
+                              << " instead of " << reference << std::endl;
+                    passed = false;
+                }
+            }
+        }
+    }
+    return passed;
+}
+
+/**
+ * @brief parallelFor visits every index of a range exactly once, in either mode.
+ */
+bool testParallelForCoverage()
+{
+    struct Range
+    {
+        std::size_t begin, end, grain;
+    };
+    const Range ranges[] = {{0, 0, 0}, {5, 6, 0}, {0, 1000, 1}, {17, 100017, 0}, {3, 10003, 333}, {0, 4096, 256}};
+
+    bool passed = true;
+    for (bool deterministic : {false, true})
+    {
+        JobSystem jobs;
+        jobs.setDeterministic(deterministic);
+        jobs.start(4);
+        for (const Range &range : ranges)
+        {
+            std::unique_ptr<std::atomic<int>[]> visits(new std::atomic<int>[range.end + 1]);
+            for (std::size_t i = 0; i <= range.end; ++i)
+                visits[i].store(0);
+
+            jobs.parallelFor(range.begin, range.end, range.grain, [&](std::size_t first, std::size_t last)
+                             {
+                for (std::size_t i = first; i < last; ++i)
+                    visits[i].fetch_add(1, std::memory_order_relaxed); });
+
+            for (std::size_t i = 0; i <= range.end; ++i)
+            {
+                const int expected = i >= range.begin && i < range.end ? 1 : 0;
+                if (visits[i].load() != expected)
+                {
+                    std::cerr << "Index " << i << " of [" << range.begin << ", " << range.end << ") visited "
+                              << visits[i].load() << " times" << (deterministic ? " (deterministic)" : "") << std::endl;
+                    passed = false;
+                    break;
+                }
+            }
+        }
+    }
+    return passed;
+}
+
+int main()
+{
+    bool passed = true;
+    passed = testDeterministicReduce() && passed;
+    passed = testParallelForCoverage() && passed;
+    if (!passed)
+    {
+        std::cerr << "JobSystem Test: FAILED" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,109 @@
+#include <cstdint>
+#include <iostream>
+#include "core/Metrics.h"
+
+/**
+ * @brief Powers of two start a bucket, and the value just below them ends the previous one.
+ */
+bool testBucketPowersOfTwo()
+{
+    bool passed = true;
+    for (unsigned bits = 0; bits < Histogram::MaxValueBits; ++bits)
+    {
+        const std::uint64_t value = std::uint64_t{1} << bits;
+        const std::size_t index = Histogram::bucketIndex(value);
+        if (Histogram::bucketLowerBound(index) != value)
+        {
+            std::cerr << "2^" << bits << " is not the lower bound of its bucket " << index << std::endl;
+            passed = false;
+        }
+        if (bits > 0 && Histogram::bucketIndex(value - 1) != index - 1)
+        {
+            std::cerr << "2^" << bits << " - 1 is not in the bucket before 2^" << bits << std::endl;
+            passed = false;
+        }
+    }
+    return passed;
+}
+
+/**
+ * @brief Every bucket's lower bound maps back to it, and the largest value lands in the last bucket.
+ */
+bool testBucketRange()
+{
+    bool passed = true;
+    if (Histogram::BucketCount != 2240)
+    {
+        std::cerr << "Expected 2240 buckets, got " << Histogram::BucketCount << std::endl;
+        passed = false;
+    }
+    for (std::size_t index = 0; index < Histogram::BucketCount; ++index)
+    {
+        if (Histogram::bucketIndex(Histogram::bucketLowerBound(index)) != index)
+        {
+            std::cerr << "Lower bound of bucket " << index << " maps to another bucket" << std::endl;
+            passed = false;
+        }
+    }
+
+    const std::uint64_t largest = (std::uint64_t{1} << Histogram::MaxValueBits) - 1;
+    if (Histogram::bucketIndex(largest) != Histogram::BucketCount - 1)
+    {
+        std::cerr << "Largest value is not in the last bucket" << std::endl;
+        passed = false;
+    }
+
+    Histogram histogram;
+    histogram.record(largest + 12345);
+    if (histogram.summarize().maxNs != static_cast<double>(largest))
+    {
+        std::cerr << "Out-of-range value was not clamped" << std::endl;
+        passed = false;
+    }
+    return passed;
+}
+
+/**
+ * @brief A snapshot prefix matches whole dotted segments only.
+ */
+bool testSnapshotPrefix()
+{
+    MetricsRegistry &registry = MetricsRegistry::instance();
+    registry.counter("testprefix").add();
+    registry.counter("testprefix.a").add();
+    registry.gauge("testprefix.b.c").set(1.0);
+    registry.counter("testprefixX").add();
+    registry.counter("testprefixX.a").add();
+
+    const auto matched = registry.snapshot("testprefix");
+    const auto dotted = registry.snapshot("testprefix.");
+    if (matched.size() != 3 || dotted.size() != 2)
+    {
+        std::cerr << "'testprefix' matched " << matched.size() << " metrics, 'testprefix.' matched "
+                  << dotted.size() << std::endl;
+        return false;
+    }
+    for (const MetricSnapshot &snapshot : matched)
+    {
+        if (snapshot.name.compare(0, 11, "testprefixX") == 0)
+        {
+            std::cerr << "'testprefix' matched " << snapshot.name << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+int main()
+{
+    bool passed = true;
+    passed = testBucketPowersOfTwo() && passed;
+    passed = testBucketRange() && passed;
+    passed = testSnapshotPrefix() && passed;
+    if (!passed)
+    {
+        std::cerr << "Metrics Test: FAILED" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,204 @@
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <vector>
+#include "core/EventBus.h"
+#include "core/World.h"
+#include "core/WorldSnapshot.h"
+#include "components/MultirotorC.h"
+#include "physics/MultirotorModel.h"
+#include "vehicles/DroneBuilder.h"
+
+namespace
+{
+    const char *const DronePath = "assets/entities/flywoo-explorer-lr4-o4-pro.xml";
+
+    constexpr float Gravity = 9.81f;
+    constexpr float Tick = 0.01f;
+    constexpr int Substeps = 40;
+
+    bool near(float value, float expected, float tolerance = 1e-6f)
+    {
+        return std::fabs(value - expected) <= tolerance;
+    }
+
+    /**
+     * @brief Hold a command from rest for a second and return the settled rotor wrench.
+     */
+    void settle(const MultirotorParams &params, const MultirotorInput &input, Vector3D &force, Vector3D &torque)
+    {
+        MultirotorState state;
+        for (int i = 0; i < 100; ++i)
+            MultirotorModel::step(params, input, state, Tick, Substeps, force, torque);
+    }
+}
+
+/**
+ * @brief The Flywoo file compiles to four rotors in the engine frame with its control-map's mixer.
+ */
+bool testCompile(const MultirotorParams &params)
+{
+    bool passed = true;
+    if (params.rotorCount != 4 || !near(params.mass, 0.178f) || params.cellCount != 4 || params.source != DronePath)
+    {
+        std::cerr << "Compiled " << params.rotorCount << " rotors, " << params.mass << " kg, " << params.cellCount
+                  << "S from '" << params.source << "'" << std::endl;
+        passed = false;
+    }
+
+    // FRD Izz (yaw) becomes the moment about the engine's up axis
+    if (!near(params.inertia.x, 0.0032f) || !near(params.inertia.y, 0.0055f) || !near(params.inertia.z, 0.0032f))
+    {
+        std::cerr << "Inertia (" << params.inertia.x << ", " << params.inertia.y << ", " << params.inertia.z
+                  << ") is not the FRD tensor in Y-up axes" << std::endl;
+        passed = false;
+    }
+
+    // front-left, front-right, rear-left, rear-right: FRD (x, y, 0) lands at (x, 0, y)
+    const float position[4][2] = {{0.09f, -0.09f}, {0.09f, 0.09f}, {-0.09f, -0.09f}, {-0.09f, 0.09f}};
+    const float spin[4] = {-1.0f, 1.0f, 1.0f, -1.0f};
+    const float mixer[4][4] = {{-1, -1, 1, 1}, {1, -1, -1, 1}, {-1, 1, -1, 1}, {1, 1, 1, 1}};
+    for (int i = 0; i < 4 && i < params.rotorCount; ++i)
+    {
+        const Vector3D &r = params.rotorPosition[i];
+        if (!near(r.x, position[i][0]) || !near(r.y, 0.0f) || !near(r.z, position[i][1]) || params.spin[i] != spin[i])
+        {
+            std::cerr << "Rotor " << i << " is at (" << r.x << ", " << r.y << ", " << r.z << ") spinning "
+                      << params.spin[i] << std::endl;
+            passed = false;
+        }
+        for (int axis = 0; axis < 4; ++axis)
+        {
+            if (params.mixer[i][axis] != mixer[i][axis])
+            {
+                std::cerr << "Mixer row " << i << " column " << axis << " is " << params.mixer[i][axis] << std::endl;
+                passed = false;
+            }
+        }
+    }
+    return passed;
+}
+
+/**
+ * @brief The vehicle hovers at about a third of throttle, and each axis command turns it about its own axis.
+ */
+bool testWrench(const MultirotorParams &params)
+{
+    Vector3D force;
+    Vector3D torque;
+    const float weight = params.mass * Gravity;
+
+    // Settled thrust rises with throttle, so bisect for the throttle that carries the weight
+    float low = 0.0f;
+    float high = 1.0f;
+    for (int i = 0; i < 20; ++i)
+    {
+        MultirotorInput input;
+        input.throttle = 0.5f * (low + high);
+        settle(params, input, force, torque);
+        (force.y < weight ? low : high) = input.throttle;
+    }
+    const float hover = 0.5f * (low + high);
+
+    bool passed = true;
+    if (hover < 0.28f || hover > 0.36f)
+    {
+        std::cerr << "Hover throttle " << hover << " is outside 0.28-0.36" << std::endl;
+        passed = false;
+    }
+
+    MultirotorInput input;
+    input.throttle = hover;
+    settle(params, input, force, torque);
+    if (!near(force.x, 0.0f) || !near(force.z, 0.0f) || !near(torque.x, 0.0f, 1e-5f) || !near(torque.y, 0.0f, 1e-5f) ||
+        !near(torque.z, 0.0f, 1e-5f))
+    {
+        std::cerr << "Collective throttle gives a sideways force or a torque" << std::endl;
+        passed = false;
+    }
+
+    // Right rotors up (roll), rear rotors up (pitch), clockwise rotors up (yaw)
+    const float expected[3][3] = {{-1, 0, 0}, {0, 0, -1}, {0, 1, 0}};
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        MultirotorInput command;
+        command.throttle = hover;
+        (axis == 0 ? command.roll : axis == 1 ? command.pitch : command.yaw) = 0.1f;
+        settle(params, command, force, torque);
+        const float components[3] = {torque.x, torque.y, torque.z};
+        for (int c = 0; c < 3; ++c)
+        {
+            const bool ok = expected[axis][c] == 0.0f ? near(components[c], 0.0f, 1e-5f) : components[c] * expected[axis][c] > 1e-4f;
+            if (!ok)
+            {
+                std::cerr << "Command axis " << axis << " gives torque (" << torque.x << ", " << torque.y << ", "
+                          << torque.z << ")" << std::endl;
+                passed = false;
+                break;
+            }
+        }
+    }
+    return passed;
+}
+
+/**
+ * @brief A snapshot keeps commands and rotor state, and re-links the shared block when the drone is recreated.
+ */
+bool testSnapshot(const std::shared_ptr<const MultirotorParams> &params)
+{
+    EventBus bus;
+    World world(bus);
+    Entity &entity = world.createEntity("drone");
+    entity.addComponent(std::make_unique<MultirotorC>(params));
+    const EntityHandle handle = entity.getHandle();
+
+    MultirotorC &drone = *world.getEntity(handle)->getComponent<MultirotorC>();
+    drone.input.throttle = 0.4f;
+    drone.input.yaw = -0.2f;
+    Vector3D force;
+    Vector3D torque;
+    MultirotorModel::step(*params, drone.input, drone.state, Tick, Substeps, force, torque);
+    const MultirotorState state = drone.state;
+
+    std::vector<std::uint8_t> snapshot;
+    WorldSnapshot::capture(world, snapshot);
+    world.destroyEntity(handle);
+    if (!WorldSnapshot::restore(world, snapshot.data(), snapshot.size()) || !world.getEntity(handle))
+    {
+        std::cerr << "Drone snapshot did not restore" << std::endl;
+        return false;
+    }
+
+    const MultirotorC &restored = *world.getEntity(handle)->getComponent<MultirotorC>();
+    bool passed = restored.params == params && restored.input.throttle == 0.4f && restored.input.yaw == -0.2f &&
+                  restored.state.stateOfCharge == state.stateOfCharge && restored.state.voltage == state.voltage &&
+                  restored.state.current == state.current;
+    for (int i = 0; i < MultirotorParams::MaxRotors; ++i)
+        passed = passed && restored.state.rotorSpeed[i] == state.rotorSpeed[i];
+    if (!passed)
+        std::cerr << "Restored drone differs from the captured one" << std::endl;
+    return passed;
+}
+
+int main()
+{
+    const std::shared_ptr<const MultirotorParams> params = DroneBuilder::load(DronePath);
+    if (!params || DroneBuilder::load(DronePath) != params)
+    {
+        std::cerr << "Could not load one shared block for " << DronePath << std::endl;
+        std::cerr << "Multirotor Test: FAILED" << std::endl;
+        return 1;
+    }
+
+    bool passed = true;
+    passed = testCompile(*params) && passed;
+    passed = testWrench(*params) && passed;
+    passed = testSnapshot(params) && passed;
+    if (!passed)
+    {
+        std::cerr << "Multirotor Test: FAILED" << std::endl;
+        return 1;
+    }
+    return 0;
+}
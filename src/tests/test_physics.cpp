@@ -0,0 +1,189 @@
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <vector>
+#include "core/EventBus.h"
+#include "core/World.h"
+#include "physics/Narrowphase.h"
+#include "physics/PerlinWindModel.h"
+#include "physics/StandardAtmosphereModel.h"
+#include "systems/PhysicsSystem.h"
+#include "components/TransformC.h"
+#include "components/PhysicsC.h"
+
+namespace
+{
+    const float HalfTurn = std::sqrt(0.5f);
+    /** Turns local Y (a capsule's segment) onto the world X axis */
+    const Quaternion AlongX(HalfTurn, 0.0f, 0.0f, HalfTurn);
+    /** Turns local Y onto the world Z axis */
+    const Quaternion AlongZ(HalfTurn, HalfTurn, 0.0f, 0.0f);
+
+    CollisionShape shape(ColliderType type, float x, float y, float z, const Vector3D &position,
+                         const Quaternion &rotation = Quaternion())
+    {
+        const float size[3] = {x, y, z};
+        return CollisionShape::make(type, size, Vector3D(1.0f, 1.0f, 1.0f), position, rotation);
+    }
+
+    /** @brief A pair of shapes and the manifold collide() should give for it */
+    struct PairCase
+    {
+        const char *name;
+        CollisionShape a;
+        CollisionShape b;
+        Vector3D normal;
+        float depth;
+        std::uint32_t points;
+    };
+
+    /**
+     * @brief Check one manifold in both argument orders.
+     *
+     * @return false if the normal, depth or point count is off
+     */
+    bool checkPair(const PairCase &pair)
+    {
+        for (int order = 0; order < 2; ++order)
+        {
+            ContactManifold manifold;
+            const bool touching = order == 0 ? collide(pair.a, pair.b, PhysicsSystem::ContactMargin, manifold)
+                                             : collide(pair.b, pair.a, PhysicsSystem::ContactMargin, manifold);
+            const float sign = order == 0 ? 1.0f : -1.0f;
+            const Vector3D &n = manifold.normal;
+            const float alignment = sign * (n.x * pair.normal.x + n.y * pair.normal.y + n.z * pair.normal.z);
+            bool passed = touching && manifold.pointCount == pair.points && alignment > 0.999f;
+            for (std::uint32_t p = 0; p < manifold.pointCount && passed; ++p)
+                passed = std::fabs(manifold.points[p].depth - pair.depth) < 1e-4f;
+            if (!passed)
+            {
+                std::cerr << pair.name << (order == 0 ? "" : " (swapped)") << ": touching " << touching << ", "
+                          << manifold.pointCount << " points, normal (" << n.x << ", " << n.y << ", " << n.z
+                          << "), depth " << (manifold.pointCount > 0 ? manifold.points[0].depth : 0.0f) << std::endl;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    struct Scene
+    {
+        EventBus bus;
+        World world{bus};
+        StandardAtmosphereModel atmosphere;
+        PerlinWindModel wind{0.0f, 0.0f, 0.0f, 1};
+        PhysicsSystem physics{bus, atmosphere, wind};
+    };
+
+    PhysicsC &addBox(World &world, const Vector3D &position, const Vector3D &size, float mass)
+    {
+        Entity &entity = world.createEntity();
+        entity.addComponent(std::make_unique<TransformC>(position));
+        auto physics = std::make_unique<PhysicsC>(mass, 0.6f, 0.0f, ColliderType::Box, mass <= 0.0f, mass > 0.0f);
+        physics->colliderSize[0] = size.x;
+        physics->colliderSize[1] = size.y;
+        physics->colliderSize[2] = size.z;
+        entity.addComponent(std::move(physics));
+        return *entity.getComponent<PhysicsC>();
+    }
+
+    constexpr float Step = 1.0f / 120.0f;
+    constexpr int StackHeight = 3;
+}
+
+/**
+ * @brief Every shape pair yields the expected normal (A to B), depth and point count.
+ */
+bool testCollidePairs()
+{
+    const PairCase pairs[] = {
+        {"sphere-sphere", shape(ColliderType::Sphere, 1.0f, 1.0f, 1.0f, Vector3D()),
+         shape(ColliderType::Sphere, 1.0f, 1.0f, 1.0f, Vector3D(0.9f, 0.0f, 0.0f)), Vector3D(1.0f, 0.0f, 0.0f), 0.1f, 1},
+        {"box-sphere", shape(ColliderType::Box, 1.0f, 1.0f, 1.0f, Vector3D()),
+         shape(ColliderType::Sphere, 1.0f, 1.0f, 1.0f, Vector3D(0.2f, 0.9f, -0.1f)), Vector3D(0.0f, 1.0f, 0.0f), 0.1f, 1},
+        {"capsule-sphere", shape(ColliderType::Capsule, 1.0f, 3.0f, 1.0f, Vector3D()),
+         shape(ColliderType::Sphere, 1.0f, 1.0f, 1.0f, Vector3D(0.0f, 0.5f, 0.9f)), Vector3D(0.0f, 0.0f, 1.0f), 0.1f, 1},
+        {"box-box", shape(ColliderType::Box, 4.0f, 1.0f, 4.0f, Vector3D()),
+         shape(ColliderType::Box, 1.0f, 1.0f, 1.0f, Vector3D(0.3f, 0.9f, 0.0f)), Vector3D(0.0f, 1.0f, 0.0f), 0.1f, 4},
+        {"box-capsule", shape(ColliderType::Box, 4.0f, 1.0f, 4.0f, Vector3D()),
+         shape(ColliderType::Capsule, 1.0f, 3.0f, 1.0f, Vector3D(0.0f, 0.9f, 0.0f), AlongX), Vector3D(0.0f, 1.0f, 0.0f), 0.1f, 2},
+        {"capsule-capsule parallel", shape(ColliderType::Capsule, 1.0f, 3.0f, 1.0f, Vector3D(), AlongX),
+         shape(ColliderType::Capsule, 1.0f, 3.0f, 1.0f, Vector3D(0.5f, 0.9f, 0.0f), AlongX), Vector3D(0.0f, 1.0f, 0.0f), 0.1f, 2},
+        {"capsule-capsule crossed", shape(ColliderType::Capsule, 1.0f, 3.0f, 1.0f, Vector3D(), AlongX),
+         shape(ColliderType::Capsule, 1.0f, 3.0f, 1.0f, Vector3D(0.0f, 0.9f, 0.0f), AlongZ), Vector3D(0.0f, 1.0f, 0.0f), 0.1f, 1},
+        // Closer than the contact margin but not touching: reported with a negative depth
+        {"sphere-sphere within margin", shape(ColliderType::Sphere, 1.0f, 1.0f, 1.0f, Vector3D()),
+         shape(ColliderType::Sphere, 1.0f, 1.0f, 1.0f, Vector3D(0.0f, 0.0f, 1.005f)), Vector3D(0.0f, 0.0f, 1.0f), -0.005f, 1},
+    };
+
+    bool passed = true;
+    for (const PairCase &pair : pairs)
+        passed = checkPair(pair) && passed;
+
+    ContactManifold manifold;
+    if (collide(shape(ColliderType::Box, 1.0f, 1.0f, 1.0f, Vector3D()),
+                shape(ColliderType::Capsule, 1.0f, 3.0f, 1.0f, Vector3D(1.1f, 0.0f, 0.0f)), PhysicsSystem::ContactMargin, manifold))
+    {
+        std::cerr << "Separated box and capsule reported a contact" << std::endl;
+        passed = false;
+    }
+    return passed;
+}
+
+/**
+ * @brief A stack of boxes settles on the ground at its rest heights and then the island sleeps.
+ */
+bool testStackSettlesAndSleeps()
+{
+    Scene scene;
+    addBox(scene.world, Vector3D(0.0f, -0.5f, 0.0f), Vector3D(20.0f, 1.0f, 20.0f), 0.0f);
+    std::vector<PhysicsC *> boxes;
+    for (int i = 0; i < StackHeight; ++i)
+        boxes.push_back(&addBox(scene.world, Vector3D(0.0f, 0.55f + 1.05f * i, 0.0f), Vector3D(1.0f, 1.0f, 1.0f), 1.0f));
+
+    for (int step = 0; step < 480; ++step)
+        scene.physics.update(scene.world, Step);
+
+    bool passed = scene.physics.getSleepingCount() == StackHeight && scene.physics.getBodyCount() == 0;
+    int i = 0;
+    for (const auto &entity : scene.world.getEntities())
+    {
+        const PhysicsC &physics = *entity->getComponent<PhysicsC>();
+        if (physics.mass <= 0.0f)
+            continue;
+        const Vector3D &position = entity->getComponent<TransformC>()->position;
+        const float rest = 0.5f + static_cast<float>(i++);
+        if (!physics.isSleeping || std::fabs(position.y - rest) > 0.03f || std::fabs(position.x) > 0.01f ||
+            std::fabs(position.z) > 0.01f)
+        {
+            std::cerr << "Box " << i - 1 << " at (" << position.x << ", " << position.y << ", " << position.z
+                      << "), rest height " << rest << ", sleeping " << physics.isSleeping << std::endl;
+            passed = false;
+        }
+    }
+    if (scene.physics.getSleepingCount() != StackHeight)
+        std::cerr << scene.physics.getSleepingCount() << " of " << StackHeight << " boxes asleep" << std::endl;
+
+    // Setting a velocity on one sleeper wakes its whole island at the next update
+    boxes.back()->velocity = Vector3D(0.5f, 0.0f, 0.0f);
+    scene.physics.update(scene.world, Step);
+    passed = scene.physics.getSleepingCount() == 0 && scene.physics.getBodyCount() == StackHeight && passed;
+    for (const PhysicsC *box : boxes)
+        passed = !box->isSleeping && passed;
+    if (scene.physics.getSleepingCount() != 0)
+        std::cerr << "Setting a velocity left " << scene.physics.getSleepingCount() << " boxes asleep" << std::endl;
+    return passed;
+}
+
+int main()
+{
+    bool passed = true;
+    passed = testCollidePairs() && passed;
+    passed = testStackSettlesAndSleeps() && passed;
+    if (!passed)
+    {
+        std::cerr << "Physics Test: FAILED" << std::endl;
+        return 1;
+    }
+    return 0;
+}
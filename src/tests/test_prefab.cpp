@@ -0,0 +1,222 @@
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include "core/Entity.h"
+#include "core/EventBus.h"
+#include "core/Prefab.h"
+#include "core/IComponent.h"
+#include "core/World.h"
+#include "components/TransformC.h"
+
+namespace
+{
+    int liveCounted = 0;
+
+    /** @brief Component that counts its live instances */
+    struct CountedC : public IComponent
+    {
+        int value = 0;
+        CountedC() { ++liveCounted; }
+        CountedC(const CountedC &other) : IComponent(), value(other.value) { ++liveCounted; }
+        ~CountedC() override { --liveCounted; }
+    };
+
+    /** @brief Component whose copies can be made to throw */
+    struct ThrowingC : public IComponent
+    {
+        bool throwOnCopy = true;
+        ThrowingC() = default;
+        ThrowingC(const ThrowingC &other) : IComponent(), throwOnCopy(other.throwOnCopy)
+        {
+            if (throwOnCopy)
+                throw std::runtime_error("copy failed");
+        }
+    };
+
+    int copiesLeft = -1;
+
+    /** @brief Component whose copies throw once copiesLeft runs out (never while it is negative) */
+    struct FailingC : public IComponent
+    {
+        FailingC() = default;
+        FailingC(const FailingC &) : IComponent()
+        {
+            if (copiesLeft == 0)
+                throw std::runtime_error("copy failed");
+            if (copiesLeft > 0)
+                --copiesLeft;
+        }
+    };
+
+    bool sameVector(const Vector3D &a, const Vector3D &b)
+    {
+        return a.x == b.x && a.y == b.y && a.z == b.z;
+    }
+}
+
+/**
+ * @brief A throwing component copy destroys only the prototypes already built and leaves the prefab empty.
+ */
+bool testCompileThrows()
+{
+    // CountedC gets the lower type ID, so its prototype is built before ThrowingC's copy throws
+    Entity source;
+    source.addComponent(std::make_unique<CountedC>());
+    source.addComponent(std::make_unique<ThrowingC>());
+    const int before = liveCounted;
+
+    Prefab prefab;
+    bool threw = false;
+    try
+    {
+        prefab.compile(source);
+    }
+    catch (const std::runtime_error &)
+    {
+        threw = true;
+    }
+
+    if (!threw || liveCounted != before || prefab.getComponentCount() != 0 || prefab.getByteSize() != 0)
+    {
+        std::cerr << "Throwing compile left " << liveCounted - before << " extra live components and "
+                  << prefab.getComponentCount() << " entries" << std::endl;
+        return false;
+    }
+
+    // The prefab is still usable afterwards
+    source.getComponent<ThrowingC>()->throwOnCopy = false;
+    if (!prefab.compile(source) || prefab.getComponentCount() != 2 || liveCounted != before + 1)
+    {
+        std::cerr << "Prefab did not compile after a failed attempt" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief instantiate() makes distinct copies equal to the prototype, with per-instance name and transform overrides.
+ */
+bool testInstantiate()
+{
+    EventBus bus;
+    World world(bus);
+    Entity source;
+    source.setName("crate");
+    source.addComponent(std::make_unique<TransformC>(Vector3D(1.0f, 2.0f, 3.0f)));
+    auto counted = std::make_unique<CountedC>();
+    counted->value = 42;
+    source.addComponent(std::move(counted));
+
+    Prefab prefab;
+    if (!prefab.compile(source))
+    {
+        std::cerr << "Prefab did not compile" << std::endl;
+        return false;
+    }
+
+    std::vector<EntityHandle> handles;
+    world.instantiate(prefab, 4, handles);
+    bool passed = handles.size() == 4 && world.getEntities().size() == 4;
+    for (std::size_t i = 0; i < handles.size(); ++i)
+    {
+        for (std::size_t j = 0; j < i; ++j)
+            passed = handles[i] != handles[j] && passed;
+
+        Entity *entity = world.getEntity(handles[i]);
+        passed = entity != nullptr && entity->getName() == "crate" && entity->getComponent<CountedC>()->value == 42 &&
+                 sameVector(entity->getComponent<TransformC>()->position, Vector3D(1.0f, 2.0f, 3.0f)) && passed;
+    }
+    // Copies are independent of each other
+    world.getEntity(handles[0])->getComponent<CountedC>()->value = 7;
+    passed = world.getEntity(handles[1])->getComponent<CountedC>()->value == 42 && passed;
+
+    PrefabInstance instances[2];
+    instances[0].position = Vector3D(-5.0f, 0.0f, 8.0f);
+    instances[0].name = "crate_a";
+    instances[1].position = Vector3D(0.0f, 9.0f, 0.0f);
+    instances[1].rotation = Quaternion(0.0f, 0.0f, 1.0f, 0.0f);
+    instances[1].scale = Vector3D(2.0f, 2.0f, 2.0f);
+    world.instantiate(prefab, 2, handles, instances);
+    passed = handles.size() == 6 && passed;
+    for (std::size_t i = 0; i < 2 && passed; ++i)
+    {
+        Entity *entity = world.getEntity(handles[4 + i]);
+        const TransformC &transform = *entity->getComponent<TransformC>();
+        passed = entity->getName() == (i == 0 ? "crate_a" : "crate") &&
+                 sameVector(transform.position, instances[i].position) &&
+                 sameVector(transform.previousPosition, instances[i].position) &&
+                 sameVector(transform.scale, instances[i].scale) && transform.rotation.y == instances[i].rotation.y &&
+                 entity->getComponent<CountedC>()->value == 42 && passed;
+    }
+
+    for (EntityHandle handle : handles)
+        passed = world.destroyEntity(handle) && passed;
+    if (!passed)
+        std::cerr << "Instantiated copies do not match the prefab and overrides" << std::endl;
+    return passed;
+}
+
+/**
+ * @brief A copy that throws mid-batch rolls the whole batch back and leaves the world usable.
+ */
+bool testInstantiateThrows()
+{
+    EventBus bus;
+    World world(bus);
+    Entity source;
+    source.addComponent(std::make_unique<CountedC>());
+    source.addComponent(std::make_unique<FailingC>());
+    Prefab prefab;
+    prefab.compile(source);
+
+    std::vector<EntityHandle> handles;
+    world.instantiate(prefab, 3, handles);
+    const int before = liveCounted;
+
+    // The fourth instance fails after its CountedC was copied
+    copiesLeft = 3;
+    bool threw = false;
+    try
+    {
+        world.instantiate(prefab, 6, handles);
+    }
+    catch (const std::runtime_error &)
+    {
+        threw = true;
+    }
+    copiesLeft = -1;
+
+    bool passed = threw && handles.size() == 3 && world.getEntities().size() == 3 && liveCounted == before;
+    for (const auto &entity : world.getEntities())
+        passed = entity->getComponent<CountedC>() != nullptr && entity->getComponent<FailingC>() != nullptr && passed;
+
+    // Freed slots are reused and every entity can still be destroyed
+    world.instantiate(prefab, 5, handles);
+    passed = handles.size() == 8 && world.getEntities().size() == 8 && passed;
+    for (EntityHandle handle : handles)
+        passed = world.destroyEntity(handle) && passed;
+    passed = world.getEntities().empty() && passed;
+    if (!passed)
+        std::cerr << "Failed instantiate was not rolled back cleanly" << std::endl;
+    return passed;
+}
+
+int main()
+{
+    bool passed = true;
+    passed = testCompileThrows() && passed;
+    passed = testInstantiate() && passed;
+    passed = testInstantiateThrows() && passed;
+    if (liveCounted != 0)
+    {
+        std::cerr << liveCounted << " components leaked or were destroyed twice" << std::endl;
+        passed = false;
+    }
+    if (!passed)
+    {
+        std::cerr << "Prefab Test: FAILED" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,273 @@
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+#include "core/EventBus.h"
+#include "core/Replay.h"
+#include "core/World.h"
+#include "core/WorldSnapshot.h"
+#include "components/TransformC.h"
+
+namespace
+{
+    constexpr std::uint64_t Steps = 300;
+
+    /**
+     * @brief A world of one body that the actions move around.
+     */
+    struct Session
+    {
+        EventBus bus;
+        World world{bus};
+        EntityHandle body;
+        std::vector<std::uint8_t> snapshot;
+
+        Session()
+        {
+            Entity &entity = world.createEntity("body");
+            entity.addComponent(std::make_unique<TransformC>());
+            body = entity.getHandle();
+        }
+
+        /**
+         * @brief Apply a step's actions and hash the resulting state.
+         */
+        std::uint64_t step(const std::vector<std::string> &actions, float drift = 0.0f)
+        {
+            TransformC &transform = *world.getEntity(body)->getComponent<TransformC>();
+            for (const std::string &action : actions)
+                transform.position.x += static_cast<float>(action.size()) * (action[0] == 'a' ? 1.0f : -0.5f);
+            transform.position.y += 0.01f + drift;
+            WorldSnapshot::capture(world, snapshot);
+            return WorldSnapshot::hash(snapshot.data(), snapshot.size());
+        }
+    };
+
+    /**
+     * @brief Actions of a recorded step: quiet steps, repeats and over 128 distinct names, so indices need two varint bytes.
+     */
+    std::vector<std::string> scriptedActions(std::uint64_t step)
+    {
+        std::vector<std::string> actions;
+        if (step % 3 == 0)
+            return actions;
+        actions.push_back("action" + std::to_string(step % 200));
+        if (step % 5 == 0)
+            actions.push_back("boost");
+        if (step % 7 == 0)
+            actions.push_back(actions.front());
+        return actions;
+    }
+
+    std::string tempPath(const std::string &name)
+    {
+        return (std::filesystem::temp_directory_path() / name).string();
+    }
+
+    std::vector<char> readFile(const std::string &path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        return std::vector<char>((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    }
+
+    void writeFile(const std::string &path, const std::vector<char> &data)
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(data.data(), static_cast<std::streamsize>(data.size()));
+    }
+
+    /**
+     * @brief Record the first steps of a scripted session to a file.
+     */
+    bool record(const std::string &path, std::uint64_t steps = Steps)
+    {
+        ReplayHeader header;
+        header.fixedTimestep = 0.005;
+        header.randomSeed = 1234;
+        header.deterministic = true;
+
+        ReplayRecorder recorder;
+        if (!recorder.open(path, header))
+            return false;
+        recorder.recordScene("test_scene");
+
+        Session session;
+        for (std::uint64_t step = 1; step <= steps; ++step)
+        {
+            const std::vector<std::string> actions = scriptedActions(step);
+            for (const std::string &action : actions)
+                recorder.addAction(action);
+            recorder.recordStep(session.step(actions));
+        }
+        recorder.close();
+        return recorder.getStepCount() == steps;
+    }
+
+    /**
+     * @brief Replay a file, optionally perturbing the simulation from one step on.
+     *
+     * @return Steps played
+     */
+    std::uint64_t replay(ReplayPlayer &player, std::uint64_t driftFrom = 0)
+    {
+        Session session;
+        std::vector<std::string> actions;
+        std::uint64_t played = 0;
+        while (player.nextStep(actions))
+        {
+            ++played;
+            const bool drift = driftFrom != 0 && played >= driftFrom;
+            player.verifyStep(session.step(actions, drift ? 0.001f : 0.0f));
+        }
+        return played;
+    }
+}
+
+/**
+ * @brief A recording replays with its header, scene, actions and matching hashes.
+ */
+bool testRecordAndReplay()
+{
+    const std::string path = tempPath("fpv_fsim_test_replay.fpvr");
+    if (!record(path))
+    {
+        std::cerr << "Could not record " << path << std::endl;
+        return false;
+    }
+
+    ReplayPlayer player;
+    if (!player.open(path))
+        return false;
+    const ReplayHeader &header = player.getHeader();
+    if (header.fixedTimestep != 0.005 || header.randomSeed != 1234 || !header.deterministic || header.sceneId != "test_scene")
+    {
+        std::cerr << "Header did not round-trip" << std::endl;
+        return false;
+    }
+
+    bool passed = true;
+    std::vector<std::string> actions;
+    for (std::uint64_t step = 1; player.nextStep(actions); ++step)
+    {
+        if (actions != scriptedActions(step))
+        {
+            std::cerr << "Actions of step " << step << " did not round-trip" << std::endl;
+            passed = false;
+            break;
+        }
+    }
+
+    ReplayPlayer verifier;
+    verifier.open(path);
+    if (replay(verifier) != Steps || verifier.getMismatchCount() != 0 || !verifier.isFinished())
+    {
+        std::cerr << "Faithful replay reported " << verifier.getMismatchCount() << " mismatches" << std::endl;
+        passed = false;
+    }
+
+    ReplayPlayer diverging;
+    diverging.open(path);
+    replay(diverging, 120);
+    if (diverging.getFirstMismatchStep() != 120 || diverging.getMismatchCount() != Steps - 119)
+    {
+        std::cerr << "Divergence reported at step " << diverging.getFirstMismatchStep() << ", expected 120" << std::endl;
+        passed = false;
+    }
+
+    std::filesystem::remove(path);
+    return passed;
+}
+
+/**
+ * @brief A truncated file replays the complete steps before the cut; a corrupt one stops at the damage.
+ */
+bool testDamagedFiles()
+{
+    const std::string path = tempPath("fpv_fsim_test_replay_damaged.fpvr");
+    if (!record(path))
+        return false;
+    const std::vector<char> data = readFile(path);
+
+    bool passed = true;
+
+    // Cut mid-file: the steps before the cut still verify
+    writeFile(path, std::vector<char>(data.begin(), data.begin() + static_cast<std::ptrdiff_t>(data.size() / 2)));
+    ReplayPlayer truncated;
+    if (!truncated.open(path) || truncated.getStepCount() == 0 || truncated.getStepCount() >= Steps)
+    {
+        std::cerr << "Truncated file gave " << truncated.getStepCount() << " steps" << std::endl;
+        passed = false;
+    }
+    else if (replay(truncated) != truncated.getStepCount() || truncated.getMismatchCount() != 0)
+    {
+        std::cerr << "Steps before the cut do not verify" << std::endl;
+        passed = false;
+    }
+
+    // A cut inside the header or a wrong magic is refused outright
+    writeFile(path, std::vector<char>(data.begin(), data.begin() + 12));
+    ReplayPlayer headerOnly;
+    if (headerOnly.open(path))
+    {
+        std::cerr << "File cut inside the header was accepted" << std::endl;
+        passed = false;
+    }
+    std::vector<char> corrupt = data;
+    corrupt[0] ^= 0x20;
+    writeFile(path, corrupt);
+    ReplayPlayer badMagic;
+    if (badMagic.open(path))
+    {
+        std::cerr << "File with a bad magic was accepted" << std::endl;
+        passed = false;
+    }
+
+    // Records are a prefix-stable stream, so a recording of 149 steps ends (before its end tag) where step 150 starts
+    record(path, 149);
+    const std::size_t step150 = readFile(path).size() - 1;
+
+    // A damaged record tag keeps the steps before it
+    corrupt = data;
+    corrupt[step150] = static_cast<char>(0xEE);
+    writeFile(path, corrupt);
+    ReplayPlayer damaged;
+    if (!damaged.open(path) || damaged.getStepCount() != 149)
+    {
+        std::cerr << "File damaged at step 150 gave " << damaged.getStepCount() << " steps" << std::endl;
+        passed = false;
+    }
+
+    // A damaged state hash is reported as a divergence at its step; the hash is the record's last 8 bytes
+    record(path, 150);
+    const std::size_t hash150 = readFile(path).size() - 1 - sizeof(std::uint64_t);
+    corrupt = data;
+    corrupt[hash150] ^= 0x01;
+    writeFile(path, corrupt);
+    ReplayPlayer wrongHash;
+    wrongHash.open(path);
+    if (replay(wrongHash) != Steps || wrongHash.getFirstMismatchStep() != 150 || wrongHash.getMismatchCount() != 1)
+    {
+        std::cerr << "Damaged hash reported at step " << wrongHash.getFirstMismatchStep() << ", expected 150" << std::endl;
+        passed = false;
+    }
+
+    std::filesystem::remove(path);
+    return passed;
+}
+
+int main()
+{
+    bool passed = true;
+    passed = testRecordAndReplay() && passed;
+    passed = testDamagedFiles() && passed;
+    if (!passed)
+    {
+        std::cerr << "Replay Test: FAILED" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,155 @@
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <vector>
+#include "core/EventBus.h"
+#include "core/RewindBuffer.h"
+#include "core/World.h"
+#include "core/WorldSnapshot.h"
+#include "components/TransformC.h"
+
+/**
+ * @brief XOR deltas round-trip for equal, sparse, longer and shorter snapshots; malformed deltas are rejected.
+ */
+bool testDeltaEncoding()
+{
+    std::vector<std::uint8_t> keyframe(4096);
+    for (std::size_t i = 0; i < keyframe.size(); ++i)
+        keyframe[i] = static_cast<std::uint8_t>(i * 31 + 7);
+
+    std::vector<std::vector<std::uint8_t>> snapshots;
+    snapshots.push_back(keyframe);
+    snapshots.push_back(keyframe);
+    snapshots.back()[0] ^= 1;
+    snapshots.back()[1000] ^= 0x80;
+    snapshots.back()[1003] ^= 0x10;
+    snapshots.back()[4095] ^= 0xFF;
+    snapshots.push_back(keyframe);
+    snapshots.back().insert(snapshots.back().end(), 300, 0x5A);
+    snapshots.push_back(std::vector<std::uint8_t>(keyframe.begin(), keyframe.begin() + 1234));
+
+    bool passed = true;
+    std::vector<std::uint8_t> delta;
+    std::vector<std::uint8_t> decoded;
+    for (std::size_t i = 0; i < snapshots.size(); ++i)
+    {
+        RewindBuffer::encodeDelta(keyframe, snapshots[i], delta);
+        if (!RewindBuffer::decodeDelta(keyframe, delta, snapshots[i].size(), decoded) || decoded != snapshots[i])
+        {
+            std::cerr << "Delta " << i << " does not round-trip" << std::endl;
+            passed = false;
+        }
+    }
+
+    // Unchanged bytes collapse into zero runs: an equal snapshot is one token, a sparse change a few
+    RewindBuffer::encodeDelta(keyframe, snapshots[0], delta);
+    if (delta.size() > 4)
+    {
+        std::cerr << "Equal snapshot encoded to " << delta.size() << " bytes" << std::endl;
+        passed = false;
+    }
+    RewindBuffer::encodeDelta(keyframe, snapshots[1], delta);
+    if (delta.size() > 32)
+    {
+        std::cerr << "Four changed bytes encoded to " << delta.size() << " bytes" << std::endl;
+        passed = false;
+    }
+
+    // A cut-off delta or one that writes past the stated size is malformed
+    const std::vector<std::uint8_t> truncated(delta.begin(), delta.end() - 1);
+    if (RewindBuffer::decodeDelta(keyframe, truncated, snapshots[1].size(), decoded))
+    {
+        std::cerr << "Truncated delta was accepted" << std::endl;
+        passed = false;
+    }
+    if (RewindBuffer::decodeDelta(keyframe, delta, 100, decoded))
+    {
+        std::cerr << "Delta larger than its snapshot was accepted" << std::endl;
+        passed = false;
+    }
+    return passed;
+}
+
+/**
+ * @brief Frames decode exactly across keyframe boundaries, and a rewind restores and truncates the timeline.
+ */
+bool testKeyframeChain()
+{
+    EventBus bus;
+    World world(bus);
+    Entity &body = world.createEntity("body");
+    body.addComponent(std::make_unique<TransformC>());
+    const EntityHandle handle = body.getHandle();
+    world.createEntity("static").addComponent(std::make_unique<TransformC>(Vector3D(5.0f, 0.0f, 0.0f)));
+
+    const double dt = 0.01;
+    const std::size_t interval = 4;
+    RewindBuffer buffer;
+    buffer.configure(1.0, dt, RewindBuffer::DefaultMaxBytes, interval);
+
+    std::vector<std::vector<std::uint8_t>> captured;
+    for (std::uint64_t step = 1; step <= 10; ++step)
+    {
+        world.getEntity(handle)->getComponent<TransformC>()->position.y = static_cast<float>(step);
+        buffer.record(world, RewindBuffer::FrameInfo{step, static_cast<double>(step) * dt});
+        captured.emplace_back();
+        WorldSnapshot::capture(world, captured.back());
+    }
+
+    bool passed = true;
+    const RewindBuffer::Stats stats = buffer.getStats();
+    if (stats.frames != 10 || stats.keyframes != 3 || stats.storedBytes >= stats.snapshotBytes)
+    {
+        std::cerr << "Expected 10 frames on 3 keyframes, got " << stats.frames << " on " << stats.keyframes << std::endl;
+        passed = false;
+    }
+
+    std::vector<std::uint8_t> decoded;
+    for (std::size_t i = 0; i < captured.size(); ++i)
+    {
+        if (!buffer.decodeFrame(i, decoded) || decoded != captured[i])
+        {
+            std::cerr << "Frame " << i << " does not decode to its snapshot" << std::endl;
+            passed = false;
+        }
+    }
+
+    // Back 5 steps from step 10 lands on step 5, the first delta after the second keyframe
+    RewindBuffer::FrameInfo restored;
+    if (!buffer.rewind(world, 5.0 * dt, restored) || restored.step != 5 || buffer.getFrameCount() != 5)
+    {
+        std::cerr << "Rewind landed on step " << restored.step << " with " << buffer.getFrameCount() << " frames left" << std::endl;
+        return false;
+    }
+    std::vector<std::uint8_t> current;
+    WorldSnapshot::capture(world, current);
+    if (current != captured[4] || world.getEntity(handle)->getComponent<TransformC>()->position.y != 5.0f)
+    {
+        std::cerr << "Rewound world differs from the recorded step" << std::endl;
+        passed = false;
+    }
+
+    // The new timeline starts from a fresh keyframe and decodes on its own
+    world.getEntity(handle)->getComponent<TransformC>()->position.y = -1.0f;
+    buffer.record(world, RewindBuffer::FrameInfo{6, 6.0 * dt});
+    WorldSnapshot::capture(world, current);
+    if (buffer.getStats().keyframes != 3 || !buffer.decodeFrame(5, decoded) || decoded != current)
+    {
+        std::cerr << "Frame recorded after the rewind does not decode" << std::endl;
+        passed = false;
+    }
+    return passed;
+}
+
+int main()
+{
+    bool passed = true;
+    passed = testDeltaEncoding() && passed;
+    passed = testKeyframeChain() && passed;
+    if (!passed)
+    {
+        std::cerr << "RewindBuffer Test: FAILED" << std::endl;
+        return 1;
+    }
+    return 0;
+}
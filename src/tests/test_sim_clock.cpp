@@ -0,0 +1,145 @@
+#include <iostream>
+#include "core/SimClock.h"
+
+namespace
+{
+    // Powers of two keep every sum exact, so the checks can compare with ==
+    constexpr float Step = 1.0f / 64.0f;
+
+    /**
+     * @brief Tick once and take every step granted.
+     *
+     * @return Steps taken
+     */
+    int frame(SimClock &clock, float deltaTime)
+    {
+        clock.tick(deltaTime);
+        int steps = 0;
+        while (clock.shouldStepPhysics())
+            ++steps;
+        return steps;
+    }
+}
+
+/**
+ * @brief Whole and fractional frames grant steps as real time crosses step boundaries.
+ */
+bool testAccumulation()
+{
+    SimClock clock(Step, 8);
+    bool passed = true;
+    for (int i = 0; i < 10; ++i)
+        passed = frame(clock, Step) == 1 && passed;
+    passed = frame(clock, Step / 2.0f) == 0 && clock.getAlpha() == 0.5f && passed;
+    passed = frame(clock, Step * 0.75f) == 1 && clock.getAlpha() == 0.25f && passed;
+    passed = frame(clock, Step * 2.75f) == 3 && clock.getAlpha() == 0.0f && clock.getStepsThisTick() == 3 && passed;
+    passed = clock.getStepCount() == 14 && clock.getSimulationTime() == 14.0 * Step && clock.getDroppedTime() == 0.0 && passed;
+
+    // A jittery frame sequence under the cap steps exactly once per elapsed step
+    SimClock jittery(Step, 8);
+    const float frames[] = {0.01171875f, 0.0234375f, 0.00390625f, 0.0546875f, 0.0f, 0.015625f, 0.0703125f};
+    float elapsed = 0.0f;
+    unsigned long long steps = 0;
+    for (int repeat = 0; repeat < 50; ++repeat)
+    {
+        for (float deltaTime : frames)
+        {
+            elapsed += deltaTime;
+            steps += static_cast<unsigned long long>(frame(jittery, deltaTime));
+        }
+    }
+    passed = steps == static_cast<unsigned long long>(elapsed / Step) && jittery.getStepCount() == steps && passed;
+
+    if (!passed)
+        std::cerr << "Accumulated steps or alpha are wrong" << std::endl;
+    return passed;
+}
+
+/**
+ * @brief A long frame is capped at maxSubsteps, dropping whole steps and keeping the fraction.
+ */
+bool testSubstepCap()
+{
+    SimClock clock(Step, 4);
+    const int steps = frame(clock, 10.0f * Step + Step / 4.0f);
+    const bool passed = steps == 4 && clock.getStepsThisTick() == 4 && clock.getDroppedTime() == 6.0 * Step &&
+                        clock.getAlpha() == 0.25f && clock.getSimulationTime() == 4.0 * Step &&
+                        frame(clock, Step * 0.75f) == 1 && clock.getDroppedTime() == 6.0 * Step;
+    if (!passed)
+        std::cerr << "Substep cap granted " << steps << " steps, dropped " << clock.getDroppedTime() << " s" << std::endl;
+    return passed;
+}
+
+/**
+ * @brief Pausing stops accumulation and freezes alpha; requestStep() single-steps a paused clock.
+ */
+bool testPauseAndSingleStep()
+{
+    SimClock clock(Step, 8);
+    frame(clock, Step * 1.5f);
+    clock.setPaused(true);
+
+    bool passed = frame(clock, 1.0f) == 0 && clock.getAlpha() == 0.5f && clock.getStepCount() == 1;
+    clock.requestStep();
+    clock.requestStep();
+    passed = frame(clock, 1.0f) == 2 && clock.getAlpha() == 0.5f && clock.getSimulationTime() == 3.0 * Step && passed;
+    passed = frame(clock, 1.0f) == 0 && passed;
+
+    clock.setPaused(false);
+    passed = frame(clock, Step / 2.0f) == 1 && clock.getAlpha() == 0.0f && clock.getStepCount() == 4 && passed;
+    if (!passed)
+        std::cerr << "Pause or single step misbehaved" << std::endl;
+    return passed;
+}
+
+/**
+ * @brief The time scale stretches real time into simulated time; zero and negative scales stop it.
+ */
+bool testTimeScale()
+{
+    SimClock clock(Step, 8);
+    clock.setTimeScale(0.5f);
+    bool passed = frame(clock, Step) == 0 && clock.getAlpha() == 0.5f && frame(clock, Step) == 1;
+    clock.setTimeScale(4.0f);
+    passed = frame(clock, Step) == 4 && clock.getSimulationTime() == 5.0 * Step && passed;
+    clock.setTimeScale(-1.0f);
+    passed = clock.getTimeScale() == 0.0f && frame(clock, 1.0f) == 0 && passed;
+    if (!passed)
+        std::cerr << "Time scale misbehaved" << std::endl;
+    return passed;
+}
+
+/**
+ * @brief restoreTime() moves the clock and discards accumulated time and steps still pending.
+ */
+bool testRestoreTime()
+{
+    SimClock clock(Step, 8);
+    clock.tick(3.5f * Step);
+    clock.shouldStepPhysics();
+    clock.requestStep();
+    clock.restoreTime(1.5, 96);
+
+    bool passed = !clock.shouldStepPhysics() && clock.getAlpha() == 0.0f && clock.getSimulationTime() == 1.5 &&
+                  clock.getStepCount() == 96;
+    passed = frame(clock, Step) == 1 && clock.getSimulationTime() == 1.5 + Step && clock.getStepCount() == 97 && passed;
+    if (!passed)
+        std::cerr << "restoreTime() kept stale time or steps" << std::endl;
+    return passed;
+}
+
+int main()
+{
+    bool passed = true;
+    passed = testAccumulation() && passed;
+    passed = testSubstepCap() && passed;
+    passed = testPauseAndSingleStep() && passed;
+    passed = testTimeScale() && passed;
+    passed = testRestoreTime() && passed;
+    if (!passed)
+    {
+        std::cerr << "SimClock Test: FAILED" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,264 @@
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+#include "core/EventBus.h"
+#include "core/SpatialIndex.h"
+#include "core/World.h"
+#include "systems/SpatialIndexSystem.h"
+#include "components/TransformC.h"
+#include "components/PhysicsC.h"
+
+namespace
+{
+    /** @brief A proxy as the test believes it to be */
+    struct LiveProxy
+    {
+        SpatialIndex::ProxyId id;
+        EntityHandle entity;
+        Aabb bounds;
+    };
+
+    constexpr float WorldSize = 100.0f;
+
+    Aabb randomBox(std::mt19937 &rng, const Vector3D &center)
+    {
+        std::uniform_real_distribution<float> extent(0.05f, 3.0f);
+        const Vector3D half(extent(rng), extent(rng), extent(rng));
+        return Aabb{center - half, center + half};
+    }
+
+    Vector3D randomPoint(std::mt19937 &rng)
+    {
+        std::uniform_real_distribution<float> coordinate(-WorldSize, WorldSize);
+        return Vector3D(coordinate(rng), coordinate(rng), coordinate(rng));
+    }
+
+    /** @brief The query's own leaf test: a box counts unless it lies wholly outside one plane */
+    bool touchesFrustum(const Frustum &frustum, const Aabb &box)
+    {
+        for (const Frustum::Plane &plane : frustum.planes)
+        {
+            const Vector3D &n = plane.normal;
+            const float farthest = n.x * (n.x >= 0.0f ? box.max.x : box.min.x) + n.y * (n.y >= 0.0f ? box.max.y : box.min.y) +
+                                   n.z * (n.z >= 0.0f ? box.max.z : box.min.z) + plane.distance;
+            if (farthest < 0.0f)
+                return false;
+        }
+        return true;
+    }
+
+    /** @brief Perspective looking down -Z from the origin (row vectors, OpenGL clip space) */
+    Matrix4 perspective(float focal, float nearPlane, float farPlane)
+    {
+        Matrix4 m;
+        m.m[0] = focal;
+        m.m[5] = focal;
+        m.m[10] = (farPlane + nearPlane) / (nearPlane - farPlane);
+        m.m[11] = -1.0f;
+        m.m[14] = 2.0f * farPlane * nearPlane / (nearPlane - farPlane);
+        m.m[15] = 0.0f;
+        return m;
+    }
+
+    std::vector<std::uint64_t> sortedValues(const std::vector<EntityHandle> &handles)
+    {
+        std::vector<std::uint64_t> values;
+        for (EntityHandle handle : handles)
+            values.push_back(handle.value());
+        std::sort(values.begin(), values.end());
+        return values;
+    }
+
+    template <typename Predicate>
+    std::vector<std::uint64_t> bruteForce(const std::vector<LiveProxy> &live, Predicate &&predicate)
+    {
+        std::vector<EntityHandle> handles;
+        for (const LiveProxy &proxy : live)
+        {
+            if (predicate(proxy.bounds))
+                handles.push_back(proxy.entity);
+        }
+        return sortedValues(handles);
+    }
+
+    /**
+     * @brief Compare every query type against brute force at a few random probes.
+     *
+     * @return false at the first mismatch
+     */
+    bool queriesMatch(const SpatialIndex &index, const std::vector<LiveProxy> &live, std::mt19937 &rng, int round)
+    {
+        std::vector<EntityHandle> results;
+        for (int probe = 0; probe < 4; ++probe)
+        {
+            const Aabb box = randomBox(rng, randomPoint(rng));
+            const Aabb wide{box.min * 4.0f, box.max * 4.0f};
+            index.queryAabb(wide, results);
+            if (sortedValues(results) != bruteForce(live, [&wide](const Aabb &bounds)
+                                                    { return bounds.overlaps(wide); }))
+            {
+                std::cerr << "queryAabb mismatch in round " << round << std::endl;
+                return false;
+            }
+
+            const Vector3D center = randomPoint(rng);
+            const float radius = std::uniform_real_distribution<float>(0.0f, 30.0f)(rng);
+            index.querySphere(center, radius, results);
+            if (sortedValues(results) != bruteForce(live, [&center, radius](const Aabb &bounds)
+                                                    { return bounds.distanceSq(center) <= radius * radius; }))
+            {
+                std::cerr << "querySphere mismatch in round " << round << std::endl;
+                return false;
+            }
+
+            // Perspective frusta from the origin, offset so the camera sits somewhere random
+            const Vector3D eye = randomPoint(rng);
+            Matrix4 view;
+            view.m[12] = -eye.x;
+            view.m[13] = -eye.y;
+            view.m[14] = -eye.z;
+            const Frustum frustum = Frustum::fromMatrix(view * perspective(1.0f + probe * 0.5f, 0.5f, 80.0f));
+            index.queryFrustum(frustum, results);
+            if (sortedValues(results) != bruteForce(live, [&frustum](const Aabb &bounds)
+                                                    { return touchesFrustum(frustum, bounds); }))
+            {
+                std::cerr << "queryFrustum mismatch in round " << round << std::endl;
+                return false;
+            }
+
+            // Nearest: the distances must match brute force exactly, ties may pick either entity
+            const Vector3D point = randomPoint(rng);
+            const std::size_t count = probe == 0 ? 1 : (probe == 1 ? 7 : 40);
+            const float maxDistance = probe == 3 ? 25.0f : std::numeric_limits<float>::max();
+            index.queryNearest(point, count, results, maxDistance);
+            std::vector<float> expected;
+            for (const LiveProxy &proxy : live)
+            {
+                const float distanceSq = proxy.bounds.distanceSq(point);
+                if (probe != 3 || distanceSq <= maxDistance * maxDistance)
+                    expected.push_back(distanceSq);
+            }
+            std::sort(expected.begin(), expected.end());
+            expected.resize(std::min(expected.size(), count));
+
+            std::vector<float> found;
+            for (EntityHandle handle : results)
+            {
+                const auto proxy = std::find_if(live.begin(), live.end(), [handle](const LiveProxy &candidate)
+                                                { return candidate.entity == handle; });
+                found.push_back(proxy != live.end() ? proxy->bounds.distanceSq(point) : -1.0f);
+            }
+            if (found != expected)
+            {
+                std::cerr << "queryNearest mismatch in round " << round << ": " << found.size() << " results, "
+                          << expected.size() << " expected" << std::endl;
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+/**
+ * @brief Random creates, jitters, jumps and destroys keep every query equal to brute force.
+ */
+bool testRandomizedAgainstBruteForce()
+{
+    std::mt19937 rng(20240611u);
+    std::uniform_int_distribution<int> action(0, 9);
+    std::uniform_real_distribution<float> jitter(-0.2f, 0.2f);
+    SpatialIndex index;
+    std::vector<LiveProxy> live;
+    std::uint32_t nextEntity = 0;
+
+    for (int round = 0; round < 400; ++round)
+    {
+        for (int op = 0; op < 25; ++op)
+        {
+            const int kind = action(rng);
+            if (live.empty() || kind < 3)
+            {
+                EntityHandle entity;
+                entity.index = nextEntity++;
+                const Aabb bounds = randomBox(rng, randomPoint(rng));
+                live.push_back(LiveProxy{index.createProxy(bounds, entity), entity, bounds});
+                continue;
+            }
+
+            LiveProxy &proxy = live[std::uniform_int_distribution<std::size_t>(0, live.size() - 1)(rng)];
+            if (kind < 7)
+            {
+                // Small moves mostly stay inside the fat box; try the tree-free path first
+                const Vector3D offset(jitter(rng), jitter(rng), jitter(rng));
+                const Aabb bounds{proxy.bounds.min + offset, proxy.bounds.max + offset};
+                if (!index.setBounds(proxy.id, bounds))
+                    index.moveProxy(proxy.id, bounds);
+                proxy.bounds = bounds;
+            }
+            else if (kind < 9)
+            {
+                proxy.bounds = randomBox(rng, randomPoint(rng));
+                index.moveProxy(proxy.id, proxy.bounds);
+            }
+            else
+            {
+                index.destroyProxy(proxy.id);
+                proxy = live.back();
+                live.pop_back();
+            }
+        }
+
+        if (index.getProxyCount() != live.size() || !queriesMatch(index, live, rng, round))
+            return false;
+    }
+
+    for (const LiveProxy &proxy : live)
+        index.destroyProxy(proxy.id);
+    if (index.getProxyCount() != 0 || index.getHeight() != 0)
+    {
+        std::cerr << "Index not empty after destroying every proxy" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Resizing a collider in place changes the indexed bounds at the next update.
+ */
+bool testColliderResize()
+{
+    EventBus bus;
+    World world(bus);
+    SpatialIndexSystem system(world);
+    Entity &entity = world.createEntity("box");
+    entity.addComponent(std::make_unique<TransformC>());
+    entity.addComponent(std::make_unique<PhysicsC>());
+
+    std::vector<EntityHandle> results;
+    system.update(world, 0.0f);
+    system.getIndex().querySphere(Vector3D(3.5f, 0.0f, 0.0f), 0.25f, results);
+    bool passed = results.empty();
+
+    entity.getComponent<PhysicsC>()->colliderSize[0] = 8.0f;
+    system.update(world, 0.0f);
+    system.getIndex().querySphere(Vector3D(3.5f, 0.0f, 0.0f), 0.25f, results);
+    passed = results.size() == 1 && results[0] == entity.getHandle() && passed;
+    if (!passed)
+        std::cerr << "Resized collider kept its old bounds" << std::endl;
+    return passed;
+}
+
+int main()
+{
+    bool passed = true;
+    passed = testRandomizedAgainstBruteForce() && passed;
+    passed = testColliderResize() && passed;
+    if (!passed)
+    {
+        std::cerr << "SpatialIndex Test: FAILED" << std::endl;
+        return 1;
+    }
+    return 0;
+}
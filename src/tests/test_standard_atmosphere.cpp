@@ -0,0 +1,106 @@
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "physics/StandardAtmosphereModel.h"
+
+namespace
+{
+    /** @brief One row of the U.S. Standard Atmosphere 1976 tables, by geometric altitude */
+    struct Reference
+    {
+        float altitude;     /**< Geometric altitude in m */
+        float temperature;  /**< K */
+        float pressure;     /**< Pa */
+        float density;      /**< kg/m³ */
+        float speedOfSound; /**< m/s */
+    };
+
+    // Sea level, tropopause, lower stratosphere and the bases of the two warming layers
+    const Reference Table[] = {
+        {0.0f, 288.150f, 101325.0f, 1.2250f, 340.29f},
+        {11000.0f, 216.774f, 22700.0f, 0.36480f, 295.15f},
+        {13000.0f, 216.650f, 16580.0f, 0.26660f, 295.07f},
+        {20000.0f, 216.650f, 5529.3f, 0.088910f, 295.07f},
+        {32000.0f, 228.490f, 889.06f, 0.013555f, 303.02f},
+        {47000.0f, 269.680f, 115.85f, 0.0014965f, 329.21f},
+    };
+
+    bool close(float value, float expected, float tolerance)
+    {
+        return std::fabs(value - expected) <= tolerance * std::fabs(expected);
+    }
+}
+
+/**
+ * @brief Density, pressure, temperature and speed of sound match the 1976 tables.
+ */
+bool testAgainstUs1976()
+{
+    const StandardAtmosphereModel atmosphere;
+    bool passed = true;
+    for (const Reference &row : Table)
+    {
+        const AtmosphereState state = atmosphere.getState(row.altitude);
+        // The tables are rounded to five digits; interpolation adds at most 1e-4
+        if (!close(state.density, row.density, 1e-3f) || !close(state.pressure, row.pressure, 1e-3f) ||
+            !close(state.temperature, row.temperature, 1e-4f) || !close(state.speedOfSound, row.speedOfSound, 1e-4f) ||
+            atmosphere.getDensity(row.altitude) != state.density)
+        {
+            std::cerr << "At " << row.altitude << " m: density " << state.density << " (" << row.density << "), pressure "
+                      << state.pressure << " (" << row.pressure << "), temperature " << state.temperature << " ("
+                      << row.temperature << "), speed of sound " << state.speedOfSound << " (" << row.speedOfSound
+                      << ")" << std::endl;
+            passed = false;
+        }
+    }
+    return passed;
+}
+
+/**
+ * @brief The batch queries return exactly what the single queries do, inside and outside the table.
+ */
+bool testBatchMatchesScalar()
+{
+    const StandardAtmosphereModel atmosphere;
+    std::mt19937 rng(5u);
+    std::uniform_real_distribution<float> altitude(StandardAtmosphereModel::MinAltitude - 3000.0f,
+                                                   StandardAtmosphereModel::MaxAltitude + 20000.0f);
+    std::vector<float> altitudes;
+    for (int i = 0; i < 2001; ++i)
+        altitudes.push_back(altitude(rng));
+    altitudes.push_back(StandardAtmosphereModel::MinAltitude);
+    altitudes.push_back(StandardAtmosphereModel::MaxAltitude);
+    altitudes.push_back(11000.0f);
+
+    std::vector<float> densities(altitudes.size());
+    std::vector<AtmosphereState> states(altitudes.size());
+    atmosphere.getDensityBatch(altitudes.data(), densities.data(), altitudes.size());
+    atmosphere.getStateBatch(altitudes.data(), states.data(), altitudes.size());
+    for (std::size_t i = 0; i < altitudes.size(); ++i)
+    {
+        const AtmosphereState state = atmosphere.getState(altitudes[i]);
+        if (densities[i] != atmosphere.getDensity(altitudes[i]) ||
+            std::memcmp(&states[i], &state, sizeof(AtmosphereState)) != 0)
+        {
+            std::cerr << "Batch query differs at " << altitudes[i] << " m: " << densities[i] << " vs "
+                      << atmosphere.getDensity(altitudes[i]) << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+int main()
+{
+    bool passed = true;
+    passed = testAgainstUs1976() && passed;
+    passed = testBatchMatchesScalar() && passed;
+    if (!passed)
+    {
+        std::cerr << "StandardAtmosphereModel Test: FAILED" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,143 @@
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "physics/SweepAndPrune.h"
+
+namespace
+{
+    /** @brief A body as the caller sees it: stable handle plus current box */
+    struct Body
+    {
+        EntityHandle handle;
+        Aabb bounds;
+    };
+
+    Aabb randomBox(std::mt19937 &rng)
+    {
+        std::uniform_real_distribution<float> coordinate(-30.0f, 30.0f);
+        std::uniform_real_distribution<float> extent(0.25f, 2.0f);
+        const Vector3D center(coordinate(rng), coordinate(rng), 0.2f * coordinate(rng));
+        const Vector3D half(extent(rng), extent(rng), extent(rng));
+        return Aabb{center - half, center + half};
+    }
+
+    std::vector<BroadphasePair> bruteForce(const std::vector<Aabb> &bounds, std::size_t dynamicCount)
+    {
+        std::vector<BroadphasePair> pairs;
+        for (std::uint32_t i = 0; i < bounds.size(); ++i)
+        {
+            for (std::uint32_t j = i + 1; j < bounds.size(); ++j)
+            {
+                if ((i < dynamicCount || j < dynamicCount) && bounds[i].overlaps(bounds[j]))
+                    pairs.push_back(BroadphasePair{i, j});
+            }
+        }
+        return pairs;
+    }
+
+    bool samePairs(const std::vector<BroadphasePair> &a, const std::vector<BroadphasePair> &b)
+    {
+        return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](const BroadphasePair &x, const BroadphasePair &y)
+                                                  { return x.first == y.first && x.second == y.second; });
+    }
+}
+
+/**
+ * @brief Pairs match brute force while bodies move, are reordered, change partition, come and go.
+ */
+bool testAgainstBruteForceAcrossReorders()
+{
+    std::mt19937 rng(424242u);
+    std::uniform_real_distribution<float> jitter(-0.3f, 0.3f);
+    std::vector<Body> bodies;
+    std::uint32_t nextSlot = 0;
+    for (int i = 0; i < 600; ++i)
+        bodies.push_back(Body{EntityHandle::fromValue(nextSlot++), randomBox(rng)});
+
+    SweepAndPrune sweep;
+    std::vector<BroadphasePair> pairs;
+    std::vector<Aabb> bounds;
+    std::vector<EntityHandle> keys;
+    for (int frame = 0; frame < 300; ++frame)
+    {
+        for (Body &body : bodies)
+        {
+            const Vector3D offset(jitter(rng), jitter(rng), jitter(rng));
+            body.bounds = Aabb{body.bounds.min + offset, body.bounds.max + offset};
+        }
+
+        // Regroup like the physics gather: a random run of bodies moves to the front
+        const std::size_t begin = std::uniform_int_distribution<std::size_t>(0, bodies.size() - 1)(rng);
+        const std::size_t end = std::uniform_int_distribution<std::size_t>(begin, bodies.size())(rng);
+        std::rotate(bodies.begin(), bodies.begin() + static_cast<std::ptrdiff_t>(begin),
+                    bodies.begin() + static_cast<std::ptrdiff_t>(end));
+        if (frame % 7 == 0)
+            std::shuffle(bodies.begin(), bodies.end(), rng);
+        if (frame % 11 == 0)
+            bodies[frame % bodies.size()] = Body{EntityHandle::fromValue(nextSlot++), randomBox(rng)};
+        if (frame % 13 == 0)
+            bodies.push_back(Body{EntityHandle::fromValue(nextSlot++), randomBox(rng)});
+        if (frame % 17 == 0)
+            bodies.erase(bodies.begin() + static_cast<std::ptrdiff_t>(frame % bodies.size()));
+
+        bounds.clear();
+        keys.clear();
+        for (const Body &body : bodies)
+        {
+            bounds.push_back(body.bounds);
+            keys.push_back(body.handle);
+        }
+        const std::size_t dynamicCount = std::uniform_int_distribution<std::size_t>(0, bodies.size())(rng);
+        sweep.update(bounds.data(), keys.data(), bounds.size(), dynamicCount, pairs);
+        if (!samePairs(pairs, bruteForce(bounds, dynamicCount)))
+        {
+            std::cerr << "Pairs differ from brute force in frame " << frame << ": " << pairs.size() << " found" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Without keys, boxes keep their identity by index.
+ */
+bool testWithoutKeys()
+{
+    std::mt19937 rng(7u);
+    std::uniform_real_distribution<float> jitter(-0.5f, 0.5f);
+    std::vector<Aabb> bounds;
+    for (int i = 0; i < 300; ++i)
+        bounds.push_back(randomBox(rng));
+
+    SweepAndPrune sweep;
+    std::vector<BroadphasePair> pairs;
+    for (int frame = 0; frame < 100; ++frame)
+    {
+        for (Aabb &box : bounds)
+        {
+            const Vector3D offset(jitter(rng), jitter(rng), jitter(rng));
+            box = Aabb{box.min + offset, box.max + offset};
+        }
+        sweep.update(bounds.data(), nullptr, bounds.size(), bounds.size() / 2, pairs);
+        if (!samePairs(pairs, bruteForce(bounds, bounds.size() / 2)))
+        {
+            std::cerr << "Keyless pairs differ from brute force in frame " << frame << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+int main()
+{
+    bool passed = true;
+    passed = testAgainstBruteForceAcrossReorders() && passed;
+    passed = testWithoutKeys() && passed;
+    if (!passed)
+    {
+        std::cerr << "SweepAndPrune Test: FAILED" << std::endl;
+        return 1;
+    }
+    return 0;
+}
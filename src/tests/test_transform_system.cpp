@@ -0,0 +1,194 @@
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include "core/EventBus.h"
+#include "core/World.h"
+#include "systems/TransformSystem.h"
+#include "components/TransformC.h"
+#include "components/HierarchyC.h"
+
+namespace
+{
+    /** @brief Entities of the test hierarchy: root -> arm -> tip, plus an unrelated pair */
+    struct Scene
+    {
+        EntityHandle root;
+        EntityHandle arm;
+        EntityHandle tip;
+        EntityHandle other;
+        EntityHandle otherChild;
+    };
+
+    EntityHandle spawn(World &world, const char *name, const Vector3D &position, const Quaternion &rotation = Quaternion())
+    {
+        Entity &entity = world.createEntity(name);
+        entity.addComponent(std::make_unique<TransformC>(position, rotation));
+        return entity.getHandle();
+    }
+
+    Scene buildScene(World &world, TransformSystem &transforms)
+    {
+        // The arm is turned 90 degrees about Z, so the tip's local +X points along the root's +Y
+        const float halfTurn = std::sqrt(0.5f);
+        Scene scene;
+        scene.root = spawn(world, "root", Vector3D(10.0f, 0.0f, 0.0f));
+        scene.arm = spawn(world, "arm", Vector3D(0.0f, 5.0f, 0.0f), Quaternion(halfTurn, 0.0f, 0.0f, halfTurn));
+        scene.tip = spawn(world, "tip", Vector3D(1.0f, 0.0f, 0.0f));
+        scene.other = spawn(world, "other", Vector3D(0.0f, 0.0f, -3.0f));
+        scene.otherChild = spawn(world, "otherChild", Vector3D(0.0f, 1.0f, 0.0f));
+        transforms.setParent(scene.arm, scene.root);
+        transforms.setParent(scene.tip, scene.arm);
+        transforms.setParent(scene.otherChild, scene.other);
+        return scene;
+    }
+
+    TransformC &transformOf(World &world, EntityHandle handle)
+    {
+        return *world.getEntity(handle)->getComponent<TransformC>();
+    }
+
+    bool near(const Vector3D &a, const Vector3D &b)
+    {
+        return std::fabs(a.x - b.x) < 1e-5f && std::fabs(a.y - b.y) < 1e-5f && std::fabs(a.z - b.z) < 1e-5f;
+    }
+}
+
+/**
+ * @brief Only the moved node and its subtree are recomputed; an idle update recomputes nothing.
+ */
+bool testDirtySubtree()
+{
+    EventBus bus;
+    World world(bus);
+    TransformSystem transforms(world);
+    const Scene scene = buildScene(world, transforms);
+
+    transforms.update(world, 0.0f);
+    bool passed = transforms.getNodeCount() == 5 && transforms.getUpdatedCount() == 5;
+    transforms.update(world, 0.0f);
+    passed = transforms.getUpdatedCount() == 0 && passed;
+
+    transformOf(world, scene.root).position.x = 20.0f;
+    transforms.update(world, 0.0f);
+    passed = transforms.getUpdatedCount() == 3 && passed;
+
+    transformOf(world, scene.tip).scale.y = 2.0f;
+    transforms.update(world, 0.0f);
+    passed = transforms.getUpdatedCount() == 1 && passed;
+
+    transformOf(world, scene.other).rotation = Quaternion(0.0f, 1.0f, 0.0f, 0.0f);
+    transforms.update(world, 0.0f);
+    passed = transforms.getUpdatedCount() == 2 && passed;
+    if (!passed)
+        std::cerr << "Dirty propagation recomputed " << transforms.getUpdatedCount() << " nodes" << std::endl;
+    return passed;
+}
+
+/**
+ * @brief A child's world matrix is its local matrix times its parent's world matrix.
+ */
+bool testWorldMatrices()
+{
+    EventBus bus;
+    World world(bus);
+    TransformSystem transforms(world);
+    const Scene scene = buildScene(world, transforms);
+    transforms.update(world, 0.0f);
+
+    const Matrix4 *root = transforms.getWorldMatrix(scene.root);
+    const Matrix4 *arm = transforms.getWorldMatrix(scene.arm);
+    const Matrix4 *tip = transforms.getWorldMatrix(scene.tip);
+    if (root == nullptr || arm == nullptr || tip == nullptr)
+    {
+        std::cerr << "Hierarchy nodes have no world matrix" << std::endl;
+        return false;
+    }
+
+    bool passed = true;
+    const EntityHandle handles[] = {scene.arm, scene.tip};
+    const Matrix4 *parents[] = {root, arm};
+    const Matrix4 *children[] = {arm, tip};
+    for (int i = 0; i < 2; ++i)
+    {
+        const TransformC &local = transformOf(world, handles[i]);
+        const Matrix4 expected = Matrix4::fromTransform(local.position, local.rotation, local.scale) * *parents[i];
+        for (int e = 0; e < 16; ++e)
+            passed = std::fabs(expected.m[e] - children[i]->m[e]) < 1e-5f && passed;
+    }
+
+    // root (10,0,0) + arm offset (0,5,0) + tip's (1,0,0) turned onto +Y
+    passed = near(tip->getTranslation(), Vector3D(10.0f, 6.0f, 0.0f)) &&
+             near(tip->transformPoint(Vector3D(1.0f, 0.0f, 0.0f)), Vector3D(10.0f, 7.0f, 0.0f)) && passed;
+    if (!passed)
+        std::cerr << "Child world matrix is not local * parentWorld" << std::endl;
+    return passed;
+}
+
+/**
+ * @brief setParent() refuses links that close a cycle, and rebuild() cuts cycles made by editing HierarchyC.
+ */
+bool testCycles()
+{
+    EventBus bus;
+    World world(bus);
+    TransformSystem transforms(world);
+    const Scene scene = buildScene(world, transforms);
+
+    bool passed = !transforms.setParent(scene.root, scene.tip) && !transforms.setParent(scene.root, scene.root) &&
+                  !transforms.getParent(scene.root).isValid() && transforms.getParent(scene.tip) == scene.arm;
+
+    // Bypass setParent() to close root -> tip -> arm -> root
+    world.getEntity(scene.root)->addComponent(std::make_unique<HierarchyC>(scene.tip));
+    transforms.update(world, 0.0f);
+    passed = transforms.getNodeCount() == 5 && transforms.getUpdatedCount() == 5 && passed;
+    for (EntityHandle handle : {scene.root, scene.arm, scene.tip})
+    {
+        const Matrix4 *matrix = transforms.getWorldMatrix(handle);
+        passed = matrix != nullptr && std::isfinite(matrix->m[12]) && std::isfinite(matrix->m[13]) && passed;
+    }
+
+    passed = transforms.setParent(scene.root, EntityHandle()) && passed;
+    transforms.update(world, 0.0f);
+    passed = near(transforms.getWorldMatrix(scene.tip)->getTranslation(), Vector3D(10.0f, 6.0f, 0.0f)) && passed;
+    if (!passed)
+        std::cerr << "Hierarchy cycles were not refused or cut" << std::endl;
+    return passed;
+}
+
+/**
+ * @brief Destroying a parent turns its child into a root at the next update.
+ */
+bool testDestroyParent()
+{
+    EventBus bus;
+    World world(bus);
+    TransformSystem transforms(world);
+    const Scene scene = buildScene(world, transforms);
+    transforms.update(world, 0.0f);
+
+    world.destroyEntity(scene.arm);
+    transforms.update(world, 0.0f);
+
+    const Matrix4 *tip = transforms.getWorldMatrix(scene.tip);
+    const bool passed = transforms.getNodeCount() == 4 && transforms.getWorldMatrix(scene.arm) == nullptr &&
+                        tip != nullptr && near(tip->getTranslation(), Vector3D(1.0f, 0.0f, 0.0f)) &&
+                        near(transforms.getWorldMatrix(scene.otherChild)->getTranslation(), Vector3D(0.0f, 1.0f, -3.0f));
+    if (!passed)
+        std::cerr << "Orphaned child did not become a root" << std::endl;
+    return passed;
+}
+
+int main()
+{
+    bool passed = true;
+    passed = testDirtySubtree() && passed;
+    passed = testWorldMatrices() && passed;
+    passed = testCycles() && passed;
+    passed = testDestroyParent() && passed;
+    if (!passed)
+    {
+        std::cerr << "TransformSystem Test: FAILED" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,133 @@
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <vector>
+#include "core/EventBus.h"
+#include "core/World.h"
+#include "core/WorldSnapshot.h"
+#include "components/PhysicsC.h"
+#include "components/TransformC.h"
+
+namespace
+{
+    /**
+     * @brief Build a world with a few moving bodies and one freed slot.
+     */
+    void populate(World &world)
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            Entity &entity = world.createEntity("body" + std::to_string(i));
+            entity.addComponent(std::make_unique<TransformC>(Vector3D(static_cast<float>(i), 2.0f, 0.0f)));
+            auto physics = std::make_unique<PhysicsC>();
+            physics->velocity = Vector3D(0.0f, -static_cast<float>(i), 0.0f);
+            entity.addComponent(std::move(physics));
+            entity.setCustomProperty("index", std::to_string(i));
+        }
+        world.destroyEntity(world.getEntities()[1]->getHandle());
+    }
+}
+
+/**
+ * @brief Capture, change, restore and capture again gives the same bytes and the same handles.
+ */
+bool testRoundTrip()
+{
+    EventBus bus;
+    World world(bus);
+    populate(world);
+
+    std::vector<std::uint8_t> before;
+    WorldSnapshot::capture(world, before);
+    const EntityHandle kept = world.getEntities()[0]->getHandle();
+
+    world.getEntity(kept)->getComponent<TransformC>()->position = Vector3D(9.0f, 9.0f, 9.0f);
+    world.destroyEntity(world.getEntities().back()->getHandle());
+    world.createEntity("spawned").addComponent(std::make_unique<TransformC>());
+
+    if (!WorldSnapshot::restore(world, before.data(), before.size()))
+    {
+        std::cerr << "Valid snapshot was rejected" << std::endl;
+        return false;
+    }
+
+    std::vector<std::uint8_t> after;
+    WorldSnapshot::capture(world, after);
+    if (after != before || world.getEntities().size() != 3)
+    {
+        std::cerr << "Restored world differs from the captured one" << std::endl;
+        return false;
+    }
+    Entity *entity = world.getEntity(kept);
+    if (!entity || entity->getComponent<TransformC>()->position.x != 0.0f)
+    {
+        std::cerr << "Surviving entity was not restored in place" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Snapshots with a wrong magic, a wrong version or a cut-off end are rejected without touching the world.
+ */
+bool testRejectsInvalid()
+{
+    EventBus bus;
+    World world(bus);
+    populate(world);
+
+    std::vector<std::uint8_t> snapshot;
+    WorldSnapshot::capture(world, snapshot);
+    const std::uint64_t hash = WorldSnapshot::hash(snapshot.data(), snapshot.size());
+
+    std::vector<std::vector<std::uint8_t>> invalid;
+    invalid.push_back(snapshot);
+    invalid.back()[0] ^= 0xFF; // magic
+    invalid.push_back(snapshot);
+    invalid.back()[4] += 1; // version
+    invalid.push_back(std::vector<std::uint8_t>(snapshot.begin(), snapshot.end() - 3));
+    invalid.push_back(std::vector<std::uint8_t>(snapshot.begin(), snapshot.begin() + 10));
+    invalid.push_back(snapshot);
+    invalid.back().push_back(0); // trailing garbage
+
+    world.createEntity("unchanged");
+    std::vector<std::uint8_t> current;
+    WorldSnapshot::capture(world, current);
+
+    bool passed = true;
+    for (std::size_t i = 0; i < invalid.size(); ++i)
+    {
+        if (WorldSnapshot::restore(world, invalid[i].data(), invalid[i].size()))
+        {
+            std::cerr << "Invalid snapshot " << i << " was accepted" << std::endl;
+            passed = false;
+        }
+    }
+
+    std::vector<std::uint8_t> after;
+    WorldSnapshot::capture(world, after);
+    if (after != current)
+    {
+        std::cerr << "A rejected snapshot changed the world" << std::endl;
+        passed = false;
+    }
+    if (WorldSnapshot::hash(snapshot.data(), snapshot.size()) != hash)
+    {
+        std::cerr << "Hash is not stable" << std::endl;
+        passed = false;
+    }
+    return passed;
+}
+
+int main()
+{
+    bool passed = true;
+    passed = testRoundTrip() && passed;
+    passed = testRejectsInvalid() && passed;
+    if (!passed)
+    {
+        std::cerr << "WorldSnapshot Test: FAILED" << std::endl;
+        return 1;
+    }
+    return 0;
+}
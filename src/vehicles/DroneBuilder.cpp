@@ -1,13 +1,428 @@
 #include "DroneBuilder.h"
+#include "components/TransformC.h"
+#include "components/PhysicsC.h"
+#include "components/VehicleC.h"
+#include "components/MultirotorC.h"
+#include "../debug.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    constexpr float Gravity = 9.81f;
+    constexpr float RpmPerVoltToRadPerSecondPerVolt = 2.0f * 3.14159265f / 60.0f;
+
+    /** @brief Resting voltage of a LiPo cell at nominal charge */
+    constexpr float CellNominalVoltage = 3.7f;
+
+    // Figures of a typical 4S FPV power train, used for whatever the file does not define
+    constexpr float DefaultKv = 2750.0f;                /**< Motor KV in rpm/V */
+    constexpr float DefaultPropDiameter = 0.1016f;      /**< 4 inch propeller */
+    constexpr float DefaultThrustToWeight = 8.0f;       /**< Total static thrust over weight */
+    constexpr int DefaultCellCount = 4;
+    constexpr float DefaultCapacityAh = 0.85f;
+    constexpr float DefaultMaxDischargeC = 75.0f;
+    constexpr float DefaultMotorTimeConstant = 0.03f;   /**< Spin-up time constant of a 4 inch rotor, in s */
+
+    /** @brief Drag torque over thrust per meter of propeller diameter: CQ / CT of small FPV propellers */
+    constexpr float TorquePerThrustPerDiameter = 0.08f;
+
+    /** @brief Fraction of the nominal pack voltage lost to sag at the rated maximum discharge */
+    constexpr float SagAtMaxDischarge = 0.15f;
+
+    /** @brief Height of the frame's collider in m */
+    constexpr float FrameHeight = 0.04f;
+
+    /**
+     * @brief Find the next element with the given tag at or after pos.
+     *
+     * @return Offset of its '<', or npos; end receives the offset past the element
+     */
+    std::size_t findElement(const std::string &xml, const std::string &tag, std::size_t pos, std::size_t &end)
+    {
+        const std::string open = "<" + tag;
+        while ((pos = xml.find(open, pos)) != std::string::npos)
+        {
+            const std::size_t after = pos + open.size();
+            const char next = after < xml.size() ? xml[after] : '\0';
+            if (next == '>' || next == '/' || std::isspace(static_cast<unsigned char>(next)))
+            {
+                const std::size_t tagEnd = xml.find('>', after);
+                if (tagEnd == std::string::npos)
+                    return std::string::npos;
+                if (xml[tagEnd - 1] == '/')
+                {
+                    end = tagEnd + 1;
+                    return pos;
+                }
+                const std::string close = "</" + tag + ">";
+                const std::size_t closePos = xml.find(close, tagEnd);
+                if (closePos == std::string::npos)
+                    return std::string::npos;
+                end = closePos + close.size();
+                return pos;
+            }
+            pos = after;
+        }
+        return std::string::npos;
+    }
+
+    /**
+     * @brief Every element with the given tag, including its own tags.
+     */
+    std::vector<std::string> extractElements(const std::string &xml, const std::string &tag)
+    {
+        std::vector<std::string> elements;
+        std::size_t pos = 0, end = 0;
+        while ((pos = findElement(xml, tag, pos, end)) != std::string::npos)
+        {
+            elements.push_back(xml.substr(pos, end - pos));
+            pos = end;
+        }
+        return elements;
+    }
+
+    /**
+     * @brief Trimmed content of the first element with the given tag, or an empty string.
+     */
+    std::string extractValue(const std::string &xml, const std::string &tag)
+    {
+        std::size_t end = 0;
+        const std::size_t pos = findElement(xml, tag, 0, end);
+        if (pos == std::string::npos)
+            return "";
+        const std::size_t contentStart = xml.find('>', pos) + 1;
+        const std::size_t contentEnd = xml.rfind("</", end);
+        if (contentEnd == std::string::npos || contentEnd < contentStart)
+            return "";
+        std::string value = xml.substr(contentStart, contentEnd - contentStart);
+        const std::size_t first = value.find_first_not_of(" \t\r\n");
+        const std::size_t last = value.find_last_not_of(" \t\r\n");
+        return first == std::string::npos ? "" : value.substr(first, last - first + 1);
+    }
+
+    /**
+     * @brief Value of an attribute on an element's opening tag, or an empty string.
+     */
+    std::string extractAttribute(const std::string &element, const std::string &name)
+    {
+        const std::string openTag = element.substr(0, element.find('>'));
+        const std::string needle = " " + name + "=\"";
+        const std::size_t pos = openTag.find(needle);
+        if (pos == std::string::npos)
+            return "";
+        const std::size_t start = pos + needle.size();
+        const std::size_t end = openTag.find('"', start);
+        return end == std::string::npos ? "" : openTag.substr(start, end - start);
+    }
+
+    float extractFloatValue(const std::string &xml, const std::string &tag, float defaultValue)
+    {
+        const std::string value = extractValue(xml, tag);
+        if (value.empty())
+            return defaultValue;
+        char *end = nullptr;
+        const float result = std::strtof(value.c_str(), &end);
+        return end != value.c_str() ? result : defaultValue;
+    }
+
+    bool extractVector(const std::string &xml, const std::string &tag, float out[3])
+    {
+        std::istringstream stream(extractValue(xml, tag));
+        return static_cast<bool>(stream >> out[0] >> out[1] >> out[2]);
+    }
+
+    /**
+     * @brief The component with the given tag and id in the <components> section, or an empty string.
+     */
+    std::string findComponent(const std::string &components, const std::string &tag, const std::string &id)
+    {
+        if (id.empty())
+            return "";
+        for (const std::string &element : extractElements(components, tag))
+        {
+            if (extractAttribute(element, "id") == id)
+                return element;
+        }
+        return "";
+    }
+
+    /**
+     * @brief Number of the first id segment that is digits followed by suffix, or 0.
+     *
+     * For "xt30-4s-lipo-850" the suffix "s" gives 4 and an empty suffix gives 850.
+     */
+    int parseIdNumber(const std::string &id, const std::string &suffix)
+    {
+        std::istringstream stream(id);
+        std::string segment;
+        while (std::getline(stream, segment, '-'))
+        {
+            if (segment.size() > suffix.size() && segment.compare(segment.size() - suffix.size(), suffix.size(), suffix) == 0 &&
+                std::all_of(segment.begin(), segment.end() - suffix.size(), [](char c)
+                            { return std::isdigit(static_cast<unsigned char>(c)) != 0; }))
+                return std::atoi(segment.c_str());
+        }
+        return 0;
+    }
+
+    /**
+     * @brief Vehicle-file body axes (+X forward, +Y right, +Z down) to the engine's (+X forward, +Y up, +Z right).
+     */
+    Vector3D toEngineFrame(const float v[3])
+    {
+        return Vector3D(v[0], -v[2], v[1]);
+    }
+
+    /**
+     * @brief Read a whole file, reporting failure on std::cerr.
+     */
+    bool readFile(const std::string &path, std::string &content)
+    {
+        std::ifstream file(path);
+        if (!file.is_open())
+        {
+            std::cerr << "Failed to open drone file: " << path << std::endl;
+            return false;
+        }
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        content = buffer.str();
+        return true;
+    }
+}
 
 DroneBuilder::DroneBuilder(IXmlQuery &xmlParser) : xmlParser_(xmlParser) {}
 
+/**
+ * @brief Build a drone entity with TransformC, PhysicsC, VehicleC and MultirotorC.
+ *
+ * The file is compiled on first use and the block is shared by every later
+ * drone built from the same path.
+ *
+ * @param configPath Path to the unified-flight-vehicle XML file
+ * @param eventBus Event bus for simulation events
+ * @return The entity, or nullptr if the file cannot be read or does not describe a multirotor
+ */
 std::unique_ptr<Entity> DroneBuilder::build(const std::string &configPath, EventBus &eventBus)
 {
-    // Stub: parse config, create entity with components
-    auto entity = std::make_unique<Entity>(1); // id 1
-    // Add components, e.g. TransformC, BatteryC, etc.
+    std::string xmlContent;
+    if (!readFile(configPath, xmlContent))
+        return nullptr;
+
+    const std::shared_ptr<const MultirotorParams> params = load(configPath);
+    if (!params)
+        return nullptr;
+
+    auto entity = std::make_unique<Entity>(); // ID assigned by World::addEntity
+    entity->addComponent<TransformC>(std::make_unique<TransformC>());
+
+    auto physics = std::make_unique<PhysicsC>(params->mass, 0.5f, 0.1f, ColliderType::Box);
+    physics->colliderSize[0] = params->frameSize.x;
+    physics->colliderSize[1] = params->frameSize.y;
+    physics->colliderSize[2] = params->frameSize.z;
+    physics->inertia = params->inertia;
+    entity->addComponent<PhysicsC>(std::move(physics));
+
+    const std::string vehicles = extractValue(xmlContent, "vehicles");
+    entity->addComponent<VehicleC>(std::make_unique<VehicleC>(
+        extractValue(vehicles, "vehicle-type"), extractFloatValue(vehicles, "vne-ms", 100.0f)));
+    entity->addComponent<MultirotorC>(std::make_unique<MultirotorC>(params));
     return entity;
 }
 
+/**
+ * @brief Compile the first vehicle of a unified-flight-vehicle document into a parameter block.
+ *
+ * Each rotor's thrust coefficient puts its static thrust at full command on
+ * a nominally charged pack; its drag torque is TorquePerThrustPerDiameter
+ * times the propeller diameter times its thrust, and its current is that
+ * torque over the motor's torque constant 1 / KV. The pack's internal
+ * resistance is the one that sags it by SagAtMaxDischarge at its rated
+ * maximum discharge.
+ *
+ * @param xmlContent XML document text
+ * @param params [out] Compiled vehicle type
+ * @return true if the document describes a multirotor with 1 to MultirotorParams::MaxRotors rotors
+ */
+bool DroneBuilder::compile(const std::string &xmlContent, MultirotorParams &params)
+{
+    const std::string vehicles = extractValue(xmlContent, "vehicles");
+    const std::string components = extractValue(xmlContent, "components");
+    if (vehicles.empty())
+    {
+        std::cerr << "Drone file has no <vehicles> section" << std::endl;
+        return false;
+    }
+    const std::string vehicleType = extractValue(vehicles, "vehicle-type");
+    if (vehicleType != "multirotor")
+    {
+        std::cerr << "Drone file describes a '" << vehicleType << "', not a multirotor" << std::endl;
+        return false;
+    }
+
+    params = MultirotorParams();
+    params.mass = extractFloatValue(vehicles, "mass-kg", 0.0f);
+    if (params.mass <= 0.0f)
+    {
+        std::cerr << "Drone file has no positive <mass-kg>" << std::endl;
+        return false;
+    }
+
+    // Principal moments only; the engine's Y axis is the file's Z axis
+    const std::vector<std::string> rows = extractElements(extractValue(vehicles, "inertia-tensor-kg-m2"), "row");
+    if (rows.size() == 3)
+    {
+        float row[3][3];
+        for (int r = 0; r < 3; ++r)
+        {
+            std::istringstream stream(extractValue(rows[r], "row"));
+            if (!(stream >> row[r][0] >> row[r][1] >> row[r][2]))
+                row[r][0] = row[r][1] = row[r][2] = 0.0f;
+        }
+        params.inertia = Vector3D(row[0][0], row[2][2], row[1][1]);
+    }
+
+    const std::string group = extractValue(vehicles, "propulsion-group");
+    std::vector<std::string> units = extractElements(group, "unit");
+    if (units.empty())
+        units = extractElements(group, "propulsion");
+    if (units.empty() || units.size() > static_cast<std::size_t>(MultirotorParams::MaxRotors))
+    {
+        std::cerr << "Drone file has " << units.size() << " rotors; 1 to " << MultirotorParams::MaxRotors
+                  << " are supported" << std::endl;
+        return false;
+    }
+    params.rotorCount = static_cast<int>(units.size());
+
+    // Battery: the first mount's pack, or the cell count and capacity spelled in its id
+    const std::vector<std::string> mounts = extractElements(extractValue(vehicles, "energy"), "mount");
+    const std::string batteryRef = mounts.empty() ? "" : extractAttribute(mounts.front(), "ref");
+    const std::string battery = findComponent(components, "battery", batteryRef);
+    const float nominalVoltage = extractFloatValue(battery, "nominal-voltage-v", 0.0f);
+    params.cellCount = nominalVoltage > 0.0f ? static_cast<int>(std::lround(nominalVoltage / CellNominalVoltage))
+                                             : parseIdNumber(batteryRef, "s");
+    if (params.cellCount <= 0)
+        params.cellCount = DefaultCellCount;
+    const int capacityMah = parseIdNumber(batteryRef, "");
+    params.capacityAh = extractFloatValue(battery, "capacity-ah", capacityMah >= 100 ? capacityMah / 1000.0f
+                                                                                      : DefaultCapacityAh);
+    const float maxDischargeC = extractFloatValue(battery, "max-discharge-c", DefaultMaxDischargeC);
+    const float packVoltage = params.cellCount * CellNominalVoltage;
+    params.internalResistance = SagAtMaxDischarge * packVoltage / std::max(maxDischargeC * params.capacityAh, 1.0f);
+
+    const std::string controlMap = extractValue(vehicles, "control-map");
+    std::vector<std::string> rotorIds(units.size());
+    float reach = 0.0f;
+    for (int i = 0; i < params.rotorCount; ++i)
+    {
+        const std::string &unit = units[i];
+        rotorIds[i] = extractAttribute(unit, "id");
+        const std::string rotor = findComponent(components, "rotor-unit", extractValue(unit, "rotor-ref"));
+        const std::string motor = findComponent(components, "electric-motor", extractValue(rotor, "motor-ref"));
+        const std::string prop = findComponent(components, "propeller", extractValue(rotor, "prop-ref"));
+
+        float location[3] = {0.0f, 0.0f, 0.0f};
+        extractVector(unit, "location-m", location);
+        params.rotorPosition[i] = toEngineFrame(location);
+        std::string direction = extractValue(unit, "rotation-direction");
+        if (direction.empty())
+            direction = extractValue(rotor, "rotation-direction");
+        params.spin[i] = direction == "cw" ? -1.0f : 1.0f;
 
+        const float kv = extractFloatValue(motor, "kv", DefaultKv);
+        const float diameter = extractFloatValue(prop, "diameter-m", DefaultPropDiameter);
+        const float staticThrust = extractFloatValue(
+            rotor, "static-thrust-n", DefaultThrustToWeight * params.mass * Gravity / params.rotorCount);
+        const float speedPerVolt = kv * RpmPerVoltToRadPerSecondPerVolt;
+        const float fullSpeed = speedPerVolt * packVoltage;
+
+        params.speedPerVolt[i] = speedPerVolt;
+        params.thrustCoefficient[i] = staticThrust / (fullSpeed * fullSpeed);
+        params.torqueCoefficient[i] = params.thrustCoefficient[i] * TorquePerThrustPerDiameter * diameter;
+        params.currentCoefficient[i] = params.torqueCoefficient[i] * speedPerVolt;
+        params.motorTimeConstant[i] = DefaultMotorTimeConstant;
+
+        reach = std::max(reach, std::max(std::fabs(params.rotorPosition[i].x), std::fabs(params.rotorPosition[i].z)) +
+                                    0.5f * diameter);
+    }
+    params.frameSize = Vector3D(2.0f * reach, FrameHeight, 2.0f * reach);
+
+    // Mixer rows from the control-map; without one every rotor follows the throttle
+    if (controlMap.empty())
+    {
+        for (int i = 0; i < params.rotorCount; ++i)
+            params.mixer[i][3] = 1.0f;
+    }
+    static const char *const Inputs[4] = {"roll", "pitch", "yaw", "throttle"};
+    for (const std::string &map : extractElements(controlMap, "map"))
+    {
+        const std::string input = extractAttribute(map, "input");
+        const int column = static_cast<int>(std::find(Inputs, Inputs + 4, input) - Inputs);
+        if (column == 4)
+        {
+            DEBUG_LOG("Ignoring control-map input '" << input << "'");
+            continue;
+        }
+        for (const std::string &effector : extractElements(map, "effector"))
+        {
+            const std::string target = extractAttribute(effector, "target");
+            const auto rotor = std::find(rotorIds.begin(), rotorIds.end(), target);
+            if (rotor == rotorIds.end())
+            {
+                std::cerr << "Control-map targets unknown rotor '" << target << "'" << std::endl;
+                continue;
+            }
+            const std::string scale = extractAttribute(effector, "scale");
+            params.mixer[rotor - rotorIds.begin()][column] = scale.empty() ? 1.0f : std::strtof(scale.c_str(), nullptr);
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Get the compiled parameter block of a vehicle file, compiling it on first use.
+ *
+ * The cache lives for the whole process and is never evicted: a vehicle
+ * type is a few hundred bytes, and snapshots refer to it by path.
+ *
+ * @param configPath Path to the unified-flight-vehicle XML file
+ * @return The shared block (its source is configPath), or nullptr if the file cannot be read or compiled
+ */
+std::shared_ptr<const MultirotorParams> DroneBuilder::load(const std::string &configPath)
+{
+    static std::mutex mutex;
+    static std::unordered_map<std::string, std::shared_ptr<const MultirotorParams>> compiled;
+    std::lock_guard<std::mutex> lock(mutex);
+
+    std::shared_ptr<const MultirotorParams> &params = compiled[configPath];
+    if (params)
+        return params;
+
+    std::string xmlContent;
+    auto block = std::make_shared<MultirotorParams>();
+    if (!readFile(configPath, xmlContent))
+    {
+        compiled.erase(configPath);
+        return nullptr;
+    }
+    if (!compile(xmlContent, *block))
+    {
+        std::cerr << "Failed to compile drone file: " << configPath << std::endl;
+        compiled.erase(configPath);
+        return nullptr;
+    }
+    block->source = configPath;
+    params = std::move(block);
+    DEBUG_LOG("Compiled drone " << configPath << ": " << params->rotorCount << " rotors, "
+                                << params->mass << " kg, " << params->cellCount << "S");
+    return params;
+}
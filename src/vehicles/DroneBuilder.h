@@ -3,16 +3,61 @@
 
 #include "IVehicleBuilder.h"
 #include "utils/IXmlQuery.h"
+#include "physics/MultirotorModel.h"
+#include <memory>
+#include <string>
 
+/**
+ * @brief Builds multirotor entities from unified-flight-vehicle XML files.
+ *
+ * The vehicle's mass properties, rotor layout, spin directions and
+ * control-map are compiled into a MultirotorParams block. Rotor units,
+ * motors, propellers and batteries are looked up by id in the file's
+ * <components> section; references it does not define fall back to the
+ * figures of a typical 4S FPV power train sized from the vehicle itself.
+ * Blocks are cached per file for the whole process, so every drone built
+ * from one file shares a single block, and a restored snapshot can find
+ * it again by the file's path.
+ *
+ * Vehicle files are in SI units with an aerospace body frame (+X forward,
+ * +Y right, +Z down); the compiled block is in the engine's frame (+X
+ * forward, +Y up, +Z right).
+ */
 class DroneBuilder : public IVehicleBuilder
 {
 public:
     DroneBuilder(IXmlQuery &xmlParser);
+
+    /**
+     * @brief Build a drone entity with TransformC, PhysicsC, VehicleC and MultirotorC.
+     *
+     * @param configPath Path to the unified-flight-vehicle XML file
+     * @param eventBus Event bus for simulation events
+     * @return The entity, or nullptr if the file cannot be read or does not describe a multirotor
+     */
     std::unique_ptr<Entity> build(const std::string &configPath, EventBus &eventBus) override;
 
+    /**
+     * @brief Compile the first vehicle of a unified-flight-vehicle document into a parameter block.
+     *
+     * @param xmlContent XML document text
+     * @param params [out] Compiled vehicle type
+     * @return true if the document describes a multirotor with 1 to MultirotorParams::MaxRotors rotors
+     */
+    static bool compile(const std::string &xmlContent, MultirotorParams &params);
+
+    /**
+     * @brief Get the compiled parameter block of a vehicle file, compiling it on first use.
+     *
+     * Safe from any thread.
+     *
+     * @param configPath Path to the unified-flight-vehicle XML file
+     * @return The shared block (its source is configPath), or nullptr if the file cannot be read or compiled
+     */
+    static std::shared_ptr<const MultirotorParams> load(const std::string &configPath);
+
 private:
     IXmlQuery &xmlParser_;
 };
 
 #endif
-